@@ -0,0 +1,92 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// A bounded queue of blocks between one producer and one consumer
+// thread, e.g. between a decompressing reader and the encoder.
+// The bound keeps memory flat when one side is faster.
+
+#ifndef BLOCKQUEUE_H
+#define BLOCKQUEUE_H
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+using namespace std;
+
+
+template<class T>
+class BlockQueue
+{
+  private:
+
+    mutex m_mtx;
+    condition_variable m_notEmpty;
+    condition_variable m_notFull;
+
+    deque<T> m_blocks;
+
+    size_t m_capacity;
+
+    bool m_closed;
+
+  public:
+
+    BlockQueue(const size_t capacity = 8)
+    {
+      m_capacity = capacity;
+      m_closed = false;
+    }
+
+    void reset()
+    {
+      lock_guard<mutex> lck(m_mtx);
+      m_blocks.clear();
+      m_closed = false;
+    }
+
+    // Waits while the queue is full.  Returns false if the queue
+    // was closed, in which case the block is dropped.
+    bool push(T&& block)
+    {
+      unique_lock<mutex> lck(m_mtx);
+      m_notFull.wait(lck, [this]
+        { return m_closed || m_blocks.size() < m_capacity; });
+      if (m_closed)
+        return false;
+
+      m_blocks.push_back(move(block));
+      m_notEmpty.notify_one();
+      return true;
+    }
+
+    // Waits while the queue is empty.  Returns false once the
+    // queue is closed and empty.
+    bool pop(T& block)
+    {
+      unique_lock<mutex> lck(m_mtx);
+      m_notEmpty.wait(lck, [this]
+        { return m_closed || ! m_blocks.empty(); });
+      if (m_blocks.empty())
+        return false;
+
+      block = move(m_blocks.front());
+      m_blocks.pop_front();
+      m_notFull.notify_one();
+      return true;
+    }
+
+    // Called by the producer at the end, or by the consumer to
+    // give up early.  Wakes up both sides.
+    void close()
+    {
+      lock_guard<mutex> lck(m_mtx);
+      m_closed = true;
+      m_notEmpty.notify_all();
+      m_notFull.notify_all();
+    }
+};
+
+#endif
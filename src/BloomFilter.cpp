@@ -0,0 +1,198 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <cstring>
+
+#include "BloomFilter.h"
+#include "MappedIndex.h"
+#include "files.h"
+
+// Odd multipliers, one per word of a block.
+static const uint32_t BLOOM_SALT[BLOOM_WORDS] =
+{
+  0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+  0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+};
+
+
+BloomFilter::BloomFilter()
+{
+  reset();
+}
+
+
+BloomFilter::~BloomFilter()
+{
+}
+
+
+void BloomFilter::reset()
+{
+  m_built.clear();
+  m_file.close();
+  m_header = nullptr;
+  m_blocks = nullptr;
+  m_numBlocks = 0;
+}
+
+
+static inline size_t bloomBlock(
+  const uint64_t hash,
+  const uint64_t numBlocks)
+{
+  // Multiply and shift instead of a division.
+  return static_cast<size_t>(((hash >> 32) * numBlocks) >> 32);
+}
+
+
+static inline uint32_t bloomBit(
+  const uint64_t hash,
+  const unsigned word)
+{
+  return 1U << ((static_cast<uint32_t>(hash) * BLOOM_SALT[word]) >> 27);
+}
+
+
+void BloomFilter::build(
+  const vector<uint64_t>& hashes,
+  const BloomSource& source)
+{
+  reset();
+
+  BloomHeader header;
+  memset(&header, 0, sizeof header);
+  memcpy(header.magic, BLOOM_MAGIC, sizeof header.magic);
+  header.version = BLOOM_VERSION;
+  header.headerSize = sizeof header;
+  header.blockWords = BLOOM_WORDS;
+  header.source = source;
+  header.numKeys = hashes.size();
+
+  const uint64_t blockBits = BLOOM_WORDS * 32;
+  const uint64_t bits = hashes.size() * BLOOM_BITS_PER_KEY;
+  header.numBlocks = (bits + blockBits - 1) / blockBits;
+  if (header.numBlocks == 0)
+    header.numBlocks = 1;
+
+  header.blocksOffset = (sizeof header + BLOOM_ALIGN - 1) /
+    BLOOM_ALIGN * BLOOM_ALIGN;
+  header.fileSize = header.blocksOffset +
+    header.numBlocks * BLOOM_WORDS * sizeof(uint32_t);
+
+  string out(header.fileSize, '\0');
+  uint32_t * blocks =
+    reinterpret_cast<uint32_t *>(&out[header.blocksOffset]);
+  for (const uint64_t hash: hashes)
+  {
+    uint32_t * block =
+      blocks + bloomBlock(hash, header.numBlocks) * BLOOM_WORDS;
+    for (unsigned w = 0; w < BLOOM_WORDS; w++)
+      block[w] |= bloomBit(hash, w);
+  }
+
+  header.checksum = indexChecksum(out.data() + sizeof header,
+    out.size() - sizeof header);
+  memcpy(&out[0], &header, sizeof header);
+
+  m_built.swap(out);
+  attach(m_built.data(), m_built.size());
+}
+
+
+bool BloomFilter::attach(
+  const char * data,
+  const size_t size)
+{
+  if (size < sizeof(BloomHeader))
+    return false;
+
+  const BloomHeader& h = * reinterpret_cast<const BloomHeader *>(data);
+  if (memcmp(h.magic, BLOOM_MAGIC, sizeof h.magic) != 0 ||
+      h.version != BLOOM_VERSION ||
+      h.headerSize != sizeof(BloomHeader) ||
+      h.fileSize != size ||
+      h.blockWords != BLOOM_WORDS ||
+      h.numBlocks == 0 ||
+      h.blocksOffset % BLOOM_ALIGN != 0 ||
+      h.blocksOffset > size ||
+      h.numBlocks > (size - h.blocksOffset) /
+        (BLOOM_WORDS * sizeof(uint32_t)))
+    return false;
+
+  m_header = &h;
+  m_blocks = reinterpret_cast<const uint32_t *>(data + h.blocksOffset);
+  m_numBlocks = h.numBlocks;
+  return true;
+}
+
+
+bool BloomFilter::save(const string& fname) const
+{
+  if (m_header == nullptr)
+    return false;
+  return writeFile(fname, string(reinterpret_cast<const char *>(m_header),
+    m_header->fileSize));
+}
+
+
+bool BloomFilter::open(
+  const string& fname,
+  const bool verify)
+{
+  reset();
+  if (! m_file.open(fname) ||
+      ! attach(m_file.data(), m_file.size()))
+  {
+    reset();
+    return false;
+  }
+
+  if (verify && indexChecksum(m_file.data() + sizeof(BloomHeader),
+      m_file.size() - sizeof(BloomHeader)) != m_header->checksum)
+  {
+    reset();
+    return false;
+  }
+  return true;
+}
+
+
+bool BloomFilter::builtFrom(const BloomSource& source) const
+{
+  if (m_header == nullptr)
+    return false;
+
+  const BloomSource& s = m_header->source;
+  return s.size == source.size && s.time == source.time &&
+    s.config == source.config && s.names == source.names;
+}
+
+
+size_t BloomFilter::numKeys() const
+{
+  return (m_header ? m_header->numKeys : 0);
+}
+
+
+size_t BloomFilter::numBytes() const
+{
+  return (m_header ? m_header->fileSize : 0);
+}
+
+
+bool BloomFilter::mayContain(const uint64_t hash) const
+{
+  const uint32_t * block =
+    m_blocks + bloomBlock(hash, m_numBlocks) * BLOOM_WORDS;
+
+  // No early exit:  the eight tests fold into a few vector operations.
+  uint32_t missing = 0;
+  for (unsigned w = 0; w < BLOOM_WORDS; w++)
+  {
+    const uint32_t bit = bloomBit(hash, w);
+    missing |= (block[w] & bit) ^ bit;
+  }
+  return missing == 0;
+}
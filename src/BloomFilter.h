@@ -0,0 +1,122 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// A Bloom filter over the names of a list, to tell quickly that a new
+// name is not in it.  The members are 64-bit hashes of key sequences
+// (see packedKeysHash() in PackedKey.h), so a probe needs the keys of
+// the new name only, and never the list itself.
+//
+// The filter is split into blocks of 256 bits, aligned so that none
+// straddles a cache line.  The upper half of a hash picks the block,
+// and the lower half sets one bit in each of the eight 32-bit words of
+// the block, using a different odd multiplier per word.  So a probe
+// reads one block only, and a miss costs about as much as one cache
+// miss.  At BLOOM_BITS_PER_KEY bits per member, about 0.15% of
+// the non-members pass.
+//
+// A filter remembers the list that it was built from (its size and
+// time, and the configuration and name mode of the keys), so a stale
+// one can be told and rebuilt.  It is the same bytes in memory and on
+// disk, so a saved one is memory-mapped and used in place:
+//
+//   BloomHeader
+//   blocks:  uint32_t[BLOOM_WORDS] per block, from a multiple of
+//            BLOOM_ALIGN
+//
+// The checksum is as for index files (see IndexFormat.h).
+
+#ifndef BLOOMFILTER_H
+#define BLOOMFILTER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "MappedFile.h"
+
+using namespace std;
+
+#define BLOOM_MAGIC "MPH3BLM"
+#define BLOOM_VERSION 1
+
+#define BLOOM_WORDS 8
+#define BLOOM_BITS_PER_KEY 16
+#define BLOOM_ALIGN 64
+
+
+// What a filter was built from.
+struct BloomSource
+{
+  uint64_t size;
+  int64_t time;
+  uint32_t config;
+  uint32_t names;
+};
+
+struct BloomHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t headerSize;
+  uint64_t fileSize;
+  uint32_t checksum;
+  uint32_t blockWords;
+
+  BloomSource source;
+  uint64_t numKeys;
+  uint64_t numBlocks;
+  uint64_t blocksOffset;
+};
+
+
+class BloomFilter
+{
+  private:
+
+    // The bytes are either built here or mapped from a file.
+    string m_built;
+    MappedFile m_file;
+
+    const BloomHeader * m_header;
+    const uint32_t * m_blocks;
+    uint64_t m_numBlocks;
+
+
+    bool attach(
+      const char * data,
+      const size_t size);
+
+  public:
+
+    BloomFilter();
+    ~BloomFilter();
+    void reset();
+
+    // Builds the filter of hashes (duplicates are fine) from source.
+    void build(
+      const vector<uint64_t>& hashes,
+      const BloomSource& source);
+
+    bool save(const string& fname) const;
+
+    // Returns false if the file is missing, is not a filter of this
+    // version, is truncated, or (with verify) fails the checksum.
+    bool open(
+      const string& fname,
+      const bool verify);
+
+    // Whether the filter was built from source.
+    bool builtFrom(const BloomSource& source) const;
+
+    size_t numKeys() const;
+
+    // All the bytes, with the header.
+    size_t numBytes() const;
+
+    // False if hash is certainly not a member.
+    bool mayContain(const uint64_t hash) const;
+};
+
+#endif
@@ -0,0 +1,730 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include "DoubleMetaphone.h"
+
+// The rules look at most this far beyond the end of the word.
+#define DMETAPHONE_PAD "     "
+
+
+DoubleMetaphone::DoubleMetaphone()
+{
+  reset();
+}
+
+
+DoubleMetaphone::~DoubleMetaphone()
+{
+}
+
+
+void DoubleMetaphone::reset()
+{
+  m_inWord.clear();
+  m_length = 0;
+  m_last = -1;
+  m_primary.clear();
+  m_secondary.clear();
+  m_hasAlternate = false;
+}
+
+
+void DoubleMetaphone::setNormalizedWord(const string_view in)
+{
+  m_inWord = in;
+  m_length = static_cast<int>(m_inWord.size());
+  m_inWord += DMETAPHONE_PAD;
+}
+
+
+char DoubleMetaphone::charAt(const int pos) const
+{
+  if (pos < 0 || pos >= static_cast<int>(m_inWord.size()))
+    return '\0';
+  return m_inWord[static_cast<size_t>(pos)];
+}
+
+
+bool DoubleMetaphone::isVowel(const int at) const
+{
+  if (at < 0 || at >= m_length)
+    return false;
+
+  const char c = m_inWord[static_cast<size_t>(at)];
+  return (c == 'A' || c == 'E' || c == 'I' || c == 'O' || c == 'U' ||
+    c == 'Y');
+}
+
+
+bool DoubleMetaphone::slavoGermanic() const
+{
+  const string_view word(m_inWord.data(), static_cast<size_t>(m_length));
+  return (word.find('W') != string_view::npos ||
+    word.find('K') != string_view::npos ||
+    word.find("CZ") != string_view::npos);
+}
+
+
+template<typename... Args>
+bool DoubleMetaphone::stringAt(
+  const int start,
+  const int length,
+  const Args... args) const
+{
+  if (start < 0 || start + length > static_cast<int>(m_inWord.size()))
+    return false;
+
+  const string_view segment(m_inWord.data() + start,
+    static_cast<size_t>(length));
+  return ((segment == args) || ...);
+}
+
+
+void DoubleMetaphone::add(const char * main)
+{
+  m_primary += main;
+  m_secondary += main;
+}
+
+
+void DoubleMetaphone::add(
+  const char * main,
+  const char * alt)
+{
+  m_primary += main;
+  if (alt[0] != '\0')
+  {
+    m_hasAlternate = true;
+    if (alt[0] != ' ')
+      m_secondary += alt;
+  }
+}
+
+
+int DoubleMetaphone::encode_C(const int current)
+{
+  // Various Germanic.
+  if (current > 1 &&
+      ! isVowel(current - 2) &&
+      stringAt(current - 1, 3, "ACH") &&
+      charAt(current + 2) != 'I' &&
+      (charAt(current + 2) != 'E' ||
+        stringAt(current - 2, 6, "BACHER", "MACHER")))
+  {
+    add("K");
+    return current + 2;
+  }
+
+  // Caesar.
+  if (current == 0 && stringAt(current, 6, "CAESAR"))
+  {
+    add("S");
+    return current + 2;
+  }
+
+  // Italian chianti.
+  if (stringAt(current, 4, "CHIA"))
+  {
+    add("K");
+    return current + 2;
+  }
+
+  if (stringAt(current, 2, "CH"))
+  {
+    // Michael.
+    if (current > 0 && stringAt(current, 4, "CHAE"))
+    {
+      add("K", "X");
+      return current + 2;
+    }
+
+    // Greek roots such as chemistry, chorus.
+    if (current == 0 &&
+        (stringAt(current + 1, 5, "HARAC", "HARIS") ||
+          stringAt(current + 1, 3, "HOR", "HYM", "HIA", "HEM")) &&
+        ! stringAt(0, 5, "CHORE"))
+    {
+      add("K");
+      return current + 2;
+    }
+
+    // Germanic, Greek or otherwise CH for KH.
+    if (stringAt(0, 4, "VAN ", "VON ") ||
+        stringAt(0, 3, "SCH") ||
+        // Architect, but not arch, orchestra, orchid.
+        stringAt(current - 2, 6, "ORCHES", "ARCHIT", "ORCHID") ||
+        stringAt(current + 2, 1, "T", "S") ||
+        ((stringAt(current - 1, 1, "A", "O", "U", "E") || current == 0) &&
+          // Wachtler, wechsler, but not tichner.
+          stringAt(current + 2, 1, "L", "R", "N", "M", "B", "H", "F",
+            "V", "W", " ")))
+      add("K");
+    else if (current > 0)
+    {
+      // McHugh.
+      if (stringAt(0, 2, "MC"))
+        add("K");
+      else
+        add("X", "K");
+    }
+    else
+      add("X");
+    return current + 2;
+  }
+
+  // Czerny.
+  if (stringAt(current, 2, "CZ") && ! stringAt(current - 2, 4, "WICZ"))
+  {
+    add("S", "X");
+    return current + 2;
+  }
+
+  // Focaccia.
+  if (stringAt(current + 1, 3, "CIA"))
+  {
+    add("X");
+    return current + 3;
+  }
+
+  // Double C, but not as in McClellan.
+  if (stringAt(current, 2, "CC") && ! (current == 1 && charAt(0) == 'M'))
+  {
+    // Bellocchio, but not bacchus.
+    if (stringAt(current + 2, 1, "I", "E", "H") &&
+        ! stringAt(current + 2, 2, "HU"))
+    {
+      // Accident, accede, succeed.
+      if ((current == 1 && charAt(current - 1) == 'A') ||
+          stringAt(current - 1, 5, "UCCEE", "UCCES"))
+        add("KS");
+      // Bacci, bertucci, other Italian.
+      else
+        add("X");
+      return current + 3;
+    }
+
+    // Pierce's rule.
+    add("K");
+    return current + 2;
+  }
+
+  if (stringAt(current, 2, "CK", "CG", "CQ"))
+  {
+    add("K");
+    return current + 2;
+  }
+
+  if (stringAt(current, 2, "CI", "CE", "CY"))
+  {
+    // Italian against English.
+    if (stringAt(current, 3, "CIO", "CIE", "CIA"))
+      add("S", "X");
+    else
+      add("S");
+    return current + 2;
+  }
+
+  add("K");
+
+  // Names sent in as mac caffrey, mac gregor.
+  if (stringAt(current + 1, 2, " C", " Q", " G"))
+    return current + 3;
+  if (stringAt(current + 1, 1, "C", "K", "Q") &&
+      ! stringAt(current + 1, 2, "CE", "CI"))
+    return current + 2;
+  return current + 1;
+}
+
+
+int DoubleMetaphone::encode_D(const int current)
+{
+  if (stringAt(current, 2, "DG"))
+  {
+    // Edge.
+    if (stringAt(current + 2, 1, "I", "E", "Y"))
+    {
+      add("J");
+      return current + 3;
+    }
+
+    // Edgar.
+    add("TK");
+    return current + 2;
+  }
+
+  add("T");
+  if (stringAt(current, 2, "DT", "DD"))
+    return current + 2;
+  return current + 1;
+}
+
+
+int DoubleMetaphone::encode_G(const int current)
+{
+  if (charAt(current + 1) == 'H')
+  {
+    if (current > 0 && ! isVowel(current - 1))
+    {
+      add("K");
+      return current + 2;
+    }
+
+    // Ghislane, ghiradelli.
+    if (current == 0)
+    {
+      if (charAt(current + 2) == 'I')
+        add("J");
+      else
+        add("K");
+      return current + 2;
+    }
+
+    // Parker's rule (with some further refinements):  hugh, bough,
+    // broughton.
+    if ((current > 1 && stringAt(current - 2, 1, "B", "H", "D")) ||
+        (current > 2 && stringAt(current - 3, 1, "B", "H", "D")) ||
+        (current > 3 && stringAt(current - 4, 1, "B", "H")))
+      return current + 2;
+
+    // Laugh, McLaughlin, cough, gough, rough, tough.
+    if (current > 2 &&
+        charAt(current - 1) == 'U' &&
+        stringAt(current - 3, 1, "C", "G", "L", "R", "T"))
+      add("F");
+    else if (current > 0 && charAt(current - 1) != 'I')
+      add("K");
+    return current + 2;
+  }
+
+  if (charAt(current + 1) == 'N')
+  {
+    if (current == 1 && isVowel(0) && ! slavoGermanic())
+      add("KN", "N");
+    // Not as in cagney.
+    else if (! stringAt(current + 2, 2, "EY") &&
+        charAt(current + 1) != 'Y' &&
+        ! slavoGermanic())
+      add("N", "KN");
+    else
+      add("KN");
+    return current + 2;
+  }
+
+  // Tagliaro.
+  if (stringAt(current + 1, 2, "LI") && ! slavoGermanic())
+  {
+    add("KL", "L");
+    return current + 2;
+  }
+
+  // -ges-, -gep-, -gel-, -gie- at the beginning.
+  if (current == 0 &&
+      (charAt(current + 1) == 'Y' ||
+        stringAt(current + 1, 2, "ES", "EP", "EB", "EL", "EY", "IB",
+          "IL", "IN", "IE", "EI", "ER")))
+  {
+    add("K", "J");
+    return current + 2;
+  }
+
+  // -ger-, -gy-.
+  if ((stringAt(current + 1, 2, "ER") || charAt(current + 1) == 'Y') &&
+      ! stringAt(0, 6, "DANGER", "RANGER", "MANGER") &&
+      ! stringAt(current - 1, 1, "E", "I") &&
+      ! stringAt(current - 1, 3, "RGY", "OGY"))
+  {
+    add("K", "J");
+    return current + 2;
+  }
+
+  // Italian such as biaggi.
+  if (stringAt(current + 1, 1, "E", "I", "Y") ||
+      stringAt(current - 1, 4, "AGGI", "OGGI"))
+  {
+    // Obviously Germanic.
+    if (stringAt(0, 4, "VAN ", "VON ") ||
+        stringAt(0, 3, "SCH") ||
+        stringAt(current + 1, 2, "ET"))
+      add("K");
+    // Always soft with a French ending.
+    else if (stringAt(current + 1, 4, "IER "))
+      add("J");
+    else
+      add("J", "K");
+    return current + 2;
+  }
+
+  add("K");
+  return current + (charAt(current + 1) == 'G' ? 2 : 1);
+}
+
+
+int DoubleMetaphone::encode_J(const int current)
+{
+  // Obviously Spanish:  jose, san jacinto.
+  if (stringAt(current, 4, "JOSE") || stringAt(0, 4, "SAN "))
+  {
+    if ((current == 0 && charAt(current + 4) == ' ') ||
+        stringAt(0, 4, "SAN "))
+      add("H");
+    else
+      add("J", "H");
+    return current + 1;
+  }
+
+  // Yankelovich, Jankelowicz.
+  if (current == 0 && ! stringAt(current, 4, "JOSE"))
+    add("J", "A");
+  // Spanish pronunciation of bajador.
+  else if (isVowel(current - 1) &&
+      ! slavoGermanic() &&
+      (charAt(current + 1) == 'A' || charAt(current + 1) == 'O'))
+    add("J", "H");
+  else if (current == m_last)
+    add("J", " ");
+  else if (! stringAt(current + 1, 1, "L", "T", "K", "S", "N", "M", "B",
+        "Z") &&
+      ! stringAt(current - 1, 1, "S", "K", "L"))
+    add("J");
+
+  return current + (charAt(current + 1) == 'J' ? 2 : 1);
+}
+
+
+int DoubleMetaphone::encode_L(const int current)
+{
+  if (charAt(current + 1) != 'L')
+  {
+    add("L");
+    return current + 1;
+  }
+
+  // Spanish such as cabrillo, gallegos.
+  if ((current == m_length - 3 &&
+        stringAt(current - 1, 4, "ILLO", "ILLA", "ALLE")) ||
+      ((stringAt(m_last - 1, 2, "AS", "OS") ||
+          stringAt(m_last, 1, "A", "O")) &&
+        stringAt(current - 1, 4, "ALLE")))
+    add("L", " ");
+  else
+    add("L");
+  return current + 2;
+}
+
+
+int DoubleMetaphone::encode_S(const int current)
+{
+  // Island, isle, carlisle, carlysle.
+  if (stringAt(current - 1, 3, "ISL", "YSL"))
+    return current + 1;
+
+  // Sugar-.
+  if (current == 0 && stringAt(current, 5, "SUGAR"))
+  {
+    add("X", "S");
+    return current + 1;
+  }
+
+  if (stringAt(current, 2, "SH"))
+  {
+    // Germanic.
+    if (stringAt(current + 1, 4, "HEIM", "HOEK", "HOLM", "HOLZ"))
+      add("S");
+    else
+      add("X");
+    return current + 2;
+  }
+
+  // Italian and Armenian.
+  if (stringAt(current, 3, "SIO", "SIA") || stringAt(current, 4, "SIAN"))
+  {
+    if (! slavoGermanic())
+      add("S", "X");
+    else
+      add("S");
+    return current + 3;
+  }
+
+  // German and anglicizations, so smith matches schmidt and snider
+  // matches schneider.  Also -sz- in Slavic languages, although
+  // Hungarian pronounces it S.
+  if ((current == 0 && stringAt(current + 1, 1, "M", "N", "L", "W")) ||
+      stringAt(current + 1, 1, "Z"))
+  {
+    add("S", "X");
+    return current + (stringAt(current + 1, 1, "Z") ? 2 : 1);
+  }
+
+  if (stringAt(current, 2, "SC"))
+  {
+    // Schlesinger's rule.
+    if (charAt(current + 2) == 'H')
+    {
+      // Dutch origin such as school, schooner.
+      if (stringAt(current + 3, 2, "OO", "ER", "EN", "UY", "ED", "EM"))
+      {
+        // Schermerhorn, schenker.
+        if (stringAt(current + 3, 2, "ER", "EN"))
+          add("X", "SK");
+        else
+          add("SK");
+        return current + 3;
+      }
+
+      if (current == 0 && ! isVowel(3) && charAt(3) != 'W')
+        add("X", "S");
+      else
+        add("X");
+      return current + 3;
+    }
+
+    if (stringAt(current + 2, 1, "I", "E", "Y"))
+      add("S");
+    else
+      add("SK");
+    return current + 3;
+  }
+
+  // French such as resnais, artois.
+  if (current == m_last && stringAt(current - 2, 2, "AI", "OI"))
+    add("", "S");
+  else
+    add("S");
+  return current + (stringAt(current + 1, 1, "S", "Z") ? 2 : 1);
+}
+
+
+int DoubleMetaphone::encode_T(const int current)
+{
+  if (stringAt(current, 4, "TION") || stringAt(current, 3, "TIA", "TCH"))
+  {
+    add("X");
+    return current + 3;
+  }
+
+  if (stringAt(current, 2, "TH") || stringAt(current, 3, "TTH"))
+  {
+    // Thomas, thames, or Germanic.
+    if (stringAt(current + 2, 2, "OM", "AM") ||
+        stringAt(0, 4, "VAN ", "VON ") ||
+        stringAt(0, 3, "SCH"))
+      add("T");
+    else
+      add("0", "T");
+    return current + 2;
+  }
+
+  add("T");
+  return current + (stringAt(current + 1, 1, "T", "D") ? 2 : 1);
+}
+
+
+int DoubleMetaphone::encode_W(const int current)
+{
+  // Can also be in the middle of a word.
+  if (stringAt(current, 2, "WR"))
+  {
+    add("R");
+    return current + 2;
+  }
+
+  if (current == 0 && (isVowel(current + 1) || stringAt(current, 2, "WH")))
+  {
+    // Wasserman should match Vasserman.
+    if (isVowel(current + 1))
+      add("A", "F");
+    // Uomo should match Womo.
+    else
+      add("A");
+  }
+
+  // Arnow should match Arnoff.
+  if ((current == m_last && isVowel(current - 1)) ||
+      stringAt(current - 1, 5, "EWSKI", "EWSKY", "OWSKI", "OWSKY") ||
+      stringAt(0, 3, "SCH"))
+  {
+    add("", "F");
+    return current + 1;
+  }
+
+  // Polish such as filipowicz.
+  if (stringAt(current, 4, "WICZ", "WITZ"))
+  {
+    add("TS", "FX");
+    return current + 4;
+  }
+
+  return current + 1;
+}
+
+
+int DoubleMetaphone::encode_Z(const int current)
+{
+  // Chinese pinyin such as zhao.
+  if (charAt(current + 1) == 'H')
+  {
+    add("J");
+    return current + 2;
+  }
+
+  if (stringAt(current + 1, 2, "ZO", "ZI", "ZA") ||
+      (slavoGermanic() && current > 0 && charAt(current - 1) != 'T'))
+    add("S", "TS");
+  else
+    add("S");
+  return current + (charAt(current + 1) == 'Z' ? 2 : 1);
+}
+
+
+void DoubleMetaphone::encode()
+{
+  m_primary.clear();
+  m_secondary.clear();
+  m_hasAlternate = false;
+  m_last = m_length - 1;
+  if (m_length < 1)
+    return;
+
+  int current = 0;
+
+  // Skip these at the start of a word.
+  if (stringAt(0, 2, "GN", "KN", "PN", "WR", "PS"))
+    current++;
+
+  // An initial X is pronounced Z, as in Xavier, and Z maps to S.
+  if (charAt(0) == 'X')
+  {
+    add("S");
+    current++;
+  }
+
+  while (m_primary.size() < DMETAPHONE_LENGTH ||
+      m_secondary.size() < DMETAPHONE_LENGTH)
+  {
+    if (current >= m_length)
+      break;
+
+    const char c = charAt(current);
+    switch (c)
+    {
+      case 'A': case 'E': case 'I': case 'O': case 'U': case 'Y':
+        // All initial vowels map to A.
+        if (current == 0)
+          add("A");
+        current++;
+        break;
+
+      case 'B':
+        // -mb, as in dumb, is already skipped.
+        add("P");
+        current += (charAt(current + 1) == 'B' ? 2 : 1);
+        break;
+
+      case 'C': current = encode_C(current); break;
+      case 'D': current = encode_D(current); break;
+
+      case 'F':
+      case 'K':
+      case 'N':
+      case 'Q':
+      case 'V':
+        add(c == 'F' || c == 'V' ? "F" : (c == 'N' ? "N" : "K"));
+        current += (charAt(current + 1) == c ? 2 : 1);
+        break;
+
+      case 'G': current = encode_G(current); break;
+
+      case 'H':
+        // Only kept if first or after a vowel, and before a vowel.
+        // This also takes care of HH.
+        if ((current == 0 || isVowel(current - 1)) &&
+            isVowel(current + 1))
+        {
+          add("H");
+          current += 2;
+        }
+        else
+          current++;
+        break;
+
+      case 'J': current = encode_J(current); break;
+      case 'L': current = encode_L(current); break;
+
+      case 'M':
+        // Dumb, thumb.
+        if ((stringAt(current - 1, 3, "UMB") &&
+              (current + 1 == m_last || stringAt(current + 2, 2, "ER"))) ||
+            charAt(current + 1) == 'M')
+          current += 2;
+        else
+          current++;
+        add("M");
+        break;
+
+      case 'P':
+        if (charAt(current + 1) == 'H')
+        {
+          add("F");
+          current += 2;
+          break;
+        }
+
+        // Also campbell, raspberry.
+        add("P");
+        current += (stringAt(current + 1, 1, "P", "B") ? 2 : 1);
+        break;
+
+      case 'R':
+        // French such as rogier, but not hochmeier.
+        if (current == m_last &&
+            ! slavoGermanic() &&
+            stringAt(current - 2, 2, "IE") &&
+            ! stringAt(current - 4, 2, "ME", "MA"))
+          add("", "R");
+        else
+          add("R");
+        current += (charAt(current + 1) == 'R' ? 2 : 1);
+        break;
+
+      case 'S': current = encode_S(current); break;
+      case 'T': current = encode_T(current); break;
+      case 'W': current = encode_W(current); break;
+
+      case 'X':
+        // French such as breaux.
+        if (! (current == m_last &&
+            (stringAt(current - 3, 3, "IAU", "EAU") ||
+              stringAt(current - 2, 2, "AU", "OU"))))
+          add("KS");
+        current += (stringAt(current + 1, 1, "C", "X") ? 2 : 1);
+        break;
+
+      case 'Z': current = encode_Z(current); break;
+
+      default:
+        current++;
+        break;
+    }
+  }
+
+  if (m_primary.size() > DMETAPHONE_LENGTH)
+    m_primary.resize(DMETAPHONE_LENGTH);
+  if (m_secondary.size() > DMETAPHONE_LENGTH)
+    m_secondary.resize(DMETAPHONE_LENGTH);
+}
+
+
+string DoubleMetaphone::getMetaph() const
+{
+  return m_primary;
+}
+
+
+string DoubleMetaphone::getAlternateMetaph() const
+{
+  if (! m_hasAlternate || m_secondary == m_primary)
+    return "";
+  return m_secondary;
+}
@@ -0,0 +1,88 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// Double Metaphone, the predecessor of Metaphone 3, after the original
+// C++ code by Lawrence Philips (C/C++ Users Journal, June 2000).  Like
+// Metaphone 3 it gives a main and sometimes an alternate key, but
+// with fewer rules and keys of at most DMETAPHONE_LENGTH symbols.
+//
+// The word must already be normalized as by Metaphone3::normalize(),
+// so all the algorithms share one upper-casing pass.
+
+#ifndef DOUBLEMETAPHONE_H
+#define DOUBLEMETAPHONE_H
+
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+#define DMETAPHONE_LENGTH 4
+
+
+class DoubleMetaphone
+{
+  private:
+
+    // Internal copy of the word, padded with spaces so that the rules
+    // can look beyond its end.
+    string m_inWord;
+
+    // Length of the word without the padding, and its last index.
+    int m_length;
+    int m_last;
+
+    // Running copies of the primary and secondary keys.
+    string m_primary;
+    string m_secondary;
+
+    // True if some rule gave an alternate encoding.
+    bool m_hasAlternate;
+
+
+    char charAt(const int pos) const;
+
+    bool isVowel(const int at) const;
+
+    bool slavoGermanic() const;
+
+    template<typename... Args>
+    bool stringAt(
+      const int start,
+      const int length,
+      const Args... args) const;
+
+    void add(const char * main);
+    void add(
+      const char * main,
+      const char * alt);
+
+    int encode_C(const int current);
+    int encode_D(const int current);
+    int encode_G(const int current);
+    int encode_J(const int current);
+    int encode_L(const int current);
+    int encode_S(const int current);
+    int encode_T(const int current);
+    int encode_W(const int current);
+    int encode_Z(const int current);
+
+  public:
+
+    DoubleMetaphone();
+    ~DoubleMetaphone();
+    void reset();
+
+    void setNormalizedWord(const string_view in);
+
+    void encode();
+
+    string getMetaph() const;
+
+    // Empty if there is no alternate key, or if it is the main one.
+    string getAlternateMetaph() const;
+};
+
+#endif
@@ -0,0 +1,279 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <algorithm>
+
+#include "IncrementalIndex.h"
+
+
+IndexSnapshot::IndexSnapshot()
+{
+  reset();
+}
+
+
+IndexSnapshot::~IndexSnapshot()
+{
+}
+
+
+void IndexSnapshot::reset()
+{
+  m_segments.clear();
+  m_numNames = 0;
+}
+
+
+void IndexSnapshot::setSegments(const vector<IndexSegment>& segments)
+{
+  m_segments = segments;
+  m_numNames = (segments.empty() ? 0 :
+    segments.back().base + segments.back().index->numNames());
+}
+
+
+const vector<IndexSegment>& IndexSnapshot::getSegments() const
+{
+  return m_segments;
+}
+
+
+size_t IndexSnapshot::numNames() const
+{
+  return m_numNames;
+}
+
+
+size_t IndexSnapshot::numSegments() const
+{
+  return m_segments.size();
+}
+
+
+string_view IndexSnapshot::getName(const uint32_t record) const
+{
+  // The last segment that starts at or before record.
+  auto it = upper_bound(m_segments.begin(), m_segments.end(), record,
+    [](const uint32_t r, const IndexSegment& seg)
+  {
+    return r < seg.base;
+  });
+  --it;
+  return it->index->getName(record - it->base);
+}
+
+
+void IndexSnapshot::lookupKey(
+  const unsigned config,
+  const PackedKey key,
+  vector<uint32_t>& records) const
+{
+  records.clear();
+  for (auto& seg: m_segments)
+  {
+    const PostingSpan span = seg.index->lookupKey(config, key);
+    for (size_t i = 0; i < span.size; i++)
+      records.push_back(seg.base + span.data[i]);
+  }
+}
+
+
+void IndexSnapshot::lookupName(
+  Metaphone3& mph,
+  const string_view text,
+  const unsigned config,
+  vector<uint32_t>& records) const
+{
+  // A record lies in one segment, so the segments can be searched
+  // one by one.
+  records.clear();
+  vector<uint32_t> segRecords;
+  for (auto& seg: m_segments)
+  {
+    seg.index->lookupName(mph, text, config, segRecords);
+    for (auto r: segRecords)
+      records.push_back(seg.base + r);
+  }
+}
+
+
+IncrementalIndex::IncrementalIndex()
+{
+  m_stop = false;
+  m_mergeWanted = false;
+  m_merging = false;
+  reset();
+}
+
+
+IncrementalIndex::~IncrementalIndex()
+{
+  stopMerger();
+}
+
+
+void IncrementalIndex::reset()
+{
+  stopMerger();
+
+  m_useTokenizer = false;
+  m_tokenizer.reset();
+
+  lock_guard<mutex> lock(m_viewMutex);
+  m_view = make_shared<const IndexSnapshot>();
+  m_numMerges = 0;
+}
+
+
+void IncrementalIndex::setTokenizer(const NameTokenizer * tokenizer)
+{
+  lock_guard<mutex> lock(m_addMutex);
+  m_useTokenizer = (tokenizer != nullptr);
+  if (tokenizer)
+    m_tokenizer = * tokenizer;
+  else
+    m_tokenizer.reset();
+}
+
+
+void IncrementalIndex::stopMerger()
+{
+  {
+    lock_guard<mutex> lock(m_mergeMutex);
+    m_stop = true;
+  }
+  m_mergeCond.notify_all();
+  if (m_merger.joinable())
+    m_merger.join();
+
+  m_stop = false;
+  m_mergeWanted = false;
+  m_merging = false;
+}
+
+
+shared_ptr<const IndexSnapshot> IncrementalIndex::snapshot() const
+{
+  lock_guard<mutex> lock(m_viewMutex);
+  return m_view;
+}
+
+
+void IncrementalIndex::publish(const vector<IndexSegment>& segments)
+{
+  auto view = make_shared<IndexSnapshot>();
+  view->setSegments(segments);
+  m_view = view;
+}
+
+
+uint32_t IncrementalIndex::add(const vector<string>& names)
+{
+  lock_guard<mutex> addLock(m_addMutex);
+
+  // A batch is small, so one thread encodes it.
+  auto seg = make_shared<PhoneticIndex>();
+  seg->build(names, m_useTokenizer ? &m_tokenizer : nullptr, 1);
+
+  uint32_t base;
+  {
+    lock_guard<mutex> lock(m_viewMutex);
+    vector<IndexSegment> segments = m_view->getSegments();
+    base = static_cast<uint32_t>(m_view->numNames());
+    segments.push_back({seg, base});
+    publish(segments);
+  }
+
+  {
+    lock_guard<mutex> lock(m_mergeMutex);
+    if (! m_merger.joinable())
+      m_merger = thread(&IncrementalIndex::mergeLoop, this);
+    m_mergeWanted = true;
+  }
+  m_mergeCond.notify_one();
+  return base;
+}
+
+
+bool IncrementalIndex::mergeOnce()
+{
+  const shared_ptr<const IndexSnapshot> view = snapshot();
+  const vector<IndexSegment>& segments = view->getSegments();
+  if (segments.size() < 2)
+    return false;
+
+  // The longest tail in which each segment has no more names than
+  // the ones after it together.
+  size_t first = segments.size() - 1;
+  size_t tailNames = segments[first].index->numNames();
+  while (first > 0 &&
+      segments[first-1].index->numNames() <= tailNames)
+  {
+    first--;
+    tailNames += segments[first].index->numNames();
+  }
+  if (first == segments.size() - 1)
+    return false;
+
+  vector<const PhoneticIndex *> parts;
+  for (size_t i = first; i < segments.size(); i++)
+    parts.push_back(segments[i].index.get());
+  auto merged = make_shared<PhoneticIndex>();
+  merged->merge(parts);
+
+  // Only this thread removes segments, so the merged ones are still
+  // in place, perhaps with new ones after them.
+  lock_guard<mutex> lock(m_viewMutex);
+  const vector<IndexSegment>& current = m_view->getSegments();
+  vector<IndexSegment> next(current.begin(), current.begin() +
+    static_cast<long>(first));
+  next.push_back({merged, segments[first].base});
+  next.insert(next.end(), current.begin() +
+    static_cast<long>(segments.size()), current.end());
+  publish(next);
+  m_numMerges++;
+  return true;
+}
+
+
+void IncrementalIndex::mergeLoop()
+{
+  unique_lock<mutex> lock(m_mergeMutex);
+  while (true)
+  {
+    m_mergeCond.wait(lock, [this] { return m_stop || m_mergeWanted; });
+    if (m_stop)
+      break;
+
+    m_mergeWanted = false;
+    m_merging = true;
+    lock.unlock();
+
+    while (mergeOnce())
+    {
+    }
+
+    lock.lock();
+    m_merging = false;
+    m_idleCond.notify_all();
+  }
+}
+
+
+void IncrementalIndex::waitForMerges()
+{
+  unique_lock<mutex> lock(m_mergeMutex);
+  m_idleCond.wait(lock, [this]
+  {
+    return ! m_merging && ! m_mergeWanted;
+  });
+}
+
+
+unsigned IncrementalIndex::numMerges() const
+{
+  lock_guard<mutex> lock(m_viewMutex);
+  return m_numMerges;
+}
@@ -0,0 +1,141 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// An appendable PhoneticIndex, organized like a log-structured merge
+// tree.
+//
+// Each add() indexes only the new names, as a new segment at the end.
+// A background thread merges segments so that there are only about
+// log2 of the number of batches:  whenever a segment has no more names
+// than all the segments after it together, they are merged into one
+// (PhoneticIndex::merge(), which needs no encoding).
+//
+// The segments are immutable and shared.  A snapshot is a list of
+// segments, and both adding and merging publish a new snapshot rather
+// than changing the current one.  So a query on a snapshot sees the
+// same records however long it takes, and neither waits for a merge
+// nor holds one up.  Records are numbered in the order they were
+// added, whichever segment they end up in.
+
+#ifndef INCREMENTALINDEX_H
+#define INCREMENTALINDEX_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <cstdint>
+
+#include "PhoneticIndex.h"
+
+using namespace std;
+
+
+struct IndexSegment
+{
+  shared_ptr<const PhoneticIndex> index;
+  uint32_t base; // Record number of its first name
+};
+
+
+class IndexSnapshot
+{
+  private:
+
+    vector<IndexSegment> m_segments;
+
+    size_t m_numNames;
+
+  public:
+
+    IndexSnapshot();
+    ~IndexSnapshot();
+    void reset();
+
+    void setSegments(const vector<IndexSegment>& segments);
+
+    const vector<IndexSegment>& getSegments() const;
+
+    size_t numNames() const;
+    size_t numSegments() const;
+
+    string_view getName(const uint32_t record) const;
+
+    // Like PhoneticIndex::lookupKey(), but copied out of each segment.
+    void lookupKey(
+      const unsigned config,
+      const PackedKey key,
+      vector<uint32_t>& records) const;
+
+    // Like PhoneticIndex::lookupName().
+    void lookupName(
+      Metaphone3& mph,
+      const string_view text,
+      const unsigned config,
+      vector<uint32_t>& records) const;
+};
+
+
+class IncrementalIndex
+{
+  private:
+
+    bool m_useTokenizer;
+    NameTokenizer m_tokenizer;
+
+    // The current snapshot.  Only swapped, never changed.
+    mutable mutex m_viewMutex;
+    shared_ptr<const IndexSnapshot> m_view;
+
+    // Adds happen one at a time.
+    mutex m_addMutex;
+
+    // The merge thread sleeps on m_mergeCond until there is work.
+    thread m_merger;
+    mutex m_mergeMutex;
+    condition_variable m_mergeCond;
+    condition_variable m_idleCond;
+    bool m_stop;
+    bool m_mergeWanted;
+    bool m_merging;
+    unsigned m_numMerges;
+
+
+    void publish(const vector<IndexSegment>& segments);
+
+    bool mergeOnce();
+
+    void mergeLoop();
+
+    void stopMerger();
+
+  public:
+
+    IncrementalIndex();
+    ~IncrementalIndex();
+    void reset();
+
+    // The tokenizer for the names added later (nullptr: split on
+    // spaces).  It is copied.
+    void setTokenizer(const NameTokenizer * tokenizer);
+
+    // Indexes names as a new segment and returns the record number of
+    // the first one.  Merging happens later in the background.
+    uint32_t add(const vector<string>& names);
+
+    // The index as it is now.  Stays valid and unchanged as long as it
+    // is held, whatever is added or merged meanwhile.
+    shared_ptr<const IndexSnapshot> snapshot() const;
+
+    // Waits until the merge thread has nothing left to do.
+    void waitForMerges();
+
+    unsigned numMerges() const;
+};
+
+#endif
@@ -0,0 +1,118 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// The on-disk format of a PhoneticIndex, written by
+// PhoneticIndex::save() and read in place by MappedIndex.
+//
+// The file is meant to be memory-mapped and used without parsing, so
+// all numbers are little-endian in host layout and every section
+// starts at a multiple of 8 bytes.
+//
+//   IndexHeader
+//   tokenizer settings:  IndexTokenizer, then the particles separated
+//                        by spaces
+//   name starts:         uint32_t[numNames + 1] into the pool
+//   name pool:           the names back to back
+//   per configuration:   IndexDirEntry[numKeys], sorted by key,
+//                        then the compressed posting lists
+//
+// A posting list is encoded as in PostingCodec.h:  a skip table, then
+// blocks of 128 bit-packed deltas, then the rest as gaps in LEB128
+// varints (7 bits per byte, high bit set on all but the last byte).
+// Version 1 had only the varints.
+//
+// The checksum is the CRC-32 of everything after the header.  A reader
+// must reject a different magic or version.
+
+#ifndef INDEXFORMAT_H
+#define INDEXFORMAT_H
+
+#include <cstdint>
+#include <string>
+
+#include "PackedKey.h"
+
+using namespace std;
+
+#define INDEX_MAGIC "MPH3IDX"
+#define INDEX_VERSION 2
+
+// Must equal INDEX_CONFIGS.
+#define INDEX_FILE_CONFIGS 4
+
+
+struct IndexSection
+{
+  uint64_t dirOffset;
+  uint64_t numKeys;
+  uint64_t postingsOffset;
+  uint64_t postingsSize;
+  uint64_t numPostings;
+};
+
+struct IndexHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t headerSize;
+  uint64_t fileSize;
+  uint32_t checksum;
+  uint32_t numNames;
+
+  uint64_t tokenizerOffset;
+  uint64_t tokenizerSize;
+  uint64_t nameStartOffset;
+  uint64_t poolOffset;
+  uint64_t poolSize;
+
+  IndexSection configs[INDEX_FILE_CONFIGS];
+};
+
+struct IndexTokenizer
+{
+  uint32_t useTokenizer;
+  uint32_t particleMode;
+  uint32_t keepInitials;
+  uint32_t keepNumbers;
+};
+
+struct IndexDirEntry
+{
+  PackedKey key;
+  uint64_t offset; // Into the postings of the configuration
+  uint32_t count;
+  uint32_t reserved;
+};
+
+
+inline void putVarint(
+  uint32_t value,
+  string& out)
+{
+  while (value >= 0x80)
+  {
+    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+
+inline const uint8_t * getVarint(
+  const uint8_t * p,
+  uint32_t& value)
+{
+  value = 0;
+  unsigned shift = 0;
+  while (* p & 0x80)
+  {
+    value |= static_cast<uint32_t>(* p++ & 0x7f) << shift;
+    shift += 7;
+  }
+  value |= static_cast<uint32_t>(* p++) << shift;
+  return p;
+}
+
+#endif
@@ -0,0 +1,309 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <algorithm>
+#include <cstring>
+
+#include "KeyDictionary.h"
+#include "MappedIndex.h"
+#include "files.h"
+
+
+KeyDictionary::KeyDictionary()
+{
+  reset();
+}
+
+
+KeyDictionary::~KeyDictionary()
+{
+}
+
+
+void KeyDictionary::reset()
+{
+  m_built.clear();
+  m_file.close();
+  m_header = nullptr;
+  m_starts = nullptr;
+  m_blocks = nullptr;
+  m_numKeys = 0;
+  m_numBlocks = 0;
+}
+
+
+static void alignTo8(string& out)
+{
+  while (out.size() % 8 != 0)
+    out.push_back('\0');
+}
+
+
+bool KeyDictionary::build(const vector<string>& keys)
+{
+  reset();
+  for (size_t i = 0; i < keys.size(); i++)
+  {
+    if (keys[i].size() > DICT_MAX_LENGTH ||
+        (i > 0 && keys[i-1] >= keys[i]))
+      return false;
+  }
+
+  DictHeader header;
+  memset(&header, 0, sizeof header);
+  memcpy(header.magic, DICT_MAGIC, sizeof header.magic);
+  header.version = DICT_VERSION;
+  header.headerSize = sizeof header;
+  header.blockSize = DICT_BLOCK;
+  header.numKeys = keys.size();
+  header.numBlocks = (keys.size() + DICT_BLOCK - 1) / DICT_BLOCK;
+
+  vector<uint32_t> starts;
+  string blocks;
+  for (size_t i = 0; i < keys.size(); i++)
+  {
+    const string& key = keys[i];
+    if (i % DICT_BLOCK == 0)
+    {
+      starts.push_back(static_cast<uint32_t>(blocks.size()));
+      blocks.push_back(static_cast<char>(key.size()));
+      blocks += key;
+      continue;
+    }
+
+    const string& prev = keys[i-1];
+    const size_t limit = min(prev.size(), key.size());
+    size_t shared = 0;
+    while (shared < limit && prev[shared] == key[shared])
+      shared++;
+
+    blocks.push_back(static_cast<char>(shared));
+    blocks.push_back(static_cast<char>(key.size() - shared));
+    blocks.append(key, shared, string::npos);
+  }
+  starts.push_back(static_cast<uint32_t>(blocks.size()));
+
+  string out(sizeof header, '\0');
+  header.startsOffset = out.size();
+  out.append(reinterpret_cast<const char *>(starts.data()),
+    starts.size() * sizeof(uint32_t));
+  alignTo8(out);
+
+  header.blocksOffset = out.size();
+  header.blocksSize = blocks.size();
+  out += blocks;
+  alignTo8(out);
+
+  header.fileSize = out.size();
+  header.checksum = indexChecksum(out.data() + sizeof header,
+    out.size() - sizeof header);
+  memcpy(&out[0], &header, sizeof header);
+
+  m_built.swap(out);
+  return attach(m_built.data(), m_built.size());
+}
+
+
+bool KeyDictionary::attach(
+  const char * data,
+  const size_t size)
+{
+  if (size < sizeof(DictHeader))
+    return false;
+
+  const DictHeader& h = * reinterpret_cast<const DictHeader *>(data);
+  if (memcmp(h.magic, DICT_MAGIC, sizeof h.magic) != 0 ||
+      h.version != DICT_VERSION ||
+      h.headerSize != sizeof(DictHeader) ||
+      h.fileSize != size ||
+      h.blockSize != DICT_BLOCK ||
+      h.numBlocks != (h.numKeys + DICT_BLOCK - 1) / DICT_BLOCK ||
+      h.numBlocks >= size / sizeof(uint32_t) ||
+      h.startsOffset % 8 != 0 ||
+      h.startsOffset > size ||
+      (h.numBlocks + 1) * sizeof(uint32_t) > size - h.startsOffset ||
+      h.blocksOffset > size ||
+      h.blocksSize > size - h.blocksOffset)
+    return false;
+
+  const uint32_t * starts =
+    reinterpret_cast<const uint32_t *>(data + h.startsOffset);
+  if (starts[h.numBlocks] != h.blocksSize)
+    return false;
+
+  m_header = &h;
+  m_starts = starts;
+  m_blocks = reinterpret_cast<const uint8_t *>(data + h.blocksOffset);
+  m_numKeys = h.numKeys;
+  m_numBlocks = h.numBlocks;
+  return true;
+}
+
+
+bool KeyDictionary::save(const string& fname) const
+{
+  if (m_header == nullptr)
+    return false;
+  return writeFile(fname, string(reinterpret_cast<const char *>(m_header),
+    m_header->fileSize));
+}
+
+
+bool KeyDictionary::open(
+  const string& fname,
+  const bool verify)
+{
+  reset();
+  if (! m_file.open(fname) ||
+      ! attach(m_file.data(), m_file.size()))
+  {
+    reset();
+    return false;
+  }
+
+  if (verify && indexChecksum(m_file.data() + sizeof(DictHeader),
+      m_file.size() - sizeof(DictHeader)) != m_header->checksum)
+  {
+    reset();
+    return false;
+  }
+  return true;
+}
+
+
+size_t KeyDictionary::numKeys() const
+{
+  return m_numKeys;
+}
+
+
+size_t KeyDictionary::numBytes() const
+{
+  return (m_header ? m_header->fileSize : 0);
+}
+
+
+string_view KeyDictionary::head(const size_t block) const
+{
+  const uint8_t * p = m_blocks + m_starts[block];
+  return string_view(reinterpret_cast<const char *>(p + 1), p[0]);
+}
+
+
+size_t KeyDictionary::findBlock(const string_view key) const
+{
+  // The first block whose head is > key, and then the one before.
+  size_t lo = 0, hi = m_numBlocks;
+  while (lo < hi)
+  {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (head(mid) <= key)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return (lo == 0 ? 0 : lo - 1);
+}
+
+
+template<class Fn>
+void KeyDictionary::walk(
+  const size_t id,
+  Fn fn) const
+{
+  string key;
+  for (size_t block = id / DICT_BLOCK; block < m_numBlocks; block++)
+  {
+    const uint8_t * p = m_blocks + m_starts[block];
+    const size_t first = block * DICT_BLOCK;
+    const size_t last = min(first + DICT_BLOCK, m_numKeys);
+
+    for (size_t k = first; k < last; k++)
+    {
+      if (k == first)
+      {
+        const size_t len = * p++;
+        key.assign(reinterpret_cast<const char *>(p), len);
+        p += len;
+      }
+      else
+      {
+        const size_t shared = * p++;
+        const size_t rest = * p++;
+        key.resize(shared);
+        key.append(reinterpret_cast<const char *>(p), rest);
+        p += rest;
+      }
+
+      if (k >= id && ! fn(k, key))
+        return;
+    }
+  }
+}
+
+
+size_t KeyDictionary::lowerBound(const string_view key) const
+{
+  if (m_numKeys == 0)
+    return 0;
+
+  // The block after it starts with a larger key, if there is one.
+  const size_t block = findBlock(key);
+  const size_t end = min((block + 1) * DICT_BLOCK, m_numKeys);
+  size_t result = end;
+  walk(block * DICT_BLOCK, [&](const size_t id, const string& k)
+  {
+    if (k >= key)
+    {
+      result = id;
+      return false;
+    }
+    return id + 1 < end;
+  });
+  return result;
+}
+
+
+bool KeyDictionary::find(
+  const string_view key,
+  size_t& id) const
+{
+  id = lowerBound(key);
+  if (id >= m_numKeys)
+    return false;
+
+  string found;
+  getKey(id, found);
+  return found == key;
+}
+
+
+void KeyDictionary::getKey(
+  const size_t id,
+  string& key) const
+{
+  key.clear();
+  walk(id, [&](const size_t, const string& k)
+  {
+    key = k;
+    return false;
+  });
+}
+
+
+size_t KeyDictionary::prefixRange(
+  const string_view prefix,
+  vector<string>& keys) const
+{
+  const size_t first = lowerBound(prefix);
+  walk(first, [&](const size_t, const string& k)
+  {
+    if (k.compare(0, prefix.size(), prefix) != 0)
+      return false;
+    keys.push_back(k);
+    return true;
+  });
+  return first;
+}
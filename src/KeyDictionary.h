@@ -0,0 +1,137 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// A sorted dictionary of distinct keys, such as all the main and
+// alternate keys of some lists, with keys numbered in order.
+//
+// Sorted keys share long prefixes with the key before them, so they
+// are front-coded:  the keys are cut into blocks of DICT_BLOCK, the
+// first key of each block (its head) is stored in full, and each other
+// key as the number of leading symbols it shares with the one before,
+// followed by the rest.  A lookup binary searches the heads and then
+// decodes at most one block.  The keys with a given prefix are one
+// range, so a prefix query is one lookup followed by decoding in
+// order.
+//
+// The dictionary is the same bytes in memory and on disk, so a saved
+// one is memory-mapped and used in place:
+//
+//   DictHeader
+//   block starts:  uint32_t[numBlocks + 1] into the blocks
+//   blocks:        per head, its length and its symbols; per other
+//                  key, the shared length, the length of the rest and
+//                  the rest (lengths are one byte each)
+//
+// The checksum is as for index files (see IndexFormat.h).
+
+#ifndef KEYDICTIONARY_H
+#define KEYDICTIONARY_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+#include "MappedFile.h"
+
+using namespace std;
+
+#define DICT_MAGIC "MPH3DIC"
+#define DICT_VERSION 1
+
+#define DICT_BLOCK 16
+#define DICT_MAX_LENGTH 255
+
+
+struct DictHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t headerSize;
+  uint64_t fileSize;
+  uint32_t checksum;
+  uint32_t blockSize;
+
+  uint64_t numKeys;
+  uint64_t numBlocks;
+  uint64_t startsOffset;
+  uint64_t blocksOffset;
+  uint64_t blocksSize;
+};
+
+
+class KeyDictionary
+{
+  private:
+
+    // The bytes are either built here or mapped from a file.
+    string m_built;
+    MappedFile m_file;
+
+    const DictHeader * m_header;
+    const uint32_t * m_starts;
+    const uint8_t * m_blocks;
+    size_t m_numKeys;
+    size_t m_numBlocks;
+
+
+    bool attach(
+      const char * data,
+      const size_t size);
+
+    string_view head(const size_t block) const;
+
+    // The last block whose head is <= key, or 0.
+    size_t findBlock(const string_view key) const;
+
+    // Decodes key number id on from the start of its block, and calls
+    // fn(id, key) for it and the keys after it until fn returns false.
+    template<class Fn>
+    void walk(
+      const size_t id,
+      Fn fn) const;
+
+  public:
+
+    KeyDictionary();
+    ~KeyDictionary();
+    void reset();
+
+    // keys must be sorted and distinct, and no longer than
+    // DICT_MAX_LENGTH.  Returns false otherwise.
+    bool build(const vector<string>& keys);
+
+    bool save(const string& fname) const;
+
+    // Returns false if the file is missing, is not a dictionary of
+    // this version, is truncated, or (with verify) fails the checksum.
+    bool open(
+      const string& fname,
+      const bool verify);
+
+    size_t numKeys() const;
+
+    // All the bytes, with the header.
+    size_t numBytes() const;
+
+    // The number of the first key >= key, or numKeys().
+    size_t lowerBound(const string_view key) const;
+
+    bool find(
+      const string_view key,
+      size_t& id) const;
+
+    void getKey(
+      const size_t id,
+      string& key) const;
+
+    // Appends the keys that start with prefix to keys, in order, and
+    // returns the number of the first one.
+    size_t prefixRange(
+      const string_view prefix,
+      vector<string>& keys) const;
+};
+
+#endif
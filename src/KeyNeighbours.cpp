@@ -0,0 +1,232 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <algorithm>
+
+#include "KeyNeighbours.h"
+#include "RadixSort.h"
+#include "Scheduler.h"
+
+// Bit position of the first symbol in an ordered key.
+#define ORDERED_TOP (PACKED_KEY_BITS * (PACKED_KEY_MAX_LENGTH - 1))
+
+// Keys per build job.
+#define NEIGHBOUR_CHUNK 4096
+
+
+KeyNeighbours::KeyNeighbours()
+{
+  reset();
+}
+
+
+KeyNeighbours::~KeyNeighbours()
+{
+}
+
+
+void KeyNeighbours::reset()
+{
+  m_keys.clear();
+  m_maxDistance = 0;
+  m_variants.clear();
+  m_offsets.clear();
+  m_offsets.push_back(0);
+  m_keyNos.clear();
+}
+
+
+static PackedKey deleteSymbol(
+  const PackedKey key,
+  const unsigned pos)
+{
+  // The symbols before pos stay, the ones after move up by one.
+  const unsigned shift = ORDERED_TOP - PACKED_KEY_BITS * pos;
+  const PackedKey lowMask = (static_cast<PackedKey>(1) << shift) - 1;
+  const PackedKey high = key & ~((lowMask << PACKED_KEY_BITS) |
+    static_cast<PackedKey>(PACKED_KEY_MASK));
+  return high | ((key & lowMask) << PACKED_KEY_BITS);
+}
+
+
+void KeyNeighbours::deletions(
+  const PackedKey key,
+  const unsigned maxDistance,
+  vector<PackedKey>& variants)
+{
+  variants.clear();
+  variants.push_back(key);
+
+  size_t levelStart = 0;
+  for (unsigned d = 0; d < maxDistance; d++)
+  {
+    const size_t levelEnd = variants.size();
+    for (size_t v = levelStart; v < levelEnd; v++)
+    {
+      const PackedKey base = variants[v];
+      const unsigned len = packedKeyOrderedLength(base);
+      for (unsigned pos = 0; pos < len; pos++)
+        variants.push_back(deleteSymbol(base, pos));
+    }
+    levelStart = levelEnd;
+  }
+
+  sort(variants.begin(), variants.end());
+  variants.erase(unique(variants.begin(), variants.end()), variants.end());
+}
+
+
+unsigned keyDistance(
+  const PackedKey a,
+  const PackedKey b,
+  const unsigned limit)
+{
+  unsigned sa[PACKED_KEY_MAX_LENGTH], sb[PACKED_KEY_MAX_LENGTH];
+  const unsigned la = packedKeyOrderedLength(a);
+  const unsigned lb = packedKeyOrderedLength(b);
+  if ((la > lb ? la - lb : lb - la) > limit)
+    return limit + 1;
+
+  for (unsigned i = 0; i < la; i++)
+    sa[i] = (a >> (ORDERED_TOP - PACKED_KEY_BITS * i)) & PACKED_KEY_MASK;
+  for (unsigned i = 0; i < lb; i++)
+    sb[i] = (b >> (ORDERED_TOP - PACKED_KEY_BITS * i)) & PACKED_KEY_MASK;
+
+  unsigned row[PACKED_KEY_MAX_LENGTH + 1];
+  for (unsigned j = 0; j <= lb; j++)
+    row[j] = j;
+
+  for (unsigned i = 1; i <= la; i++)
+  {
+    unsigned diag = row[0];
+    row[0] = i;
+    unsigned rowMin = row[0];
+    for (unsigned j = 1; j <= lb; j++)
+    {
+      const unsigned up = row[j];
+      row[j] = min(min(row[j] + 1, row[j-1] + 1),
+        diag + (sa[i-1] == sb[j-1] ? 0 : 1));
+      diag = up;
+      rowMin = min(rowMin, row[j]);
+    }
+    if (rowMin > limit)
+      return limit + 1;
+  }
+  return min(row[lb], limit + 1);
+}
+
+
+void KeyNeighbours::build(
+  const vector<PackedKey>& keys,
+  const unsigned maxDistance,
+  const unsigned numThreads)
+{
+  reset();
+  m_keys = keys;
+  m_maxDistance = min(maxDistance,
+    static_cast<unsigned>(NEIGHBOUR_MAX_DISTANCE));
+
+  const size_t numChunks =
+    (keys.size() + NEIGHBOUR_CHUNK - 1) / NEIGHBOUR_CHUNK;
+  vector<vector<KeyRecord>> parts(numChunks);
+
+  Scheduler scheduler;
+  scheduler.setThreads(numThreads);
+  scheduler.run(vector<size_t>(numChunks, 1), [&](size_t chunk, unsigned)
+  {
+    vector<PackedKey> variants;
+    const size_t first = chunk * NEIGHBOUR_CHUNK;
+    const size_t last = min(first + NEIGHBOUR_CHUNK, keys.size());
+    for (size_t k = first; k < last; k++)
+    {
+      deletions(keys[k], m_maxDistance, variants);
+      for (auto v: variants)
+        parts[chunk].push_back({v, static_cast<uint32_t>(k), 0});
+    }
+  });
+
+  vector<KeyRecord> all;
+  size_t total = 0;
+  for (auto& part: parts)
+    total += part.size();
+  all.reserve(total);
+  for (auto& part: parts)
+  {
+    all.insert(all.end(), part.begin(), part.end());
+    vector<KeyRecord>().swap(part);
+  }
+
+  // Stable, so the key numbers of each variant stay sorted.
+  radixSort(all, numThreads);
+
+  m_offsets.clear();
+  m_keyNos.reserve(all.size());
+  for (size_t i = 0; i < all.size(); i++)
+  {
+    if (i == 0 || all[i].key != all[i-1].key)
+    {
+      m_variants.push_back(all[i].key);
+      m_offsets.push_back(static_cast<uint32_t>(m_keyNos.size()));
+    }
+    m_keyNos.push_back(all[i].record);
+  }
+  m_offsets.push_back(static_cast<uint32_t>(m_keyNos.size()));
+}
+
+
+size_t KeyNeighbours::numKeys() const
+{
+  return m_keys.size();
+}
+
+
+size_t KeyNeighbours::numVariants() const
+{
+  return m_variants.size();
+}
+
+
+void KeyNeighbours::lookup(
+  const PackedKey query,
+  const unsigned maxDistance,
+  vector<KeyNeighbour>& neighbours) const
+{
+  neighbours.clear();
+  const unsigned dist = min(maxDistance, m_maxDistance);
+
+  vector<PackedKey> variants;
+  deletions(query, dist, variants);
+
+  vector<uint32_t> candidates;
+  for (auto v: variants)
+  {
+    auto it = lower_bound(m_variants.begin(), m_variants.end(), v);
+    if (it == m_variants.end() || * it != v)
+      continue;
+    const size_t i = static_cast<size_t>(it - m_variants.begin());
+    candidates.insert(candidates.end(),
+      m_keyNos.begin() + m_offsets[i], m_keyNos.begin() + m_offsets[i+1]);
+  }
+
+  sort(candidates.begin(), candidates.end());
+  candidates.erase(unique(candidates.begin(), candidates.end()),
+    candidates.end());
+
+  for (auto k: candidates)
+  {
+    const unsigned d = keyDistance(query, m_keys[k], dist);
+    if (d <= dist)
+      neighbours.push_back({k, m_keys[k], d});
+  }
+
+  sort(neighbours.begin(), neighbours.end(),
+    [](const KeyNeighbour& a, const KeyNeighbour& b)
+  {
+    if (a.distance != b.distance)
+      return a.distance < b.distance;
+    return a.key < b.key;
+  });
+}
+
@@ -0,0 +1,95 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// Finds the keys within edit distance 1 or 2 of a query key without
+// comparing against every key (the symmetric deletion method of
+// SymSpell).
+//
+// Two keys are within distance d (Levenshtein:  insertions, deletions
+// and substitutions) only if deleting at most d symbols from each
+// makes them equal.  So the index maps every variant of each key with
+// up to d symbols deleted back to the key.  A query looks up its own
+// deletion variants, and the candidates are then checked with the
+// real distance.  A key of length n has about n^2 / 2 such variants
+// at d = 2, which for Metaphone3 keys (mostly 8 symbols or fewer) is
+// a few dozen.
+//
+// The keys are ordered packed keys (see PackedKey.h), where deleting a
+// symbol is a shift and a mask.
+
+#ifndef KEYNEIGHBOURS_H
+#define KEYNEIGHBOURS_H
+
+#include <vector>
+#include <cstdint>
+
+#include "PackedKey.h"
+
+using namespace std;
+
+#define NEIGHBOUR_MAX_DISTANCE 2
+
+
+struct KeyNeighbour
+{
+  uint32_t keyNo; // Into the keys given to build()
+  PackedKey key;
+  unsigned distance;
+};
+
+
+class KeyNeighbours
+{
+  private:
+
+    vector<PackedKey> m_keys;
+
+    unsigned m_maxDistance;
+
+    // The distinct deletion variants, sorted, and for variant i the
+    // key numbers m_keyNos[m_offsets[i] .. m_offsets[i+1]-1].
+    vector<PackedKey> m_variants;
+    vector<uint32_t> m_offsets;
+    vector<uint32_t> m_keyNos;
+
+
+    static void deletions(
+      const PackedKey key,
+      const unsigned maxDistance,
+      vector<PackedKey>& variants);
+
+  public:
+
+    KeyNeighbours();
+    ~KeyNeighbours();
+    void reset();
+
+    // Indexes keys for queries up to maxDistance (at most
+    // NEIGHBOUR_MAX_DISTANCE), on numThreads threads.
+    void build(
+      const vector<PackedKey>& keys,
+      const unsigned maxDistance,
+      const unsigned numThreads);
+
+    size_t numKeys() const;
+    size_t numVariants() const;
+
+    // All keys within maxDistance (at most that of build()) of query,
+    // by distance and then by key.  The query itself is included at
+    // distance 0 if it is one of the keys.
+    void lookup(
+      const PackedKey query,
+      const unsigned maxDistance,
+      vector<KeyNeighbour>& neighbours) const;
+};
+
+// Levenshtein distance of two ordered packed keys, or limit + 1 if it
+// is more than limit.
+unsigned keyDistance(
+  const PackedKey a,
+  const PackedKey b,
+  const unsigned limit);
+
+#endif
@@ -0,0 +1,227 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define SCAN_AVX2
+#elif defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+  #define SCAN_SSE2
+#endif
+
+#include <algorithm>
+
+#include "KeyScan.h"
+
+// Keys per block of hits.
+#define SCAN_BLOCK 4096
+
+
+PackedKey scanPrefixMask(const unsigned prefixLength)
+{
+  if (prefixLength == 0 || prefixLength >= PACKED_KEY_MAX_LENGTH)
+    return ~static_cast<PackedKey>(0);
+
+  const unsigned bits = PACKED_KEY_BITS * prefixLength;
+  return ((static_cast<PackedKey>(1) << bits) - 1) <<
+    (PACKED_KEY_BITS * PACKED_KEY_MAX_LENGTH - bits);
+}
+
+
+// The plain loop from key number first on.
+static void scanRange(
+  const PackedKey keys[],
+  const size_t first,
+  const size_t numKeys,
+  const PackedKey main,
+  const PackedKey alt,
+  const PackedKey mask,
+  vector<uint32_t>& indices)
+{
+  const PackedKey m = main & mask;
+  const PackedKey a = alt & mask;
+  for (size_t i = first; i < numKeys; i++)
+  {
+    const PackedKey k = keys[i] & mask;
+    if (k == m || k == a)
+      indices.push_back(static_cast<uint32_t>(i));
+  }
+}
+
+
+size_t scanKeysPlain(
+  const PackedKey keys[],
+  const size_t numKeys,
+  const PackedKey main,
+  const PackedKey alt,
+  const unsigned prefixLength,
+  vector<uint32_t>& indices)
+{
+  const size_t before = indices.size();
+  scanRange(keys, 0, numKeys, main, alt, scanPrefixMask(prefixLength),
+    indices);
+  return indices.size() - before;
+}
+
+
+// Writes first + b for each bit b set in the low 8 bits of bits to
+// out[n], n+1, ..., and returns the new n.  Always writes 8 entries,
+// but without branches, which matters when most keys match.
+static inline size_t addBits(
+  const unsigned bits,
+  const uint32_t first,
+  uint32_t out[],
+  size_t n)
+{
+  for (unsigned b = 0; b < 8; b++)
+  {
+    out[n] = first + b;
+    n += (bits >> b) & 1;
+  }
+  return n;
+}
+
+
+#if defined(SCAN_AVX2)
+
+size_t scanKeys(
+  const PackedKey keys[],
+  const size_t numKeys,
+  const PackedKey main,
+  const PackedKey alt,
+  const unsigned prefixLength,
+  vector<uint32_t>& indices)
+{
+  const PackedKey mask = scanPrefixMask(prefixLength);
+  const size_t before = indices.size();
+
+  const __m256i vmask = _mm256_set1_epi64x(static_cast<long long>(mask));
+  const __m256i vm = _mm256_set1_epi64x(static_cast<long long>(main & mask));
+  const __m256i va = _mm256_set1_epi64x(static_cast<long long>(alt & mask));
+
+  // Two vectors per round, and a single combined test in the common
+  // case that neither has a hit.  Hits go to a buffer first, as there
+  // is room for all of a block.
+  uint32_t buffer[SCAN_BLOCK + 8];
+  size_t i = 0;
+  while (i + 8 <= numKeys)
+  {
+    const size_t blockEnd = min(numKeys, i + SCAN_BLOCK) & ~size_t(7);
+    size_t n = 0;
+    for ( ; i + 8 <= blockEnd; i += 8)
+    {
+      const __m256i k0 = _mm256_and_si256(vmask,
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i)));
+      const __m256i k1 = _mm256_and_si256(vmask,
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i + 4)));
+      const __m256i e0 = _mm256_or_si256(
+        _mm256_cmpeq_epi64(k0, vm), _mm256_cmpeq_epi64(k0, va));
+      const __m256i e1 = _mm256_or_si256(
+        _mm256_cmpeq_epi64(k1, vm), _mm256_cmpeq_epi64(k1, va));
+      const __m256i e = _mm256_or_si256(e0, e1);
+
+      if (_mm256_testz_si256(e, e))
+        continue;
+
+      const unsigned bits = static_cast<unsigned>(
+        _mm256_movemask_pd(_mm256_castsi256_pd(e0)) |
+        (_mm256_movemask_pd(_mm256_castsi256_pd(e1)) << 4));
+      n = addBits(bits, static_cast<uint32_t>(i), buffer, n);
+    }
+    indices.insert(indices.end(), buffer, buffer + n);
+  }
+
+  scanRange(keys, i, numKeys, main, alt, mask, indices);
+  return indices.size() - before;
+}
+
+
+const char * scanKernel()
+{
+  return "AVX2";
+}
+
+#elif defined(SCAN_SSE2)
+
+// SSE2 has no 64-bit compare, so both 32-bit halves must be equal.
+static inline __m128i equal64(
+  const __m128i a,
+  const __m128i b)
+{
+  const __m128i e = _mm_cmpeq_epi32(a, b);
+  return _mm_and_si128(e, _mm_shuffle_epi32(e, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+
+size_t scanKeys(
+  const PackedKey keys[],
+  const size_t numKeys,
+  const PackedKey main,
+  const PackedKey alt,
+  const unsigned prefixLength,
+  vector<uint32_t>& indices)
+{
+  const PackedKey mask = scanPrefixMask(prefixLength);
+  const size_t before = indices.size();
+
+  const __m128i vmask = _mm_set1_epi64x(static_cast<long long>(mask));
+  const __m128i vm = _mm_set1_epi64x(static_cast<long long>(main & mask));
+  const __m128i va = _mm_set1_epi64x(static_cast<long long>(alt & mask));
+
+  uint32_t buffer[SCAN_BLOCK + 8];
+  size_t i = 0;
+  while (i + 4 <= numKeys)
+  {
+    const size_t blockEnd = min(numKeys, i + SCAN_BLOCK) & ~size_t(3);
+    size_t n = 0;
+    for ( ; i + 4 <= blockEnd; i += 4)
+    {
+      const __m128i k0 = _mm_and_si128(vmask,
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i)));
+      const __m128i k1 = _mm_and_si128(vmask,
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i + 2)));
+      const __m128i e0 = _mm_or_si128(equal64(k0, vm), equal64(k0, va));
+      const __m128i e1 = _mm_or_si128(equal64(k1, vm), equal64(k1, va));
+
+      const unsigned bits = static_cast<unsigned>(
+        _mm_movemask_pd(_mm_castsi128_pd(e0)) |
+        (_mm_movemask_pd(_mm_castsi128_pd(e1)) << 2));
+      if (bits != 0)
+        n = addBits(bits, static_cast<uint32_t>(i), buffer, n);
+    }
+    indices.insert(indices.end(), buffer, buffer + n);
+  }
+
+  scanRange(keys, i, numKeys, main, alt, mask, indices);
+  return indices.size() - before;
+}
+
+
+const char * scanKernel()
+{
+  return "SSE2";
+}
+
+#else
+
+size_t scanKeys(
+  const PackedKey keys[],
+  const size_t numKeys,
+  const PackedKey main,
+  const PackedKey alt,
+  const unsigned prefixLength,
+  vector<uint32_t>& indices)
+{
+  return scanKeysPlain(keys, numKeys, main, alt, prefixLength, indices);
+}
+
+
+const char * scanKernel()
+{
+  return "plain";
+}
+
+#endif
+
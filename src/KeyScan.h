@@ -0,0 +1,54 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// Brute-force matching of a query key against an array of ordered
+// packed keys (see PackedKey.h), for scans without an index.
+//
+// Each key is compared (after masking to an optional prefix) with the
+// main and the alternate key of the query.  The kernel is chosen at
+// compile time:  AVX2 (4 keys per compare) if the compiler targets it
+// (/arch:AVX2, -mavx2), else SSE2 (2 keys) on any x86-64, else a plain
+// loop.  The plain loop is always available as a reference.
+
+#ifndef KEYSCAN_H
+#define KEYSCAN_H
+
+#include <vector>
+#include <cstdint>
+
+#include "PackedKey.h"
+
+using namespace std;
+
+
+// The mask for the first prefixLength symbols of an ordered key, or
+// all of it for 0 (or PACKED_KEY_MAX_LENGTH or more).
+PackedKey scanPrefixMask(const unsigned prefixLength);
+
+// Appends to indices every i for which keys[i] agrees with main or
+// alt on the first prefixLength symbols (0:  the whole key), in
+// increasing order.  Pass alt = main if there is no alternate key.
+// Returns the number of indices appended.
+size_t scanKeys(
+  const PackedKey keys[],
+  const size_t numKeys,
+  const PackedKey main,
+  const PackedKey alt,
+  const unsigned prefixLength,
+  vector<uint32_t>& indices);
+
+// The same as a plain loop.
+size_t scanKeysPlain(
+  const PackedKey keys[],
+  const size_t numKeys,
+  const PackedKey main,
+  const PackedKey alt,
+  const unsigned prefixLength,
+  vector<uint32_t>& indices);
+
+// "AVX2", "SSE2" or "plain", the kernel of scanKeys().
+const char * scanKernel();
+
+#endif
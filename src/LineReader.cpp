@@ -0,0 +1,283 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <cstring>
+
+#include <zlib.h>
+
+#ifdef USE_ZSTD
+  #include <zstd.h>
+#endif
+
+#include "LineReader.h"
+
+// Bytes per read from disk and per decompressed chunk.
+#define READ_CHUNK (1 << 17)
+
+// Lines per block handed to the consumer.
+#define READ_BLOCK_LINES 4096
+
+
+LineReader::LineReader()
+{
+  m_file = nullptr;
+  reset();
+}
+
+
+LineReader::~LineReader()
+{
+  close();
+}
+
+
+void LineReader::reset()
+{
+  m_ok = true;
+  m_stop = false;
+  m_partial.clear();
+  m_block.clear();
+  m_queue.reset();
+}
+
+
+bool LineReader::open(const string& fname)
+{
+  close();
+  reset();
+
+  m_file = fopen(fname.c_str(), "rb");
+  if (m_file == nullptr)
+    return false;
+
+  m_thread = thread(&LineReader::run, this);
+  return true;
+}
+
+
+void LineReader::pushBlock()
+{
+  if (m_block.empty())
+    return;
+
+  if (! m_queue.push(move(m_block)))
+    m_stop = true;
+  m_block.clear();
+}
+
+
+void LineReader::addData(
+  const char * data,
+  const size_t len)
+{
+  // Splits into lines as getline() does.
+  const char * p = data;
+  const char * end = data + len;
+  while (p < end)
+  {
+    const char * nl = static_cast<const char *>(memchr(p, '\n',
+      static_cast<size_t>(end - p)));
+    if (nl == nullptr)
+    {
+      m_partial.append(p, end);
+      return;
+    }
+
+    m_partial.append(p, nl);
+    m_block.push_back(move(m_partial));
+    m_partial.clear();
+    p = nl + 1;
+
+    if (m_block.size() >= READ_BLOCK_LINES)
+    {
+      pushBlock();
+      if (m_stop)
+        return;
+    }
+  }
+}
+
+
+void LineReader::readPlain(
+  vector<char>& in,
+  size_t n)
+{
+  while (n > 0 && ! m_stop)
+  {
+    addData(in.data(), n);
+    n = fread(in.data(), 1, in.size(), m_file);
+  }
+}
+
+
+void LineReader::readGzip(
+  vector<char>& in,
+  size_t n)
+{
+  // Handles concatenated gzip members, as gzip -d does.
+  z_stream zs;
+  memset(&zs, 0, sizeof zs);
+  if (inflateInit2(&zs, 15 + 16) != Z_OK)
+  {
+    m_ok = false;
+    return;
+  }
+
+  vector<char> out(READ_CHUNK);
+  zs.next_in = reinterpret_cast<Bytef *>(in.data());
+  zs.avail_in = static_cast<uInt>(n);
+
+  bool ended = false;
+  bool full = false;
+  while (! m_stop)
+  {
+    if (zs.avail_in == 0 && ! full)
+    {
+      n = fread(in.data(), 1, in.size(), m_file);
+      if (n == 0)
+        break;
+      zs.next_in = reinterpret_cast<Bytef *>(in.data());
+      zs.avail_in = static_cast<uInt>(n);
+    }
+
+    if (ended)
+    {
+      inflateReset(&zs);
+      ended = false;
+    }
+
+    zs.next_out = reinterpret_cast<Bytef *>(out.data());
+    zs.avail_out = static_cast<uInt>(out.size());
+    const int ret = inflate(&zs, Z_NO_FLUSH);
+    if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+    {
+      m_ok = false;
+      break;
+    }
+
+    addData(out.data(), out.size() - zs.avail_out);
+    full = (zs.avail_out == 0);
+    if (ret == Z_STREAM_END)
+      ended = true;
+  }
+
+  // A truncated file ends inside a member.
+  if (! ended && ! m_stop)
+    m_ok = false;
+
+  inflateEnd(&zs);
+}
+
+
+#ifdef USE_ZSTD
+void LineReader::readZstd(
+  vector<char>& in,
+  size_t n)
+{
+  ZSTD_DStream * ds = ZSTD_createDStream();
+  if (ds == nullptr)
+  {
+    m_ok = false;
+    return;
+  }
+  ZSTD_initDStream(ds);
+
+  vector<char> out(ZSTD_DStreamOutSize());
+  ZSTD_inBuffer input = {in.data(), n, 0};
+
+  // 0 once a frame is complete.
+  size_t hint = 1;
+  bool full = false;
+  while (! m_stop)
+  {
+    if (input.pos == input.size && ! full)
+    {
+      n = fread(in.data(), 1, in.size(), m_file);
+      if (n == 0)
+        break;
+      input.size = n;
+      input.pos = 0;
+    }
+
+    ZSTD_outBuffer output = {out.data(), out.size(), 0};
+    hint = ZSTD_decompressStream(ds, &output, &input);
+    if (ZSTD_isError(hint))
+    {
+      m_ok = false;
+      break;
+    }
+
+    addData(out.data(), output.pos);
+    full = (output.pos == output.size);
+  }
+
+  if (hint != 0 && ! m_stop)
+    m_ok = false;
+
+  ZSTD_freeDStream(ds);
+}
+#else
+void LineReader::readZstd(
+  vector<char>&,
+  size_t)
+{
+  // Compiled without zstd support.
+  m_ok = false;
+}
+#endif
+
+
+void LineReader::run()
+{
+  vector<char> in(READ_CHUNK);
+  const size_t n = fread(in.data(), 1, in.size(), m_file);
+  const unsigned char * u =
+    reinterpret_cast<const unsigned char *>(in.data());
+
+  if (n >= 2 && u[0] == 0x1f && u[1] == 0x8b)
+    readGzip(in, n);
+  else if (n >= 4 &&
+      u[0] == 0x28 && u[1] == 0xb5 && u[2] == 0x2f && u[3] == 0xfd)
+    readZstd(in, n);
+  else
+    readPlain(in, n);
+
+  if (ferror(m_file))
+    m_ok = false;
+
+  if (! m_stop && ! m_partial.empty())
+  {
+    m_block.push_back(move(m_partial));
+    m_partial.clear();
+  }
+  pushBlock();
+  m_queue.close();
+}
+
+
+bool LineReader::getBlock(vector<string>& lines)
+{
+  lines.clear();
+  if (m_file == nullptr)
+    return false;
+  return m_queue.pop(lines);
+}
+
+
+bool LineReader::close()
+{
+  if (m_file == nullptr)
+    return m_ok;
+
+  // Unblocks the reader thread if we stop early.
+  m_queue.close();
+  if (m_thread.joinable())
+    m_thread.join();
+
+  fclose(m_file);
+  m_file = nullptr;
+  return m_ok;
+}
+
@@ -0,0 +1,83 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// Reads the lines of a plain, gzip or zstd file in blocks.  The format
+// is detected from the first bytes.  Reading and decompression run on
+// their own thread, so they overlap with the encoding of the previous
+// block.  zstd support needs USE_ZSTD at compile time.
+
+#ifndef LINEREADER_H
+#define LINEREADER_H
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstdio>
+
+#include "BlockQueue.h"
+#include "files.h"
+
+using namespace std;
+
+
+class LineReader
+{
+  private:
+
+    FILE * m_file;
+
+    thread m_thread;
+
+    BlockQueue<vector<string>> m_queue;
+
+    // Set by the reader thread, read after it is joined.
+    bool m_ok;
+
+    // Set when the consumer has closed the queue early.
+    bool m_stop;
+
+    // Unfinished last line of the data so far.
+    string m_partial;
+
+    // Lines not yet handed over.
+    vector<string> m_block;
+
+
+    void addData(
+      const char * data,
+      const size_t len);
+
+    void pushBlock();
+
+    void readPlain(
+      vector<char>& in,
+      size_t n);
+
+    void readGzip(
+      vector<char>& in,
+      size_t n);
+
+    void readZstd(
+      vector<char>& in,
+      size_t n);
+
+    void run();
+
+  public:
+
+    LineReader();
+    ~LineReader();
+    void reset();
+
+    bool open(const string& fname);
+
+    // Returns false when there are no more lines.
+    bool getBlock(vector<string>& lines);
+
+    // Returns false if the file could not be read or decompressed.
+    bool close();
+};
+
+#endif
@@ -0,0 +1,227 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <cstring>
+
+#include <zlib.h>
+
+#ifdef USE_ZSTD
+  #include <zstd.h>
+#endif
+
+#ifdef _WIN32
+  #include <io.h>
+  #include <fcntl.h>
+#endif
+
+#include "LineWriter.h"
+
+// Bytes per compressed output chunk.
+#define WRITE_CHUNK (1 << 17)
+
+#define GZIP_LEVEL 6
+#define ZSTD_LEVEL 3
+
+
+LineWriter::LineWriter()
+{
+  m_file = nullptr;
+  m_ownFile = false;
+  reset();
+}
+
+
+LineWriter::~LineWriter()
+{
+  close();
+}
+
+
+void LineWriter::reset()
+{
+  m_format = COMPRESS_NONE;
+  m_ok = true;
+  m_queue.reset();
+}
+
+
+bool LineWriter::open(
+  const string& fname,
+  const CompressFormat format)
+{
+  close();
+  reset();
+
+  if (fname == "")
+  {
+#ifdef _WIN32
+    if (format != COMPRESS_NONE)
+      _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    fflush(stdout);
+    m_file = stdout;
+    m_ownFile = false;
+  }
+  else
+  {
+    m_file = fopen(fname.c_str(), "wb");
+    if (m_file == nullptr)
+      return false;
+    m_ownFile = true;
+  }
+
+#ifndef USE_ZSTD
+  if (format == COMPRESS_ZSTD)
+  {
+    // Compiled without zstd support.
+    close();
+    return false;
+  }
+#endif
+
+  m_format = format;
+  m_thread = thread(&LineWriter::run, this);
+  return true;
+}
+
+
+void LineWriter::writeBytes(
+  const char * data,
+  const size_t len)
+{
+  if (len > 0 && fwrite(data, 1, len, m_file) != len)
+    m_ok = false;
+}
+
+
+void LineWriter::writePlain()
+{
+  string text;
+  while (m_queue.pop(text))
+    writeBytes(text.data(), text.size());
+}
+
+
+void LineWriter::writeGzip()
+{
+  z_stream zs;
+  memset(&zs, 0, sizeof zs);
+  if (deflateInit2(&zs, GZIP_LEVEL, Z_DEFLATED, 15 + 16, 8,
+      Z_DEFAULT_STRATEGY) != Z_OK)
+  {
+    m_ok = false;
+    return;
+  }
+
+  vector<char> out(WRITE_CHUNK);
+  string text;
+  bool more = true;
+  while (more)
+  {
+    more = m_queue.pop(text);
+    const int flush = (more ? Z_NO_FLUSH : Z_FINISH);
+
+    zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(text.data()));
+    zs.avail_in = static_cast<uInt>(more ? text.size() : 0);
+    do
+    {
+      zs.next_out = reinterpret_cast<Bytef *>(out.data());
+      zs.avail_out = static_cast<uInt>(out.size());
+      deflate(&zs, flush);
+      writeBytes(out.data(), out.size() - zs.avail_out);
+    }
+    while (zs.avail_out == 0);
+  }
+
+  deflateEnd(&zs);
+}
+
+
+#ifdef USE_ZSTD
+void LineWriter::writeZstd()
+{
+  ZSTD_CStream * cs = ZSTD_createCStream();
+  if (cs == nullptr)
+  {
+    m_ok = false;
+    return;
+  }
+  ZSTD_initCStream(cs, ZSTD_LEVEL);
+
+  vector<char> out(ZSTD_CStreamOutSize());
+  string text;
+  bool more = true;
+  while (more)
+  {
+    more = m_queue.pop(text);
+    const ZSTD_EndDirective mode = (more ? ZSTD_e_continue : ZSTD_e_end);
+
+    ZSTD_inBuffer input = {text.data(), more ? text.size() : 0, 0};
+    size_t remaining;
+    do
+    {
+      ZSTD_outBuffer output = {out.data(), out.size(), 0};
+      remaining = ZSTD_compressStream2(cs, &output, &input, mode);
+      if (ZSTD_isError(remaining))
+      {
+        m_ok = false;
+        break;
+      }
+      writeBytes(out.data(), output.pos);
+    }
+    while (more ? input.pos < input.size : remaining != 0);
+  }
+
+  ZSTD_freeCStream(cs);
+}
+#else
+void LineWriter::writeZstd()
+{
+  // Compiled without zstd support, caught in open().
+  m_ok = false;
+}
+#endif
+
+
+void LineWriter::run()
+{
+  if (m_format == COMPRESS_GZIP)
+    writeGzip();
+  else if (m_format == COMPRESS_ZSTD)
+    writeZstd();
+  else
+    writePlain();
+
+  if (fflush(m_file) != 0)
+    m_ok = false;
+
+  // On failure, drain the queue so that the producer does not block.
+  string text;
+  while (m_queue.pop(text))
+    ;
+}
+
+
+bool LineWriter::write(string&& text)
+{
+  return m_queue.push(move(text));
+}
+
+
+bool LineWriter::close()
+{
+  if (m_file == nullptr)
+    return m_ok;
+
+  m_queue.close();
+  if (m_thread.joinable())
+    m_thread.join();
+
+  if (m_ownFile && fclose(m_file) != 0)
+    m_ok = false;
+  m_file = nullptr;
+  return m_ok;
+}
+
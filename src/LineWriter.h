@@ -0,0 +1,70 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// Writes blocks of text to a file or to stdout, optionally gzip or
+// zstd-compressed.  Compression and writing run on their own thread,
+// so they overlap with the encoding of the next block.  zstd support
+// needs USE_ZSTD at compile time.
+
+#ifndef LINEWRITER_H
+#define LINEWRITER_H
+
+#include <string>
+#include <thread>
+#include <cstdio>
+
+#include "BlockQueue.h"
+#include "files.h"
+
+using namespace std;
+
+
+class LineWriter
+{
+  private:
+
+    FILE * m_file;
+
+    bool m_ownFile;
+
+    CompressFormat m_format;
+
+    thread m_thread;
+
+    BlockQueue<string> m_queue;
+
+    // Set by the writer thread, read after it is joined.
+    bool m_ok;
+
+
+    void writeBytes(
+      const char * data,
+      const size_t len);
+
+    void writePlain();
+    void writeGzip();
+    void writeZstd();
+
+    void run();
+
+  public:
+
+    LineWriter();
+    ~LineWriter();
+    void reset();
+
+    // An empty name means stdout.
+    bool open(
+      const string& fname,
+      const CompressFormat format);
+
+    // Queues a block of text.  Waits if the writer is far behind.
+    bool write(string&& text);
+
+    // Returns false if something could not be written.
+    bool close();
+};
+
+#endif
@@ -0,0 +1,147 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifdef _WIN32
+  #define WIN32_LEAN_AND_MEAN
+  #include <windows.h>
+#else
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+
+
+MappedFile::MappedFile()
+{
+  m_data = nullptr;
+  m_size = 0;
+#ifdef _WIN32
+  m_file = INVALID_HANDLE_VALUE;
+  m_mapping = nullptr;
+#endif
+}
+
+
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+
+void MappedFile::reset()
+{
+  close();
+}
+
+
+#ifdef _WIN32
+
+bool MappedFile::open(const string& fname)
+{
+  close();
+
+  m_file = CreateFileA(fname.c_str(), GENERIC_READ, FILE_SHARE_READ,
+    nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (m_file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER size;
+  if (! GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+  {
+    close();
+    return false;
+  }
+
+  m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY,
+    0, 0, nullptr);
+  if (m_mapping == nullptr)
+  {
+    close();
+    return false;
+  }
+
+  m_data = static_cast<const char *>(
+    MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+  if (m_data == nullptr)
+  {
+    close();
+    return false;
+  }
+
+  m_size = static_cast<size_t>(size.QuadPart);
+  return true;
+}
+
+
+void MappedFile::close()
+{
+  if (m_data)
+    UnmapViewOfFile(m_data);
+  if (m_mapping)
+    CloseHandle(m_mapping);
+  if (m_file != INVALID_HANDLE_VALUE)
+    CloseHandle(m_file);
+
+  m_data = nullptr;
+  m_size = 0;
+  m_mapping = nullptr;
+  m_file = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+bool MappedFile::open(const string& fname)
+{
+  close();
+
+  const int fd = ::open(fname.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0)
+  {
+    ::close(fd);
+    return false;
+  }
+
+  void * p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ,
+    MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED)
+    return false;
+
+  m_data = static_cast<const char *>(p);
+  m_size = static_cast<size_t>(st.st_size);
+  return true;
+}
+
+
+void MappedFile::close()
+{
+  if (m_data)
+    munmap(const_cast<char *>(m_data), m_size);
+
+  m_data = nullptr;
+  m_size = 0;
+}
+
+#endif
+
+
+const char * MappedFile::data() const
+{
+  return m_data;
+}
+
+
+size_t MappedFile::size() const
+{
+  return m_size;
+}
+
@@ -0,0 +1,41 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// A read-only memory mapping of a whole file.
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+
+using namespace std;
+
+
+class MappedFile
+{
+  private:
+
+    const char * m_data;
+    size_t m_size;
+
+#ifdef _WIN32
+    void * m_file;
+    void * m_mapping;
+#endif
+
+  public:
+
+    MappedFile();
+    ~MappedFile();
+    void reset();
+
+    bool open(const string& fname);
+    void close();
+
+    const char * data() const;
+    size_t size() const;
+};
+
+#endif
@@ -0,0 +1,322 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <algorithm>
+#include <cstring>
+
+#include <zlib.h>
+
+#include "MappedIndex.h"
+#include "PhoneticIndex.h"
+#include "NameQuery.h"
+#include "encode.h"
+
+static_assert(INDEX_FILE_CONFIGS == INDEX_CONFIGS,
+  "Index file and index differ in configurations");
+
+
+uint32_t indexChecksum(
+  const char * data,
+  const size_t size)
+{
+  // crc32() takes at most 4 GB at a time.
+  uLong crc = crc32(0L, Z_NULL, 0);
+  size_t done = 0;
+  while (done < size)
+  {
+    const size_t len = min(size - done, static_cast<size_t>(1) << 30);
+    crc = crc32(crc, reinterpret_cast<const Bytef *>(data + done),
+      static_cast<uInt>(len));
+    done += len;
+  }
+  return static_cast<uint32_t>(crc);
+}
+
+
+MappedIndex::MappedIndex()
+{
+  reset();
+}
+
+
+MappedIndex::~MappedIndex()
+{
+}
+
+
+void MappedIndex::reset()
+{
+  m_file.close();
+  m_header = nullptr;
+  m_nameStart = nullptr;
+  m_pool = nullptr;
+  for (unsigned config = 0; config < INDEX_FILE_CONFIGS; config++)
+  {
+    m_dirs[config] = nullptr;
+    m_postings[config] = nullptr;
+  }
+
+  m_useTokenizer = false;
+  m_tokenizer.reset();
+}
+
+
+bool MappedIndex::inFile(
+  const uint64_t offset,
+  const uint64_t size) const
+{
+  return offset <= m_file.size() && size <= m_file.size() - offset;
+}
+
+
+bool MappedIndex::checkLayout()
+{
+  const IndexHeader& h = * m_header;
+  if (h.fileSize != m_file.size() ||
+      ! inFile(h.tokenizerOffset, h.tokenizerSize) ||
+      h.tokenizerSize < sizeof(IndexTokenizer) ||
+      ! inFile(h.nameStartOffset,
+        (static_cast<uint64_t>(h.numNames) + 1) * sizeof(uint32_t)) ||
+      ! inFile(h.poolOffset, h.poolSize) ||
+      h.tokenizerOffset % 8 != 0 || h.nameStartOffset % 8 != 0)
+    return false;
+
+  for (unsigned config = 0; config < INDEX_FILE_CONFIGS; config++)
+  {
+    const IndexSection& s = h.configs[config];
+    if (s.dirOffset % 8 != 0 ||
+        s.numKeys > m_file.size() / sizeof(IndexDirEntry) ||
+        ! inFile(s.dirOffset, s.numKeys * sizeof(IndexDirEntry)) ||
+        ! inFile(s.postingsOffset, s.postingsSize))
+      return false;
+  }
+  return true;
+}
+
+
+bool MappedIndex::checkNames() const
+{
+  // The names must lie back to back in the pool.
+  const IndexHeader& h = * m_header;
+  const uint32_t * start = reinterpret_cast<const uint32_t *>(
+    m_file.data() + h.nameStartOffset);
+  if (start[0] != 0 || start[h.numNames] > h.poolSize)
+    return false;
+
+  for (uint32_t i = 0; i < h.numNames; i++)
+  {
+    if (start[i] > start[i+1])
+      return false;
+  }
+  return true;
+}
+
+
+bool MappedIndex::checkDirectory(const unsigned config) const
+{
+  // The keys must be sorted for the binary search, and the posting
+  // lists must follow each other within the postings and add up to
+  // numPostings.
+  const IndexSection& s = m_header->configs[config];
+  const IndexDirEntry * dir = reinterpret_cast<const IndexDirEntry *>(
+    m_file.data() + s.dirOffset);
+
+  uint64_t numPostings = 0;
+  for (uint64_t k = 0; k < s.numKeys; k++)
+  {
+    const IndexDirEntry& e = dir[k];
+    if (e.count == 0 || e.offset >= s.postingsSize)
+      return false;
+    if (k > 0 && (e.key <= dir[k-1].key || e.offset <= dir[k-1].offset))
+      return false;
+    numPostings += e.count;
+  }
+  return (numPostings == s.numPostings);
+}
+
+
+void MappedIndex::readTokenizer()
+{
+  const char * base = m_file.data() + m_header->tokenizerOffset;
+  IndexTokenizer tok;
+  memcpy(&tok, base, sizeof tok);
+
+  m_useTokenizer = (tok.useTokenizer != 0);
+  m_tokenizer.setParticleMode(static_cast<ParticleMode>(tok.particleMode));
+  m_tokenizer.setKeepInitials(tok.keepInitials != 0);
+  m_tokenizer.setKeepNumbers(tok.keepNumbers != 0);
+
+  const string_view text(base + sizeof tok,
+    m_header->tokenizerSize - sizeof tok);
+  vector<string> particles;
+  size_t lastPos = 0;
+  while (lastPos < text.size())
+  {
+    size_t pos = text.find(' ', lastPos);
+    if (pos == string_view::npos)
+      pos = text.size();
+    if (pos > lastPos)
+      particles.push_back(string(text.substr(lastPos, pos - lastPos)));
+    lastPos = pos + 1;
+  }
+  m_tokenizer.setParticles(particles);
+}
+
+
+bool MappedIndex::open(
+  const string& fname,
+  const bool verify)
+{
+  reset();
+  if (! m_file.open(fname))
+    return false;
+
+  m_header = reinterpret_cast<const IndexHeader *>(m_file.data());
+  if (m_file.size() < sizeof(IndexHeader) ||
+      memcmp(m_header->magic, INDEX_MAGIC, sizeof m_header->magic) != 0 ||
+      m_header->version != INDEX_VERSION ||
+      m_header->headerSize != sizeof(IndexHeader) ||
+      ! checkLayout() ||
+      ! checkNames())
+  {
+    reset();
+    return false;
+  }
+
+  for (unsigned config = 0; config < INDEX_FILE_CONFIGS; config++)
+  {
+    if (! checkDirectory(config))
+    {
+      reset();
+      return false;
+    }
+  }
+
+  if (verify && indexChecksum(m_file.data() + sizeof(IndexHeader),
+      m_file.size() - sizeof(IndexHeader)) != m_header->checksum)
+  {
+    reset();
+    return false;
+  }
+
+  const char * base = m_file.data();
+  m_nameStart = reinterpret_cast<const uint32_t *>(
+    base + m_header->nameStartOffset);
+  m_pool = base + m_header->poolOffset;
+  for (unsigned config = 0; config < INDEX_FILE_CONFIGS; config++)
+  {
+    const IndexSection& s = m_header->configs[config];
+    m_dirs[config] = reinterpret_cast<const IndexDirEntry *>(
+      base + s.dirOffset);
+    m_postings[config] = reinterpret_cast<const uint8_t *>(
+      base + s.postingsOffset);
+  }
+
+  readTokenizer();
+  return true;
+}
+
+
+void MappedIndex::close()
+{
+  reset();
+}
+
+
+size_t MappedIndex::numNames() const
+{
+  return (m_header ? m_header->numNames : 0);
+}
+
+
+size_t MappedIndex::numKeys(const unsigned config) const
+{
+  return (m_header ? m_header->configs[config].numKeys : 0);
+}
+
+
+string_view MappedIndex::getName(const uint32_t record) const
+{
+  return string_view(m_pool + m_nameStart[record],
+    m_nameStart[record+1] - m_nameStart[record]);
+}
+
+
+const NameTokenizer * MappedIndex::tokenizer() const
+{
+  return (m_useTokenizer ? &m_tokenizer : nullptr);
+}
+
+
+uint64_t MappedIndex::numPostings() const
+{
+  uint64_t n = 0;
+  if (m_header)
+    for (unsigned config = 0; config < INDEX_FILE_CONFIGS; config++)
+      n += m_header->configs[config].numPostings;
+  return n;
+}
+
+
+uint64_t MappedIndex::postingBytes() const
+{
+  uint64_t n = 0;
+  if (m_header)
+    for (unsigned config = 0; config < INDEX_FILE_CONFIGS; config++)
+      n += m_header->configs[config].postingsSize;
+  return n;
+}
+
+
+PackedKey MappedIndex::getKey(
+  const unsigned config,
+  const size_t no) const
+{
+  return m_dirs[config][no].key;
+}
+
+
+void MappedIndex::openList(
+  const unsigned config,
+  const PackedKey key,
+  PostingReader& reader) const
+{
+  reader.reset();
+  if (m_header == nullptr)
+    return;
+
+  const IndexDirEntry * dir = m_dirs[config];
+  const IndexDirEntry * end = dir + m_header->configs[config].numKeys;
+  const IndexDirEntry * it = lower_bound(dir, end, key,
+    [](const IndexDirEntry& e, const PackedKey k)
+  {
+    return e.key < k;
+  });
+  if (it != end && it->key == key)
+    reader.init(m_postings[config] + it->offset, it->count);
+}
+
+
+void MappedIndex::lookupKey(
+  const unsigned config,
+  const PackedKey key,
+  vector<uint32_t>& records) const
+{
+  PostingReader reader;
+  openList(config, key, reader);
+  reader.decodeAll(records);
+}
+
+
+void MappedIndex::lookupName(
+  Metaphone3& mph,
+  const string_view text,
+  const unsigned config,
+  vector<uint32_t>& records) const
+{
+  NameQuery query;
+  query.setIndex(* this);
+  query.lookup(mph, text, config, 0, records);
+}
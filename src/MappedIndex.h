@@ -0,0 +1,118 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// A PhoneticIndex file (see IndexFormat.h) used in place through a
+// memory mapping.  Opening checks the header, the section bounds, the
+// name starts and the key directories, but not the posting lists
+// themselves.  The checksum is only verified on request, as that
+// reads the whole file.
+
+#ifndef MAPPEDINDEX_H
+#define MAPPEDINDEX_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+#include "Metaphone3.h"
+#include "NameTokenizer.h"
+#include "MappedFile.h"
+#include "IndexFormat.h"
+#include "PostingCodec.h"
+
+using namespace std;
+
+
+// CRC-32 of an index file body.
+uint32_t indexChecksum(
+  const char * data,
+  const size_t size);
+
+
+class MappedIndex
+{
+  private:
+
+    MappedFile m_file;
+
+    const IndexHeader * m_header;
+    const uint32_t * m_nameStart;
+    const char * m_pool;
+    const IndexDirEntry * m_dirs[INDEX_FILE_CONFIGS];
+    const uint8_t * m_postings[INDEX_FILE_CONFIGS];
+
+    bool m_useTokenizer;
+    NameTokenizer m_tokenizer;
+
+
+    bool inFile(
+      const uint64_t offset,
+      const uint64_t size) const;
+
+    bool checkLayout();
+
+    bool checkNames() const;
+
+    bool checkDirectory(const unsigned config) const;
+
+    void readTokenizer();
+
+  public:
+
+    MappedIndex();
+    ~MappedIndex();
+    void reset();
+
+    // Returns false if the file is missing, is not an index file of
+    // this version, is truncated, has inconsistent name starts or key
+    // directories, or (with verify) fails the checksum.
+    bool open(
+      const string& fname,
+      const bool verify);
+
+    void close();
+
+    size_t numNames() const;
+    size_t numKeys(const unsigned config) const;
+
+    // Over all configurations, the number of postings and the bytes
+    // they take.
+    uint64_t numPostings() const;
+    uint64_t postingBytes() const;
+
+    string_view getName(const uint32_t record) const;
+
+    // The tokenizer of the index, or nullptr if it had none.
+    const NameTokenizer * tokenizer() const;
+
+    // Key number no of config, in sorted order.
+    PackedKey getKey(
+      const unsigned config,
+      const size_t no) const;
+
+    // Decodes the posting list of key (ordered packed) in config.
+    void lookupKey(
+      const unsigned config,
+      const PackedKey key,
+      vector<uint32_t>& records) const;
+
+    // Sets reader to the posting list of key (ordered packed) in
+    // config, or to an empty one.  It is valid as long as the index.
+    void openList(
+      const unsigned config,
+      const PackedKey key,
+      PostingReader& reader) const;
+
+    // Like PhoneticIndex::lookupName().  The lists are only read as
+    // far as NameQuery needs them, which mostly skips whole blocks.
+    void lookupName(
+      Metaphone3& mph,
+      const string_view text,
+      const unsigned config,
+      vector<uint32_t>& records) const;
+};
+
+#endif
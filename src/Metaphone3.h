@@ -61,10 +61,69 @@
 #define METAPHONE3_H
 
 #include <string>
+#include <string_view>
+#include <vector>
+
+#include "PackedKey.h"
 
 using namespace std;
 
 
+class RuleProfile;
+
+// The order in which the letter functions try their rules:  that of
+// Metaphone3Rules.h, that of the source, the source order while
+// counting rule hits (see RuleProfile.h), or an order set at run time
+// (setRuleTable()).  All give the same keys.
+enum RuleOrder
+{
+  RULE_ORDER_GENERATED = 0,
+  RULE_ORDER_SOURCE = 1,
+  RULE_ORDER_PROFILE = 2,
+  RULE_ORDER_TABLE = 3
+};
+
+
+// Rules that only matter for words from some languages, or for single
+// English words.  Each pack can be turned off per encoder instance
+// (setRulePacks()), or left out of the build with e.g.
+// -DMETAPHONE3_RULE_PACKS=0x0e for only Germanic, Slavic and Romance.
+// A rule that is off never fires, so its letter falls through to the
+// next rule or to the default code of the letter function.  The other
+// rules are always on.
+enum RulePack
+{
+  RULE_PACK_ENGLISH = 0x01, // Lexical exceptions: 'christmas', 'sugar'
+  RULE_PACK_GERMANIC = 0x02, // German, Dutch, Scandinavian
+  RULE_PACK_SLAVIC = 0x04, // Polish, Czech, Hungarian
+  RULE_PACK_ROMANCE = 0x08, // Spanish, Italian, Portuguese
+  RULE_PACK_FRENCH = 0x10,
+  RULE_PACK_GREEK = 0x20,
+  RULE_PACK_TRANSLIT = 0x40, // Pinyin, Hebrew and Nahuatl spellings
+  RULE_PACKS_ALL = 0x7f
+};
+
+#ifndef METAPHONE3_RULE_PACKS
+  #define METAPHONE3_RULE_PACKS RULE_PACKS_ALL
+#endif
+
+
+// One step of the main encoding loop, for rule traces.
+struct Metaphone3Step
+{
+  // Index of the character in the (upper-case) word.
+  int pos;
+
+  // Innermost sub-rule that fired, or nullptr if the letter
+  // was handled by the default code of its letter function.
+  const char * rule;
+
+  // What the step added to the primary and secondary keys.
+  string main;
+  string alt;
+};
+
+
 class Metaphone3
 {
   private:
@@ -99,6 +158,30 @@ class Metaphone3
     // True if an AL inversion has already been done.
     bool flag_AL_inversion;
 
+    // True if encode() should record a rule trace.
+    bool m_tracing;
+
+    // Innermost sub-rule that fired in the current step.
+    const char * m_rule;
+
+    // Rule trace of the last encode(), if m_tracing.
+    vector<Metaphone3Step> m_trace;
+
+    RuleOrder m_ruleOrder;
+
+    // Rule hit counts, if m_ruleOrder is RULE_ORDER_PROFILE.
+    RuleProfile * m_profile;
+
+    // True while profileChain() tries the rules of a chain.
+    bool m_inTrial;
+
+    // Per chain, the order of the rules as their numbers in source
+    // order, if m_ruleOrder is RULE_ORDER_TABLE.
+    vector<vector<unsigned>> m_ruleTable;
+
+    // The rule packs that are on, within METAPHONE3_RULE_PACKS.
+    unsigned m_rulePacks;
+
 
     void addExactApprox(
       const string& mainExact,
@@ -124,6 +207,21 @@ class Metaphone3
 
     char charAt(const int pos) const;
 
+    bool ruleHit(const char * rule);
+
+    // The rules of each chain in source order.
+    typedef bool (Metaphone3::*RuleFunction)();
+    static const vector<vector<RuleFunction>>& chainFunctions();
+
+    bool profileChain(const unsigned chainNo);
+
+    bool tableChain(const unsigned chainNo);
+
+    void traceStep(
+      const int start,
+      const size_t lenMain,
+      const size_t lenAlt);
+
     bool rootOrInflections(
       const string& inWord,
       const string& root);
@@ -161,6 +259,10 @@ class Metaphone3
     bool e_Pronounced_Exceptions();
     bool skip_Silent_UE();
 
+    // The letter functions and their rules.  Most rules are defined in
+    // Metaphone3Spec.h, which test -S generates from Metaphone3Spec.txt,
+    // and the others in Metaphone3.cpp.
+
     void encode_B();
     bool encode_Silent_B();
 
@@ -377,7 +479,14 @@ class Metaphone3
     ~Metaphone3();
     void reset();
 
-    void setWord(const string in);
+    void setWord(const string_view in);
+
+    // The two halves of setWord(), for callers that normalize
+    // a word once and encode it several times.
+    void normalize(
+      const string_view in,
+      string& out) const;
+    void setNormalizedWord(const string& in);
 
     bool setKeyLength(const int inKeyLength);
     int getKeyLength() const;
@@ -398,6 +507,49 @@ class Metaphone3
 
     string getMetaph() const;
     string getAlternateMetaph() const;
+
+    // The keys of the last encode() packed without a string copy
+    // (see PackedKey.h), at most the first PACKED_KEY_MAX_LENGTH
+    // symbols.  The ordered ones compare like the strings.
+    PackedKey getPackedMetaph() const;
+    PackedKey getPackedAlternateMetaph() const;
+    PackedKey getOrderedMetaph() const;
+    PackedKey getOrderedAlternateMetaph() const;
+
+    void setTrace(const bool inTrace);
+    bool getTrace() const;
+    const vector<Metaphone3Step>& getTraceSteps() const;
+    string getStepRule(const Metaphone3Step& step) const;
+    string getTraceString() const;
+
+    void setRuleOrder(const RuleOrder order);
+    RuleOrder getRuleOrder() const;
+
+    // Sets RULE_ORDER_PROFILE and counts the rule hits into profile.
+    bool setRuleProfile(RuleProfile * profile);
+
+    // Sets RULE_ORDER_TABLE, which tries the rules of chain c in the
+    // order table[c] (numbers in source order, as from
+    // RuleProfile::reorder()), so that an order can be checked without
+    // building again.  Returns false and changes nothing unless each
+    // order is a permutation of the rules of its chain.
+    bool setRuleTable(const vector<vector<unsigned>>& table);
+
+    // The table that gives the source order.
+    static void getSourceTable(vector<vector<unsigned>>& table);
+
+    // Turns on the packs in packs (RulePack bits) and the others off.
+    // Packs that are not compiled in stay off.
+    void setRulePacks(const unsigned packs);
+    unsigned getRulePacks() const;
+
+    // The number of rules in the packs, whether compiled in or not.
+    static unsigned numPackRules(const unsigned packs);
+
+    // The number of rules and the checksum (see RuleSpec.h) of the
+    // spec that Metaphone3Spec.h was compiled from.
+    static unsigned numSpecRules();
+    static unsigned getSpecChecksum();
 };
 
 #endif
@@ -0,0 +1,189 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// The order in which the letter functions of Metaphone3 try their
+// rules, the most hits first where that gives the same keys (see
+// RuleProfile.h).  Generated by test -R, so do not edit.  The source
+// order is SOURCE_RULES_* in Metaphone3.cpp.
+// In source order:  not profiled yet.
+
+#ifndef METAPHONE3RULES_H
+#define METAPHONE3RULES_H
+
+// C
+#define RULES_C(R) \
+  R(encode_Silent_C_At_Beginning) \
+  R(encode_CA_To_S) \
+  R(encode_CO_To_S) \
+  R(encode_CH) \
+  R(encode_CCIA) \
+  R(encode_CC) \
+  R(encode_CK_CG_CQ) \
+  R(encode_C_Front_Vowel) \
+  R(encode_Silent_C) \
+  R(encode_CZ) \
+  R(encode_CS)
+
+// CH
+#define RULES_CH(R) \
+  R(encode_CHAE) \
+  R(encode_CH_To_H) \
+  R(encode_Silent_CH) \
+  R(encode_ARCH) \
+  R(encode_CH_To_X) \
+  R(encode_English_CH_To_K) \
+  R(encode_Germanic_CH_To_K) \
+  R(encode_Greek_CH_Initial) \
+  R(encode_Greek_CH_Non_Initial)
+
+// C_FRONT_VOWEL
+#define RULES_C_FRONT_VOWEL(R) \
+  R(encode_British_Silent_CE) \
+  R(encode_CE) \
+  R(encode_CI) \
+  R(encode_Latinate_Suffixes)
+
+// D
+#define RULES_D(R) \
+  R(encode_DG) \
+  R(encode_DJ) \
+  R(encode_DT_DD) \
+  R(encode_D_To_J) \
+  R(encode_DOUS) \
+  R(encode_Silent_D)
+
+// G
+#define RULES_G(R) \
+  R(encode_Silent_G_At_Beginning) \
+  R(encode_GG) \
+  R(encode_GK) \
+  R(encode_GH) \
+  R(encode_Silent_G) \
+  R(encode_GN) \
+  R(encode_GL) \
+  R(encode_Initial_G_Front_Vowel) \
+  R(encode_NGER) \
+  R(encode_GER) \
+  R(encode_GEL) \
+  R(encode_Non_Initial_G_Front_Vowel) \
+  R(encode_GA_To_J)
+
+// GH
+#define RULES_GH(R) \
+  R(encode_GH_After_Consonant) \
+  R(encode_Initial_GH) \
+  R(encode_GH_To_J) \
+  R(encode_GH_To_H) \
+  R(encode_UGHT) \
+  R(encode_GH_H_Part_Of_Other_Word) \
+  R(encode_Silent_GH) \
+  R(encode_GH_To_F)
+
+// H
+#define RULES_H(R) \
+  R(encode_Initial_Silent_H) \
+  R(encode_Initial_HS) \
+  R(encode_Initial_HU_HW) \
+  R(encode_Non_Initial_Silent_H)
+
+// L
+#define RULES_L(R) \
+  R(encode_LELY_To_L) \
+  R(encode_COLONEL) \
+  R(encode_French_AULT) \
+  R(encode_French_EUIL) \
+  R(encode_French_OULX) \
+  R(encode_Silent_L_In_LM) \
+  R(encode_Silent_L_In_LK_LV) \
+  R(encode_Silent_L_In_OULD)
+
+// M
+#define RULES_M(R) \
+  R(encode_Silent_M_At_Beginning) \
+  R(encode_MR_And_MRS) \
+  R(encode_MAC) \
+  R(encode_MPT)
+
+// P
+#define RULES_P(R) \
+  R(encode_Silent_P_At_Beginning) \
+  R(encode_PT) \
+  R(encode_PH) \
+  R(encode_PPH) \
+  R(encode_RPS) \
+  R(encode_COUP) \
+  R(encode_PNEUM) \
+  R(encode_PSYCH) \
+  R(encode_PSALM)
+
+// S
+#define RULES_S(R) \
+  R(encode_SKJ) \
+  R(encode_Special_SW) \
+  R(encode_SJ) \
+  R(encode_Silent_French_S_Final) \
+  R(encode_Silent_French_S_Internal) \
+  R(encode_ISL) \
+  R(encode_STL) \
+  R(encode_Christmas) \
+  R(encode_STHM) \
+  R(encode_ISTEN) \
+  R(encode_Sugar) \
+  R(encode_SH) \
+  R(encode_SCH) \
+  R(encode_SUR) \
+  R(encode_SU) \
+  R(encode_SSIO) \
+  R(encode_SS) \
+  R(encode_SIA) \
+  R(encode_SIO) \
+  R(encode_Anglicisations) \
+  R(encode_SC) \
+  R(encode_SEA_SUI_SIER) \
+  R(encode_SEA)
+
+// T
+#define RULES_T(R) \
+  R(encode_T_Initial) \
+  R(encode_TCH) \
+  R(encode_Silent_French_T) \
+  R(encode_TUN_TUL_TUA_TUO) \
+  R(encode_TUE_TEU_TEOU_TUL_TIE) \
+  R(encode_TUR_TIU_Suffixes) \
+  R(encode_TI) \
+  R(encode_TIENT) \
+  R(encode_TSCH) \
+  R(encode_TZSCH) \
+  R(encode_TH_Pronounced_Separately) \
+  R(encode_TTH) \
+  R(encode_TH)
+
+// W
+#define RULES_W(R) \
+  R(encode_Silent_W_At_Beginning) \
+  R(encode_WITZ_WICZ) \
+  R(encode_WR) \
+  R(encode_Initial_W_Vowel) \
+  R(encode_WH) \
+  R(encode_Eastern_European_W)
+
+// X
+#define RULES_X(R) \
+  R(encode_Initial_X) \
+  R(encode_Greek_X) \
+  R(encode_X_Special_Cases) \
+  R(encode_X_To_H) \
+  R(encode_X_Vowel) \
+  R(encode_French_X_Final)
+
+// Z
+#define RULES_Z(R) \
+  R(encode_ZZ) \
+  R(encode_ZU_ZIER_ZS) \
+  R(encode_French_EZ) \
+  R(encode_German_Z) \
+  R(encode_ZH)
+
+#endif
@@ -0,0 +1,7370 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// The Metaphone3 rules of Metaphone3Spec.txt compiled into C++ (see
+// RuleSpec.h).  Generated by test -S, so do not edit.  These are the
+// only definitions of the rules;  Metaphone3.cpp has the others.
+
+#ifndef METAPHONE3SPEC_H
+#define METAPHONE3SPEC_H
+
+#include <cstdint>
+
+#define METAPHONE3_SPEC_CHECKSUM 0x2887cca7u
+
+#define SPEC_RULE_COUNT 137
+
+#define SPEC_RULE_WORDS 3
+
+// Per rule:  whether it only changes the state when it fires, and the
+// rules that can never fire together with it (rule r is bit r % 64 of
+// word r / 64).
+struct SpecRuleInfo
+{
+  const char * name;
+  bool pure;
+  uint64_t apart[SPEC_RULE_WORDS];
+};
+
+static const SpecRuleInfo SPEC_RULES[] =
+{
+  {"encode_Silent_B", true,
+    {0xfd637f1f7fd7f622ull, 0x9ffff77fbf7fffe7ull, 0x000000000000017eull}},
+  {"encode_Silent_C_At_Beginning", true,
+    {0xf977fafefffffeddull, 0xb7fffeffffdeffffull, 0x000000000000017full}},
+  {"encode_CA_To_S", true,
+    {0x0002000010080002ull, 0x02001000008004e0ull, 0x0000000000000008ull}},
+  {"encode_CO_To_S", true,
+    {0x0002000010080002ull, 0x02001000000004e0ull, 0x0000000000000008ull}},
+  {"encode_CHAE", true,
+    {0xdc633e1b14049022ull, 0x8aff3436bb77a7e0ull, 0x000000000000001eull}},
+  {"encode_CH_To_H", true,
+    {0xf9613a1e0e0c9211ull, 0x80bbe476bf57eb46ull, 0x000000000000005aull}},
+  {"encode_Silent_CH", true,
+    {0x0002000010080002ull, 0x02001000000004e0ull, 0x0000000000000008ull}},
+  {"encode_CH_To_X", true,
+    {0x0002000010080002ull, 0x02001000000004e0ull, 0x0000000000000008ull}},
+  {"encode_Germanic_CH_To_K", true,
+    {0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000008ull}},
+  {"encode_ARCH", true,
+    {0xfd637f0f7fdff823ull, 0x9fbff77fbf7fefe7ull, 0x000000000000007eull}},
+  {"encode_Greek_CH_Initial", true,
+    {0xfd637b0a7fdff003ull, 0x97bfe77fbf5fefe7ull, 0x000000000000007eull}},
+  {"encode_Greek_CH_Non_Initial", true,
+    {0x5c633e0b16069202ull, 0x8abfb47ebf67efe0ull, 0x000000000000003eull}},
+  {"encode_CCIA", true,
+    {0xfd637b1a77dfce33ull, 0x97ffb57fbf5fff67ull, 0x000000000000013eull}},
+  {"encode_CC", true,
+    {0xfd637b1a7fdfc603ull, 0x97ffd77dbf5ffde7ull, 0x000000000000017eull}},
+  {"encode_CK_CG_CQ", true,
+    {0xfd637b1a1fdfb603ull, 0x97fff77fbf5fffe7ull, 0x000000000000017eull}},
+  {"encode_British_Silent_CE", true,
+    {0xfc633b1a77de7e33ull, 0x97ffbf7fbf5fffe7ull, 0x000000000000013eull}},
+  {"encode_CE", true,
+    {0xfc62031a77da7603ull, 0x17ffb77fbf4fffe7ull, 0x000000000000013eull}},
+  {"encode_CI", true,
+    {0xfc633b1a77d9fe03ull, 0x97f1b77fbf5fffe7ull, 0x000000000000013aull}},
+  {"encode_Latinate_Suffixes", true,
+    {0xfc633b1a77d8fe33ull, 0x97fab77fbf5fffe7ull, 0x000000000000013aull}},
+  {"encode_Silent_C", true,
+    {0xdd77ff5b76d7f6eeull, 0xdf6fbfcf87f9b5efull, 0x000000000000011full}},
+  {"encode_CZ", true,
+    {0xfd637b1a77cff603ull, 0x97dfa67fbf57ffe7ull, 0x000000000000012eull}},
+  {"encode_CS", true,
+    {0x0002000010000002ull, 0x02001000000004e0ull, 0x0000000000000008ull}},
+  {"encode_DG", true,
+    {0xfd637b1a579ff603ull, 0x97fff77fbf5fffe7ull, 0x000000000000017eull}},
+  {"encode_DJ", true,
+    {0xfd637b1a775ff603ull, 0x97ffe77fbf5fffe7ull, 0x000000000000017eull}},
+  {"encode_DT_DD", true,
+    {0xfd637b1a76d7f603ull, 0x97fff77fbf5fffe7ull, 0x000000000000017eull}},
+  {"encode_D_To_J", true,
+    {0xfd633b1a75dffe23ull, 0x97f9f773bf5fffe7ull, 0x000000000000017aull}},
+  {"encode_DOUS", true,
+    {0xfd637b1a73dffe33ull, 0x97ff3f77bf5fffe7ull, 0x000000000000013eull}},
+  {"encode_Silent_D", true,
+    {0xf9020c0f10006623ull, 0x1fb0d661be68cde7ull, 0x000000000000006aull}},
+  {"encode_Silent_G_At_Beginning", true,
+    {0xf977fafeeffffedfull, 0xb7fffeffffdeffffull, 0x000000000000017full}},
+  {"encode_GG", true,
+    {0xfd637b1a579fb603ull, 0x97ffb77fbf5fffe7ull, 0x000000000000013eull}},
+  {"encode_GK", true,
+    {0xfd637b1a37dfb603ull, 0x97ffb77fbf1fffe5ull, 0x000000000000013eull}},
+  {"encode_GH_After_Consonant", true,
+    {0x0002040110000002ull, 0x0a001000002004e0ull, 0x0000000000000008ull}},
+  {"encode_Initial_GH", true,
+    {0xf900380e88080a11ull, 0x000244201710c106ull, 0x000000000000004aull}},
+  {"encode_GH_To_J", true,
+    {0xfd637f1d7fdffe33ull, 0x9fffff7fbf7fefe7ull, 0x000000000000007eull}},
+  {"encode_GH_To_H", true,
+    {0xf8020c0b18000223ull, 0x0a0050001620cde6ull, 0x000000000000004aull}},
+  {"encode_UGHT", true,
+    {0xfd637f177fdffe33ull, 0x9ffff77fbf7fefe7ull, 0x000000000000007eull}},
+  {"encode_GH_H_Part_Of_Other_Word", true,
+    {0xfd637b0a77dff033ull, 0x86bfbf7ebf5fefe7ull, 0x000000000000003eull}},
+  {"encode_Silent_GH", true,
+    {0x0002000010000002ull, 0x02001000000004e0ull, 0x0000000000000008ull}},
+  {"encode_GH_Special_Cases", true,
+    {0x0002000010080002ull, 0x02001000000004e0ull, 0x0000000000000008ull}},
+  {"encode_Silent_G", true,
+    {0x0002000010000002ull, 0x02001000000004e0ull, 0x0000000000000008ull}},
+  {"encode_GN", true,
+    {0xf9637a1a67dff601ull, 0x97ffb67fbd5efbc6ull, 0x000000000000013eull}},
+  {"encode_GL", true,
+    {0xfd63791a77dffe33ull, 0x97ffb67fbb5fffe7ull, 0x000000000000013eull}},
+  {"encode_Initial_G_Front_Vowel", true,
+    {0xf900380e88080a11ull, 0x000244201710c106ull, 0x000000000000004aull}},
+  {"encode_NGER", true,
+    {0xfd62271f7fdefe33ull, 0x9ffff77fbf7fffe7ull, 0x000000000000017eull}},
+  {"encode_GER", true,
+    {0xfc62271b77defe33ull, 0x9fffb77fbf7fffe7ull, 0x000000000000013eull}},
+  {"encode_GEL", true,
+    {0xf4631f1b77defe33ull, 0x9fffb77fbf7fffe7ull, 0x000000000000013eull}},
+  {"encode_Non_Initial_G_Front_Vowel", true,
+    {0xf462031a75d87603ull, 0x17f0b33fbf4fffe7ull, 0x000000000000011aull}},
+  {"encode_GA_To_J", true,
+    {0x0002000010080002ull, 0x02001000000004e0ull, 0x0000000000000008ull}},
+  {"encode_Initial_Silent_H", true,
+    {0xfc62231a77defe33ull, 0x97ffb77fbf5fffe7ull, 0x000000000000013eull}},
+  {"encode_Initial_HS", true,
+    {0xfd75fbfefffffedfull, 0xb7ffefefffd9fdffull, 0x000000000000017full}},
+  {"encode_Non_Initial_Silent_H", true,
+    {0x0002000010080002ull, 0x02001000000004e0ull, 0x0000000000000008ull}},
+  {"encode_H_Pronounced", true,
+    {0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000008ull}},
+  {"encode_Spanish_J", true,
+    {0x0002000010080002ull, 0x0200100000000460ull, 0x0000000000000008ull}},
+  {"encode_German_J", true,
+    {0xfc437b1a77dffe33ull, 0x97ff377fbf5fffe7ull, 0x000000000000013eull}},
+  {"encode_Spanish_OJ_UJ", true,
+    {0xfc237b1a77dffe33ull, 0x97ffbf7fbf5fffe7ull, 0x000000000000013eull}},
+  {"encode_J_To_J", false,
+    {0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000008ull}},
+  {"encode_Spanish_J_2", true,
+    {0xfc020f1b7fd87623ull, 0x1ff1f77fbf6fffe7ull, 0x000000000000017aull}},
+  {"encode_J_As_Vowel", true,
+    {0x0000000000000000ull, 0x02000000000000c0ull, 0x0000000000000008ull}},
+  {"encode_Silent_K", true,
+    {0xf9637a1a67dffe11ull, 0x97ffb67fbf5efbc6ull, 0x000000000000013eull}},
+  {"encode_LELY_To_L", true,
+    {0xf5631f1f7fdffe33ull, 0x9ffff77fbf7fffe7ull, 0x000000000000017eull}},
+  {"encode_COLONEL", true,
+    {0xed637f1f7fdffe33ull, 0x9fffff7fbf7fffe7ull, 0x000000000000017eull}},
+  {"encode_French_AULT", true,
+    {0xdd637f1f7fd7f623ull, 0x9ffff77fbf7fffe7ull, 0x000000000000017eull}},
+  {"encode_French_EUIL", true,
+    {0xbd637f1f7fdffe33ull, 0x9fffff7fbe7fffe7ull, 0x000000000000017eull}},
+  {"encode_French_OULX", true,
+    {0x7d637f1f7fdff633ull, 0x9fffff7fbf7fffe7ull, 0x000000000000017eull}},
+  {"encode_Silent_L_In_LM", true,
+    {0xf9637a1a7fdff603ull, 0x97fff67fbf5effe6ull, 0x000000000000017eull}},
+  {"encode_Silent_L_In_LK_LV", true,
+    {0xfd637f1f3fdff623ull, 0x9ffff77fbf7fffe5ull, 0x000000000000017eull}},
+  {"encode_Silent_L_In_OULD", true,
+    {0xfd637f1f7fdff623ull, 0x9ffff77fbf7fffe3ull, 0x000000000000017eull}},
+  {"encode_LL_As_Vowel_Special_Cases", true,
+    {0x0002000010080002ull, 0x02001000000004e0ull, 0x0000000000000008ull}},
+  {"encode_LL_As_Vowel", true,
+    {0x0002000010000002ull, 0x02001000000004e0ull, 0x0000000000000008ull}},
+  {"encode_Silent_M_At_Beginning", true,
+    {0xf977fafefffffedfull, 0xb7fffeffffdeffdfull, 0x000000000000017full}},
+  {"encode_MR_And_MRS", true,
+    {0xff77fbfefffffeffull, 0xb7ffffffffdfffbfull, 0x000000000000017full}},
+  {"encode_MAC", true,
+    {0xff67fbfeffffeedfull, 0xb7ffdffdffdffd7full, 0x000000000000017full}},
+  {"encode_MPT", true,
+    {0xfd637f1f7fdffe33ull, 0x9ffff77fbf7ffee7ull, 0x000000000000017eull}},
+  {"encode_NCE", true,
+    {0xfd617b1a77d7de33ull, 0x97ffa57fbf5fb967ull, 0x000000000000013eull}},
+  {"encode_Silent_P_At_Beginning", true,
+    {0xf977fafefffffedfull, 0xb7ffeeefffd8f1ffull, 0x000000000000017full}},
+  {"encode_PT", true,
+    {0xfd637b1e7fd7fe23ull, 0x97fff77fbf5ff3e7ull, 0x000000000000017eull}},
+  {"encode_PH", true,
+    {0xfd637b0077dff003ull, 0x86bfa77ebd5fefe7ull, 0x000000000000003eull}},
+  {"encode_PPH", true,
+    {0xfd637b1a77dffe33ull, 0x97ffb77fbf5fdfe7ull, 0x000000000000013eull}},
+  {"encode_RPS", true,
+    {0xfd637f1f7fd7fe23ull, 0x9ffff76fbf79bde7ull, 0x000000000000017eull}},
+  {"encode_COUP", true,
+    {0xfd637f1f7fdffe33ull, 0x9fffff7fbe7f7fe7ull, 0x000000000000017eull}},
+  {"encode_PNEUM", true,
+    {0xf9637a1a67dffe31ull, 0x97ffbe7fbd5efbc6ull, 0x000000000000013eull}},
+  {"encode_PSYCH", true,
+    {0xfd617b1a77d7fe33ull, 0x97ffaf7fbf5dbbe7ull, 0x000000000000013eull}},
+  {"encode_PSALM", true,
+    {0xfd617b1a77d7fe33ull, 0x97ffaf7fbf5bbbe7ull, 0x000000000000011eull}},
+  {"encode_RZ", true,
+    {0xfd637b1a7fcff603ull, 0x97ffe67fbf57ffe7ull, 0x000000000000016eull}},
+  {"encode_Vowel_RE_Transposition", true,
+    {0xfc633f1b77def633ull, 0x9fffbf7fbf6fffe7ull, 0x000000000000013eull}},
+  {"encode_Special_SW", true,
+    {0xf900380e88080a11ull, 0x000244201710c106ull, 0x000000000000004aull}},
+  {"encode_SKJ", true,
+    {0xfd637b1a3fdffe33ull, 0x97fff77fbf1fffe7ull, 0x000000000000017eull}},
+  {"encode_SJ", true,
+    {0x0002000010080006ull, 0x02000000000004e0ull, 0x0000000000000008ull}},
+  {"encode_Silent_French_S_Final", true,
+    {0xbd637f1b77dffe33ull, 0x9fffbf7fbe7f7fe7ull, 0x000000000000013eull}},
+  {"encode_Silent_French_S_Internal", true,
+    {0xfd637e1f7fdffe33ull, 0x1fffd57cbd7eefe7ull, 0x000000000000007eull}},
+  {"encode_ISL", true,
+    {0xfd637d1f7fdffe23ull, 0x9ffff77fbb7fffe7ull, 0x000000000000017eull}},
+  {"encode_STL", true,
+    {0xfd637b1a7fd7fe33ull, 0x97fff57fb75fffe7ull, 0x000000000000017eull}},
+  {"encode_Christmas", true,
+    {0xfd637f1f7fd7fe33ull, 0x9ffff77faf7fffe7ull, 0x000000000000017eull}},
+  {"encode_STHM", true,
+    {0xfd637b1a7fd7fe33ull, 0x97fff77f9f5fffe7ull, 0x000000000000017eull}},
+  {"encode_ISTEN", true,
+    {0x0002000010000002ull, 0x02001000000004e0ull, 0x0000000000000008ull}},
+  {"encode_Sugar", true,
+    {0xfd637b1a7fdffe33ull, 0x97ffff7f3f5fffe7ull, 0x000000000000017eull}},
+  {"encode_SH", true,
+    {0xfd637b0a7fdff603ull, 0x97bfe77ebd5fefe7ull, 0x000000000000007eull}},
+  {"encode_SCH", true,
+    {0xfd637b1a77dfde33ull, 0x97ff957dbd5fff67ull, 0x000000000000013eull}},
+  {"encode_SUR", true,
+    {0xfd637b1a75dffe33ull, 0x97fdb77bbf5fffe7ull, 0x000000000000011eull}},
+  {"encode_SU", true,
+    {0xfd637b1a71dffe03ull, 0x97ff3777bf5fffe7ull, 0x000000000000013aull}},
+  {"encode_SSIO", true,
+    {0xfd617b1a77d7fe33ull, 0x97ffaf6fbf5fbbe7ull, 0x000000000000013eull}},
+  {"encode_SS", true,
+    {0xfd637f1b7fd7fe33ull, 0x9ffff75fbf7fffe7ull, 0x000000000000017eull}},
+  {"encode_SIA", true,
+    {0xfd633b1a7fdffe23ull, 0x97fbf73fbf5fffe7ull, 0x000000000000017eull}},
+  {"encode_SIO", true,
+    {0x0002000010080002ull, 0x02001000000004e0ull, 0x0000000000000008ull}},
+  {"encode_Anglicisations", true,
+    {0xf963781a67cff601ull, 0x97dfa67fbf56fbc6ull, 0x000000000000012eull}},
+  {"encode_SC", true,
+    {0xfd637b1a7fdfe603ull, 0x97ffd57db55ffde7ull, 0x000000000000017eull}},
+  {"encode_SEA_SUI_SIER", true,
+    {0xfd633f1b7fdffe33ull, 0x9ffff37fbf7fffe7ull, 0x000000000000017eull}},
+  {"encode_SEA", true,
+    {0xd042001214088002ull, 0x02281010811784e0ull, 0x0000000000000018ull}},
+  {"encode_T_Initial", true,
+    {0xfd75fbfeff6ffadfull, 0xa6efeeeeff51e9ffull, 0x000000000000005full}},
+  {"encode_TCH", true,
+    {0xfd637b1a77dfde33ull, 0x97ff957dbd5fff67ull, 0x000000000000013eull}},
+  {"encode_Silent_French_T", true,
+    {0xf9020c0f1bc06623ull, 0x1e001661be68cde7ull, 0x000000000000006aull}},
+  {"encode_TUN_TUL_TUA_TUO", true,
+    {0xfd437b1a7bdffe23ull, 0x97fe3777bf5fffe7ull, 0x000000000000017aull}},
+  {"encode_TUE_TEU_TEOU_TUL_TIE", true,
+    {0xfd633b1a77dbfe33ull, 0x97fe377fbf5fffe7ull, 0x000000000000013eull}},
+  {"encode_TUR_TIU_Suffixes", true,
+    {0xfc633f1b75ddfe33ull, 0x9ffdb77bbf7fffe7ull, 0x000000000000011eull}},
+  {"encode_TI", true,
+    {0xfc633b1a75d9fe13ull, 0x97fbb73fbf5fffe7ull, 0x000000000000013aull}},
+  {"encode_TIENT", true,
+    {0xfc633b1a77ddfe33ull, 0x97f7bf7fbf5fffe7ull, 0x000000000000013eull}},
+  {"encode_TSCH", true,
+    {0xfd637b1a7fd7fe33ull, 0x97efa77fbf5fffe7ull, 0x000000000000017eull}},
+  {"encode_TZSCH", true,
+    {0xfd637b1a7fcffe33ull, 0x97dfbe7fbf5fffe7ull, 0x000000000000017eull}},
+  {"encode_TH_Pronounced_Separately", true,
+    {0xfd637b0a77dff013ull, 0x86bfb77ebf5fefe7ull, 0x000000000000003eull}},
+  {"encode_TTH", true,
+    {0xfd637b1a7fd7fe33ull, 0x977fb77fbf5fffe7ull, 0x000000000000017eull}},
+  {"encode_TH", true,
+    {0xfd637b0a7fdff603ull, 0x96bfa77fbf5fefe7ull, 0x000000000000007eull}},
+  {"encode_Silent_W_At_Beginning", true,
+    {0xff77fbfefffffedfull, 0xb1ffffffffdfffffull, 0x000000000000017full}},
+  {"encode_WR", true,
+    {0xfd637b1a7fdff603ull, 0x91fff77fbf5fffe7ull, 0x000000000000017eull}},
+  {"encode_Initial_W_Vowel", true,
+    {0xf900380e88080a11ull, 0x000244201710c106ull, 0x000000000000004aull}},
+  {"encode_WH", true,
+    {0xfd637b0a7fdff603ull, 0x87bfe77fbf5fefe7ull, 0x000000000000007eull}},
+  {"encode_Eastern_European_W", true,
+    {0x0002000010000002ull, 0x02001000000004e0ull, 0x0000000000000008ull}},
+  {"encode_Initial_X", true,
+    {0x0000000000080000ull, 0x0000000000000000ull, 0x0000000000000008ull}},
+  {"encode_Greek_X", true,
+    {0xfc633b1a77defe33ull, 0x17ffb77fbd5fffe7ull, 0x000000000000013eull}},
+  {"encode_X_Special_Cases", true,
+    {0x0002000010080002ull, 0x02001000000004e0ull, 0x0000000000000008ull}},
+  {"encode_X_To_H", true,
+    {0xfd637f1f7fdffe33ull, 0x9ffff77fbf7fffe7ull, 0x000000000000017cull}},
+  {"encode_X_Vowel", true,
+    {0xfc633b1a75d9fe13ull, 0x97fb3777bf5fffe7ull, 0x000000000000013aull}},
+  {"encode_French_X_Final", false,
+    {0xffffffffffffffffull, 0xffffffffffffffffull, 0x00000000000001f7ull}},
+  {"encode_ZZ", true,
+    {0xfd637b1a77cffe33ull, 0x97ffbe7fbf57ffe7ull, 0x000000000000012eull}},
+  {"encode_ZU_ZIER_ZS", true,
+    {0xfd633b1a7fd7fe03ull, 0x97fde77bbf5bffe7ull, 0x000000000000011eull}},
+  {"encode_French_EZ", true,
+    {0xf9020c0f1bc06623ull, 0x1fb0d661be68cde7ull, 0x000000000000000aull}},
+  {"encode_German_Z", true,
+    {0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000008ull}},
+  {"encode_ZH", true,
+    {0xfd637b0077dff003ull, 0x86bfa77ebd5fefe7ull, 0x000000000000003eull}}
+};
+
+
+// encode_Silent_B, Metaphone3Spec.txt line 59.
+bool Metaphone3::encode_Silent_B()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current >= 2 &&
+       m_current + 2 <= m_length &&
+       memcmp(w + m_current - 2, "DEBT", 4) == 0) ||
+      (m_current >= 2 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 2, "SUBTL", 5) == 0) ||
+      (m_current >= 2 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 2, "SUBTIL", 6) == 0) ||
+      (m_current >= 3 &&
+       m_current + 2 <= m_length &&
+       memcmp(w + m_current - 3, "DOUBT", 5) == 0))
+  {
+    add("T");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Silent_C_At_Beginning, Metaphone3Spec.txt line 67.
+bool Metaphone3::encode_Silent_C_At_Beginning()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current == 0 &&
+      m_length >= 2 &&
+      w[0] == 'C' &&
+      (w[1] == 'N' || w[1] == 'T'))
+  {
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_CA_To_S, Metaphone3Spec.txt line 71.
+bool Metaphone3::encode_CA_To_S()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current == 0 &&
+       m_length >= 4 &&
+       w[0] == 'C' &&
+       w[1] == 'A' &&
+       w[2] == 'E' &&
+       (w[3] == 'C' || w[3] == 'M' || w[3] == 'S')) ||
+      (m_length >= 6 && memcmp(w + 0, "FACADE", 6) == 0) ||
+      (m_length >= 8 &&
+       ((w[0] == 'F' &&
+         w[1] == 'R' &&
+         w[2] == 'A' &&
+         w[3] == 'N' &&
+         w[4] == 'C' &&
+         w[5] == 'A' &&
+         w[6] == 'I' &&
+         (w[7] == 'S' || w[7] == 'X')) ||
+        (w[0] == 'L' && memcmp(w + 1, "INGUICA", 7) == 0))) ||
+      (m_length >= 9 &&
+       ((w[0] == 'G' && memcmp(w + 1, "ONCALVES", 8) == 0) ||
+        (w[0] == 'P' && memcmp(w + 1, "ROVENCAL", 8) == 0))))
+  {
+    add("S");
+    advanceCounter(2, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_CO_To_S, Metaphone3Spec.txt line 77.
+bool Metaphone3::encode_CO_To_S()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current + 4 <= m_length &&
+       memcmp(w + m_current, "COEL", 4) == 0 &&
+       (isVowel(m_current + 4) || m_current == m_last - 3)) ||
+      (m_current + 5 <= m_length &&
+       w[m_current] == 'C' &&
+       w[m_current + 1] == 'O' &&
+       w[m_current + 2] == 'E' &&
+       w[m_current + 3] == 'N' &&
+       (w[m_current + 4] == 'A' || w[m_current + 4] == 'O')) ||
+      (m_length >= 6 && memcmp(w + 0, "GARCON", 6) == 0) ||
+      (m_length >= 8 &&
+       ((w[0] == 'F' && memcmp(w + 1, "RANCOIS", 7) == 0) ||
+        (w[0] == 'M' && memcmp(w + 1, "ELANCON", 7) == 0))))
+  {
+    add("S");
+    advanceCounter(3, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_CHAE, Metaphone3Spec.txt line 84.
+bool Metaphone3::encode_CHAE()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current > 0 &&
+      m_current + 4 <= m_length &&
+      w[m_current + 2] == 'A' &&
+      w[m_current + 3] == 'E')
+  {
+    if (m_length >= 7 && memcmp(w + 0, "RACHAEL", 7) == 0)
+    {
+      add("X");
+    }
+    else if (! (m_current >= 1 &&
+                m_current <= m_length &&
+                (w[m_current - 1] == 'C' ||
+                 w[m_current - 1] == 'G' ||
+                 w[m_current - 1] == 'K' ||
+                 w[m_current - 1] == 'Q')))
+    {
+      add("K");
+    }
+    advanceCounter(4, 2);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_CH_To_H, Metaphone3Spec.txt line 92.
+bool Metaphone3::encode_CH_To_H()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current == 0 &&
+       ((m_current + 5 <= m_length &&
+         ((w[m_current + 2] == 'A' &&
+           w[m_current + 3] == 'I' &&
+           w[m_current + 4] == 'M') ||
+          (w[m_current + 2] == 'E' &&
+           ((w[m_current + 3] == 'L' && w[m_current + 4] == 'M') ||
+            (w[m_current + 3] == 'T' && w[m_current + 4] == 'H'))))) ||
+        (m_current + 6 <= m_length &&
+         w[m_current + 2] == 'A' &&
+         ((w[m_current + 3] == 'S' &&
+           w[m_current + 4] == 'I' &&
+           w[m_current + 5] == 'D') ||
+          (w[m_current + 3] == 'Z' &&
+           w[m_current + 4] == 'A' &&
+           w[m_current + 5] == 'N'))) ||
+        (m_current + 7 <= m_length &&
+         ((w[m_current + 2] == 'A' &&
+           ((w[m_current + 3] == 'L' &&
+             ((w[m_current + 4] == 'L' &&
+               w[m_current + 5] == 'A' &&
+               w[m_current + 6] == 'H') ||
+              (w[m_current + 4] == 'U' &&
+               w[m_current + 5] == 'T' &&
+               w[m_current + 6] == 'Z'))) ||
+            (w[m_current + 3] == 'M' &&
+             w[m_current + 4] == 'E' &&
+             w[m_current + 5] == 'T' &&
+             w[m_current + 6] == 'Z'))) ||
+          (w[m_current + 2] == 'U' &&
+           ((w[m_current + 3] == 'P' &&
+             w[m_current + 4] == 'P' &&
+             w[m_current + 5] == 'A' &&
+             w[m_current + 6] == 'H') ||
+            (w[m_current + 3] == 'T' &&
+             w[m_current + 4] == 'Z' &&
+             w[m_current + 5] == 'P' &&
+             w[m_current + 6] == 'A'))))) ||
+        (m_current + 8 <= m_length &&
+         ((w[m_current + 2] == 'A' &&
+           ((w[m_current + 3] == 'D' &&
+             memcmp(w + m_current + 4, "ARIM", 4) == 0) ||
+            (w[m_current + 3] == 'N' &&
+             memcmp(w + m_current + 4, "UKAH", 4) == 0))) ||
+          (w[m_current + 2] == 'E' &&
+           memcmp(w + m_current + 3, "SHVAN", 5) == 0))) ||
+        (m_current + 9 <= m_length &&
+         w[m_current + 2] == 'A' &&
+         ((w[m_current + 3] == 'L' &&
+           memcmp(w + m_current + 4, "LLOTH", 5) == 0) ||
+          (w[m_current + 3] == 'N' &&
+           memcmp(w + m_current + 4, "NUKAH", 5) == 0) ||
+          (w[m_current + 3] == 'R' &&
+           memcmp(w + m_current + 4, "OSETH", 5) == 0))))) ||
+      (m_current >= 3 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 3, "CLACHAN", 7) == 0))
+  {
+    add("H");
+    advanceCounter(3, 2);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Silent_CH, Metaphone3Spec.txt line 99.
+bool Metaphone3::encode_Silent_CH()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current >= 2 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 2, "YACHT", 5) == 0) ||
+      (m_current >= 2 &&
+       m_current + 5 <= m_length &&
+       memcmp(w + m_current - 2, "FUCHSIA", 7) == 0) ||
+      (m_length >= 8 &&
+       ((w[0] == 'C' && memcmp(w + 1, "RICHTON", 7) == 0) ||
+        (w[0] == 'S' && memcmp(w + 1, "TRACHAN", 7) == 0))) ||
+      (m_current >= 3 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 3, "DRACHM", 6) == 0 &&
+       ! (m_current >= 3 &&
+          m_current + 4 <= m_length &&
+          memcmp(w + m_current - 3, "DRACHMA", 7) == 0)))
+  {
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_CH_To_X, Metaphone3Spec.txt line 105.
+bool Metaphone3::encode_CH_To_X()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current >= 2 &&
+       m_current + 2 <= m_length &&
+       ((w[m_current - 2] == 'E' &&
+         ((w[m_current - 1] == 'A' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H') ||
+          (w[m_current - 1] == 'E' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H'))) ||
+        (w[m_current - 2] == 'M' &&
+         w[m_current - 1] == 'U' &&
+         w[m_current] == 'C' &&
+         w[m_current + 1] == 'H') ||
+        (w[m_current - 2] == 'O' &&
+         ((w[m_current - 1] == 'A' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H') ||
+          (w[m_current - 1] == 'O' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H') ||
+          (w[m_current - 1] == 'U' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H'))) ||
+        (w[m_current - 2] == 'S' &&
+         w[m_current - 1] == 'U' &&
+         w[m_current] == 'C' &&
+         w[m_current + 1] == 'H')) &&
+       ! (m_current >= 3 &&
+          m_current + 2 <= m_length &&
+          memcmp(w + m_current - 3, "JOACH", 5) == 0)) ||
+      (m_current == m_last - 2 &&
+       m_current >= 1 &&
+       m_current + 3 <= m_length &&
+       w[m_current - 1] == 'A' &&
+       w[m_current] == 'C' &&
+       w[m_current + 1] == 'H' &&
+       (w[m_current + 2] == 'A' || w[m_current + 2] == 'O')) ||
+      (m_current == m_last - 3 &&
+       m_current + 4 <= m_length &&
+       w[m_current] == 'C' &&
+       w[m_current + 1] == 'H' &&
+       ((w[m_current + 2] == 'A' && w[m_current + 3] == 'T') ||
+        (w[m_current + 2] == 'O' &&
+         (w[m_current + 3] == 'D' || w[m_current + 3] == 'T')))) ||
+      (m_current == m_last - 2 &&
+       m_current >= 1 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 1, "OCHE", 4) == 0 &&
+       ! (m_current >= 2 &&
+          m_current + 3 <= m_length &&
+          memcmp(w + m_current - 2, "DOCHE", 5) == 0)) ||
+      (m_current >= 4 &&
+       m_current + 2 <= m_length &&
+       ((w[m_current - 4] == 'A' &&
+         memcmp(w + m_current - 3, "TTACH", 5) == 0) ||
+        (w[m_current - 4] == 'D' &&
+         memcmp(w + m_current - 3, "ETACH", 5) == 0) ||
+        (w[m_current - 4] == 'K' &&
+         memcmp(w + m_current - 3, "OVACH", 5) == 0))) ||
+      (m_current >= 4 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 4, "PARACHUT", 8) == 0) ||
+      (m_current >= 5 &&
+       m_current + 2 <= m_length &&
+       memcmp(w + m_current - 5, "SPINACH", 7) == 0) ||
+      (m_current >= 5 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 5, "MASSACHU", 8) == 0) ||
+      (m_length >= 6 && memcmp(w + 0, "MACHAU", 6) == 0) ||
+      (m_current >= 3 &&
+       m_current + 2 <= m_length &&
+       memcmp(w + m_current - 3, "THACH", 5) == 0 &&
+       ! (m_current >= 1 &&
+          m_current + 3 <= m_length &&
+          memcmp(w + m_current - 1, "ACHE", 4) == 0)) ||
+      (m_current >= 2 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 2, "VACHON", 6) == 0))
+  {
+    add("X");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Germanic_CH_To_K, Metaphone3Spec.txt line 118.
+bool Metaphone3::encode_Germanic_CH_To_K()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current > 1 &&
+       ! isVowel(m_current - 2) &&
+       m_current >= 1 &&
+       m_current + 2 <= m_length &&
+       w[m_current - 1] == 'A' &&
+       w[m_current] == 'C' &&
+       w[m_current + 1] == 'H' &&
+       ! (m_current >= 2 &&
+          m_current + 5 <= m_length &&
+          ((w[m_current - 2] == 'K' &&
+            memcmp(w + m_current - 1, "ACHATU", 6) == 0) ||
+           (w[m_current - 2] == 'L' &&
+            w[m_current - 1] == 'A' &&
+            w[m_current] == 'C' &&
+            w[m_current + 1] == 'H' &&
+            w[m_current + 2] == 'A' &&
+            ((w[m_current + 3] == 'N' && w[m_current + 4] == 'C') ||
+             (w[m_current + 3] == 'P' && w[m_current + 4] == 'E'))) ||
+           (w[m_current - 2] == 'M' &&
+            w[m_current - 1] == 'A' &&
+            w[m_current] == 'C' &&
+            w[m_current + 1] == 'H' &&
+            ((w[m_current + 2] == 'A' &&
+              w[m_current + 3] == 'D' &&
+              w[m_current + 4] == 'O') ||
+             (w[m_current + 2] == 'U' &&
+              w[m_current + 3] == 'C' &&
+              w[m_current + 4] == 'A'))))) &&
+       ! (m_current >= 3 &&
+          m_current + 4 <= m_length &&
+          memcmp(w + m_current - 3, "KHACHAT", 7) == 0) &&
+       ! (m_current + 3 <= m_length && w[m_current + 2] == 'I') &&
+       (! (m_current + 3 <= m_length && w[m_current + 2] == 'E') ||
+        (m_current >= 2 &&
+         m_current + 4 <= m_length &&
+         ((w[m_current - 2] == 'B' &&
+           memcmp(w + m_current - 1, "ACHER", 5) == 0) ||
+          (w[m_current - 2] == 'L' &&
+           memcmp(w + m_current - 1, "ACHER", 5) == 0) ||
+          (w[m_current - 2] == 'M' &&
+           w[m_current - 1] == 'A' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H' &&
+           w[m_current + 2] == 'E' &&
+           (w[m_current + 3] == 'N' || w[m_current + 3] == 'R')))))) ||
+      (m_current + 3 <= m_length &&
+       (w[m_current + 2] == 'S' || w[m_current + 2] == 'T') &&
+       ! ((m_length >= 9 && memcmp(w + 0, "LUNCHTIME", 9) == 0) ||
+          (m_length >= 11 && memcmp(w + 0, "WHICHSOEVER", 11) == 0))) ||
+      (m_length >= 4 && memcmp(w + 0, "SCHR", 4) == 0) ||
+      (m_current > 2 &&
+       m_current >= 2 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 2, "MACHE", 5) == 0) ||
+      (m_current == 2 && m_length >= 4 && memcmp(w + 0, "ZACH", 4) == 0) ||
+      (m_current >= 4 &&
+       m_current + 2 <= m_length &&
+       memcmp(w + m_current - 4, "SCHACH", 6) == 0) ||
+      (m_current >= 1 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 1, "ACHEN", 5) == 0) ||
+      (m_current >= 3 &&
+       m_current + 2 <= m_length &&
+       ((w[m_current - 3] == 'B' &&
+         memcmp(w + m_current - 2, "UECH", 4) == 0) ||
+        (w[m_current - 3] == 'S' &&
+         memcmp(w + m_current - 2, "PICH", 4) == 0) ||
+        (w[m_current - 3] == 'Z' &&
+         memcmp(w + m_current - 2, "URCH", 4) == 0))) ||
+      (m_current != m_last - 1 &&
+       m_current >= 3 &&
+       m_current + 2 <= m_length &&
+       ((w[m_current - 3] == 'B' &&
+         memcmp(w + m_current - 2, "LECH", 4) == 0) ||
+        (w[m_current - 3] == 'J' &&
+         memcmp(w + m_current - 2, "OACH", 4) == 0) ||
+        (w[m_current - 3] == 'K' &&
+         memcmp(w + m_current - 2, "IRCH", 4) == 0) ||
+        (w[m_current - 3] == 'M' &&
+         memcmp(w + m_current - 2, "ALCH", 4) == 0)) &&
+       ! (m_current >= 3 &&
+          m_current + 5 <= m_length &&
+          memcmp(w + m_current - 3, "KIRCHNER", 8) == 0)) ||
+      (m_current == m_last - 1 &&
+       m_current >= 2 &&
+       m_current + 2 <= m_length &&
+       ((w[m_current - 2] == 'B' &&
+         w[m_current - 1] == 'A' &&
+         w[m_current] == 'C' &&
+         w[m_current + 1] == 'H') ||
+        (w[m_current - 2] == 'L' &&
+         w[m_current - 1] == 'I' &&
+         w[m_current] == 'C' &&
+         w[m_current + 1] == 'H') ||
+        (w[m_current - 2] == 'N' &&
+         w[m_current - 1] == 'I' &&
+         w[m_current] == 'C' &&
+         w[m_current + 1] == 'H'))) ||
+      (m_current == m_last - 1 &&
+       m_current >= 3 &&
+       m_current + 2 <= m_length &&
+       ((w[m_current - 3] == 'B' &&
+         memcmp(w + m_current - 2, "RICH", 4) == 0) ||
+        (w[m_current - 3] == 'D' &&
+         memcmp(w + m_current - 2, "RICH", 4) == 0) ||
+        (w[m_current - 3] == 'E' &&
+         memcmp(w + m_current - 2, "RICH", 4) == 0) ||
+        (w[m_current - 3] == 'N' &&
+         memcmp(w + m_current - 2, "RICH", 4) == 0) ||
+        (w[m_current - 3] == 'U' &&
+         memcmp(w + m_current - 2, "RICH", 4) == 0)) &&
+       ! (m_current >= 5 &&
+          m_current + 2 <= m_length &&
+          memcmp(w + m_current - 5, "ALDRICH", 7) == 0) &&
+       ! (m_current >= 6 &&
+          m_current + 2 <= m_length &&
+          memcmp(w + m_current - 6, "GOODRICH", 8) == 0) &&
+       ! (m_current >= 7 &&
+          m_current + 2 <= m_length &&
+          memcmp(w + m_current - 7, "GINGERICH", 9) == 0)) ||
+      (m_current == m_last - 1 &&
+       m_current >= 4 &&
+       m_current + 2 <= m_length &&
+       ((w[m_current - 4] == 'E' &&
+         ((w[m_current - 3] == 'M' &&
+           memcmp(w + m_current - 2, "RICH", 4) == 0) ||
+          (w[m_current - 3] == 'Y' &&
+           memcmp(w + m_current - 2, "RICH", 4) == 0))) ||
+        (w[m_current - 4] == 'L' &&
+         ((w[m_current - 3] == 'F' &&
+           memcmp(w + m_current - 2, "RICH", 4) == 0) ||
+          (w[m_current - 3] == 'L' &&
+           memcmp(w + m_current - 2, "RICH", 4) == 0))) ||
+        (w[m_current - 4] == 'U' &&
+         memcmp(w + m_current - 3, "LRICH", 5) == 0) ||
+        (w[m_current - 4] == 'Z' &&
+         memcmp(w + m_current - 3, "URICH", 5) == 0))) ||
+      ((m_current == 0 ||
+        (m_current >= 1 &&
+         m_current <= m_length &&
+         (w[m_current - 1] == 'A' ||
+          w[m_current - 1] == 'E' ||
+          w[m_current - 1] == 'O' ||
+          w[m_current - 1] == 'U'))) &&
+       m_current + 3 <= m_length &&
+       (w[m_current + 2] == 'B' ||
+        w[m_current + 2] == 'F' ||
+        w[m_current + 2] == 'H' ||
+        w[m_current + 2] == 'L' ||
+        w[m_current + 2] == 'M' ||
+        w[m_current + 2] == 'N' ||
+        w[m_current + 2] == 'R' ||
+        w[m_current + 2] == 'V' ||
+        w[m_current + 2] == 'W')))
+  {
+    if ((m_current + 3 <= m_length &&
+         (w[m_current + 2] == 'L' || w[m_current + 2] == 'R')) ||
+        slavoGermanic())
+    {
+      add("K");
+    }
+    else
+    {
+      add("K", "X");
+    }
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_ARCH, Metaphone3Spec.txt line 145.
+bool Metaphone3::encode_ARCH()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current >= 2 &&
+      m_current + 2 <= m_length &&
+      memcmp(w + m_current - 2, "ARCH", 4) == 0)
+  {
+    if ((m_current == m_last - 1 ||
+         (m_current >= 2 &&
+          m_current + 3 <= m_length &&
+          w[m_current - 2] == 'A' &&
+          w[m_current - 1] == 'R' &&
+          w[m_current] == 'C' &&
+          w[m_current + 1] == 'H' &&
+          (w[m_current + 2] == 'A' ||
+           w[m_current + 2] == 'I' ||
+           w[m_current + 2] == 'O' ||
+           w[m_current + 2] == 'U' ||
+           w[m_current + 2] == 'Y')) ||
+         (m_current >= 2 &&
+          m_current + 4 <= m_length &&
+          w[m_current - 2] == 'A' &&
+          w[m_current - 1] == 'R' &&
+          w[m_current] == 'C' &&
+          w[m_current + 1] == 'H' &&
+          w[m_current + 2] == 'E' &&
+          (w[m_current + 3] == 'A' ||
+           w[m_current + 3] == 'G' ||
+           w[m_current + 3] == 'L' ||
+           w[m_current + 3] == 'M' ||
+           w[m_current + 3] == 'N' ||
+           w[m_current + 3] == 'O' ||
+           w[m_current + 3] == 'P' ||
+           w[m_current + 3] == 'S' ||
+           w[m_current + 3] == 'T')) ||
+         (m_length >= 7 && memcmp(w + 0, "MENARCH", 7) == 0)) &&
+        ! rootOrInflections(m_inWord, "ARCH") &&
+        ! (m_current >= 4 &&
+           m_current + 2 <= m_length &&
+           ((w[m_current - 4] == 'P' &&
+             memcmp(w + m_current - 3, "OARCH", 5) == 0) ||
+            (w[m_current - 4] == 'S' &&
+             memcmp(w + m_current - 3, "EARCH", 5) == 0))) &&
+        ! ((m_length >= 6 &&
+            w[0] == 'A' &&
+            w[1] == 'R' &&
+            w[2] == 'C' &&
+            w[3] == 'H' &&
+            ((w[4] == 'E' && w[5] == 'R') || (w[4] == 'I' && w[5] == 'E'))) ||
+           (m_length >= 9 &&
+            w[0] == 'A' &&
+            w[1] == 'R' &&
+            w[2] == 'C' &&
+            w[3] == 'H' &&
+            ((w[4] == 'A' && memcmp(w + 5, "MBAU", 4) == 0) ||
+             (w[4] == 'E' && memcmp(w + 5, "NEMY", 4) == 0) ||
+             (w[4] == 'I' && memcmp(w + 5, "BALD", 4) == 0) ||
+             (w[4] == 'U' && memcmp(w + 5, "LETA", 4) == 0)))) &&
+        ((((! (m_current >= 3 &&
+               m_current + 2 <= m_length &&
+               ((w[m_current - 3] == 'L' &&
+                 memcmp(w + m_current - 2, "ARCH", 4) == 0) ||
+                (w[m_current - 3] == 'M' &&
+                 memcmp(w + m_current - 2, "ARCH", 4) == 0) ||
+                (w[m_current - 3] == 'P' &&
+                 memcmp(w + m_current - 2, "ARCH", 4) == 0))) &&
+            ! (m_current >= 4 &&
+               m_current + 2 <= m_length &&
+               memcmp(w + m_current - 4, "STARCH", 6) == 0)) ||
+           (m_length >= 6 && memcmp(w + 0, "EPARCH", 6) == 0) ||
+           (m_length >= 7 && memcmp(w + 0, "NOMARCH", 7) == 0) ||
+           (m_length >= 8 &&
+            ((w[0] == 'E' && memcmp(w + 1, "XILARCH", 7) == 0) ||
+             (w[0] == 'H' && memcmp(w + 1, "IPPARCH", 7) == 0) ||
+             (w[0] == 'M' && memcmp(w + 1, "ARCHESE", 7) == 0))) ||
+           (m_length >= 9 &&
+            ((w[0] == 'A' && memcmp(w + 1, "RISTARCH", 8) == 0) ||
+             (w[0] == 'M' && memcmp(w + 1, "ARCHETTI", 8) == 0)))) &&
+          ! rootOrInflections(m_inWord, "STARCH")) ||
+         (m_current >= 2 &&
+          m_current + 3 <= m_length &&
+          w[m_current - 2] == 'A' &&
+          w[m_current - 1] == 'R' &&
+          w[m_current] == 'C' &&
+          w[m_current + 1] == 'H' &&
+          (w[m_current + 2] == 'U' || w[m_current + 2] == 'Y') &&
+          ! (m_length >= 7 && memcmp(w + 0, "STARCHY", 7) == 0))))
+    {
+      add("K", "X");
+    }
+    else
+    {
+      add("X");
+    }
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Greek_CH_Initial, Metaphone3Spec.txt line 164.
+bool Metaphone3::encode_Greek_CH_Initial()
+{
+  const char * w = m_inWord.c_str();
+
+  if (((m_current + 6 <= m_length &&
+        w[m_current] == 'C' &&
+        w[m_current + 1] == 'H' &&
+        ((w[m_current + 2] == 'A' &&
+          ((w[m_current + 3] == 'M' &&
+            w[m_current + 4] == 'O' &&
+            w[m_current + 5] == 'M') ||
+           (w[m_current + 3] == 'R' &&
+            ((w[m_current + 4] == 'A' && w[m_current + 5] == 'C') ||
+             (w[m_current + 4] == 'I' && w[m_current + 5] == 'S') ||
+             (w[m_current + 4] == 'T' &&
+              (w[m_current + 5] == 'O' || w[m_current + 5] == 'U')) ||
+             (w[m_current + 4] == 'Y' && w[m_current + 5] == 'B'))))) ||
+         (w[m_current + 2] == 'E' &&
+          w[m_current + 3] == 'M' &&
+          w[m_current + 4] == 'I' &&
+          w[m_current + 5] == 'C') ||
+         (w[m_current + 2] == 'I' &&
+          w[m_current + 3] == 'L' &&
+          w[m_current + 4] == 'I' &&
+          w[m_current + 5] == 'A') ||
+         (w[m_current + 2] == 'R' &&
+          w[m_current + 3] == 'I' &&
+          w[m_current + 4] == 'S' &&
+          w[m_current + 5] == 'T'))) ||
+       (m_current + 5 <= m_length &&
+        w[m_current] == 'C' &&
+        w[m_current + 1] == 'H' &&
+        ((w[m_current + 2] == 'A' &&
+          ((w[m_current + 3] == 'E' && w[m_current + 4] == 'T') ||
+           (w[m_current + 3] == 'L' &&
+            (w[m_current + 4] == 'C' || w[m_current + 4] == 'D')) ||
+           (w[m_current + 3] == 'M' && w[m_current + 4] == 'A') ||
+           (w[m_current + 3] == 'R' && w[m_current + 4] == 'O') ||
+           (w[m_current + 3] == 'S' && w[m_current + 4] == 'M'))) ||
+         (w[m_current + 2] == 'E' &&
+          ((w[m_current + 3] == 'I' &&
+            (w[m_current + 4] == 'L' ||
+             w[m_current + 4] == 'M' ||
+             w[m_current + 4] == 'R')) ||
+           (w[m_current + 3] == 'L' && w[m_current + 4] == 'A') ||
+           (w[m_current + 3] == 'M' &&
+            (w[m_current + 4] == 'I' ||
+             w[m_current + 4] == 'O' ||
+             w[m_current + 4] == 'U' ||
+             w[m_current + 4] == 'Y')) ||
+           (w[m_current + 3] == 'O' && w[m_current + 4] == 'P'))) ||
+         (w[m_current + 2] == 'I' &&
+          ((w[m_current + 3] == 'L' && w[m_current + 4] == 'O') ||
+           (w[m_current + 3] == 'R' && w[m_current + 4] == 'O') ||
+           (w[m_current + 3] == 'T' && w[m_current + 4] == 'I'))) ||
+         (w[m_current + 2] == 'O' &&
+          ((w[m_current + 3] == 'I' && w[m_current + 4] == 'R') ||
+           (w[m_current + 3] == 'N' &&
+            (w[m_current + 4] == 'A' ||
+             w[m_current + 4] == 'D' ||
+             w[m_current + 4] == 'I')) ||
+           (w[m_current + 3] == 'U' && w[m_current + 4] == 'S'))) ||
+         (w[m_current + 2] == 'R' &&
+          w[m_current + 3] == 'O' &&
+          (w[m_current + 4] == 'I' || w[m_current + 4] == 'M'))) &&
+        ! (m_current + 6 <= m_length &&
+           memcmp(w + m_current, "CHEMIN", 6) == 0) &&
+        ! (m_current >= 2 &&
+           m_current + 6 <= m_length &&
+           memcmp(w + m_current - 2, "ANCHONDO", 8) == 0)) ||
+       (m_current + 5 <= m_length &&
+        w[m_current] == 'C' &&
+        w[m_current + 1] == 'H' &&
+        ((w[m_current + 2] == 'E' &&
+          w[m_current + 3] == 'L' &&
+          w[m_current + 4] == 'I') ||
+         (w[m_current + 2] == 'I' &&
+          w[m_current + 3] == 'S' &&
+          w[m_current + 4] == 'M')) &&
+        ! ((m_length >= 6 && memcmp(w + 0, "MICHEL", 6) == 0) ||
+           (m_length >= 8 && memcmp(w + 0, "MACHISMO", 8) == 0) ||
+           (m_length >= 9 && memcmp(w + 0, "RICHELIEU", 9) == 0) ||
+           (m_length >= 10 && memcmp(w + 0, "REVANCHISM", 10) == 0)) &&
+        (m_length != 5 ||
+         ! (m_length >= 5 && memcmp(w + 0, "CHISM", 5) == 0))) ||
+       (m_current + 4 <= m_length &&
+        w[m_current] == 'C' &&
+        w[m_current + 1] == 'H' &&
+        ((w[m_current + 2] == 'L' && w[m_current + 3] == 'O') ||
+         (w[m_current + 2] == 'O' &&
+          (w[m_current + 3] == 'E' ||
+           w[m_current + 3] == 'L' ||
+           w[m_current + 3] == 'R' ||
+           w[m_current + 3] == 'S')) ||
+         (w[m_current + 2] == 'U' && w[m_current + 3] == 'S') ||
+         (w[m_current + 2] == 'Y' &&
+          (w[m_current + 3] == 'L' || w[m_current + 3] == 'M'))) &&
+        ! (m_length >= 6 &&
+           w[0] == 'C' &&
+           w[1] == 'H' &&
+           w[2] == 'O' &&
+           ((w[3] == 'L' && w[4] == 'L' && (w[5] == 'A' || w[5] == 'O')) ||
+            (w[3] == 'R' && w[4] == 'I' && w[5] == 'Z')))) ||
+       (m_current != m_last - 3 &&
+        m_current + 4 <= m_length &&
+        memcmp(w + m_current, "CHAO", 4) == 0) ||
+       (m_current + 4 <= m_length &&
+        memcmp(w + m_current, "CHIA", 4) == 0 &&
+        ! ((m_length >= 7 && memcmp(w + 0, "CHIAPAS", 7) == 0) ||
+           (m_length >= 10 && memcmp(w + 0, "APPALACHIA", 10) == 0))) ||
+       (m_current + 7 <= m_length &&
+        w[m_current] == 'C' &&
+        w[m_current + 1] == 'H' &&
+        w[m_current + 2] == 'I' &&
+        w[m_current + 3] == 'M' &&
+        ((w[m_current + 4] == 'A' &&
+          w[m_current + 5] == 'E' &&
+          w[m_current + 6] == 'R') ||
+         (w[m_current + 4] == 'E' &&
+          w[m_current + 5] == 'R' &&
+          (w[m_current + 6] == 'A' || w[m_current + 6] == 'I')))) ||
+       (m_current == 0 &&
+        m_length >= 5 &&
+        w[0] == 'C' &&
+        w[1] == 'H' &&
+        ((w[2] == 'A' && w[3] == 'M' && w[4] == 'E') ||
+         (w[2] == 'E' && w[3] == 'L' && w[4] == 'O') ||
+         (w[2] == 'I' && w[3] == 'T' && w[4] == 'O'))) ||
+       ((m_current == m_last - 4 || m_current == m_last - 5) &&
+        m_current >= 1 &&
+        m_current + 5 <= m_length &&
+        memcmp(w + m_current - 1, "OCHETE", 6) == 0)) &&
+      (m_length != 5 ||
+       ! (m_length >= 5 &&
+          w[0] == 'C' &&
+          w[1] == 'H' &&
+          w[2] == 'O' &&
+          ((w[3] == 'L' && (w[4] == 'A' || w[4] == 'O')) ||
+           (w[3] == 'R' && w[4] == 'E')))) &&
+      ! (m_current + 5 <= m_length &&
+         w[m_current] == 'C' &&
+         w[m_current + 1] == 'H' &&
+         w[m_current + 2] == 'O' &&
+         ((w[m_current + 3] == 'R' && w[m_current + 4] == 'T') ||
+          (w[m_current + 3] == 'S' && w[m_current + 4] == 'E'))) &&
+      ! (m_current >= 3 &&
+         m_current + 4 <= m_length &&
+         memcmp(w + m_current - 3, "CROCHET", 7) == 0) &&
+      ! (m_length >= 7 &&
+         w[0] == 'C' &&
+         w[1] == 'H' &&
+         ((w[2] == 'A' &&
+           w[3] == 'R' &&
+           ((w[4] == 'I' && w[5] == 'S' && (w[6] == 'E' || w[6] == 'S')) ||
+            (w[4] == 'O' && w[5] == 'L' && w[6] == 'E'))) ||
+          (w[2] == 'E' && memcmp(w + 3, "MISE", 4) == 0))))
+  {
+    if (m_current + 3 <= m_length &&
+        (w[m_current + 2] == 'L' || w[m_current + 2] == 'R'))
+    {
+      add("K");
+    }
+    else
+    {
+      add("K", "X");
+    }
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Greek_CH_Non_Initial, Metaphone3Spec.txt line 191.
+bool Metaphone3::encode_Greek_CH_Non_Initial()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current >= 2 &&
+       m_current + 4 <= m_length &&
+       ((w[m_current - 2] == 'L' &&
+         memcmp(w + m_current - 1, "ICHEN", 5) == 0) ||
+        (w[m_current - 2] == 'M' &&
+         ((w[m_current - 1] == 'A' &&
+           memcmp(w + m_current, "CHIC", 4) == 0) ||
+          (w[m_current - 1] == 'E' &&
+           memcmp(w + m_current, "CHAN", 4) == 0) ||
+          (w[m_current - 1] == 'I' &&
+           memcmp(w + m_current, "CHAL", 4) == 0))) ||
+        (w[m_current - 2] == 'N' &&
+         memcmp(w + m_current - 1, "ICHOL", 5) == 0) ||
+        (w[m_current - 2] == 'O' &&
+         memcmp(w + m_current - 1, "RCHID", 5) == 0) ||
+        (w[m_current - 2] == 'P' &&
+         memcmp(w + m_current - 1, "ACHEL", 5) == 0) ||
+        (w[m_current - 2] == 'R' &&
+         w[m_current - 1] == 'A' &&
+         w[m_current] == 'C' &&
+         w[m_current + 1] == 'H' &&
+         w[m_current + 2] == 'I' &&
+         (w[m_current + 3] == 'C' ||
+          w[m_current + 3] == 'D' ||
+          w[m_current + 3] == 'F' ||
+          w[m_current + 3] == 'S')))) ||
+      (m_current >= 3 &&
+       m_current + 2 <= m_length &&
+       ((w[m_current - 3] == 'B' &&
+         memcmp(w + m_current - 2, "RACH", 4) == 0) ||
+        (w[m_current - 3] == 'E' &&
+         memcmp(w + m_current - 2, "POCH", 4) == 0) ||
+        (w[m_current - 3] == 'G' &&
+         memcmp(w + m_current - 2, "LOCH", 4) == 0) ||
+        (w[m_current - 3] == 'M' &&
+         memcmp(w + m_current - 2, "ELCH", 4) == 0) ||
+        (w[m_current - 3] == 'P' &&
+         ((w[m_current - 2] == 'S' &&
+           w[m_current - 1] == 'Y' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H') ||
+          (w[m_current - 2] == 'U' &&
+           w[m_current - 1] == 'L' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H'))) ||
+        (w[m_current - 3] == 'S' &&
+         ((w[m_current - 2] == 'T' &&
+           w[m_current - 1] == 'I' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H') ||
+          (w[m_current - 2] == 'Y' &&
+           w[m_current - 1] == 'N' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H'))) ||
+        (w[m_current - 3] == 'T' &&
+         w[m_current - 2] == 'R' &&
+         ((w[m_current - 1] == 'A' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H') ||
+          (w[m_current - 1] == 'O' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H'))))) ||
+      (m_current >= 3 &&
+       m_current + 2 <= m_length &&
+       memcmp(w + m_current - 3, "TRICH", 5) == 0 &&
+       ! (m_current >= 5 &&
+          m_current + 2 <= m_length &&
+          memcmp(w + m_current - 5, "OSTRICH", 7) == 0)) ||
+      (m_current >= 2 &&
+       m_current + 2 <= m_length &&
+       ((w[m_current - 2] == 'B' &&
+         w[m_current - 1] == 'U' &&
+         w[m_current] == 'C' &&
+         w[m_current + 1] == 'H') ||
+        (w[m_current - 2] == 'C' &&
+         w[m_current - 1] == 'I' &&
+         w[m_current] == 'C' &&
+         w[m_current + 1] == 'H') ||
+        (w[m_current - 2] == 'D' &&
+         ((w[m_current - 1] == 'I' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H') ||
+          (w[m_current - 1] == 'O' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H'))) ||
+        (w[m_current - 2] == 'E' &&
+         w[m_current - 1] == 'I' &&
+         w[m_current] == 'C' &&
+         w[m_current + 1] == 'H') ||
+        (w[m_current - 2] == 'L' &&
+         w[m_current - 1] == 'O' &&
+         w[m_current] == 'C' &&
+         w[m_current + 1] == 'H') ||
+        (w[m_current - 2] == 'M' &&
+         w[m_current - 1] == 'O' &&
+         w[m_current] == 'C' &&
+         w[m_current + 1] == 'H') ||
+        (w[m_current - 2] == 'N' &&
+         w[m_current - 1] == 'U' &&
+         w[m_current] == 'C' &&
+         w[m_current + 1] == 'H') ||
+        (w[m_current - 2] == 'T' &&
+         ((w[m_current - 1] == 'O' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H') ||
+          (w[m_current - 1] == 'Y' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H'))) ||
+        (w[m_current - 2] == 'W' &&
+         w[m_current - 1] == 'Y' &&
+         w[m_current] == 'C' &&
+         w[m_current + 1] == 'H') ||
+        (w[m_current - 2] == 'Z' &&
+         w[m_current - 1] == 'E' &&
+         w[m_current] == 'C' &&
+         w[m_current + 1] == 'H')) &&
+       ! (m_current >= 4 &&
+          m_current + 5 <= m_length &&
+          memcmp(w + m_current - 4, "INDOCHINA", 9) == 0) &&
+       ! (m_current >= 2 &&
+          m_current + 4 <= m_length &&
+          memcmp(w + m_current - 2, "BUCHON", 6) == 0)) ||
+      (m_current >= 2 &&
+       m_current + 3 <= m_length &&
+       ((w[m_current - 2] == 'L' &&
+         ((w[m_current - 1] == 'I' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H' &&
+           w[m_current + 2] == 'O') ||
+          (w[m_current - 1] == 'Y' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H' &&
+           w[m_current + 2] == 'N'))) ||
+        (w[m_current - 2] == 'O' &&
+         w[m_current - 1] == 'R' &&
+         w[m_current] == 'C' &&
+         w[m_current + 1] == 'H' &&
+         (w[m_current + 2] == 'I' || w[m_current + 2] == 'O')) ||
+        (w[m_current - 2] == 'T' &&
+         memcmp(w + m_current - 1, "ACHO", 4) == 0))) ||
+      (m_current >= 2 &&
+       m_current + 6 <= m_length &&
+       memcmp(w + m_current - 2, "ORCHESTR", 8) == 0) ||
+      ((m_current == 1 || m_current == 2) &&
+       m_current >= 1 &&
+       m_current + 4 <= m_length &&
+       ((w[m_current - 1] == 'E' &&
+         w[m_current] == 'C' &&
+         w[m_current + 1] == 'H' &&
+         w[m_current + 2] == 'I' &&
+         (w[m_current + 3] == 'D' || w[m_current + 3] == 'N')) ||
+        (w[m_current - 1] == 'O' &&
+         memcmp(w + m_current, "CHER", 4) == 0))) ||
+      (m_current >= 4 &&
+       m_current + 2 <= m_length &&
+       ((w[m_current - 4] == 'B' &&
+         ((w[m_current - 3] == 'I' &&
+           memcmp(w + m_current - 2, "ANCH", 4) == 0) ||
+          (w[m_current - 3] == 'R' &&
+           memcmp(w + m_current - 2, "ONCH", 4) == 0))) ||
+        (w[m_current - 4] == 'C' &&
+         memcmp(w + m_current - 3, "ATECH", 5) == 0) ||
+        (w[m_current - 4] == 'D' &&
+         memcmp(w + m_current - 3, "IDACH", 5) == 0) ||
+        (w[m_current - 4] == 'M' &&
+         w[m_current - 3] == 'A' &&
+         ((w[m_current - 2] == 'L' &&
+           w[m_current - 1] == 'A' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H') ||
+          (w[m_current - 2] == 'N' &&
+           w[m_current - 1] == 'I' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H'))) ||
+        (w[m_current - 4] == 'P' &&
+         memcmp(w + m_current - 3, "LANCH", 5) == 0) ||
+        (w[m_current - 4] == 'S' &&
+         w[m_current - 3] == 'T' &&
+         ((w[m_current - 2] == 'O' &&
+           w[m_current - 1] == 'I' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H') ||
+          (w[m_current - 2] == 'R' &&
+           w[m_current - 1] == 'Y' &&
+           w[m_current] == 'C' &&
+           w[m_current + 1] == 'H'))) ||
+        (w[m_current - 4] == 'T' &&
+         memcmp(w + m_current - 3, "ELECH", 5) == 0))) ||
+      (m_current >= 4 &&
+       m_current + 4 <= m_length &&
+       w[m_current - 4] == 'B' &&
+       w[m_current - 3] == 'R' &&
+       w[m_current - 2] == 'A' &&
+       w[m_current - 1] == 'N' &&
+       w[m_current] == 'C' &&
+       w[m_current + 1] == 'H' &&
+       w[m_current + 2] == 'I' &&
+       (w[m_current + 3] == 'F' || w[m_current + 3] == 'O')) ||
+      (m_current == 1 &&
+       m_length >= 4 &&
+       w[0] == 'I' &&
+       w[1] == 'C' &&
+       w[2] == 'H' &&
+       (w[3] == 'A' || w[3] == 'N')) ||
+      (m_current >= 1 &&
+       m_current + 4 <= m_length &&
+       w[m_current - 1] == 'A' &&
+       w[m_current] == 'C' &&
+       w[m_current + 1] == 'H' &&
+       w[m_current + 2] == 'A' &&
+       (w[m_current + 3] == 'B' ||
+        w[m_current + 3] == 'D' ||
+        w[m_current + 3] == 'N' ||
+        w[m_current + 3] == 'Z') &&
+       ! (m_current >= 2 &&
+          m_current + 5 <= m_length &&
+          ((w[m_current - 2] == 'L' &&
+            memcmp(w + m_current - 1, "ACHANC", 6) == 0) ||
+           (w[m_current - 2] == 'M' &&
+            memcmp(w + m_current - 1, "ACHADO", 6) == 0)))) ||
+      (m_current >= 1 &&
+       m_current + 5 <= m_length &&
+       w[m_current - 1] == 'A' &&
+       w[m_current] == 'C' &&
+       w[m_current + 1] == 'H' &&
+       ((w[m_current + 2] == 'A' &&
+         w[m_current + 3] == 'I' &&
+         w[m_current + 4] == 'A') ||
+        (w[m_current + 2] == 'E' &&
+         w[m_current + 3] == 'N' &&
+         w[m_current + 4] == 'E') ||
+        (w[m_current + 2] == 'I' &&
+         ((w[m_current + 3] == 'L' && w[m_current + 4] == 'L') ||
+          (w[m_current + 3] == 'S' && w[m_current + 4] == 'H'))))) ||
+      (m_current >= 1 &&
+       m_current + 6 <= m_length &&
+       w[m_current - 1] == 'A' &&
+       w[m_current] == 'C' &&
+       w[m_current + 1] == 'H' &&
+       ((w[m_current + 2] == 'A' &&
+         ((w[m_current + 3] == 'I' &&
+           w[m_current + 4] == 'A' &&
+           w[m_current + 5] == 'N') ||
+          (w[m_current + 3] == 'T' &&
+           w[m_current + 4] == 'E' &&
+           w[m_current + 5] == 'S'))) ||
+        (w[m_current + 2] == 'E' &&
+         w[m_current + 3] == 'R' &&
+         w[m_current + 4] == 'O' &&
+         w[m_current + 5] == 'N') ||
+        (w[m_current + 2] == 'I' &&
+         w[m_current + 3] == 'R' &&
+         w[m_current + 4] == 'A' &&
+         w[m_current + 5] == 'L'))) ||
+      (m_current >= 1 &&
+       m_current + 7 <= m_length &&
+       w[m_current - 1] == 'A' &&
+       w[m_current] == 'C' &&
+       w[m_current + 1] == 'H' &&
+       ((w[m_current + 2] == 'E' &&
+         ((w[m_current + 3] == 'L' &&
+           w[m_current + 4] == 'O' &&
+           w[m_current + 5] == 'U' &&
+           w[m_current + 6] == 'S') ||
+          (w[m_current + 3] == 'N' &&
+           w[m_current + 4] == 'I' &&
+           w[m_current + 5] == 'A' &&
+           w[m_current + 6] == 'L') ||
+          (w[m_current + 3] == 'R' &&
+           w[m_current + 4] == 'N' &&
+           w[m_current + 5] == 'A' &&
+           w[m_current + 6] == 'R'))) ||
+        (w[m_current + 2] == 'I' &&
+         ((w[m_current + 3] == 'L' &&
+           ((w[m_current + 4] == 'A' &&
+             w[m_current + 5] == 'R' &&
+             w[m_current + 6] == 'Y') ||
+            (w[m_current + 4] == 'L' &&
+             w[m_current + 5] == 'E' &&
+             w[m_current + 6] == 'A'))) ||
+          (w[m_current + 3] == 'M' &&
+           w[m_current + 4] == 'A' &&
+           w[m_current + 5] == 'A' &&
+           w[m_current + 6] == 'S'))))) ||
+      (m_current >= 1 &&
+       m_current + 8 <= m_length &&
+       w[m_current - 1] == 'A' &&
+       w[m_current] == 'C' &&
+       w[m_current + 1] == 'H' &&
+       ((w[m_current + 2] == 'A' &&
+         memcmp(w + m_current + 3, "LASIA", 5) == 0) ||
+        (w[m_current + 2] == 'I' &&
+         ((w[m_current + 3] == 'L' &&
+           memcmp(w + m_current + 4, "LEAN", 4) == 0) ||
+          (w[m_current + 3] == 'M' &&
+           memcmp(w + m_current + 4, "ENES", 4) == 0))))) ||
+      (m_current >= 1 &&
+       m_current + 9 <= m_length &&
+       w[m_current - 1] == 'A' &&
+       w[m_current] == 'C' &&
+       w[m_current + 1] == 'H' &&
+       w[m_current + 2] == 'I' &&
+       ((w[m_current + 3] == 'M' &&
+         memcmp(w + m_current + 4, "ELECH", 5) == 0) ||
+        (w[m_current + 3] == 'T' &&
+         memcmp(w + m_current + 4, "OPHEL", 5) == 0))) ||
+      (m_current == 2 &&
+       ((m_length >= 4 && memcmp(w + 0, "ISCH", 4) == 0) ||
+        (m_length >= 6 && memcmp(w + 0, "INCHOA", 6) == 0))) ||
+      (m_current == m_last - 1 &&
+       m_current >= 1 &&
+       m_current <= m_length &&
+       (w[m_current - 1] == 'A' ||
+        w[m_current - 1] == 'E' ||
+        w[m_current - 1] == 'O' ||
+        w[m_current - 1] == 'U') &&
+       ! (m_length >= 7 && memcmp(w + 0, "DEBAUCH", 7) == 0) &&
+       ! (m_current >= 2 &&
+          m_current + 2 <= m_length &&
+          ((w[m_current - 2] == 'K' &&
+            w[m_current - 1] == 'O' &&
+            w[m_current] == 'C' &&
+            w[m_current + 1] == 'H') ||
+           (w[m_current - 2] == 'M' &&
+            w[m_current - 1] == 'U' &&
+            w[m_current] == 'C' &&
+            w[m_current + 1] == 'H') ||
+           (w[m_current - 2] == 'S' &&
+            w[m_current - 1] == 'U' &&
+            w[m_current] == 'C' &&
+            w[m_current + 1] == 'H'))) &&
+       ! (m_current >= 5 &&
+          m_current + 2 <= m_length &&
+          ((w[m_current - 5] == 'A' &&
+            memcmp(w + m_current - 4, "LDRICH", 6) == 0) ||
+           (w[m_current - 5] == 'O' &&
+            memcmp(w + m_current - 4, "ODRICH", 6) == 0)))))
+  {
+    add("K", "X");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_CCIA, Metaphone3Spec.txt line 213.
+bool Metaphone3::encode_CCIA()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 4 <= m_length &&
+      w[m_current + 1] == 'C' &&
+      w[m_current + 2] == 'I' &&
+      w[m_current + 3] == 'A')
+  {
+    add("X", "S");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_CC, Metaphone3Spec.txt line 218.
+bool Metaphone3::encode_CC()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length &&
+      w[m_current] == 'C' &&
+      w[m_current + 1] == 'C' &&
+      (m_current != 1 || ! (m_length >= 1 && w[0] == 'M')))
+  {
+    if (m_current >= 3 &&
+        m_current + 4 <= m_length &&
+        memcmp(w + m_current - 3, "FLACCID", 7) == 0)
+    {
+      add("S");
+      advanceCounter(3, 2);
+    }
+    else if ((m_current == m_last - 2 && m_last >= 0 && w[m_last] == 'I') ||
+             (m_current + 4 <= m_length &&
+              w[m_current + 2] == 'I' &&
+              w[m_current + 3] == 'O') ||
+             (m_current == m_last - 4 &&
+              m_current + 5 <= m_length &&
+              w[m_current + 2] == 'I' &&
+              w[m_current + 3] == 'N' &&
+              (w[m_current + 4] == 'I' || w[m_current + 4] == 'O')))
+    {
+      add("X");
+      advanceCounter(3, 2);
+    }
+    else if (m_current + 3 <= m_length &&
+             (w[m_current + 2] == 'E' ||
+              w[m_current + 2] == 'I' ||
+              w[m_current + 2] == 'Y') &&
+             ! (m_current + 3 <= m_length && w[m_current + 2] == 'H') &&
+             ! (m_current >= 2 &&
+                m_current + 4 <= m_length &&
+                memcmp(w + m_current - 2, "SOCCER", 6) == 0))
+    {
+      add("KS");
+      advanceCounter(3, 2);
+    }
+    else
+    {
+      add("K");
+      m_current += 2;
+    }
+    return true;
+  }
+  return false;
+}
+
+
+// encode_CK_CG_CQ, Metaphone3Spec.txt line 233.
+bool Metaphone3::encode_CK_CG_CQ()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length &&
+      w[m_current] == 'C' &&
+      (w[m_current + 1] == 'G' ||
+       w[m_current + 1] == 'K' ||
+       w[m_current + 1] == 'Q'))
+  {
+    if (m_length > 6 &&
+        m_current == m_last - 2 &&
+        m_current + 3 <= m_length &&
+        w[m_current] == 'C' &&
+        w[m_current + 1] == 'K' &&
+        (w[m_current + 2] == 'I' || w[m_current + 2] == 'Y'))
+    {
+      add("K", "SK");
+    }
+    else
+    {
+      add("K");
+    }
+    if (m_current + 3 <= m_length &&
+        (w[m_current + 2] == 'G' ||
+         w[m_current + 2] == 'K' ||
+         w[m_current + 2] == 'Q'))
+    {
+      m_current += 3;
+    }
+    else
+    {
+      m_current += 2;
+    }
+    return true;
+  }
+  return false;
+}
+
+
+// encode_British_Silent_CE, Metaphone3Spec.txt line 244.
+bool Metaphone3::encode_British_Silent_CE()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current + 6 <= m_length &&
+       memcmp(w + m_current + 1, "ESTER", 5) == 0 &&
+       m_current == m_last - 5) ||
+      (m_current + 11 <= m_length &&
+       memcmp(w + m_current + 1, "ESTERSHIRE", 10) == 0))
+  {
+    return true;
+  }
+  return false;
+}
+
+
+// encode_CE, Metaphone3Spec.txt line 247.
+bool Metaphone3::encode_CE()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current + 4 <= m_length &&
+       w[m_current + 1] == 'E' &&
+       w[m_current + 2] == 'A' &&
+       w[m_current + 3] == 'N' &&
+       isVowel(m_current - 1)) ||
+      (m_current >= 1 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 1, "ACEA", 4) == 0 &&
+       m_current == m_last - 2 &&
+       ! (m_length >= 7 && memcmp(w + 0, "PANACEA", 7) == 0)) ||
+      (m_current + 5 <= m_length &&
+       w[m_current + 1] == 'E' &&
+       ((w[m_current + 2] == 'L' &&
+         w[m_current + 3] == 'L' &&
+         w[m_current + 4] == 'I') ||
+        (w[m_current + 2] == 'O' &&
+         w[m_current + 3] == 'R' &&
+         w[m_current + 4] == 'L') ||
+        (w[m_current + 2] == 'R' &&
+         w[m_current + 3] == 'T' &&
+         w[m_current + 4] == 'O'))) ||
+      (m_current == m_last - 1 &&
+       m_current >= 3 &&
+       m_current + 2 <= m_length &&
+       memcmp(w + m_current - 3, "CROCE", 5) == 0) ||
+      (m_current >= 3 &&
+       m_current + 2 <= m_length &&
+       memcmp(w + m_current - 3, "DOLCE", 5) == 0) ||
+      (m_current == m_last - 4 &&
+       m_current + 5 <= m_length &&
+       memcmp(w + m_current + 1, "ELLO", 4) == 0))
+  {
+    add("X", "S");
+    return true;
+  }
+  return false;
+}
+
+
+// encode_CI, Metaphone3Spec.txt line 256.
+bool Metaphone3::encode_CI()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current == m_last - 3 &&
+       m_current + 4 <= m_length &&
+       w[m_current + 1] == 'I' &&
+       w[m_current + 2] == 'N' &&
+       w[m_current + 3] == 'I' &&
+       ! (m_length >= 7 && memcmp(w + 0, "MANCINI", 7) == 0)) ||
+      (m_current == m_last - 1 &&
+       m_current >= 1 &&
+       m_current + 2 <= m_length &&
+       w[m_current - 1] == 'I' &&
+       w[m_current] == 'C' &&
+       w[m_current + 1] == 'I') ||
+      (m_current >= 1 &&
+       m_current + 4 <= m_length &&
+       ((w[m_current - 1] == 'N' && memcmp(w + m_current, "CIAL", 4) == 0) ||
+        (w[m_current - 1] == 'R' &&
+         w[m_current] == 'C' &&
+         w[m_current + 1] == 'I' &&
+         w[m_current + 2] == 'A' &&
+         (w[m_current + 3] == 'L' || w[m_current + 3] == 'N')) ||
+        (w[m_current - 1] == 'U' &&
+         memcmp(w + m_current, "CIUS", 4) == 0))) ||
+      (m_current >= 3 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 3, "MARCIA", 6) == 0) ||
+      (m_current >= 2 &&
+       m_current + 5 <= m_length &&
+       memcmp(w + m_current - 2, "ANCIENT", 7) == 0))
+  {
+    add("X", "S");
+    return true;
+  }
+
+  if (m_current + 3 <= m_length &&
+      w[m_current] == 'C' &&
+      w[m_current + 1] == 'I' &&
+      (w[m_current + 2] == 'A' ||
+       w[m_current + 2] == 'E' ||
+       w[m_current + 2] == 'O') &&
+      (isVowel(m_current - 1) ||
+       (m_current + 4 <= m_length &&
+        w[m_current + 1] == 'I' &&
+        w[m_current + 2] == 'A' &&
+        w[m_current + 3] == 'O')))
+  {
+    if (((m_current + 4 <= m_length &&
+          w[m_current] == 'C' &&
+          w[m_current + 1] == 'I' &&
+          ((w[m_current + 2] == 'A' &&
+            (w[m_current + 3] == 'L' ||
+             w[m_current + 3] == 'N' ||
+             w[m_current + 3] == 'O')) ||
+           (w[m_current + 2] == 'E' && w[m_current + 3] == 'S') ||
+           (w[m_current + 2] == 'O' &&
+            (w[m_current + 3] == 'L' || w[m_current + 3] == 'N')))) ||
+         (m_current + 5 <= m_length &&
+          w[m_current] == 'C' &&
+          w[m_current + 1] == 'I' &&
+          ((w[m_current + 2] == 'A' &&
+            ((w[m_current + 3] == 'B' && w[m_current + 4] == 'L') ||
+             (w[m_current + 3] == 'R' && w[m_current + 4] == 'Y') ||
+             (w[m_current + 3] == 'T' &&
+              (w[m_current + 4] == 'E' ||
+               w[m_current + 4] == 'I' ||
+               w[m_current + 4] == 'O')))) ||
+           (w[m_current + 2] == 'E' &&
+            w[m_current + 3] == 'N' &&
+            (w[m_current + 4] == 'C' || w[m_current + 4] == 'T')) ||
+           (w[m_current + 2] == 'O' &&
+            w[m_current + 3] == 'U' &&
+            w[m_current + 4] == 'S'))) ||
+         (m_current >= 3 &&
+          m_current + 4 <= m_length &&
+          memcmp(w + m_current - 3, "GLACIER", 7) == 0) ||
+         (m_current == m_last - 2 &&
+          m_current + 3 <= m_length &&
+          w[m_current] == 'C' &&
+          w[m_current + 1] == 'I' &&
+          (w[m_current + 2] == 'A' || w[m_current + 2] == 'O'))) &&
+        ! ((m_current >= 4 &&
+            m_current + 7 <= m_length &&
+            memcmp(w + m_current - 4, "ASSOCIATION", 11) == 0) ||
+           (m_length >= 4 && memcmp(w + 0, "OCIE", 4) == 0) ||
+           (m_current >= 2 &&
+            m_current + 3 <= m_length &&
+            ((w[m_current - 2] == 'L' &&
+              memcmp(w + m_current - 1, "UCIO", 4) == 0) ||
+             (w[m_current - 2] == 'S' &&
+              w[m_current - 1] == 'O' &&
+              w[m_current] == 'C' &&
+              w[m_current + 1] == 'I' &&
+              (w[m_current + 2] == 'E' || w[m_current + 2] == 'O')))) ||
+           (m_current >= 2 &&
+            m_current + 4 <= m_length &&
+            memcmp(w + m_current - 2, "MACIAS", 6) == 0) ||
+           (m_current >= 2 &&
+            m_current + 5 <= m_length &&
+            memcmp(w + m_current - 2, "LUCIANO", 7) == 0) ||
+           (m_current >= 2 &&
+            m_current + 6 <= m_length &&
+            memcmp(w + m_current - 2, "HACIENDA", 8) == 0) ||
+           (m_current >= 3 &&
+            m_current + 3 <= m_length &&
+            w[m_current - 3] == 'G' &&
+            w[m_current - 2] == 'R' &&
+            w[m_current - 1] == 'A' &&
+            w[m_current] == 'C' &&
+            w[m_current + 1] == 'I' &&
+            (w[m_current + 2] == 'A' || w[m_current + 2] == 'E')) ||
+           (m_current >= 3 &&
+            m_current + 5 <= m_length &&
+            memcmp(w + m_current - 3, "MARCIANO", 8) == 0) ||
+           (m_current >= 4 &&
+            m_current + 3 <= m_length &&
+            memcmp(w + m_current - 4, "PALACIO", 7) == 0) ||
+           (m_current >= 4 &&
+            m_current + 4 <= m_length &&
+            memcmp(w + m_current - 4, "POLICIES", 8) == 0) ||
+           (m_current >= 4 &&
+            m_current + 5 <= m_length &&
+            memcmp(w + m_current - 4, "FELICIANO", 9) == 0) ||
+           (m_current >= 5 &&
+            m_current + 3 <= m_length &&
+            memcmp(w + m_current - 5, "MAURICIO", 8) == 0) ||
+           (m_current >= 6 &&
+            m_current + 3 <= m_length &&
+            memcmp(w + m_current - 6, "ANDALUCIA", 9) == 0) ||
+           (m_current >= 7 &&
+            m_current + 4 <= m_length &&
+            memcmp(w + m_current - 7, "ENCARNACION", 11) == 0)))
+    {
+      add("X", "S");
+    }
+    else
+    {
+      add("S", "X");
+    }
+    return true;
+  }
+
+  if (m_current >= 4 &&
+      m_current + 4 <= m_length &&
+      memcmp(w + m_current - 4, "COERCION", 8) == 0)
+  {
+    add("J");
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Latinate_Suffixes, Metaphone3Spec.txt line 282.
+bool Metaphone3::encode_Latinate_Suffixes()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 5 <= m_length &&
+      ((w[m_current + 1] == 'E' &&
+        w[m_current + 2] == 'O' &&
+        w[m_current + 3] == 'U' &&
+        w[m_current + 4] == 'S') ||
+       (w[m_current + 1] == 'I' &&
+        w[m_current + 2] == 'O' &&
+        w[m_current + 3] == 'U' &&
+        w[m_current + 4] == 'S')))
+  {
+    add("X", "S");
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Silent_C, Metaphone3Spec.txt line 286.
+bool Metaphone3::encode_Silent_C()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length &&
+      (w[m_current + 1] == 'S' || w[m_current + 1] == 'T') &&
+      ((m_length >= 6 &&
+        ((w[0] == 'I' && memcmp(w + 1, "NDICT", 5) == 0) ||
+         (w[0] == 'T' && memcmp(w + 1, "UCSON", 5) == 0))) ||
+       (m_length >= 11 && memcmp(w + 0, "CONNECTICUT", 11) == 0)))
+  {
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_CZ, Metaphone3Spec.txt line 290.
+bool Metaphone3::encode_CZ()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length &&
+      w[m_current + 1] == 'Z' &&
+      ! (m_current >= 1 &&
+         m_current + 5 <= m_length &&
+         memcmp(w + m_current - 1, "ECZEMA", 6) == 0))
+  {
+    if (m_current + 4 <= m_length && memcmp(w + m_current, "CZAR", 4) == 0)
+    {
+      add("S");
+    }
+    else
+    {
+      add("X");
+    }
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_CS, Metaphone3Spec.txt line 298.
+bool Metaphone3::encode_CS()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_length >= 6 && memcmp(w + 0, "KOVACS", 6) == 0)
+  {
+    add("KS", "X");
+    m_current += 2;
+    return true;
+  }
+
+  if (m_current == m_last - 1 &&
+      m_current >= 1 &&
+      m_current + 2 <= m_length &&
+      w[m_current - 1] == 'A' &&
+      w[m_current] == 'C' &&
+      w[m_current + 1] == 'S' &&
+      ! (m_current >= 4 &&
+         m_current + 2 <= m_length &&
+         memcmp(w + m_current - 4, "ISAACS", 6) == 0))
+  {
+    add("X");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_DG, Metaphone3Spec.txt line 309.
+bool Metaphone3::encode_DG()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length &&
+      w[m_current] == 'D' &&
+      w[m_current + 1] == 'G')
+  {
+    if ((m_current + 3 <= m_length &&
+         (w[m_current + 2] == 'A' || w[m_current + 2] == 'O')) ||
+        (m_current + 4 <= m_length &&
+         w[m_current + 1] == 'G' &&
+         w[m_current + 2] == 'U' &&
+         (w[m_current + 3] == 'N' || w[m_current + 3] == 'T')) ||
+        (m_current + 5 <= m_length &&
+         w[m_current + 1] == 'G' &&
+         ((w[m_current + 2] == 'E' &&
+           w[m_current + 3] == 'A' &&
+           w[m_current + 4] == 'R') ||
+          (w[m_current + 2] == 'I' &&
+           w[m_current + 3] == 'L' &&
+           w[m_current + 4] == 'L') ||
+          (w[m_current + 2] == 'L' &&
+           w[m_current + 3] == 'A' &&
+           w[m_current + 4] == 'S') ||
+          (w[m_current + 2] == 'R' &&
+           ((w[m_current + 3] == 'A' && w[m_current + 4] == 'F') ||
+            (w[m_current + 3] == 'E' && w[m_current + 4] == 'N') ||
+            (w[m_current + 3] == 'I' && w[m_current + 4] == 'P'))))) ||
+        (m_current + 6 <= m_length &&
+         w[m_current + 1] == 'G' &&
+         ((w[m_current + 2] == 'R' &&
+           w[m_current + 3] == 'A' &&
+           ((w[m_current + 4] == 'S' && w[m_current + 5] == 'S') ||
+            (w[m_current + 4] == 'V' && w[m_current + 5] == 'E'))) ||
+          (w[m_current + 2] == 'U' &&
+           ((w[m_current + 3] == 'A' &&
+             w[m_current + 4] == 'R' &&
+             w[m_current + 5] == 'D') ||
+            (w[m_current + 3] == 'I' &&
+             w[m_current + 4] == 'L' &&
+             w[m_current + 5] == 'T'))))) ||
+        (m_current + 7 <= m_length &&
+         memcmp(w + m_current + 1, "GROUSE", 6) == 0))
+    {
+      addExactApprox("DG", "TK");
+    }
+    else
+    {
+      add("J");
+    }
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_DJ, Metaphone3Spec.txt line 319.
+bool Metaphone3::encode_DJ()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length &&
+      w[m_current] == 'D' &&
+      w[m_current + 1] == 'J')
+  {
+    add("J");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_DT_DD, Metaphone3Spec.txt line 324.
+bool Metaphone3::encode_DT_DD()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length &&
+      w[m_current] == 'D' &&
+      (w[m_current + 1] == 'D' || w[m_current + 1] == 'T'))
+  {
+    if (m_current + 3 <= m_length &&
+        w[m_current] == 'D' &&
+        w[m_current + 1] == 'T' &&
+        w[m_current + 2] == 'H')
+    {
+      addExactApprox("D0", "T0");
+      m_current += 3;
+    }
+    else if (m_encodeExact &&
+             m_current + 2 <= m_length &&
+             w[m_current] == 'D' &&
+             w[m_current + 1] == 'D')
+    {
+      add("D");
+      m_current += 2;
+    }
+    else
+    {
+      add("T");
+      m_current += 2;
+    }
+    return true;
+  }
+  return false;
+}
+
+
+// encode_D_To_J, Metaphone3Spec.txt line 336.
+bool Metaphone3::encode_D_To_J()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current + 3 <= m_length &&
+       w[m_current] == 'D' &&
+       w[m_current + 1] == 'U' &&
+       w[m_current + 2] == 'L' &&
+       isVowel(m_current - 1) &&
+       isVowel(m_current + 3)) ||
+      (m_current == m_last - 3 &&
+       m_current >= 1 &&
+       m_current + 4 <= m_length &&
+       ((w[m_current - 1] == 'E' && memcmp(w + m_current, "DURE", 4) == 0) ||
+        (w[m_current - 1] == 'L' && memcmp(w + m_current, "DIER", 4) == 0) ||
+        (w[m_current - 1] == 'N' && memcmp(w + m_current, "DEUR", 4) == 0) ||
+        (w[m_current - 1] == 'R' &&
+         memcmp(w + m_current, "DURE", 4) == 0))) ||
+      (m_current >= 3 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 3, "CORDIAL", 7) == 0) ||
+      (m_current >= 1 &&
+       m_current + 3 <= m_length &&
+       ((w[m_current - 1] == 'A' &&
+         w[m_current] == 'D' &&
+         w[m_current + 1] == 'U' &&
+         w[m_current + 2] == 'A') ||
+        (w[m_current - 1] == 'I' &&
+         w[m_current] == 'D' &&
+         w[m_current + 1] == 'U' &&
+         (w[m_current + 2] == 'A' || w[m_current + 2] == 'U')))) ||
+      (m_current >= 1 &&
+       m_current + 4 <= m_length &&
+       ((w[m_current - 1] == 'E' && memcmp(w + m_current, "DUCA", 4) == 0) ||
+        (w[m_current - 1] == 'N' &&
+         w[m_current] == 'D' &&
+         w[m_current + 1] == 'U' &&
+         w[m_current + 2] == 'L' &&
+         (w[m_current + 3] == 'A' || w[m_current + 3] == 'U')))))
+  {
+    addExactApprox("J", "D", "J", "T");
+    advanceCounter(2, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_DOUS, Metaphone3Spec.txt line 344.
+bool Metaphone3::encode_DOUS()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 5 <= m_length && memcmp(w + m_current + 1, "UOUS", 4) == 0)
+  {
+    addExactApprox("J", "D", "J", "T");
+    advanceCounter(4, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Silent_D, Metaphone3Spec.txt line 349.
+bool Metaphone3::encode_Silent_D()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current >= 2 &&
+       m_current + 7 <= m_length &&
+       memcmp(w + m_current - 2, "WEDNESDAY", 9) == 0) ||
+      (m_current >= 3 &&
+       m_current + 4 <= m_length &&
+       ((w[m_current - 3] == 'H' &&
+         w[m_current - 2] == 'A' &&
+         w[m_current - 1] == 'N' &&
+         w[m_current] == 'D' &&
+         ((w[m_current + 1] == 'K' &&
+           w[m_current + 2] == 'E' &&
+           w[m_current + 3] == 'R') ||
+          (w[m_current + 1] == 'S' &&
+           w[m_current + 2] == 'O' &&
+           w[m_current + 3] == 'M'))) ||
+        (w[m_current - 3] == 'W' &&
+         memcmp(w + m_current - 2, "INDSOR", 6) == 0))) ||
+      (m_current >= 5 &&
+       m_current + 1 <= m_length &&
+       ((w[m_current - 5] == 'A' &&
+         memcmp(w + m_current - 4, "RTAUD", 5) == 0) ||
+        (w[m_current - 5] == 'P' &&
+         memcmp(w + m_current - 4, "ERNOD", 5) == 0) ||
+        (w[m_current - 5] == 'R' &&
+         memcmp(w + m_current - 4, "ENAUD", 5) == 0))) ||
+      (m_current >= 6 &&
+       m_current + 1 <= m_length &&
+       ((w[m_current - 6] == 'B' &&
+         memcmp(w + m_current - 5, "ICHAUD", 6) == 0) ||
+        (w[m_current - 6] == 'M' &&
+         memcmp(w + m_current - 5, "ICHAUD", 6) == 0) ||
+        (w[m_current - 6] == 'R' &&
+         memcmp(w + m_current - 5, "IMBAUD", 6) == 0))))
+  {
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Silent_G_At_Beginning, Metaphone3Spec.txt line 359.
+bool Metaphone3::encode_Silent_G_At_Beginning()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current == 0 && m_length >= 2 && w[0] == 'G' && w[1] == 'N')
+  {
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_GG, Metaphone3Spec.txt line 363.
+bool Metaphone3::encode_GG()
+{
+  const char * w = m_inWord.c_str();
+
+  if (! (m_current + 2 <= m_length && w[m_current + 1] == 'G'))
+    return false;
+
+  if ((m_current >= 1 &&
+       m_current + 4 <= m_length &&
+       ((w[m_current - 1] == 'A' &&
+         w[m_current] == 'G' &&
+         w[m_current + 1] == 'G' &&
+         w[m_current + 2] == 'I' &&
+         (w[m_current + 3] == 'A' || w[m_current + 3] == 'O')) ||
+        (w[m_current - 1] == 'E' &&
+         w[m_current] == 'G' &&
+         w[m_current + 1] == 'G' &&
+         w[m_current + 2] == 'I' &&
+         (w[m_current + 3] == 'A' || w[m_current + 3] == 'O')) ||
+        (w[m_current - 1] == 'I' && memcmp(w + m_current, "GGIO", 4) == 0) ||
+        (w[m_current - 1] == 'O' &&
+         memcmp(w + m_current, "GGIA", 4) == 0))) ||
+      (m_current != m_last - 3 &&
+       m_current != m_last - 4 &&
+       m_current >= 1 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 1, "UGGIE", 5) == 0) ||
+      (m_current == m_last - 2 &&
+       m_current >= 1 &&
+       m_current + 3 <= m_length &&
+       ((w[m_current - 1] == 'A' &&
+         w[m_current] == 'G' &&
+         w[m_current + 1] == 'G' &&
+         w[m_current + 2] == 'I') ||
+        (w[m_current - 1] == 'O' &&
+         w[m_current] == 'G' &&
+         w[m_current + 1] == 'G' &&
+         w[m_current + 2] == 'I'))) ||
+      (m_current >= 2 &&
+       m_current + 4 <= m_length &&
+       ((w[m_current - 2] == 'R' &&
+         memcmp(w + m_current - 1, "EGGIE", 5) == 0) ||
+        (w[m_current - 2] == 'S' &&
+         memcmp(w + m_current - 1, "UGGES", 5) == 0) ||
+        (w[m_current - 2] == 'X' &&
+         memcmp(w + m_current - 1, "AGGER", 5) == 0))))
+  {
+    if (m_current >= 2 &&
+        m_current + 5 <= m_length &&
+        memcmp(w + m_current - 2, "SUGGEST", 7) == 0)
+    {
+      addExactApprox("G", "K");
+    }
+    add("J");
+    advanceCounter(3, 2);
+    return true;
+  }
+
+  if (m_current + 2 <= m_length && w[m_current + 1] == 'G')
+  {
+    addExactApprox("G", "K");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_GK, Metaphone3Spec.txt line 377.
+bool Metaphone3::encode_GK()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length && w[m_current + 1] == 'K')
+  {
+    add("K");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_GH_After_Consonant, Metaphone3Spec.txt line 382.
+bool Metaphone3::encode_GH_After_Consonant()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current > 0 &&
+      ! isVowel(m_current - 1) &&
+      ! (m_current >= 3 &&
+         m_current + 2 <= m_length &&
+         memcmp(w + m_current - 3, "HALGH", 5) == 0 &&
+         m_current == m_last - 1))
+  {
+    addExactApprox("G", "K");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Initial_GH, Metaphone3Spec.txt line 387.
+bool Metaphone3::encode_Initial_GH()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current == 0)
+  {
+    if (m_current + 3 <= m_length && w[m_current + 2] == 'I')
+    {
+      add("J");
+    }
+    else
+    {
+      addExactApprox("G", "K");
+    }
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_GH_To_J, Metaphone3Spec.txt line 395.
+bool Metaphone3::encode_GH_To_J()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current == m_last - 1 &&
+      m_current >= 2 &&
+      m_current + 2 <= m_length &&
+      memcmp(w + m_current - 2, "ALGH", 4) == 0)
+  {
+    add("J", "");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_GH_To_H, Metaphone3Spec.txt line 400.
+bool Metaphone3::encode_GH_To_H()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current >= 4 &&
+       m_current <= m_length &&
+       w[m_current - 4] == 'D' &&
+       w[m_current - 3] == 'O' &&
+       w[m_current - 2] == 'N' &&
+       (w[m_current - 1] == 'A' || w[m_current - 1] == 'O') &&
+       isVowel(m_current + 2)) ||
+      (m_current >= 5 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 5, "CALLAGHAN", 9) == 0))
+  {
+    add("H");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_UGHT, Metaphone3Spec.txt line 405.
+bool Metaphone3::encode_UGHT()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current >= 1 &&
+      m_current + 3 <= m_length &&
+      memcmp(w + m_current - 1, "UGHT", 4) == 0)
+  {
+    if ((m_current >= 3 &&
+         m_current + 2 <= m_length &&
+         memcmp(w + m_current - 3, "LAUGH", 5) == 0 &&
+         ! (m_current >= 4 &&
+            m_current + 3 <= m_length &&
+            memcmp(w + m_current - 4, "SLAUGHT", 7) == 0) &&
+         ! (m_current >= 3 &&
+            m_current + 4 <= m_length &&
+            memcmp(w + m_current - 3, "LAUGHTO", 7) == 0)) ||
+        (m_current >= 4 &&
+         m_current + 2 <= m_length &&
+         memcmp(w + m_current - 4, "DRAUGH", 6) == 0))
+    {
+      add("FT");
+    }
+    else
+    {
+      add("T");
+    }
+    m_current += 3;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_GH_H_Part_Of_Other_Word, Metaphone3Spec.txt line 414.
+bool Metaphone3::encode_GH_H_Part_Of_Other_Word()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 5 <= m_length &&
+      w[m_current + 1] == 'H' &&
+      ((w[m_current + 2] == 'A' &&
+        w[m_current + 3] == 'R' &&
+        w[m_current + 4] == 'N') ||
+       (w[m_current + 2] == 'E' &&
+        w[m_current + 3] == 'A' &&
+        w[m_current + 4] == 'D') ||
+       (w[m_current + 2] == 'O' &&
+        ((w[m_current + 3] == 'L' && w[m_current + 4] == 'E') ||
+         (w[m_current + 3] == 'R' && w[m_current + 4] == 'N') ||
+         (w[m_current + 3] == 'U' && w[m_current + 4] == 'S')))))
+  {
+    addExactApprox("G", "K");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Silent_GH, Metaphone3Spec.txt line 419.
+bool Metaphone3::encode_Silent_GH()
+{
+  const char * w = m_inWord.c_str();
+
+  if (((m_current >= 2 &&
+        m_current - 1 <= m_length &&
+        (w[m_current - 2] == 'B' ||
+         w[m_current - 2] == 'D' ||
+         w[m_current - 2] == 'G' ||
+         w[m_current - 2] == 'H' ||
+         w[m_current - 2] == 'L')) ||
+       (m_current >= 3 &&
+        m_current - 2 <= m_length &&
+        (w[m_current - 3] == 'B' ||
+         w[m_current - 3] == 'D' ||
+         w[m_current - 3] == 'H' ||
+         w[m_current - 3] == 'K' ||
+         w[m_current - 3] == 'N' ||
+         w[m_current - 3] == 'P' ||
+         w[m_current - 3] == 'V' ||
+         w[m_current - 3] == 'W') &&
+        ! (m_length >= 6 && memcmp(w + 0, "ENOUGH", 6) == 0)) ||
+       (m_current >= 4 &&
+        m_current - 3 <= m_length &&
+        (w[m_current - 4] == 'B' || w[m_current - 4] == 'H')) ||
+       (m_current >= 4 &&
+        m_current - 2 <= m_length &&
+        ((w[m_current - 4] == 'P' && w[m_current - 3] == 'L') ||
+         (w[m_current - 4] == 'S' && w[m_current - 3] == 'L'))) ||
+       (m_current >= 4 &&
+        m_current + 2 <= m_length &&
+        ((w[m_current - 4] == 'D' &&
+          memcmp(w + m_current - 3, "RAUGH", 5) == 0) ||
+         (w[m_current - 4] == 'G' &&
+          memcmp(w + m_current - 3, "ERAGH", 5) == 0))) ||
+       (m_current >= 1 && m_current <= m_length && w[m_current - 1] == 'I') ||
+       (m_length >= 4 && memcmp(w + 0, "PUGH", 4) == 0) ||
+       (m_current == m_last - 1 &&
+        m_current >= 1 &&
+        m_current + 2 <= m_length &&
+        w[m_current - 1] == 'A' &&
+        w[m_current] == 'G' &&
+        w[m_current + 1] == 'H') ||
+       (m_current >= 3 &&
+        m_current + 2 <= m_length &&
+        ((w[m_current - 3] == 'G' &&
+          ((w[m_current - 2] == 'A' &&
+            w[m_current - 1] == 'U' &&
+            w[m_current] == 'G' &&
+            w[m_current + 1] == 'H') ||
+           (w[m_current - 2] == 'E' &&
+            w[m_current - 1] == 'O' &&
+            w[m_current] == 'G' &&
+            w[m_current + 1] == 'H'))) ||
+         (w[m_current - 3] == 'M' &&
+          memcmp(w + m_current - 2, "AUGH", 4) == 0)) &&
+        ! (m_length >= 9 && memcmp(w + 0, "MCGAUGHEY", 9) == 0)) ||
+       (m_current > 3 &&
+        m_current >= 2 &&
+        m_current + 2 <= m_length &&
+        memcmp(w + m_current - 2, "OUGH", 4) == 0 &&
+        ! (m_current >= 4 &&
+           m_current + 2 <= m_length &&
+           ((w[m_current - 4] == 'C' &&
+             ((w[m_current - 3] == 'C' &&
+               memcmp(w + m_current - 2, "OUGH", 4) == 0) ||
+              (w[m_current - 3] == 'L' &&
+               memcmp(w + m_current - 2, "OUGH", 4) == 0))) ||
+            (w[m_current - 4] == 'E' &&
+             memcmp(w + m_current - 3, "NOUGH", 5) == 0) ||
+            (w[m_current - 4] == 'T' &&
+             memcmp(w + m_current - 3, "ROUGH", 5) == 0))))) &&
+      (m_current == m_last - 1 ||
+       ! isVowel(m_current + 2) ||
+       (m_current >= 4 &&
+        m_current + 4 <= m_length &&
+        memcmp(w + m_current - 4, "BROUGHAM", 8) == 0) ||
+       (m_current >= 3 &&
+        m_current + 2 <= m_length &&
+        ((w[m_current - 3] == 'F' &&
+          memcmp(w + m_current - 2, "EIGH", 4) == 0) ||
+         (w[m_current - 3] == 'G' &&
+          ((w[m_current - 2] == 'A' &&
+            w[m_current - 1] == 'U' &&
+            w[m_current] == 'G' &&
+            w[m_current + 1] == 'H') ||
+           (w[m_current - 2] == 'E' &&
+            w[m_current - 1] == 'O' &&
+            w[m_current] == 'G' &&
+            w[m_current + 1] == 'H'))) ||
+         (w[m_current - 3] == 'L' &&
+          memcmp(w + m_current - 2, "EIGH", 4) == 0) ||
+         (w[m_current - 3] == 'M' &&
+          memcmp(w + m_current - 2, "AUGH", 4) == 0) ||
+         (w[m_current - 3] == 'V' &&
+          memcmp(w + m_current - 2, "AUGH", 4) == 0))) ||
+       (m_current >= 2 &&
+        m_current + 2 <= m_length &&
+        ((w[m_current - 2] == 'H' &&
+          w[m_current - 1] == 'I' &&
+          w[m_current] == 'G' &&
+          w[m_current + 1] == 'H') ||
+         (w[m_current - 2] == 'T' &&
+          w[m_current - 1] == 'I' &&
+          w[m_current] == 'G' &&
+          w[m_current + 1] == 'H'))) ||
+       (m_current == m_last - 2 && m_last >= 0 && w[m_last] == 'Y') ||
+       (m_current == m_last - 3 &&
+        m_current + 4 <= m_length &&
+        ((w[m_current + 2] == 'E' &&
+          (w[m_current + 3] == 'D' ||
+           w[m_current + 3] == 'R' ||
+           w[m_current + 3] == 'S' ||
+           w[m_current + 3] == 'Y')) ||
+         (w[m_current + 2] == 'I' && w[m_current + 3] == 'E') ||
+         (w[m_current + 2] == 'T' && w[m_current + 3] == 'Y')) &&
+        ! (m_current >= 5 &&
+           m_current + 4 <= m_length &&
+           memcmp(w + m_current - 5, "GALLAGHER", 9) == 0)) ||
+       (m_current == m_last - 4 &&
+        m_current + 5 <= m_length &&
+        ((w[m_current + 2] == 'I' &&
+          w[m_current + 3] == 'N' &&
+          w[m_current + 4] == 'G') ||
+         (w[m_current + 2] == 'O' &&
+          w[m_current + 3] == 'U' &&
+          w[m_current + 4] == 'T'))) ||
+       (m_current == m_last - 5 &&
+        m_current + 6 <= m_length &&
+        memcmp(w + m_current + 2, "ERTY", 4) == 0)) &&
+      ! (m_length >= 6 &&
+         ((w[0] == 'B' && memcmp(w + 1, "ALOGH", 5) == 0) ||
+          (w[0] == 'S' && memcmp(w + 1, "ABAGH", 5) == 0))) &&
+      ! (m_current >= 2 &&
+         m_current + 5 <= m_length &&
+         memcmp(w + m_current - 2, "BAGHDAD", 7) == 0) &&
+      ! (m_current >= 3 &&
+         m_current + 2 <= m_length &&
+         memcmp(w + m_current - 3, "WHIGH", 5) == 0) &&
+      ! (m_current >= 5 &&
+         m_current + 2 <= m_length &&
+         memcmp(w + m_current - 5, "SABBAGH", 7) == 0))
+  {
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_GH_Special_Cases, Metaphone3Spec.txt line 445.
+bool Metaphone3::encode_GH_Special_Cases()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current >= 6 &&
+      m_current + 2 <= m_length &&
+      memcmp(w + m_current - 6, "HICCOUGH", 8) == 0)
+  {
+    add("P");
+    m_current += 2;
+    return true;
+  }
+
+  if (m_length >= 5 && memcmp(w + 0, "LOUGH", 5) == 0)
+  {
+    add("K");
+    m_current += 2;
+    return true;
+  }
+
+  if (m_length >= 6 && memcmp(w + 0, "BALOGH", 6) == 0)
+  {
+    addExactApprox("G", "", "K", "");
+    m_current += 2;
+    return true;
+  }
+
+  if (m_current >= 3 &&
+      m_current + 5 <= m_length &&
+      ((w[m_current - 3] == 'C' &&
+        memcmp(w + m_current - 2, "OUGHLAN", 7) == 0) ||
+       (w[m_current - 3] == 'L' &&
+        ((w[m_current - 2] == 'A' &&
+          memcmp(w + m_current - 1, "UGHLIN", 6) == 0) ||
+         (w[m_current - 2] == 'O' &&
+          memcmp(w + m_current - 1, "UGHLIN", 6) == 0)))))
+  {
+    add("K", "F");
+    m_current += 2;
+    return true;
+  }
+
+  if ((m_current >= 3 &&
+       m_current + 2 <= m_length &&
+       memcmp(w + m_current - 3, "GOUGH", 5) == 0) ||
+      (m_current >= 7 &&
+       m_current + 2 <= m_length &&
+       memcmp(w + m_current - 7, "COLCLOUGH", 9) == 0))
+  {
+    add("", "F");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Silent_G, Metaphone3Spec.txt line 462.
+bool Metaphone3::encode_Silent_G()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current == m_last - 1 &&
+       ((m_current >= 1 &&
+         m_current + 2 <= m_length &&
+         ((w[m_current - 1] == 'A' &&
+           w[m_current] == 'G' &&
+           w[m_current + 1] == 'M') ||
+          (w[m_current - 1] == 'E' &&
+           w[m_current] == 'G' &&
+           w[m_current + 1] == 'M') ||
+          (w[m_current - 1] == 'I' &&
+           w[m_current] == 'G' &&
+           w[m_current + 1] == 'M'))) ||
+        (m_current + 2 <= m_length &&
+         w[m_current] == 'G' &&
+         w[m_current + 1] == 'T'))) ||
+      (m_length == 5 && m_length >= 5 && memcmp(w + 0, "HUGES", 5) == 0))
+  {
+    m_current++;
+    return true;
+  }
+
+  if (m_current != m_last && m_length >= 2 && w[0] == 'N' && w[1] == 'G')
+  {
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_GN, Metaphone3Spec.txt line 469.
+bool Metaphone3::encode_GN()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length && w[m_current + 1] == 'N')
+  {
+    if ((m_current > 1 &&
+         ((m_current >= 1 &&
+           m_current <= m_length &&
+           (w[m_current - 1] == 'E' ||
+            w[m_current - 1] == 'I' ||
+            w[m_current - 1] == 'U')) ||
+          (m_current >= 3 &&
+           m_current + 4 <= m_length &&
+           memcmp(w + m_current - 3, "CHAGNON", 7) == 0) ||
+          (m_current >= 3 &&
+           m_current + 6 <= m_length &&
+           memcmp(w + m_current - 3, "LORGNETTE", 9) == 0) ||
+          (m_current >= 2 &&
+           m_current + 4 <= m_length &&
+           memcmp(w + m_current - 2, "COGNAC", 6) == 0) ||
+          (m_current >= 2 &&
+           m_current + 7 <= m_length &&
+           memcmp(w + m_current - 2, "LAGNIAPPE", 9) == 0) ||
+          (m_current >= 5 &&
+           m_current + 4 <= m_length &&
+           memcmp(w + m_current - 5, "COMPAGNIE", 9) == 0) ||
+          (m_current >= 4 &&
+           m_current + 2 <= m_length &&
+           memcmp(w + m_current - 4, "BOLOGN", 6) == 0)) &&
+         ! ((m_current + 5 <= m_length &&
+             ((w[m_current + 2] == 'A' &&
+               w[m_current + 3] == 'T' &&
+               w[m_current + 4] == 'E') ||
+              (w[m_current + 2] == 'I' &&
+               w[m_current + 3] == 'T' &&
+               w[m_current + 4] == 'Y'))) ||
+            (m_current + 6 <= m_length &&
+             memcmp(w + m_current + 2, "ATOR", 4) == 0) ||
+            (m_current + 7 <= m_length &&
+             memcmp(w + m_current + 2, "ATION", 5) == 0)) &&
+         (! (m_current + 4 <= m_length &&
+             ((w[m_current + 2] == 'A' &&
+               (w[m_current + 3] == 'C' || w[m_current + 3] == 'N')) ||
+              (w[m_current + 2] == 'I' && w[m_current + 3] == 'A') ||
+              (w[m_current + 2] == 'U' && w[m_current + 3] == 'M'))) ||
+          (m_current >= 3 &&
+           m_current + 5 <= m_length &&
+           memcmp(w + m_current - 3, "POIGNANT", 8) == 0) ||
+          (m_current >= 2 &&
+           m_current + 4 <= m_length &&
+           memcmp(w + m_current - 2, "COGNAC", 6) == 0)) &&
+         ! (m_length >= 7 &&
+            w[0] == 'S' &&
+            ((w[1] == 'P' && memcmp(w + 2, "IGNER", 5) == 0) ||
+             (w[1] == 'T' && memcmp(w + 2, "EGNER", 5) == 0))) &&
+         (m_length != 5 ||
+          ! (m_length >= 5 && memcmp(w + 0, "SIGNE", 5) == 0)) &&
+         ! ((m_current >= 2 &&
+             m_current + 3 <= m_length &&
+             ((w[m_current - 2] == 'D' &&
+               memcmp(w + m_current - 1, "IGNI", 4) == 0) ||
+              (w[m_current - 2] == 'L' &&
+               w[m_current - 1] == 'I' &&
+               w[m_current] == 'G' &&
+               w[m_current + 1] == 'N' &&
+               (w[m_current + 2] == 'I' || w[m_current + 2] == 'O')) ||
+              (w[m_current - 2] == 'R' &&
+               ((w[m_current - 1] == 'E' &&
+                 w[m_current] == 'G' &&
+                 w[m_current + 1] == 'N' &&
+                 (w[m_current + 2] == 'A' || w[m_current + 2] == 'E')) ||
+                (w[m_current - 1] == 'I' &&
+                 w[m_current] == 'G' &&
+                 w[m_current + 1] == 'N' &&
+                 w[m_current + 2] == 'E'))) ||
+              (w[m_current - 2] == 'T' &&
+               w[m_current - 1] == 'I' &&
+               w[m_current] == 'G' &&
+               w[m_current + 1] == 'N' &&
+               (w[m_current + 2] == 'E' || w[m_current + 2] == 'O')) ||
+              (w[m_current - 2] == 'W' &&
+               memcmp(w + m_current - 1, "EGNE", 4) == 0))) ||
+            (m_current >= 2 &&
+             m_current + 4 <= m_length &&
+             ((w[m_current - 2] == 'L' &&
+               memcmp(w + m_current - 1, "IGNEO", 5) == 0) ||
+              (w[m_current - 2] == 'S' &&
+               w[m_current - 1] == 'I' &&
+               w[m_current] == 'G' &&
+               w[m_current + 1] == 'N' &&
+               ((w[m_current + 2] == 'A' &&
+                 (w[m_current + 3] == 'L' || w[m_current + 3] == 'T')) ||
+                (w[m_current + 2] == 'E' && w[m_current + 3] == 'T') ||
+                (w[m_current + 2] == 'I' && w[m_current + 3] == 'F')))))) &&
+         ! (m_current >= 1 &&
+            m_current + 4 <= m_length &&
+            memcmp(w + m_current - 1, "IGNIT", 5) == 0)) ||
+        (m_current == m_last - 2 &&
+         m_current + 3 <= m_length &&
+         w[m_current] == 'G' &&
+         w[m_current + 1] == 'N' &&
+         (w[m_current + 2] == 'A' || w[m_current + 2] == 'E') &&
+         ! (m_current >= 2 &&
+            m_current + 3 <= m_length &&
+            ((w[m_current - 2] == 'M' &&
+              memcmp(w + m_current - 1, "AGNA", 4) == 0) ||
+             (w[m_current - 2] == 'S' &&
+              w[m_current - 1] == 'I' &&
+              w[m_current] == 'G' &&
+              w[m_current + 1] == 'N' &&
+              (w[m_current + 2] == 'A' || w[m_current + 2] == 'E'))))))
+    {
+      addExactApprox("N", "GN", "N", "KN");
+    }
+    else
+    {
+      addExactApprox("GN", "KN");
+    }
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_GL, Metaphone3Spec.txt line 490.
+bool Metaphone3::encode_GL()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 4 <= m_length &&
+      w[m_current + 1] == 'L' &&
+      w[m_current + 2] == 'I' &&
+      (w[m_current + 3] == 'A' ||
+       w[m_current + 3] == 'E' ||
+       w[m_current + 3] == 'O') &&
+      isVowel(m_current - 1))
+  {
+    addExactApprox("L", "GL", "L", "KL");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Initial_G_Front_Vowel, Metaphone3Spec.txt line 495.
+bool Metaphone3::encode_Initial_G_Front_Vowel()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current == 0 && front_Vowel(1))
+  {
+    if (m_length == 4 &&
+        m_length >= 4 &&
+        w[1] == 'I' &&
+        w[2] == 'L' &&
+        w[3] == 'A')
+    {
+      add("H");
+    }
+    else if (initial_G_Soft())
+    {
+      addExactApprox("J", "G", "J", "K");
+    }
+    else if (m_length >= 2 && (w[1] == 'E' || w[1] == 'I'))
+    {
+      addExactApprox("G", "J", "K", "J");
+    }
+    else
+    {
+      addExactApprox("G", "K");
+    }
+    advanceCounter(2, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_NGER, Metaphone3Spec.txt line 507.
+bool Metaphone3::encode_NGER()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current > 1 &&
+      m_current >= 1 &&
+      m_current + 3 <= m_length &&
+      memcmp(w + m_current - 1, "NGER", 4) == 0)
+  {
+    if (rootOrInflections(m_inWord, "ANGER") ||
+        rootOrInflections(m_inWord, "LINGER") ||
+        rootOrInflections(m_inWord, "MALINGER") ||
+        rootOrInflections(m_inWord, "FINGER") ||
+        (m_current >= 3 &&
+         m_current + 1 <= m_length &&
+         ((w[m_current - 3] == 'B' &&
+           ((w[m_current - 2] == 'A' &&
+             w[m_current - 1] == 'N' &&
+             w[m_current] == 'G') ||
+            (w[m_current - 2] == 'U' &&
+             w[m_current - 1] == 'N' &&
+             w[m_current] == 'G'))) ||
+          (w[m_current - 3] == 'C' &&
+           w[m_current - 2] == 'O' &&
+           w[m_current - 1] == 'N' &&
+           w[m_current] == 'G') ||
+          (w[m_current - 3] == 'D' &&
+           w[m_current - 2] == 'I' &&
+           w[m_current - 1] == 'N' &&
+           w[m_current] == 'G') ||
+          (w[m_current - 3] == 'F' &&
+           w[m_current - 2] == 'I' &&
+           w[m_current - 1] == 'N' &&
+           w[m_current] == 'G') ||
+          (w[m_current - 3] == 'G' &&
+           w[m_current - 2] == 'A' &&
+           w[m_current - 1] == 'N' &&
+           w[m_current] == 'G') ||
+          (w[m_current - 3] == 'H' &&
+           ((w[m_current - 2] == 'A' &&
+             w[m_current - 1] == 'N' &&
+             w[m_current] == 'G') ||
+            (w[m_current - 2] == 'U' &&
+             w[m_current - 1] == 'N' &&
+             w[m_current] == 'G'))) ||
+          (w[m_current - 3] == 'J' &&
+           w[m_current - 2] == 'U' &&
+           w[m_current - 1] == 'N' &&
+           w[m_current] == 'G') ||
+          (w[m_current - 3] == 'L' &&
+           ((w[m_current - 2] == 'A' &&
+             w[m_current - 1] == 'N' &&
+             w[m_current] == 'G') ||
+            (w[m_current - 2] == 'O' &&
+             w[m_current - 1] == 'N' &&
+             w[m_current] == 'G'))) ||
+          (w[m_current - 3] == 'M' &&
+           w[m_current - 2] == 'O' &&
+           w[m_current - 1] == 'N' &&
+           w[m_current] == 'G') ||
+          (w[m_current - 3] == 'P' &&
+           w[m_current - 2] == 'I' &&
+           w[m_current - 1] == 'N' &&
+           w[m_current] == 'G') ||
+          (w[m_current - 3] == 'R' &&
+           w[m_current - 2] == 'I' &&
+           w[m_current - 1] == 'N' &&
+           w[m_current] == 'G') ||
+          (w[m_current - 3] == 'S' &&
+           ((w[m_current - 2] == 'A' &&
+             w[m_current - 1] == 'N' &&
+             w[m_current] == 'G') ||
+            (w[m_current - 2] == 'I' &&
+             w[m_current - 1] == 'N' &&
+             w[m_current] == 'G'))) ||
+          (w[m_current - 3] == 'W' &&
+           ((w[m_current - 2] == 'A' &&
+             w[m_current - 1] == 'N' &&
+             w[m_current] == 'G') ||
+            (w[m_current - 2] == 'I' &&
+             w[m_current - 1] == 'N' &&
+             w[m_current] == 'G'))) ||
+          (w[m_current - 3] == 'Z' &&
+           ((w[m_current - 2] == 'A' &&
+             w[m_current - 1] == 'N' &&
+             w[m_current] == 'G') ||
+            (w[m_current - 2] == 'E' &&
+             w[m_current - 1] == 'N' &&
+             w[m_current] == 'G') ||
+            (w[m_current - 2] == 'I' &&
+             w[m_current - 1] == 'N' &&
+             w[m_current] == 'G')))) &&
+         ! ((m_current >= 6 &&
+             m_current + 1 <= m_length &&
+             ((w[m_current - 6] == 'B' &&
+               ((w[m_current - 5] == 'A' &&
+                 memcmp(w + m_current - 4, "RRING", 5) == 0) ||
+                (w[m_current - 5] == 'O' &&
+                 memcmp(w + m_current - 4, "ULANG", 5) == 0))) ||
+              (w[m_current - 6] == 'D' &&
+               memcmp(w + m_current - 5, "ERRING", 6) == 0) ||
+              (w[m_current - 6] == 'K' &&
+               memcmp(w + m_current - 5, "ISSING", 6) == 0) ||
+              (w[m_current - 6] == 'S' &&
+               memcmp(w + m_current - 5, "LESING", 6) == 0))) ||
+            (m_current >= 6 &&
+             m_current + 3 <= m_length &&
+             memcmp(w + m_current - 6, "PHALANGER", 9) == 0)) &&
+         ! (m_current >= 8 &&
+            m_current + 1 <= m_length &&
+            memcmp(w + m_current - 8, "SCHLESING", 9) == 0) &&
+         ! (m_current >= 5 &&
+            m_current + 1 <= m_length &&
+            ((w[m_current - 5] == 'B' &&
+              memcmp(w + m_current - 4, "ELANG", 5) == 0) ||
+             (w[m_current - 5] == 'S' &&
+              memcmp(w + m_current - 4, "ALING", 5) == 0))) &&
+         ! (m_current >= 4 &&
+            m_current + 1 <= m_length &&
+            memcmp(w + m_current - 4, "CHANG", 5) == 0)) ||
+        (m_current >= 4 &&
+         m_current + 1 <= m_length &&
+         ((w[m_current - 4] == 'S' &&
+           memcmp(w + m_current - 3, "TING", 4) == 0) ||
+          (w[m_current - 4] == 'Y' &&
+           memcmp(w + m_current - 3, "OUNG", 4) == 0))) ||
+        (m_current >= 4 &&
+         m_current + 3 <= m_length &&
+         ((w[m_current - 4] == 'C' &&
+           memcmp(w + m_current - 3, "LINGER", 6) == 0) ||
+          (w[m_current - 4] == 'F' &&
+           memcmp(w + m_current - 3, "LINGER", 6) == 0) ||
+          (w[m_current - 4] == 'K' &&
+           memcmp(w + m_current - 3, "LINGER", 6) == 0) ||
+          (w[m_current - 4] == 'S' &&
+           ((w[m_current - 3] == 'L' &&
+             memcmp(w + m_current - 2, "INGER", 5) == 0) ||
+            (w[m_current - 3] == 'T' &&
+             ((w[m_current - 2] == 'A' &&
+               memcmp(w + m_current - 1, "NGER", 4) == 0) ||
+              (w[m_current - 2] == 'E' &&
+               memcmp(w + m_current - 1, "NGER", 4) == 0))))))) ||
+        (m_current >= 5 &&
+         m_current + 1 <= m_length &&
+         memcmp(w + m_current - 5, "STRONG", 6) == 0) ||
+        (m_current >= 5 &&
+         m_current + 3 <= m_length &&
+         w[m_current - 5] == 'S' &&
+         w[m_current - 4] == 'P' &&
+         w[m_current - 3] == 'R' &&
+         ((w[m_current - 2] == 'E' &&
+           memcmp(w + m_current - 1, "NGER", 4) == 0) ||
+          (w[m_current - 2] == 'I' &&
+           memcmp(w + m_current - 1, "NGER", 4) == 0))) ||
+        (m_length >= 3 &&
+         ((w[0] == 'E' && w[1] == 'N' && w[2] == 'G') ||
+          (w[0] == 'I' && w[1] == 'N' && w[2] == 'G') ||
+          (w[0] == 'U' && w[1] == 'N' && w[2] == 'G'))) ||
+        (m_length >= 6 && memcmp(w + 0, "SENGER", 6) == 0) ||
+        (m_current + 6 <= m_length &&
+         memcmp(w + m_current, "GERICH", 6) == 0) ||
+        (m_current >= 3 &&
+         m_current + 3 <= m_length &&
+         ((w[m_current - 3] == 'K' &&
+           memcmp(w + m_current - 2, "INGER", 5) == 0) ||
+          (w[m_current - 3] == 'M' &&
+           memcmp(w + m_current - 2, "UNGER", 5) == 0) ||
+          (w[m_current - 3] == 'S' &&
+           memcmp(w + m_current - 2, "ONGER", 5) == 0) ||
+          (w[m_current - 3] == 'W' &&
+           memcmp(w + m_current - 2, "ENGER", 5) == 0))) ||
+        (m_current >= 3 &&
+         m_current + 4 <= m_length &&
+         memcmp(w + m_current - 3, "LINGERF", 7) == 0) ||
+        (m_current >= 2 &&
+         m_current + 5 <= m_length &&
+         ((w[m_current - 2] == 'A' &&
+           w[m_current - 1] == 'N' &&
+           w[m_current] == 'G' &&
+           w[m_current + 1] == 'E' &&
+           w[m_current + 2] == 'R' &&
+           ((w[m_current + 3] == 'B' && w[m_current + 4] == 'O') ||
+            (w[m_current + 3] == 'L' && w[m_current + 4] == 'Y'))) ||
+          (w[m_current - 2] == 'I' &&
+           memcmp(w + m_current - 1, "NGERSO", 6) == 0))))
+    {
+      addExactApprox("G", "J", "K", "J");
+    }
+    else
+    {
+      addExactApprox("J", "G", "J", "K");
+    }
+    advanceCounter(2, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_GER, Metaphone3Spec.txt line 528.
+bool Metaphone3::encode_GER()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current > 0 &&
+      m_current + 3 <= m_length &&
+      w[m_current + 1] == 'E' &&
+      w[m_current + 2] == 'R')
+  {
+    if (((m_current == 2 &&
+          isVowel(1) &&
+          ! isVowel(0) &&
+          ! (m_length >= 5 &&
+             ((w[0] == 'A' && memcmp(w + 1, "UGER", 4) == 0) ||
+              (w[0] == 'C' && memcmp(w + 1, "AGER", 4) == 0) ||
+              (w[0] == 'E' && memcmp(w + 1, "AGER", 4) == 0) ||
+              (w[0] == 'I' && memcmp(w + 1, "NGER", 4) == 0) ||
+              (w[0] == 'L' && memcmp(w + 1, "EGER", 4) == 0) ||
+              (w[0] == 'N' && memcmp(w + 1, "IGER", 4) == 0) ||
+              (w[0] == 'P' && memcmp(w + 1, "AGER", 4) == 0) ||
+              (w[0] == 'R' && memcmp(w + 1, "OGER", 4) == 0) ||
+              (w[0] == 'W' && memcmp(w + 1, "AGER", 4) == 0) ||
+              (w[0] == 'Y' && memcmp(w + 1, "AGER", 4) == 0)))) ||
+         (m_current >= 2 &&
+          m_current + 3 <= m_length &&
+          ((w[m_current - 2] == 'A' &&
+            memcmp(w + m_current - 1, "UGER", 4) == 0) ||
+           (w[m_current - 2] == 'E' &&
+            memcmp(w + m_current - 1, "AGER", 4) == 0) ||
+           (w[m_current - 2] == 'I' &&
+            memcmp(w + m_current - 1, "NGER", 4) == 0) ||
+           (w[m_current - 2] == 'Y' &&
+            memcmp(w + m_current - 1, "AGER", 4) == 0))) ||
+         (m_current >= 3 &&
+          m_current + 3 <= m_length &&
+          ((w[m_current - 3] == 'B' &&
+            ((w[m_current - 2] == 'E' &&
+              memcmp(w + m_current - 1, "RGER", 4) == 0) ||
+             (w[m_current - 2] == 'U' &&
+              memcmp(w + m_current - 1, "RGER", 4) == 0))) ||
+           (w[m_current - 3] == 'C' &&
+            ((w[m_current - 2] == 'O' &&
+              memcmp(w + m_current - 1, "WGER", 4) == 0) ||
+             (w[m_current - 2] == 'R' &&
+              memcmp(w + m_current - 1, "EGER", 4) == 0))) ||
+           (w[m_current - 3] == 'F' &&
+            memcmp(w + m_current - 2, "ERGER", 5) == 0) ||
+           (w[m_current - 3] == 'G' &&
+            ((w[m_current - 2] == 'E' &&
+              memcmp(w + m_current - 1, "IGER", 4) == 0) ||
+             (w[m_current - 2] == 'R' &&
+              memcmp(w + m_current - 1, "AGER", 4) == 0))) ||
+           (w[m_current - 3] == 'H' &&
+            memcmp(w + m_current - 2, "ILGER", 5) == 0) ||
+           (w[m_current - 3] == 'J' &&
+            memcmp(w + m_current - 2, "AEGER", 5) == 0) ||
+           (w[m_current - 3] == 'K' &&
+            w[m_current - 2] == 'R' &&
+            ((w[m_current - 1] == 'E' &&
+              w[m_current] == 'G' &&
+              w[m_current + 1] == 'E' &&
+              w[m_current + 2] == 'R') ||
+             (w[m_current - 1] == 'O' &&
+              w[m_current] == 'G' &&
+              w[m_current + 1] == 'E' &&
+              w[m_current + 2] == 'R') ||
+             (w[m_current - 1] == 'U' &&
+              w[m_current] == 'G' &&
+              w[m_current + 1] == 'E' &&
+              w[m_current + 2] == 'R'))) ||
+           (w[m_current - 3] == 'M' &&
+            ((w[m_current - 2] == 'A' &&
+              memcmp(w + m_current - 1, "RGER", 4) == 0) ||
+             (w[m_current - 2] == 'E' &&
+              memcmp(w + m_current - 1, "AGER", 4) == 0))) ||
+           (w[m_current - 3] == 'P' &&
+            memcmp(w + m_current - 2, "RAGER", 5) == 0) ||
+           (w[m_current - 3] == 'R' &&
+            memcmp(w + m_current - 2, "IEGER", 5) == 0) ||
+           (w[m_current - 3] == 'S' &&
+            ((w[m_current - 2] == 'A' &&
+              memcmp(w + m_current - 1, "UGER", 4) == 0) ||
+             (w[m_current - 2] == 'E' &&
+              memcmp(w + m_current - 1, "EGER", 4) == 0) ||
+             (w[m_current - 2] == 'T' &&
+              ((w[m_current - 1] == 'E' &&
+                w[m_current] == 'G' &&
+                w[m_current + 1] == 'E' &&
+                w[m_current + 2] == 'R') ||
+               (w[m_current - 1] == 'I' &&
+                w[m_current] == 'G' &&
+                w[m_current + 1] == 'E' &&
+                w[m_current + 2] == 'R'))) ||
+             (w[m_current - 2] == 'W' &&
+              memcmp(w + m_current - 1, "IGER", 4) == 0))) ||
+           (w[m_current - 3] == 'T' &&
+            memcmp(w + m_current - 2, "ORGER", 5) == 0) ||
+           (w[m_current - 3] == 'Y' &&
+            ((w[m_current - 2] == 'A' &&
+              ((w[m_current - 1] == 'E' &&
+                w[m_current] == 'G' &&
+                w[m_current + 1] == 'E' &&
+                w[m_current + 2] == 'R') ||
+               (w[m_current - 1] == 'R' &&
+                w[m_current] == 'G' &&
+                w[m_current + 1] == 'E' &&
+                w[m_current + 2] == 'R'))) ||
+             (w[m_current - 2] == 'E' &&
+              memcmp(w + m_current - 1, "RGER", 4) == 0))) ||
+           (w[m_current - 3] == 'Z' &&
+            memcmp(w + m_current - 2, "EIGER", 5) == 0))) ||
+         (m_current == m_last - 2 &&
+          m_current >= 3 &&
+          m_current + 3 <= m_length &&
+          memcmp(w + m_current - 3, "BERGER", 6) == 0) ||
+         (m_current >= 4 &&
+          m_current + 3 <= m_length &&
+          ((w[m_current - 4] == 'B' &&
+            ((w[m_current - 3] == 'O' &&
+              memcmp(w + m_current - 2, "ERGER", 5) == 0) ||
+             (w[m_current - 3] == 'U' &&
+              memcmp(w + m_current - 2, "ERGER", 5) == 0))) ||
+           (w[m_current - 4] == 'D' &&
+            memcmp(w + m_current - 3, "RAEGER", 6) == 0) ||
+           (w[m_current - 4] == 'F' &&
+            memcmp(w + m_current - 3, "IBIGER", 6) == 0) ||
+           (w[m_current - 4] == 'K' &&
+            w[m_current - 3] == 'R' &&
+            ((w[m_current - 2] == 'E' &&
+              memcmp(w + m_current - 1, "IGER", 4) == 0) ||
+             (w[m_current - 2] == 'I' &&
+              memcmp(w + m_current - 1, "EGER", 4) == 0) ||
+             (w[m_current - 2] == 'O' &&
+              memcmp(w + m_current - 1, "EGER", 4) == 0) ||
+             (w[m_current - 2] == 'U' &&
+              memcmp(w + m_current - 1, "EGER", 4) == 0))) ||
+           (w[m_current - 4] == 'M' &&
+            memcmp(w + m_current - 3, "ETZGER", 6) == 0) ||
+           (w[m_current - 4] == 'S' &&
+            memcmp(w + m_current - 3, "TEIGER", 6) == 0))) ||
+         (m_current > 4 &&
+          m_current >= 3 &&
+          m_current + 3 <= m_length &&
+          memcmp(w + m_current - 3, "BARGER", 6) == 0) ||
+         (m_current > 0 &&
+          m_current + 6 <= m_length &&
+          memcmp(w + m_current, "GERBER", 6) == 0) ||
+         (m_current >= 5 &&
+          m_current + 3 <= m_length &&
+          ((w[m_current - 5] == 'G' &&
+            memcmp(w + m_current - 4, "ALLAGER", 7) == 0) ||
+           (w[m_current - 5] == 'L' &&
+            memcmp(w + m_current - 4, "YBARGER", 7) == 0) ||
+           (w[m_current - 5] == 'S' &&
+            ((w[m_current - 4] == 'C' &&
+              memcmp(w + m_current - 3, "HWAGER", 6) == 0) ||
+             (w[m_current - 4] == 'P' &&
+              memcmp(w + m_current - 3, "RENGER", 6) == 0))) ||
+           (w[m_current - 5] == 'W' &&
+            memcmp(w + m_current - 4, "ILLIGER", 7) == 0))) ||
+         (m_length == 4 &&
+          m_length >= 4 &&
+          ((w[0] == 'A' && w[1] == 'G' && w[2] == 'E' && w[3] == 'R') ||
+           (w[0] == 'E' && w[1] == 'G' && w[2] == 'E' && w[3] == 'R'))) ||
+         (m_current >= 1 &&
+          m_current + 5 <= m_length &&
+          memcmp(w + m_current - 1, "YGERNE", 6) == 0) ||
+         (m_current >= 6 &&
+          m_current + 3 <= m_length &&
+          memcmp(w + m_current - 6, "SCHWEIGER", 9) == 0)) &&
+        ! (m_current >= 5 &&
+           m_current + 5 <= m_length &&
+           memcmp(w + m_current - 5, "BELLIGEREN", 10) == 0) &&
+        ! (m_length >= 7 && memcmp(w + 0, "MARGERY", 7) == 0) &&
+        ! (m_current >= 3 &&
+           m_current + 5 <= m_length &&
+           memcmp(w + m_current - 3, "BERGERAC", 8) == 0))
+    {
+      if (slavoGermanic())
+      {
+        addExactApprox("G", "K");
+      }
+      else
+      {
+        addExactApprox("G", "J", "K", "J");
+      }
+    }
+    else
+    {
+      addExactApprox("J", "G", "J", "K");
+    }
+    advanceCounter(2, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_GEL, Metaphone3Spec.txt line 557.
+bool Metaphone3::encode_GEL()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current > 0 &&
+      m_current + 3 <= m_length &&
+      w[m_current + 1] == 'E' &&
+      w[m_current + 2] == 'L')
+  {
+    if ((m_length == 5 &&
+         isVowel(m_current - 1) &&
+         ! isVowel(m_current - 2) &&
+         ! (m_current >= 2 &&
+            m_current + 3 <= m_length &&
+            ((w[m_current - 2] == 'N' &&
+              memcmp(w + m_current - 1, "IGEL", 4) == 0) ||
+             (w[m_current - 2] == 'R' &&
+              memcmp(w + m_current - 1, "IGEL", 4) == 0)))) ||
+        (m_current >= 2 &&
+         m_current + 3 <= m_length &&
+         ((w[m_current - 2] == 'E' &&
+           memcmp(w + m_current - 1, "NGEL", 4) == 0) ||
+          (w[m_current - 2] == 'H' &&
+           memcmp(w + m_current - 1, "EGEL", 4) == 0) ||
+          (w[m_current - 2] == 'N' &&
+           memcmp(w + m_current - 1, "AGEL", 4) == 0) ||
+          (w[m_current - 2] == 'V' &&
+           memcmp(w + m_current - 1, "OGEL", 4) == 0))) ||
+        (m_current >= 3 &&
+         m_current + 3 <= m_length &&
+         ((w[m_current - 3] == 'F' &&
+           memcmp(w + m_current - 2, "LUGEL", 5) == 0) ||
+          (w[m_current - 3] == 'H' &&
+           memcmp(w + m_current - 2, "AUGEN", 5) == 0) ||
+          (w[m_current - 3] == 'M' &&
+           memcmp(w + m_current - 2, "ANGEL", 5) == 0) ||
+          (w[m_current - 3] == 'R' &&
+           ((w[m_current - 2] == 'A' &&
+             memcmp(w + m_current - 1, "NGEL", 4) == 0) ||
+            (w[m_current - 2] == 'I' &&
+             memcmp(w + m_current - 1, "EGEL", 4) == 0))) ||
+          (w[m_current - 3] == 'V' &&
+           memcmp(w + m_current - 2, "OEGEL", 5) == 0) ||
+          (w[m_current - 3] == 'W' &&
+           memcmp(w + m_current - 2, "EIGEL", 5) == 0))) ||
+        (m_current >= 4 &&
+         m_current + 3 <= m_length &&
+         ((w[m_current - 4] == 'S' &&
+           ((w[m_current - 3] == 'P' &&
+             ((w[m_current - 2] == 'E' &&
+               memcmp(w + m_current - 1, "IGEL", 4) == 0) ||
+              (w[m_current - 2] == 'I' &&
+               memcmp(w + m_current - 1, "EGEL", 4) == 0))) ||
+            (w[m_current - 3] == 'T' &&
+             memcmp(w + m_current - 2, "EIGEL", 5) == 0))) ||
+          (w[m_current - 4] == 'W' &&
+           memcmp(w + m_current - 3, "RANGEL", 6) == 0))) ||
+        (m_current >= 4 &&
+         m_current + 4 <= m_length &&
+         memcmp(w + m_current - 4, "DANEGELD", 8) == 0))
+    {
+      if (slavoGermanic())
+      {
+        addExactApprox("G", "K");
+      }
+      else
+      {
+        addExactApprox("G", "J", "K", "J");
+      }
+    }
+    else
+    {
+      addExactApprox("J", "G", "J", "K");
+    }
+    advanceCounter(2, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Non_Initial_G_Front_Vowel, Metaphone3Spec.txt line 571.
+bool Metaphone3::encode_Non_Initial_G_Front_Vowel()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length &&
+      (w[m_current + 1] == 'E' ||
+       w[m_current + 1] == 'I' ||
+       w[m_current + 1] == 'Y'))
+  {
+    if (m_current == m_last - 1 &&
+        m_current + 2 <= m_length &&
+        w[m_current] == 'G' &&
+        w[m_current + 1] == 'E')
+    {
+      if (! hard_GE_At_End())
+      {
+        add("J");
+      }
+      else if (slavoGermanic())
+      {
+        addExactApprox("G", "K");
+      }
+      else
+      {
+        addExactApprox("G", "J", "K", "J");
+      }
+    }
+    else if (! internal_Hard_G())
+    {
+      addExactApprox("J", "G", "J", "K");
+    }
+    else if (! (m_current == 2 &&
+                m_length >= 2 &&
+                w[0] == 'M' &&
+                w[1] == 'C') ||
+             (m_current == 3 &&
+              m_length >= 3 &&
+              w[0] == 'M' &&
+              w[1] == 'A' &&
+              w[2] == 'C'))
+    {
+      if (slavoGermanic())
+      {
+        addExactApprox("G", "K");
+      }
+      else
+      {
+        addExactApprox("G", "J", "K", "J");
+      }
+    }
+    advanceCounter(2, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_GA_To_J, Metaphone3Spec.txt line 589.
+bool Metaphone3::encode_GA_To_J()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current >= 3 &&
+       m_current + 4 <= m_length &&
+       w[m_current - 3] == 'M' &&
+       w[m_current - 2] == 'A' &&
+       w[m_current - 1] == 'R' &&
+       w[m_current] == 'G' &&
+       w[m_current + 1] == 'A' &&
+       w[m_current + 2] == 'R' &&
+       (w[m_current + 3] == 'I' || w[m_current + 3] == 'Y') &&
+       ! (m_current >= 3 &&
+          m_current + 5 <= m_length &&
+          memcmp(w + m_current - 3, "MARGARIT", 8) == 0)) ||
+      (m_length >= 4 && memcmp(w + 0, "GAOL", 4) == 0) ||
+      (m_current >= 2 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 2, "ALGAE", 5) == 0))
+  {
+    addExactApprox("J", "G", "J", "K");
+    advanceCounter(2, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Initial_Silent_H, Metaphone3Spec.txt line 599.
+bool Metaphone3::encode_Initial_Silent_H()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current + 4 <= m_length &&
+       ((w[m_current + 1] == 'E' &&
+         ((w[m_current + 2] == 'I' && w[m_current + 3] == 'R') ||
+          (w[m_current + 2] == 'R' && w[m_current + 3] == 'B'))) ||
+        (w[m_current + 1] == 'O' &&
+         w[m_current + 2] == 'U' &&
+         w[m_current + 3] == 'R'))) ||
+      (m_current + 5 <= m_length &&
+       memcmp(w + m_current + 1, "ONOR", 4) == 0) ||
+      (m_current + 6 <= m_length &&
+       w[m_current + 1] == 'O' &&
+       w[m_current + 2] == 'N' &&
+       ((w[m_current + 3] == 'E' &&
+         w[m_current + 4] == 'S' &&
+         w[m_current + 5] == 'T') ||
+        (w[m_current + 3] == 'O' &&
+         w[m_current + 4] == 'U' &&
+         w[m_current + 5] == 'R'))))
+  {
+    if (m_current == 0 && m_length >= 4 && memcmp(w + 0, "HERB", 4) == 0)
+    {
+      add(m_encodeVowels ? "HA" : "H",
+        "A");
+    }
+    else if (m_current == 0 || m_encodeVowels)
+    {
+      add("A");
+    }
+    m_current++;
+    m_current = skipVowels(m_current);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Initial_HS, Metaphone3Spec.txt line 608.
+bool Metaphone3::encode_Initial_HS()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current == 0 && m_length >= 2 && w[0] == 'H' && w[1] == 'S')
+  {
+    add("X");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Non_Initial_Silent_H, Metaphone3Spec.txt line 613.
+bool Metaphone3::encode_Non_Initial_Silent_H()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current >= 2 &&
+       m_current + 3 <= m_length &&
+       ((w[m_current - 2] == 'C' &&
+         memcmp(w + m_current - 1, "OHEN", 4) == 0) ||
+        (w[m_current - 2] == 'G' &&
+         memcmp(w + m_current - 1, "AHAN", 4) == 0) ||
+        (w[m_current - 2] == 'L' &&
+         memcmp(w + m_current - 1, "OHEN", 4) == 0) ||
+        (w[m_current - 2] == 'M' &&
+         w[m_current - 1] == 'A' &&
+         w[m_current] == 'H' &&
+         ((w[m_current + 1] == 'A' && w[m_current + 2] == 'N') ||
+          (w[m_current + 1] == 'O' && w[m_current + 2] == 'N'))) ||
+        (w[m_current - 2] == 'N' &&
+         ((w[m_current - 1] == 'E' &&
+           w[m_current] == 'H' &&
+           w[m_current + 1] == 'E' &&
+           w[m_current + 2] == 'M') ||
+          (w[m_current - 1] == 'I' &&
+           w[m_current] == 'H' &&
+           w[m_current + 1] == 'I' &&
+           w[m_current + 2] == 'L'))) ||
+        (w[m_current - 2] == 'V' &&
+         memcmp(w + m_current - 1, "EHEM", 4) == 0))) ||
+      (m_current >= 3 &&
+       m_current + 2 <= m_length &&
+       memcmp(w + m_current - 3, "TOUHY", 5) == 0) ||
+      (m_current >= 3 &&
+       m_current + 3 <= m_length &&
+       ((w[m_current - 3] == 'F' &&
+         memcmp(w + m_current - 2, "RAHER", 5) == 0) ||
+        (w[m_current - 3] == 'G' &&
+         memcmp(w + m_current - 2, "RAHAM", 5) == 0) ||
+        (w[m_current - 3] == 'P' &&
+         memcmp(w + m_current - 2, "ROHIB", 5) == 0) ||
+        (w[m_current - 3] == 'T' &&
+         w[m_current - 2] == 'O' &&
+         ((w[m_current - 1] == 'O' &&
+           w[m_current] == 'H' &&
+           w[m_current + 1] == 'E' &&
+           w[m_current + 2] == 'Y') ||
+          (w[m_current - 1] == 'U' &&
+           w[m_current] == 'H' &&
+           w[m_current + 1] == 'E' &&
+           w[m_current + 2] == 'Y'))))) ||
+      (m_length >= 9 && memcmp(w + 0, "CHIHUAHUA", 9) == 0))
+  {
+    if (m_encodeVowels)
+    {
+      m_current++;
+      m_current = skipVowels(m_current);
+    }
+    else
+    {
+      m_current += 2;
+    }
+    return true;
+  }
+  return false;
+}
+
+
+// encode_H_Pronounced, Metaphone3Spec.txt line 623.
+bool Metaphone3::encode_H_Pronounced()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((isVowel(m_current + 1) &&
+       (m_current == 0 ||
+        isVowel(m_current - 1) ||
+        (m_current >= 1 &&
+         m_current <= m_length &&
+         w[m_current - 1] == 'W'))) ||
+      (m_current + 2 <= m_length &&
+       w[m_current + 1] == 'H' &&
+       isVowel(m_current + 2)))
+  {
+    add("H");
+    advanceCounter(2, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Spanish_J, Metaphone3Spec.txt line 632.
+bool Metaphone3::encode_Spanish_J()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current + 4 <= m_length &&
+       ((w[m_current + 1] == 'A' &&
+         ((w[m_current + 2] == 'C' && w[m_current + 3] == 'I') ||
+          (w[m_current + 2] == 'L' && w[m_current + 3] == 'I'))) ||
+        (w[m_current + 1] == 'E' &&
+         w[m_current + 2] == 'F' &&
+         w[m_current + 3] == 'E') ||
+        (w[m_current + 1] == 'I' &&
+         ((w[m_current + 2] == 'C' && w[m_current + 3] == 'A') ||
+          (w[m_current + 2] == 'M' && w[m_current + 3] == 'E'))) ||
+        (w[m_current + 1] == 'O' &&
+         w[m_current + 2] == 'A' &&
+         w[m_current + 3] == 'Q') ||
+        (w[m_current + 1] == 'U' &&
+         w[m_current + 2] == 'A' &&
+         (w[m_current + 3] == 'N' || w[m_current + 3] == 'R'))) &&
+       ! (m_current + 8 <= m_length &&
+          w[m_current] == 'J' &&
+          w[m_current + 1] == 'I' &&
+          w[m_current + 2] == 'M' &&
+          w[m_current + 3] == 'E' &&
+          w[m_current + 4] == 'R' &&
+          w[m_current + 5] == 'S' &&
+          ((w[m_current + 6] == 'E' && w[m_current + 7] == 'N') ||
+           (w[m_current + 6] == 'O' && w[m_current + 7] == 'N')))) ||
+      (m_current == m_last - 3 &&
+       m_current + 4 <= m_length &&
+       w[m_current + 1] == 'O' &&
+       w[m_current + 2] == 'S' &&
+       w[m_current + 3] == 'E') ||
+      (m_current + 5 <= m_length &&
+       ((w[m_current + 1] == 'A' &&
+         ((w[m_current + 2] == 'I' &&
+           w[m_current + 3] == 'M' &&
+           w[m_current + 4] == 'E') ||
+          (w[m_current + 2] == 'V' &&
+           w[m_current + 3] == 'I' &&
+           (w[m_current + 4] == 'A' || w[m_current + 4] == 'E')))) ||
+        (w[m_current + 1] == 'E' &&
+         w[m_current + 2] == 'R' &&
+         w[m_current + 3] == 'E' &&
+         w[m_current + 4] == 'Z') ||
+        (w[m_current + 1] == 'U' &&
+         w[m_current + 2] == 'N' &&
+         w[m_current + 3] == 'T' &&
+         w[m_current + 4] == 'A'))) ||
+      (m_current + 7 <= m_length &&
+       ((w[m_current + 1] == 'A' &&
+         memcmp(w + m_current + 2, "RAMIL", 5) == 0) ||
+        (w[m_current + 1] == 'I' &&
+         memcmp(w + m_current + 2, "MINEZ", 5) == 0))) ||
+      (m_current == m_last - 2 &&
+       m_current >= 2 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 2, "MEJIA", 5) == 0) ||
+      (m_current >= 2 &&
+       m_current + 3 <= m_length &&
+       ((w[m_current - 2] == 'B' &&
+         ((w[m_current - 1] == 'E' &&
+           w[m_current] == 'J' &&
+           w[m_current + 1] == 'A' &&
+           w[m_current + 2] == 'R') ||
+          (w[m_current - 1] == 'O' &&
+           w[m_current] == 'J' &&
+           w[m_current + 1] == 'O' &&
+           w[m_current + 2] == 'R'))) ||
+        (w[m_current - 2] == 'C' &&
+         memcmp(w + m_current - 1, "AJIG", 4) == 0) ||
+        (w[m_current - 2] == 'D' &&
+         ((w[m_current - 1] == 'E' &&
+           w[m_current] == 'J' &&
+           w[m_current + 1] == 'A' &&
+           w[m_current + 2] == 'S') ||
+          (w[m_current - 1] == 'U' &&
+           w[m_current] == 'J' &&
+           w[m_current + 1] == 'A' &&
+           (w[m_current + 2] == 'N' || w[m_current + 2] == 'R')))) ||
+        (w[m_current - 2] == 'F' &&
+         memcmp(w + m_current - 1, "AJAR", 4) == 0) ||
+        (w[m_current - 2] == 'L' &&
+         memcmp(w + m_current - 1, "UJAN", 4) == 0) ||
+        (w[m_current - 2] == 'M' &&
+         ((w[m_current - 1] == 'E' &&
+           w[m_current] == 'J' &&
+           w[m_current + 1] == 'O' &&
+           w[m_current + 2] == 'R') ||
+          (w[m_current - 1] == 'I' &&
+           w[m_current] == 'J' &&
+           w[m_current + 1] == 'A' &&
+           w[m_current + 2] == 'R'))) ||
+        (w[m_current - 2] == 'N' &&
+         ((w[m_current - 1] == 'A' &&
+           w[m_current] == 'J' &&
+           w[m_current + 1] == 'A' &&
+           w[m_current + 2] == 'R') ||
+          (w[m_current - 1] == 'O' &&
+           w[m_current] == 'J' &&
+           w[m_current + 1] == 'O' &&
+           w[m_current + 2] == 'S'))) ||
+        (w[m_current - 2] == 'R' &&
+         ((w[m_current - 1] == 'A' &&
+           w[m_current] == 'J' &&
+           w[m_current + 1] == 'E' &&
+           w[m_current + 2] == 'D') ||
+          (w[m_current - 1] == 'E' &&
+           w[m_current] == 'J' &&
+           w[m_current + 1] == 'O' &&
+           w[m_current + 2] == 'N') ||
+          (w[m_current - 1] == 'I' &&
+           w[m_current] == 'J' &&
+           w[m_current + 1] == 'A' &&
+           w[m_current + 2] == 'L'))) ||
+        (w[m_current - 2] == 'T' &&
+         w[m_current - 1] == 'E' &&
+         w[m_current] == 'J' &&
+         ((w[m_current + 1] == 'A' &&
+           (w[m_current + 2] == 'D' || w[m_current + 2] == 'N')) ||
+          (w[m_current + 1] == 'E' && w[m_current + 2] == 'D'))) ||
+        (w[m_current - 2] == 'U' &&
+         memcmp(w + m_current - 1, "IJAN", 4) == 0))) ||
+      (m_current >= 3 &&
+       m_current + 5 <= m_length &&
+       ((w[m_current - 3] == 'A' &&
+         memcmp(w + m_current - 2, "LEJANDR", 7) == 0) ||
+        (w[m_current - 3] == 'G' &&
+         memcmp(w + m_current - 2, "UAJARDO", 7) == 0) ||
+        (w[m_current - 3] == 'T' &&
+         memcmp(w + m_current - 2, "RUJILLO", 7) == 0))) ||
+      (m_current > 2 &&
+       m_current >= 2 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 2, "RAJAS", 5) == 0) ||
+      (m_current >= 2 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 2, "MEJIA", 5) == 0 &&
+       ! (m_current >= 2 &&
+          m_current + 4 <= m_length &&
+          memcmp(w + m_current - 2, "MEJIAN", 6) == 0)) ||
+      (m_current >= 1 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 1, "OJEDA", 5) == 0) ||
+      (m_current >= 3 &&
+       m_current + 2 <= m_length &&
+       ((w[m_current - 3] == 'L' &&
+         memcmp(w + m_current - 2, "EIJA", 4) == 0) ||
+        (w[m_current - 3] == 'M' &&
+         memcmp(w + m_current - 2, "INJA", 4) == 0))) ||
+      (m_current >= 3 &&
+       m_current + 3 <= m_length &&
+       ((w[m_current - 3] == 'G' &&
+         memcmp(w + m_current - 2, "RAJAL", 5) == 0) ||
+        (w[m_current - 3] == 'V' &&
+         memcmp(w + m_current - 2, "IAJES", 5) == 0))) ||
+      (m_current + 8 <= m_length &&
+       memcmp(w + m_current, "JAUREGUI", 8) == 0) ||
+      (m_current >= 4 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 4, "HINOJOSA", 8) == 0) ||
+      (m_length >= 4 && memcmp(w + 0, "SAN ", 4) == 0) ||
+      (m_current == m_last - 1 &&
+       m_current + 2 <= m_length &&
+       w[m_current + 1] == 'O' &&
+       ! ((m_length >= 4 && memcmp(w + 0, "TOJO", 4) == 0) ||
+          (m_length >= 5 && memcmp(w + 0, "BANJO", 5) == 0) ||
+          (m_length >= 6 && memcmp(w + 0, "MARYJO", 6) == 0))))
+  {
+    if (! (m_current + 4 <= m_length &&
+           w[m_current] == 'J' &&
+           ((w[m_current + 1] == 'O' &&
+             w[m_current + 2] == 'A' &&
+             w[m_current + 3] == 'Q') ||
+            (w[m_current + 1] == 'U' &&
+             w[m_current + 2] == 'A' &&
+             w[m_current + 3] == 'N'))))
+    {
+      add("H");
+    }
+    else if (m_current == 0)
+    {
+      add("A");
+    }
+    advanceCounter(2, 1);
+    return true;
+  }
+
+  if (m_current + 5 <= m_length &&
+      ((w[m_current + 1] == 'E' &&
+        w[m_current + 2] == 'S' &&
+        w[m_current + 3] == 'U' &&
+        w[m_current + 4] == 'S') ||
+       (w[m_current + 1] == 'O' &&
+        w[m_current + 2] == 'R' &&
+        w[m_current + 3] == 'G' &&
+        w[m_current + 4] == 'E') ||
+       (w[m_current + 1] == 'U' &&
+        w[m_current + 2] == 'L' &&
+        w[m_current + 3] == 'I' &&
+        w[m_current + 4] == 'O')) &&
+      ! (m_length >= 6 && memcmp(w + 0, "JORGEN", 6) == 0))
+  {
+    if (m_current == m_last - 4 &&
+        m_current + 5 <= m_length &&
+        memcmp(w + m_current + 1, "ORGE", 4) == 0)
+    {
+      add(m_encodeVowels ? "JARJ" : "JRJ",
+        m_encodeVowels ? "HARHA" : "HRH");
+      m_current += 5;
+    }
+    else
+    {
+      add("J", "H");
+      advanceCounter(2, 1);
+    }
+    return true;
+  }
+  return false;
+}
+
+
+// encode_German_J, Metaphone3Spec.txt line 662.
+bool Metaphone3::encode_German_J()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current + 3 <= m_length &&
+       w[m_current + 1] == 'A' &&
+       w[m_current + 2] == 'H') ||
+      (m_current == m_last - 5 &&
+       m_current + 6 <= m_length &&
+       memcmp(w + m_current + 1, "OHANN", 5) == 0) ||
+      (m_current + 4 <= m_length &&
+       w[m_current + 1] == 'U' &&
+       w[m_current + 2] == 'N' &&
+       w[m_current + 3] == 'G' &&
+       ! (m_current + 5 <= m_length &&
+          memcmp(w + m_current + 1, "UNGL", 4) == 0)) ||
+      (m_current + 4 <= m_length &&
+       w[m_current + 1] == 'U' &&
+       w[m_current + 2] == 'G' &&
+       w[m_current + 3] == 'O'))
+  {
+    add("A");
+    advanceCounter(2, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Spanish_OJ_UJ, Metaphone3Spec.txt line 670.
+bool Metaphone3::encode_Spanish_OJ_UJ()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current + 5 <= m_length &&
+       memcmp(w + m_current + 1, "UJUY", 4) == 0) ||
+      (m_current + 6 <= m_length &&
+       memcmp(w + m_current + 1, "OJOBA", 5) == 0))
+  {
+    if (m_encodeVowels)
+    {
+      add("HAH");
+      m_current += 3;
+    }
+    else
+    {
+      add("HH");
+      m_current += 4;
+    }
+    return true;
+  }
+  return false;
+}
+
+
+// encode_J_To_J, Metaphone3Spec.txt line 679.
+bool Metaphone3::encode_J_To_J()
+{
+
+  if (isVowel(m_current + 1))
+  {
+    if (m_current == 0 && names_Beginning_With_J_That_Get_Alt_Y())
+    {
+      add(m_encodeVowels ? "JA" : "J",
+        "A");
+    }
+    else
+    {
+      add(m_encodeVowels ? "JA" : "J");
+    }
+    m_current++;
+    m_current = skipVowels(m_current);
+    return false;
+  }
+
+  if (! isVowel(m_current + 1))
+  {
+    add("J");
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Spanish_J_2, Metaphone3Spec.txt line 692.
+bool Metaphone3::encode_Spanish_J_2()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current == 2 &&
+       m_length >= 4 &&
+       ((w[0] == 'B' &&
+         ((w[1] == 'A' && w[2] == 'J' && w[3] == 'A') ||
+          (w[1] == 'E' && w[2] == 'J' && w[3] == 'A') ||
+          (w[1] == 'O' && w[2] == 'J' && (w[3] == 'A' || w[3] == 'O')))) ||
+        (w[0] == 'M' &&
+         ((w[1] == 'E' && w[2] == 'J' && w[3] == 'I') ||
+          (w[1] == 'O' && w[2] == 'J' && (w[3] == 'A' || w[3] == 'I')))))) ||
+      (m_current == 3 &&
+       m_length >= 5 &&
+       ((w[0] == 'B' &&
+         w[1] == 'R' &&
+         w[2] == 'U' &&
+         w[3] == 'J' &&
+         (w[4] == 'A' || w[4] == 'O')) ||
+        (w[0] == 'F' && memcmp(w + 1, "RIJO", 4) == 0) ||
+        (w[0] == 'G' &&
+         w[1] == 'R' &&
+         ((w[2] == 'A' && w[3] == 'J' && w[4] == 'E') ||
+          (w[2] == 'I' && w[3] == 'J' && w[4] == 'A'))) ||
+        (w[0] == 'L' && memcmp(w + 1, "EIJA", 4) == 0) ||
+        (w[0] == 'Q' && memcmp(w + 1, "UIJA", 4) == 0))) ||
+      (m_current == m_last - 3 &&
+       m_current >= 1 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 1, "AJARA", 5) == 0) ||
+      (m_current == m_last - 2 &&
+       m_current >= 1 &&
+       m_current + 3 <= m_length &&
+       ((w[m_current - 1] == 'A' &&
+         w[m_current] == 'J' &&
+         ((w[m_current + 1] == 'A' && w[m_current + 2] == 'L') ||
+          (w[m_current + 1] == 'O' &&
+           (w[m_current + 2] == 'S' || w[m_current + 2] == 'Z')))) ||
+        (w[m_current - 1] == 'E' &&
+         w[m_current] == 'J' &&
+         ((w[m_current + 1] == 'A' && w[m_current + 2] == 'N') ||
+          (w[m_current + 1] == 'O' &&
+           (w[m_current + 2] == 'N' || w[m_current + 2] == 'S')))) ||
+        (w[m_current - 1] == 'O' &&
+         w[m_current] == 'J' &&
+         ((w[m_current + 1] == 'A' && w[m_current + 2] == 'S') ||
+          (w[m_current + 1] == 'O' && w[m_current + 2] == 'S'))) ||
+        (w[m_current - 1] == 'U' &&
+         w[m_current] == 'J' &&
+         ((w[m_current + 1] == 'A' && w[m_current + 2] == 'R') ||
+          (w[m_current + 1] == 'O' && w[m_current + 2] == 'N'))))) ||
+      (m_current == m_last - 1 &&
+       m_current >= 1 &&
+       m_current + 2 <= m_length &&
+       ((w[m_current - 1] == 'E' &&
+         w[m_current] == 'J' &&
+         w[m_current + 1] == 'A') ||
+        (w[m_current - 1] == 'O' &&
+         w[m_current] == 'J' &&
+         w[m_current + 1] == 'A')) &&
+       ! (m_length >= 4 && memcmp(w + 0, "DEJA", 4) == 0)))
+  {
+    add("H");
+    advanceCounter(2, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_J_As_Vowel, Metaphone3Spec.txt line 702.
+bool Metaphone3::encode_J_As_Vowel()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 5 <= m_length && memcmp(w + m_current, "JEWSK", 5) == 0)
+  {
+    add("J", "");
+    return true;
+  }
+
+  if ((m_current + 2 <= m_length &&
+       (w[m_current + 1] == 'K' ||
+        w[m_current + 1] == 'L' ||
+        w[m_current + 1] == 'M' ||
+        w[m_current + 1] == 'N' ||
+        w[m_current + 1] == 'S' ||
+        w[m_current + 1] == 'T') &&
+       ! (m_current + 3 <= m_length && w[m_current + 2] == 'A')) ||
+      (m_length >= 2 && w[0] == 'F' && w[1] == 'J') ||
+      (m_length >= 3 && w[0] == 'W' && w[1] == 'O' && w[2] == 'J') ||
+      (m_length >= 4 &&
+       ((w[0] == 'B' && w[1] == 'J' && w[2] == 'O' && w[3] == 'R') ||
+        (w[0] == 'L' && w[1] == 'J' && w[2] == 'U' && w[3] == 'B'))) ||
+      (m_length >= 5 && memcmp(w + 0, "HAJEK", 5) == 0) ||
+      (m_length >= 9 &&
+       ((w[0] == 'H' && memcmp(w + 1, "ALLELUJA", 8) == 0) ||
+        (w[0] == 'L' && memcmp(w + 1, "JUBLJANA", 8) == 0))) ||
+      (m_current + 5 <= m_length &&
+       w[m_current] == 'J' &&
+       ((w[m_current + 1] == 'A' &&
+         w[m_current + 2] == 'V' &&
+         w[m_current + 3] == 'I' &&
+         w[m_current + 4] == 'K') ||
+        (w[m_current + 1] == 'E' &&
+         w[m_current + 2] == 'V' &&
+         w[m_current + 3] == 'I' &&
+         w[m_current + 4] == 'C'))) ||
+      (m_current == m_last - 1 &&
+       m_length >= 5 &&
+       ((w[0] == 'S' && memcmp(w + 1, "ONJA", 4) == 0) ||
+        (w[0] == 'T' &&
+         ((w[1] == 'A' && w[2] == 'N' && w[3] == 'J' && w[4] == 'A') ||
+          (w[1] == 'O' && w[2] == 'N' && w[3] == 'J' && w[4] == 'A'))))))
+  {
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Silent_K, Metaphone3Spec.txt line 713.
+bool Metaphone3::encode_Silent_K()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current == 0 &&
+      m_length >= 2 &&
+      w[0] == 'K' &&
+      w[1] == 'N' &&
+      ! ((m_current + 5 <= m_length &&
+          w[m_current + 2] == 'I' &&
+          w[m_current + 3] == 'S' &&
+          w[m_current + 4] == 'H') ||
+         (m_current + 7 <= m_length &&
+          ((w[m_current + 2] == 'E' &&
+            memcmp(w + m_current + 3, "SSET", 4) == 0) ||
+           (w[m_current + 2] == 'I' &&
+            memcmp(w + m_current + 3, "EVEL", 4) == 0)))))
+  {
+    m_current++;
+    return true;
+  }
+
+  if ((m_current + 4 <= m_length &&
+       w[m_current + 1] == 'N' &&
+       ((w[m_current + 2] == 'I' && w[m_current + 3] == 'T') ||
+        (w[m_current + 2] == 'O' &&
+         (w[m_current + 3] == 'B' ||
+          w[m_current + 3] == 'T' ||
+          w[m_current + 3] == 'W'))) &&
+       ! (m_length >= 8 && memcmp(w + 0, "BANKNOTE", 8) == 0)) ||
+      (m_current + 5 <= m_length &&
+       w[m_current + 1] == 'N' &&
+       ((w[m_current + 2] == 'A' &&
+         w[m_current + 3] == 'C' &&
+         w[m_current + 4] == 'K') ||
+        (w[m_current + 2] == 'I' &&
+         w[m_current + 3] == 'F' &&
+         w[m_current + 4] == 'E') ||
+        (w[m_current + 2] == 'O' &&
+         w[m_current + 3] == 'C' &&
+         w[m_current + 4] == 'K') ||
+        (w[m_current + 2] == 'U' &&
+         w[m_current + 3] == 'C' &&
+         w[m_current + 4] == 'K'))) ||
+      (m_current + 6 <= m_length &&
+       memcmp(w + m_current + 1, "NIGHT", 5) == 0))
+  {
+    if (m_current > 0 &&
+        m_current >= 1 &&
+        m_current <= m_length &&
+        w[m_current - 1] == 'N')
+    {
+      m_current += 2;
+    }
+    else
+    {
+      m_current++;
+    }
+    return true;
+  }
+  return false;
+}
+
+
+// encode_LELY_To_L, Metaphone3Spec.txt line 726.
+bool Metaphone3::encode_LELY_To_L()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current == m_last - 3 &&
+      m_current >= 1 &&
+      m_current + 4 <= m_length &&
+      memcmp(w + m_current - 1, "ILELY", 5) == 0)
+  {
+    add("L");
+    m_current += 3;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_COLONEL, Metaphone3Spec.txt line 731.
+bool Metaphone3::encode_COLONEL()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current >= 2 &&
+      m_current + 5 <= m_length &&
+      memcmp(w + m_current - 2, "COLONEL", 7) == 0)
+  {
+    add("R");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_French_AULT, Metaphone3Spec.txt line 736.
+bool Metaphone3::encode_French_AULT()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current > 3 &&
+      ((m_current >= 3 &&
+        m_current + 2 <= m_length &&
+        ((w[m_current - 3] == 'B' &&
+          memcmp(w + m_current - 2, "AULT", 4) == 0) ||
+         (w[m_current - 3] == 'C' &&
+          memcmp(w + m_current - 2, "AULT", 4) == 0) ||
+         (w[m_current - 3] == 'G' &&
+          memcmp(w + m_current - 2, "AULT", 4) == 0) ||
+         (w[m_current - 3] == 'N' &&
+          memcmp(w + m_current - 2, "AULT", 4) == 0) ||
+         (w[m_current - 3] == 'R' &&
+          memcmp(w + m_current - 2, "AULT", 4) == 0) ||
+         (w[m_current - 3] == 'S' &&
+          memcmp(w + m_current - 2, "AULT", 4) == 0))) ||
+       (m_current >= 4 &&
+        m_current + 2 <= m_length &&
+        ((w[m_current - 4] == 'B' &&
+          memcmp(w + m_current - 3, "EAULT", 5) == 0) ||
+         (w[m_current - 4] == 'N' &&
+          memcmp(w + m_current - 3, "EAULT", 5) == 0) ||
+         (w[m_current - 4] == 'R' &&
+          ((w[m_current - 3] == 'E' &&
+            memcmp(w + m_current - 2, "AULT", 4) == 0) ||
+           (w[m_current - 3] == 'I' &&
+            memcmp(w + m_current - 2, "AULT", 4) == 0)))))) &&
+      ! rootOrInflections(m_inWord, "ASSAULT") &&
+      ! (m_current >= 8 &&
+         m_current + 2 <= m_length &&
+         memcmp(w + m_current - 8, "SOMERSAULT", 10) == 0) &&
+      ! (m_current >= 9 &&
+         m_current + 2 <= m_length &&
+         memcmp(w + m_current - 9, "SUMMERSAULT", 11) == 0))
+  {
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_French_EUIL, Metaphone3Spec.txt line 745.
+bool Metaphone3::encode_French_EUIL()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current == m_last &&
+      m_current >= 3 &&
+      m_current + 1 <= m_length &&
+      memcmp(w + m_current - 3, "EUIL", 4) == 0)
+  {
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_French_OULX, Metaphone3Spec.txt line 749.
+bool Metaphone3::encode_French_OULX()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current == m_last - 1 &&
+      m_current >= 2 &&
+      m_current + 2 <= m_length &&
+      memcmp(w + m_current - 2, "OULX", 4) == 0)
+  {
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Silent_L_In_LM, Metaphone3Spec.txt line 753.
+bool Metaphone3::encode_Silent_L_In_LM()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length &&
+      w[m_current] == 'L' &&
+      (w[m_current + 1] == 'M' || w[m_current + 1] == 'N'))
+  {
+    if (((m_current >= 2 &&
+          m_current + 2 <= m_length &&
+          ((w[m_current - 2] == 'B' &&
+            w[m_current - 1] == 'A' &&
+            w[m_current] == 'L' &&
+            w[m_current + 1] == 'M') ||
+           (w[m_current - 2] == 'C' &&
+            ((w[m_current - 1] == 'A' &&
+              w[m_current] == 'L' &&
+              w[m_current + 1] == 'M') ||
+             (w[m_current - 1] == 'O' &&
+              w[m_current] == 'L' &&
+              w[m_current + 1] == 'N'))) ||
+           (w[m_current - 2] == 'M' &&
+            w[m_current - 1] == 'A' &&
+            w[m_current] == 'L' &&
+            w[m_current + 1] == 'M') ||
+           (w[m_current - 2] == 'P' &&
+            w[m_current - 1] == 'A' &&
+            w[m_current] == 'L' &&
+            w[m_current + 1] == 'M'))) ||
+         (m_current >= 2 &&
+          m_current + 4 <= m_length &&
+          ((w[m_current - 2] == 'H' &&
+            memcmp(w + m_current - 1, "OLMES", 5) == 0) ||
+           (w[m_current - 2] == 'S' &&
+            memcmp(w + m_current - 1, "ALMON", 5) == 0))) ||
+         (m_current == m_last - 1 &&
+          m_current >= 1 &&
+          m_current + 2 <= m_length &&
+          w[m_current - 1] == 'O' &&
+          w[m_current] == 'L' &&
+          w[m_current + 1] == 'M') ||
+         (m_current >= 3 &&
+          m_current + 2 <= m_length &&
+          ((w[m_current - 3] == 'P' &&
+            memcmp(w + m_current - 2, "SALM", 4) == 0) ||
+           (w[m_current - 3] == 'Q' &&
+            memcmp(w + m_current - 2, "UALM", 4) == 0))) ||
+         (m_current >= 1 &&
+          m_current + 5 <= m_length &&
+          memcmp(w + m_current - 1, "ALMOND", 6) == 0) ||
+         (m_current == 1 &&
+          m_length >= 4 &&
+          memcmp(w + 0, "ALMS", 4) == 0)) &&
+        ! (m_current + 3 <= m_length && w[m_current + 2] == 'A') &&
+        ! ((m_current >= 2 &&
+            m_current + 3 <= m_length &&
+            memcmp(w + m_current - 2, "BALMO", 5) == 0) ||
+           (m_current >= 2 &&
+            m_current + 4 <= m_length &&
+            ((w[m_current - 2] == 'B' &&
+              memcmp(w + m_current - 1, "ALMER", 5) == 0) ||
+             (w[m_current - 2] == 'P' &&
+              w[m_current - 1] == 'A' &&
+              w[m_current] == 'L' &&
+              w[m_current + 1] == 'M' &&
+              ((w[m_current + 2] == 'E' && w[m_current + 3] == 'R') ||
+               (w[m_current + 2] == 'O' && w[m_current + 3] == 'R')))))) &&
+        ! (m_current >= 3 &&
+           m_current + 2 <= m_length &&
+           memcmp(w + m_current - 3, "THALM", 5) == 0))
+    {
+      m_current++;
+    }
+    else
+    {
+      add("L");
+      m_current++;
+    }
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Silent_L_In_LK_LV, Metaphone3Spec.txt line 768.
+bool Metaphone3::encode_Silent_L_In_LK_LV()
+{
+  const char * w = m_inWord.c_str();
+
+  if (((m_current >= 2 &&
+        m_current + 2 <= m_length &&
+        ((w[m_current - 2] == 'B' &&
+          w[m_current - 1] == 'A' &&
+          w[m_current] == 'L' &&
+          w[m_current + 1] == 'K') ||
+         (w[m_current - 2] == 'C' &&
+          w[m_current - 1] == 'A' &&
+          w[m_current] == 'L' &&
+          (w[m_current + 1] == 'F' || w[m_current + 1] == 'K')) ||
+         (w[m_current - 2] == 'F' &&
+          w[m_current - 1] == 'O' &&
+          w[m_current] == 'L' &&
+          w[m_current + 1] == 'K') ||
+         (w[m_current - 2] == 'H' &&
+          w[m_current - 1] == 'A' &&
+          w[m_current] == 'L' &&
+          w[m_current + 1] == 'F') ||
+         (w[m_current - 2] == 'T' &&
+          w[m_current - 1] == 'A' &&
+          w[m_current] == 'L' &&
+          w[m_current + 1] == 'K') ||
+         (w[m_current - 2] == 'W' &&
+          w[m_current - 1] == 'A' &&
+          w[m_current] == 'L' &&
+          w[m_current + 1] == 'K') ||
+         (w[m_current - 2] == 'Y' &&
+          w[m_current - 1] == 'O' &&
+          w[m_current] == 'L' &&
+          w[m_current + 1] == 'K'))) ||
+       (m_current >= 2 &&
+        m_current + 4 <= m_length &&
+        memcmp(w + m_current - 2, "SOLDER", 6) == 0) ||
+       (m_current >= 2 &&
+        m_current + 2 <= m_length &&
+        memcmp(w + m_current - 2, "POLK", 4) == 0 &&
+        ! (m_current >= 2 &&
+           m_current + 3 <= m_length &&
+           ((w[m_current - 2] == 'P' &&
+             memcmp(w + m_current - 1, "OLKA", 4) == 0) ||
+            (w[m_current - 2] == 'W' &&
+             memcmp(w + m_current - 1, "ALKO", 4) == 0)))) ||
+       (m_current >= 2 &&
+        m_current + 2 <= m_length &&
+        memcmp(w + m_current - 2, "HALV", 4) == 0 &&
+        ! (m_current >= 2 &&
+           m_current + 3 <= m_length &&
+           w[m_current - 2] == 'H' &&
+           w[m_current - 1] == 'A' &&
+           w[m_current] == 'L' &&
+           w[m_current + 1] == 'V' &&
+           (w[m_current + 2] == 'A' || w[m_current + 2] == 'O'))) ||
+       (m_current >= 3 &&
+        m_current + 2 <= m_length &&
+        ((w[m_current - 3] == 'B' &&
+          memcmp(w + m_current - 2, "AULK", 4) == 0) ||
+         (w[m_current - 3] == 'C' &&
+          ((w[m_current - 2] == 'A' &&
+            w[m_current - 1] == 'U' &&
+            w[m_current] == 'L' &&
+            w[m_current + 1] == 'K') ||
+           (w[m_current - 2] == 'H' &&
+            w[m_current - 1] == 'A' &&
+            w[m_current] == 'L' &&
+            w[m_current + 1] == 'K'))) ||
+         (w[m_current - 3] == 'F' &&
+          memcmp(w + m_current - 2, "AULK", 4) == 0)) &&
+        ! (m_current >= 4 &&
+           m_current + 2 <= m_length &&
+           memcmp(w + m_current - 4, "SCHALK", 6) == 0)) ||
+       (m_current >= 2 &&
+        m_current + 3 <= m_length &&
+        memcmp(w + m_current - 2, "SALVE", 5) == 0 &&
+        ! (m_current >= 2 &&
+           m_current + 4 <= m_length &&
+           memcmp(w + m_current - 2, "SALVER", 6) == 0)) ||
+       (m_current >= 2 &&
+        m_current + 3 <= m_length &&
+        memcmp(w + m_current - 2, "CALVE", 5) == 0 &&
+        ! (m_current >= 2 &&
+           m_current + 4 <= m_length &&
+           memcmp(w + m_current - 2, "CALVER", 6) == 0))) &&
+      ! (m_current >= 5 &&
+         m_current + 4 <= m_length &&
+         w[m_current - 5] == 'G' &&
+         w[m_current - 4] == 'O' &&
+         w[m_current - 3] == 'N' &&
+         ((w[m_current - 2] == 'C' &&
+           memcmp(w + m_current - 1, "ALVES", 5) == 0) ||
+          (w[m_current - 2] == 'S' &&
+           memcmp(w + m_current - 1, "ALVES", 5) == 0))) &&
+      ! (m_current >= 2 &&
+         m_current + 4 <= m_length &&
+         ((w[m_current - 2] == 'B' &&
+           memcmp(w + m_current - 1, "ALKAN", 5) == 0) ||
+          (w[m_current - 2] == 'T' &&
+           memcmp(w + m_current - 1, "ALKAL", 5) == 0))) &&
+      ! (m_current >= 3 &&
+         m_current + 2 <= m_length &&
+         ((w[m_current - 3] == 'C' &&
+           memcmp(w + m_current - 2, "HALF", 4) == 0) ||
+          (w[m_current - 3] == 'P' &&
+           memcmp(w + m_current - 2, "AULK", 4) == 0))))
+  {
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Silent_L_In_OULD, Metaphone3Spec.txt line 780.
+bool Metaphone3::encode_Silent_L_In_OULD()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current >= 3 &&
+       m_current + 2 <= m_length &&
+       ((w[m_current - 3] == 'C' &&
+         memcmp(w + m_current - 2, "OULD", 4) == 0) ||
+        (w[m_current - 3] == 'W' &&
+         memcmp(w + m_current - 2, "OULD", 4) == 0))) ||
+      (m_current >= 4 &&
+       m_current + 2 <= m_length &&
+       memcmp(w + m_current - 4, "SHOULD", 6) == 0 &&
+       ! (m_current >= 4 &&
+          m_current + 4 <= m_length &&
+          memcmp(w + m_current - 4, "SHOULDER", 8) == 0)))
+  {
+    addExactApprox("D", "T");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_LL_As_Vowel_Special_Cases, Metaphone3Spec.txt line 785.
+bool Metaphone3::encode_LL_As_Vowel_Special_Cases()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current >= 5 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 5, "TORTILLA", 8) == 0) ||
+      (m_current >= 8 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 8, "RATATOUILLE", 11) == 0) ||
+      (m_length >= 5 &&
+       ((w[0] == 'G' &&
+         ((w[1] == 'A' && w[2] == 'I' && w[3] == 'L' && w[4] == 'L') ||
+          (w[1] == 'U' && w[2] == 'I' && w[3] == 'L' && w[4] == 'L'))) ||
+        (w[0] == 'V' && memcmp(w + 1, "EILL", 4) == 0)) &&
+       ! ((m_current >= 3 &&
+           m_current + 4 <= m_length &&
+           w[m_current - 3] == 'G' &&
+           w[m_current - 2] == 'U' &&
+           w[m_current - 1] == 'I' &&
+           w[m_current] == 'L' &&
+           w[m_current + 1] == 'L' &&
+           ((w[m_current + 2] == 'E' && w[m_current + 3] == 'N') ||
+            (w[m_current + 2] == 'O' &&
+             (w[m_current + 3] == 'R' || w[m_current + 3] == 'T')))) ||
+          (m_length == 5 &&
+           m_length >= 5 &&
+           memcmp(w + 0, "GUILL", 5) == 0))) ||
+      (m_length >= 7 &&
+       ((w[0] == 'B' && memcmp(w + 1, "ROUILL", 6) == 0) ||
+        (w[0] == 'G' && memcmp(w + 1, "REMILL", 6) == 0))) ||
+      (m_current == m_last - 2 &&
+       m_current >= 2 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 2, "EILLE", 5) == 0 &&
+       ! (m_current >= 5 &&
+          m_current + 3 <= m_length &&
+          memcmp(w + m_current - 5, "REVEILLE", 8) == 0)))
+  {
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_LL_As_Vowel, Metaphone3Spec.txt line 795.
+bool Metaphone3::encode_LL_As_Vowel()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current == m_last - 2 &&
+       m_current >= 1 &&
+       m_current + 3 <= m_length &&
+       ((w[m_current - 1] == 'A' &&
+         w[m_current] == 'L' &&
+         w[m_current + 1] == 'L' &&
+         w[m_current + 2] == 'E') ||
+        (w[m_current - 1] == 'I' &&
+         w[m_current] == 'L' &&
+         w[m_current + 1] == 'L' &&
+         (w[m_current + 2] == 'A' || w[m_current + 2] == 'O')))) ||
+      (((m_last >= 1 &&
+         ((w[m_last - 1] == 'A' && w[m_last] == 'S') ||
+          (w[m_last - 1] == 'O' && w[m_last] == 'S'))) ||
+        (m_last >= 0 && (w[m_last] == 'A' || w[m_last] == 'O'))) &&
+       m_current >= 1 &&
+       m_current + 1 <= m_length &&
+       ((w[m_current - 1] == 'A' && w[m_current] == 'L') ||
+        (w[m_current - 1] == 'I' && w[m_current] == 'L')) &&
+       ! (m_current >= 1 &&
+          m_current + 3 <= m_length &&
+          memcmp(w + m_current - 1, "ALLA", 4) == 0)) ||
+      (m_length >= 3 && w[0] == 'L' && w[1] == 'L' && w[2] == 'A') ||
+      (m_length >= 5 &&
+       w[0] == 'V' &&
+       w[1] == 'I' &&
+       w[2] == 'L' &&
+       w[3] == 'L' &&
+       (w[4] == 'A' || w[4] == 'E')) ||
+      (m_length >= 8 &&
+       ((w[0] == 'B' && memcmp(w + 1, "ALLASTE", 7) == 0) ||
+        (w[0] == 'C' && memcmp(w + 1, "AVALLAR", 7) == 0) ||
+        (w[0] == 'G' && memcmp(w + 1, "ALLARDO", 7) == 0) ||
+        (w[0] == 'M' && memcmp(w + 1, "AGALLAN", 7) == 0) ||
+        (w[0] == 'V' && memcmp(w + 1, "ALLADAR", 7) == 0))))
+  {
+    add("L", "");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Silent_M_At_Beginning, Metaphone3Spec.txt line 806.
+bool Metaphone3::encode_Silent_M_At_Beginning()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current == 0 && m_length >= 2 && w[0] == 'M' && w[1] == 'N')
+  {
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_MR_And_MRS, Metaphone3Spec.txt line 810.
+bool Metaphone3::encode_MR_And_MRS()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current == 0 &&
+      m_length >= 2 &&
+      w[0] == 'M' &&
+      w[1] == 'R' &&
+      m_length == 2)
+  {
+    add(m_encodeVowels ? "MASTAR" : "MSTR");
+    m_current += 2;
+    return true;
+  }
+
+  if (m_current == 0 &&
+      m_length >= 2 &&
+      w[0] == 'M' &&
+      w[1] == 'R' &&
+      m_length == 3 &&
+      m_length >= 3 &&
+      w[0] == 'M' &&
+      w[1] == 'R' &&
+      w[2] == 'S')
+  {
+    add(m_encodeVowels ? "MASAS" : "MSS");
+    m_current += 3;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_MAC, Metaphone3Spec.txt line 818.
+bool Metaphone3::encode_MAC()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current == 0 &&
+      ((m_length >= 2 && w[0] == 'M' && w[1] == 'C') ||
+       (m_length >= 7 &&
+        w[0] == 'M' &&
+        w[1] == 'A' &&
+        w[2] == 'C' &&
+        ((w[3] == 'E' && w[4] == 'W' && w[5] == 'E' && w[6] == 'N') ||
+         (w[3] == 'I' && w[4] == 'V' && w[5] == 'E' && w[6] == 'R'))) ||
+       (m_length >= 8 &&
+        w[0] == 'M' &&
+        w[1] == 'A' &&
+        w[2] == 'C' &&
+        ((w[3] == 'E' && memcmp(w + 4, "LROY", 4) == 0) ||
+         (w[3] == 'I' && memcmp(w + 4, "LROY", 4) == 0))) ||
+       (m_length >= 9 && memcmp(w + 0, "MACINTOSH", 9) == 0)))
+  {
+    add(m_encodeVowels ? "MAK" : "MK");
+    if (m_length >= 2 &&
+        w[0] == 'M' &&
+        w[1] == 'C' &&
+        (! (m_length >= 3 && (w[2] == 'G' || w[2] == 'K' || w[2] == 'Q')) ||
+         (m_length >= 6 && memcmp(w + 2, "GEOR", 4) == 0)))
+    {
+      m_current += 2;
+    }
+    else
+    {
+      m_current += 3;
+    }
+    return true;
+  }
+  return false;
+}
+
+
+// encode_MPT, Metaphone3Spec.txt line 827.
+bool Metaphone3::encode_MPT()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current >= 2 &&
+       m_current + 6 <= m_length &&
+       memcmp(w + m_current - 2, "COMPTROL", 8) == 0) ||
+      (m_current >= 4 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 4, "ACCOMPT", 7) == 0))
+  {
+    add("N");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_NCE, Metaphone3Spec.txt line 835.
+bool Metaphone3::encode_NCE()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length &&
+      (w[m_current + 1] == 'C' || w[m_current + 1] == 'S') &&
+      m_current + 3 <= m_length &&
+      (w[m_current + 2] == 'E' ||
+       w[m_current + 2] == 'I' ||
+       w[m_current + 2] == 'Y') &&
+      (m_current == m_last - 2 ||
+       (m_current == m_last - 3 &&
+        m_current + 4 <= m_length &&
+        w[m_current + 3] == 'S')))
+  {
+    add("NTS");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Silent_P_At_Beginning, Metaphone3Spec.txt line 844.
+bool Metaphone3::encode_Silent_P_At_Beginning()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current == 0 &&
+      m_length >= 2 &&
+      w[0] == 'P' &&
+      (w[1] == 'F' || w[1] == 'N' || w[1] == 'S' || w[1] == 'T'))
+  {
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_PT, Metaphone3Spec.txt line 848.
+bool Metaphone3::encode_PT()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length &&
+      w[m_current + 1] == 'T' &&
+      ((m_current == 0 && m_length >= 5 && memcmp(w + 0, "PTERO", 5) == 0) ||
+       (m_current >= 5 &&
+        m_current + 2 <= m_length &&
+        memcmp(w + m_current - 5, "RECEIPT", 7) == 0) ||
+       (m_current >= 4 &&
+        m_current + 4 <= m_length &&
+        memcmp(w + m_current - 4, "ASYMPTOT", 8) == 0)))
+  {
+    add("T");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_PH, Metaphone3Spec.txt line 854.
+bool Metaphone3::encode_PH()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length && w[m_current + 1] == 'H')
+  {
+    if ((m_current + 9 <= m_length &&
+         memcmp(w + m_current, "PHTHALEIN", 9) == 0) ||
+        (m_current == 0 && m_length >= 4 && memcmp(w + 0, "PHTH", 4) == 0) ||
+        (m_current >= 3 &&
+         m_current + 7 <= m_length &&
+         memcmp(w + m_current - 3, "APOPHTHEGM", 10) == 0))
+    {
+      add("0");
+      m_current += 4;
+    }
+    else if (m_current > 0 &&
+             ((m_current + 5 <= m_length &&
+               ((w[m_current + 2] == 'A' &&
+                 ((w[m_current + 3] == 'N' && w[m_current + 4] == 'G') ||
+                  (w[m_current + 3] == 'R' &&
+                   (w[m_current + 4] == 'D' || w[m_current + 4] == 'T')))) ||
+                (w[m_current + 2] == 'E' &&
+                 ((w[m_current + 3] == 'A' &&
+                   (w[m_current + 4] == 'D' ||
+                    w[m_current + 4] == 'P' ||
+                    w[m_current + 4] == 'V')) ||
+                  (w[m_current + 3] == 'L' && w[m_current + 4] == 'D') ||
+                  (w[m_current + 3] == 'R' && w[m_current + 4] == 'D'))) ||
+                (w[m_current + 2] == 'I' &&
+                 w[m_current + 3] == 'L' &&
+                 w[m_current + 4] == 'L') ||
+                (w[m_current + 2] == 'O' &&
+                 ((w[m_current + 3] == 'L' &&
+                   (w[m_current + 4] == 'D' || w[m_current + 4] == 'E')) ||
+                  (w[m_current + 3] == 'R' && w[m_current + 4] == 'N'))))) ||
+              (m_current + 6 <= m_length &&
+               memcmp(w + m_current + 2, "OUSE", 4) == 0) ||
+              (m_current + 7 <= m_length &&
+               ((w[m_current + 2] == 'A' &&
+                 ((w[m_current + 3] == 'M' &&
+                   w[m_current + 4] == 'M' &&
+                   w[m_current + 5] == 'E' &&
+                   w[m_current + 6] == 'R') ||
+                  (w[m_current + 3] == 'Z' &&
+                   w[m_current + 4] == 'A' &&
+                   w[m_current + 5] == 'R' &&
+                   w[m_current + 6] == 'D'))) ||
+                (w[m_current + 2] == 'U' &&
+                 memcmp(w + m_current + 3, "GGER", 4) == 0))) ||
+              (m_current + 8 <= m_length &&
+               memcmp(w + m_current + 2, "OLSTER", 6) == 0) ||
+              (m_current + 4 <= m_length &&
+               w[m_current + 2] == 'A' &&
+               w[m_current + 3] == 'M' &&
+               ! (m_current >= 1 &&
+                  m_current + 4 <= m_length &&
+                  memcmp(w + m_current - 1, "LPHAM", 5) == 0))) &&
+             ! (m_current >= 3 &&
+                m_current + 2 <= m_length &&
+                ((w[m_current - 3] == 'L' &&
+                  memcmp(w + m_current - 2, "YMPH", 4) == 0) ||
+                 (w[m_current - 3] == 'N' &&
+                  memcmp(w + m_current - 2, "YMPH", 4) == 0))))
+    {
+      add("P");
+      advanceCounter(3, 2);
+    }
+    else
+    {
+      add("F");
+      m_current += 2;
+    }
+    return true;
+  }
+  return false;
+}
+
+
+// encode_PPH, Metaphone3Spec.txt line 870.
+bool Metaphone3::encode_PPH()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current < m_last - 1 &&
+      m_current + 3 <= m_length &&
+      w[m_current + 1] == 'P' &&
+      w[m_current + 2] == 'H')
+  {
+    add("F");
+    m_current += 3;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_RPS, Metaphone3Spec.txt line 875.
+bool Metaphone3::encode_RPS()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current >= 3 &&
+      m_current + 2 <= m_length &&
+      memcmp(w + m_current - 3, "CORPS", 5) == 0 &&
+      ! (m_current >= 3 &&
+         m_current + 3 <= m_length &&
+         memcmp(w + m_current - 3, "CORPSE", 6) == 0))
+  {
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_COUP, Metaphone3Spec.txt line 879.
+bool Metaphone3::encode_COUP()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current == m_last &&
+      m_current >= 3 &&
+      m_current + 1 <= m_length &&
+      memcmp(w + m_current - 3, "COUP", 4) == 0 &&
+      ! (m_current >= 5 &&
+         m_current + 1 <= m_length &&
+         memcmp(w + m_current - 5, "RECOUP", 6) == 0))
+  {
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_PNEUM, Metaphone3Spec.txt line 883.
+bool Metaphone3::encode_PNEUM()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 5 <= m_length && memcmp(w + m_current + 1, "NEUM", 4) == 0)
+  {
+    add("N");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_PSYCH, Metaphone3Spec.txt line 888.
+bool Metaphone3::encode_PSYCH()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 5 <= m_length && memcmp(w + m_current + 1, "SYCH", 4) == 0)
+  {
+    add(m_encodeVowels ? "SAK" : "SK");
+    m_current += 5;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_PSALM, Metaphone3Spec.txt line 893.
+bool Metaphone3::encode_PSALM()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 5 <= m_length && memcmp(w + m_current + 1, "SALM", 4) == 0)
+  {
+    add(m_encodeVowels ? "SAM" : "SM");
+    m_current += 5;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_RZ, Metaphone3Spec.txt line 901.
+bool Metaphone3::encode_RZ()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current >= 2 &&
+       m_current + 2 <= m_length &&
+       ((w[m_current - 2] == 'G' &&
+         w[m_current - 1] == 'A' &&
+         w[m_current] == 'R' &&
+         w[m_current + 1] == 'Z') ||
+        (w[m_current - 2] == 'H' &&
+         w[m_current - 1] == 'E' &&
+         w[m_current] == 'R' &&
+         w[m_current + 1] == 'Z') ||
+        (w[m_current - 2] == 'K' &&
+         w[m_current - 1] == 'U' &&
+         w[m_current] == 'R' &&
+         w[m_current + 1] == 'Z') ||
+        (w[m_current - 2] == 'M' &&
+         ((w[m_current - 1] == 'A' &&
+           w[m_current] == 'R' &&
+           w[m_current + 1] == 'Z') ||
+          (w[m_current - 1] == 'E' &&
+           w[m_current] == 'R' &&
+           w[m_current + 1] == 'Z'))) ||
+        (w[m_current - 2] == 'P' &&
+         w[m_current - 1] == 'E' &&
+         w[m_current] == 'R' &&
+         w[m_current + 1] == 'Z') ||
+        (w[m_current - 2] == 'W' &&
+         w[m_current - 1] == 'A' &&
+         w[m_current] == 'R' &&
+         w[m_current + 1] == 'Z'))) ||
+      (m_current + 5 <= m_length &&
+       w[m_current] == 'R' &&
+       w[m_current + 1] == 'Z' &&
+       ((w[m_current + 2] == 'A' &&
+         w[m_current + 3] == 'N' &&
+         w[m_current + 4] == 'O') ||
+        (w[m_current + 2] == 'O' &&
+         w[m_current + 3] == 'L' &&
+         w[m_current + 4] == 'A'))) ||
+      (m_current >= 1 &&
+       m_current + 3 <= m_length &&
+       w[m_current - 1] == 'A' &&
+       w[m_current] == 'R' &&
+       w[m_current + 1] == 'Z' &&
+       (w[m_current + 2] == 'A' || w[m_current + 2] == 'N')))
+  {
+    return false;
+  }
+
+  if (m_current >= 4 &&
+      m_current + 7 <= m_length &&
+      memcmp(w + m_current - 4, "YASTRZEMSKI", 11) == 0)
+  {
+    add("R", "X");
+    m_current += 2;
+    return true;
+  }
+
+  if (m_current >= 1 &&
+      m_current + 9 <= m_length &&
+      memcmp(w + m_current - 1, "BRZEZINSKI", 10) == 0)
+  {
+    add("RS", "RJ");
+    m_current += 4;
+    return true;
+  }
+
+  if ((m_current >= 1 &&
+       m_current + 2 <= m_length &&
+       ((w[m_current - 1] == 'K' &&
+         w[m_current] == 'R' &&
+         w[m_current + 1] == 'Z') ||
+        (w[m_current - 1] == 'P' &&
+         w[m_current] == 'R' &&
+         w[m_current + 1] == 'Z') ||
+        (w[m_current - 1] == 'T' &&
+         w[m_current] == 'R' &&
+         w[m_current + 1] == 'Z'))) ||
+      (m_current + 2 <= m_length &&
+       w[m_current] == 'R' &&
+       w[m_current + 1] == 'Z' &&
+       (isVowel(m_current - 1) || m_current == 0)))
+  {
+    add("RS", "X");
+    m_current += 2;
+    return true;
+  }
+
+  if (m_current >= 1 &&
+      m_current + 2 <= m_length &&
+      ((w[m_current - 1] == 'B' &&
+        w[m_current] == 'R' &&
+        w[m_current + 1] == 'Z') ||
+       (w[m_current - 1] == 'D' &&
+        w[m_current] == 'R' &&
+        w[m_current + 1] == 'Z') ||
+       (w[m_current - 1] == 'G' &&
+        w[m_current] == 'R' &&
+        w[m_current + 1] == 'Z')))
+  {
+    add("RS", "J");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Vowel_RE_Transposition, Metaphone3Spec.txt line 919.
+bool Metaphone3::encode_Vowel_RE_Transposition()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_encodeVowels &&
+      m_length > 3 &&
+      m_current + 2 <= m_length &&
+      w[m_current + 1] == 'E' &&
+      ! (m_length >= 5 &&
+         ((w[0] == 'A' && memcmp(w + 1, "NDRE", 4) == 0) ||
+          (w[0] == 'L' && memcmp(w + 1, "IBRE", 4) == 0) ||
+          (w[0] == 'O' && memcmp(w + 1, "UTRE", 4) == 0))) &&
+      ! (m_length == 4 &&
+         m_length >= 4 &&
+         ((w[0] == 'F' && w[1] == 'R' && w[2] == 'E' && w[3] == 'D') ||
+          (w[0] == 'T' && w[1] == 'R' && w[2] == 'E' && w[3] == 'S'))) &&
+      ! (m_current >= 2 &&
+         m_current + 3 <= m_length &&
+         ((w[m_current - 2] == 'I' &&
+           memcmp(w + m_current - 1, "FRED", 4) == 0) ||
+          (w[m_current - 2] == 'L' &&
+           ((w[m_current - 1] == 'D' &&
+             w[m_current] == 'R' &&
+             w[m_current + 1] == 'E' &&
+             w[m_current + 2] == 'D') ||
+            (w[m_current - 1] == 'F' &&
+             w[m_current] == 'R' &&
+             w[m_current + 1] == 'E' &&
+             w[m_current + 2] == 'D'))) ||
+          (w[m_current - 2] == 'N' &&
+           ((w[m_current - 1] == 'D' &&
+             w[m_current] == 'R' &&
+             w[m_current + 1] == 'E' &&
+             (w[m_current + 2] == 'D' || w[m_current + 2] == 'S')) ||
+            (w[m_current - 1] == 'F' &&
+             w[m_current] == 'R' &&
+             w[m_current + 1] == 'E' &&
+             w[m_current + 2] == 'D'))))) &&
+      ! isVowel(m_current - 1) &&
+      (m_current == m_last - 1 ||
+       (m_current == m_last - 2 &&
+        m_last >= 0 &&
+        (w[m_last] == 'D' || w[m_last] == 'S'))))
+  {
+    add("AR");
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Special_SW, Metaphone3Spec.txt line 931.
+bool Metaphone3::encode_Special_SW()
+{
+
+  if (m_current == 0 && names_Beginning_With_SW_That_Get_Alt_SV())
+  {
+    add("S", "SV");
+    m_current += 2;
+    return true;
+  }
+
+  if (m_current == 0 && names_Beginning_With_SW_That_Get_Alt_XV())
+  {
+    add("S", "XV");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_SKJ, Metaphone3Spec.txt line 939.
+bool Metaphone3::encode_SKJ()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 4 <= m_length &&
+      w[m_current] == 'S' &&
+      w[m_current + 1] == 'K' &&
+      w[m_current + 2] == 'J' &&
+      (w[m_current + 3] == 'O' || w[m_current + 3] == 'U') &&
+      isVowel(m_current + 3))
+  {
+    add("X");
+    m_current += 3;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_SJ, Metaphone3Spec.txt line 944.
+bool Metaphone3::encode_SJ()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_length >= 2 && w[0] == 'S' && w[1] == 'J')
+  {
+    add("X");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Silent_French_S_Final, Metaphone3Spec.txt line 949.
+bool Metaphone3::encode_Silent_French_S_Final()
+{
+  const char * w = m_inWord.c_str();
+
+  if (! (m_current == m_last))
+    return false;
+
+  if (m_length >= 5 && memcmp(w + 0, "LOUIS", 5) == 0)
+  {
+    add("S", "");
+    m_current++;
+    return true;
+  }
+
+  if ((m_length >= 4 && memcmp(w + 0, "YVES", 4) == 0) ||
+      (m_length >= 8 &&
+       ((w[0] == 'A' && memcmp(w + 1, "RKANSAS", 7) == 0) ||
+        (w[0] == 'B' && memcmp(w + 1, "RUYERES", 7) == 0) ||
+        (w[0] == 'C' && memcmp(w + 1, "RUDITES", 7) == 0) ||
+        (w[0] == 'F' && memcmp(w + 1, "RANCAIS", 7) == 0))) ||
+      (m_length >= 9 &&
+       w[0] == 'D' &&
+       w[1] == 'E' &&
+       w[2] == 'S' &&
+       ((w[3] == 'C' &&
+         ((w[4] == 'A' && memcmp(w + 5, "RTES", 4) == 0) ||
+          (w[4] == 'H' &&
+           ((w[5] == 'A' && w[6] == 'M' && w[7] == 'P' && w[8] == 'S') ||
+            (w[5] == 'E' && w[6] == 'N' && w[7] == 'E' && w[8] == 'S') ||
+            (w[5] == 'U' && w[6] == 'T' && w[7] == 'E' && w[8] == 'S'))))) ||
+        (w[3] == 'R' && memcmp(w + 4, "OCHES", 5) == 0))) ||
+      (m_length >= 10 && memcmp(w + 0, "RENDEZVOUS", 10) == 0) ||
+      (m_length >= 11 &&
+       ((w[0] == 'C' && memcmp(w + 1, "ONTRETEMPS", 10) == 0) ||
+        (w[0] == 'D' && memcmp(w + 1, "ESLAURIERS", 10) == 0))) ||
+      (m_current == 3 && m_length >= 4 && memcmp(w + 0, "HORS", 4) == 0) ||
+      (m_current >= 4 &&
+       m_current + 1 <= m_length &&
+       ((w[m_current - 4] == 'C' &&
+         memcmp(w + m_current - 3, "AMUS", 4) == 0) ||
+        (w[m_current - 4] == 'Y' &&
+         memcmp(w + m_current - 3, "PRES", 4) == 0))) ||
+      (m_current >= 5 &&
+       m_current + 1 <= m_length &&
+       ((w[m_current - 5] == 'B' &&
+         memcmp(w + m_current - 4, "LANCS", 5) == 0) ||
+        (w[m_current - 5] == 'C' &&
+         memcmp(w + m_current - 4, "ANNES", 5) == 0) ||
+        (w[m_current - 5] == 'D' &&
+         memcmp(w + m_current - 4, "EBRIS", 5) == 0) ||
+        (w[m_current - 5] == 'I' &&
+         memcmp(w + m_current - 4, "NGRES", 5) == 0) ||
+        (w[m_current - 5] == 'M' &&
+         memcmp(w + m_current - 4, "ESNES", 5) == 0))) ||
+      (m_current >= 6 &&
+       m_current + 1 <= m_length &&
+       ((w[m_current - 6] == 'A' &&
+         memcmp(w + m_current - 5, "PROPOS", 6) == 0) ||
+        (w[m_current - 6] == 'C' &&
+         memcmp(w + m_current - 5, "HABLIS", 6) == 0) ||
+        (w[m_current - 6] == 'D' &&
+         memcmp(w + m_current - 5, "ESPRES", 6) == 0) ||
+        (w[m_current - 6] == 'E' &&
+         memcmp(w + m_current - 5, "LYSEES", 6) == 0) ||
+        (w[m_current - 6] == 'G' &&
+         memcmp(w + m_current - 5, "EORGES", 6) == 0) ||
+        (w[m_current - 6] == 'J' &&
+         memcmp(w + m_current - 5, "ACQUES", 6) == 0) ||
+        (w[m_current - 6] == 'O' &&
+         memcmp(w + m_current - 5, "EUVRES", 6) == 0))) ||
+      (m_current >= 2 &&
+       m_current <= m_length &&
+       ((w[m_current - 2] == 'A' && w[m_current - 1] == 'I') ||
+        (w[m_current - 2] == 'O' && w[m_current - 1] == 'I') ||
+        (w[m_current - 2] == 'U' && w[m_current - 1] == 'I')) &&
+       ! (m_length >= 4 &&
+          w[0] == 'L' &&
+          ((w[1] == 'O' && w[2] == 'I' && w[3] == 'S') ||
+           (w[1] == 'U' && w[2] == 'I' && w[3] == 'S')))))
+  {
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Silent_French_S_Internal, Metaphone3Spec.txt line 963.
+bool Metaphone3::encode_Silent_French_S_Internal()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current >= 2 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 2, "MESNES", 6) == 0) ||
+      (m_current >= 2 &&
+       m_current + 5 <= m_length &&
+       w[m_current - 2] == 'D' &&
+       w[m_current - 1] == 'E' &&
+       w[m_current] == 'S' &&
+       ((w[m_current + 1] == 'C' &&
+         w[m_current + 2] == 'H' &&
+         ((w[m_current + 3] == 'A' && w[m_current + 4] == 'M') ||
+          (w[m_current + 3] == 'E' && w[m_current + 4] == 'N'))) ||
+        (w[m_current + 1] == 'H' &&
+         w[m_current + 2] == 'O' &&
+         w[m_current + 3] == 'T' &&
+         w[m_current + 4] == 'E') ||
+        (w[m_current + 1] == 'J' &&
+         w[m_current + 2] == 'A' &&
+         w[m_current + 3] == 'R' &&
+         w[m_current + 4] == 'D') ||
+        (w[m_current + 1] == 'L' &&
+         w[m_current + 2] == 'A' &&
+         w[m_current + 3] == 'U' &&
+         w[m_current + 4] == 'R') ||
+        (w[m_current + 1] == 'M' &&
+         w[m_current + 2] == 'A' &&
+         w[m_current + 3] == 'R' &&
+         w[m_current + 4] == 'A') ||
+        (w[m_current + 1] == 'P' &&
+         w[m_current + 2] == 'R' &&
+         w[m_current + 3] == 'E' &&
+         w[m_current + 4] == 'S') ||
+        (w[m_current + 1] == 'R' &&
+         w[m_current + 2] == 'O' &&
+         ((w[m_current + 3] == 'C' && w[m_current + 4] == 'H') ||
+          (w[m_current + 3] == 'S' && w[m_current + 4] == 'I'))))) ||
+      (m_current >= 2 &&
+       m_current + 7 <= m_length &&
+       memcmp(w + m_current - 2, "DESCARTES", 9) == 0) ||
+      (m_current >= 5 &&
+       m_current + 3 <= m_length &&
+       w[m_current - 5] == 'D' &&
+       w[m_current - 4] == 'U' &&
+       ((w[m_current - 3] == 'C' &&
+         memcmp(w + m_current - 2, "HESNE", 5) == 0) ||
+        (w[m_current - 3] == 'Q' &&
+         memcmp(w + m_current - 2, "UESNE", 5) == 0))) ||
+      (m_current >= 7 &&
+       m_current + 3 <= m_length &&
+       ((w[m_current - 7] == 'B' &&
+         memcmp(w + m_current - 6, "EAUCHESNE", 9) == 0) ||
+        (w[m_current - 7] == 'I' &&
+         memcmp(w + m_current - 6, "LLINOISAN", 9) == 0))) ||
+      (m_current >= 3 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 3, "FRESNEL", 7) == 0) ||
+      (m_current >= 3 &&
+       m_current + 6 <= m_length &&
+       memcmp(w + m_current - 3, "GROSVENOR", 9) == 0) ||
+      (m_current >= 4 &&
+       m_current + 6 <= m_length &&
+       memcmp(w + m_current - 4, "LOUISVILLE", 10) == 0))
+  {
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_ISL, Metaphone3Spec.txt line 972.
+bool Metaphone3::encode_ISL()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current >= 2 &&
+       m_current + 2 <= m_length &&
+       ((w[m_current - 2] == 'A' &&
+         w[m_current - 1] == 'I' &&
+         w[m_current] == 'S' &&
+         w[m_current + 1] == 'L') ||
+        (w[m_current - 2] == 'L' &&
+         ((w[m_current - 1] == 'I' &&
+           w[m_current] == 'S' &&
+           w[m_current + 1] == 'L') ||
+          (w[m_current - 1] == 'Y' &&
+           w[m_current] == 'S' &&
+           w[m_current + 1] == 'L')))) &&
+       ! (m_current >= 3 &&
+          m_current + 4 <= m_length &&
+          ((w[m_current - 3] == 'A' &&
+            w[m_current - 2] == 'L' &&
+            w[m_current - 1] == 'I' &&
+            w[m_current] == 'S' &&
+            w[m_current + 1] == 'L' &&
+            w[m_current + 2] == 'A' &&
+            (w[m_current + 3] == 'A' ||
+             w[m_current + 3] == 'H' ||
+             w[m_current + 3] == 'M')) ||
+           (w[m_current - 3] == 'B' &&
+            memcmp(w + m_current - 2, "AISLEY", 6) == 0) ||
+           (w[m_current - 3] == 'P' &&
+            memcmp(w + m_current - 2, "AISLEY", 6) == 0)))) ||
+      (m_current == 1 &&
+       ((m_length >= 4 && memcmp(w + 0, "ISLE", 4) == 0) ||
+        (m_length >= 5 && memcmp(w + 0, "ISLAN", 5) == 0)) &&
+       ! (m_length >= 5 &&
+          w[0] == 'I' &&
+          w[1] == 'S' &&
+          w[2] == 'L' &&
+          w[3] == 'E' &&
+          (w[4] == 'R' || w[4] == 'Y'))))
+  {
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_STL, Metaphone3Spec.txt line 978.
+bool Metaphone3::encode_STL()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current + 4 <= m_length &&
+       w[m_current] == 'S' &&
+       w[m_current + 1] == 'T' &&
+       w[m_current + 2] == 'L' &&
+       (w[m_current + 3] == 'E' || w[m_current + 3] == 'I') &&
+       ! (m_current + 6 <= m_length &&
+          w[m_current + 2] == 'L' &&
+          ((w[m_current + 3] == 'E' &&
+            w[m_current + 4] == 'S' &&
+            w[m_current + 5] == 'S') ||
+           (w[m_current + 3] == 'I' &&
+            ((w[m_current + 4] == 'K' && w[m_current + 5] == 'E') ||
+             (w[m_current + 4] == 'N' && w[m_current + 5] == 'E')))))) ||
+      (m_current >= 3 &&
+       m_current + 4 <= m_length &&
+       ((w[m_current - 3] == 'B' &&
+         memcmp(w + m_current - 2, "RISTLY", 6) == 0) ||
+        (w[m_current - 3] == 'G' &&
+         memcmp(w + m_current - 2, "RISTLY", 6) == 0) ||
+        (w[m_current - 3] == 'T' &&
+         memcmp(w + m_current - 2, "HISTLY", 6) == 0))) ||
+      (m_current >= 1 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 1, "USCLE", 5) == 0))
+  {
+    if ((m_length >= 7 &&
+         ((w[0] == 'C' && memcmp(w + 1, "RYSTLE", 6) == 0) ||
+          (w[0] == 'K' &&
+           w[1] == 'R' &&
+           ((w[2] == 'I' &&
+             w[3] == 'S' &&
+             w[4] == 'T' &&
+             ((w[5] == 'E' && w[6] == 'N') ||
+              (w[5] == 'L' && w[6] == 'E'))) ||
+            (w[2] == 'Y' && memcmp(w + 3, "STLE", 4) == 0))))) ||
+        (m_length >= 11 &&
+         w[0] == 'C' &&
+         w[1] == 'H' &&
+         w[2] == 'R' &&
+         w[3] == 'I' &&
+         w[4] == 'S' &&
+         w[5] == 'T' &&
+         w[6] == 'E' &&
+         w[7] == 'N' &&
+         w[8] == 'S' &&
+         ((w[9] == 'E' && w[10] == 'N') || (w[9] == 'O' && w[10] == 'N'))) ||
+        (m_current >= 3 &&
+         m_current + 6 <= m_length &&
+         memcmp(w + m_current - 3, "FIRSTLING", 9) == 0) ||
+        (m_current >= 2 &&
+         m_current + 6 <= m_length &&
+         ((w[m_current - 2] == 'N' &&
+           memcmp(w + m_current - 1, "ESTLING", 7) == 0) ||
+          (w[m_current - 2] == 'W' &&
+           memcmp(w + m_current - 1, "ESTLING", 7) == 0))))
+    {
+      add("ST");
+      m_current += 2;
+    }
+    else if (m_encodeVowels &&
+             m_current + 4 <= m_length &&
+             w[m_current + 3] == 'E' &&
+             ! (m_current + 5 <= m_length && w[m_current + 4] == 'R') &&
+             ! ((m_current + 5 <= m_length &&
+                 w[m_current + 3] == 'E' &&
+                 w[m_current + 4] == 'Y') ||
+                (m_current + 7 <= m_length &&
+                 w[m_current + 3] == 'E' &&
+                 w[m_current + 4] == 'T' &&
+                 w[m_current + 5] == 'T' &&
+                 (w[m_current + 6] == 'A' || w[m_current + 6] == 'E'))))
+    {
+      add("SAL");
+      flag_AL_inversion = true;
+      m_current += 3;
+    }
+    else
+    {
+      add("SL");
+      m_current += 3;
+    }
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Christmas, Metaphone3Spec.txt line 995.
+bool Metaphone3::encode_Christmas()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current >= 4 &&
+      m_current + 4 <= m_length &&
+      memcmp(w + m_current - 4, "CHRISTMA", 8) == 0)
+  {
+    add("SM");
+    m_current += 3;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_STHM, Metaphone3Spec.txt line 1000.
+bool Metaphone3::encode_STHM()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 4 <= m_length && memcmp(w + m_current, "STHM", 4) == 0)
+  {
+    add("SM");
+    m_current += 4;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_ISTEN, Metaphone3Spec.txt line 1005.
+bool Metaphone3::encode_ISTEN()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_length >= 8 && memcmp(w + 0, "CHRISTEN", 8) == 0)
+  {
+    if (rootOrInflections(m_inWord, "CHRISTEN") ||
+        (m_length >= 11 && memcmp(w + 0, "CHRISTENDOM", 11) == 0))
+    {
+      add("S", "ST");
+    }
+    else
+    {
+      add("ST");
+    }
+    m_current += 2;
+    return true;
+  }
+
+  if ((m_current >= 2 &&
+       m_current + 4 <= m_length &&
+       ((w[m_current - 2] == 'F' &&
+         memcmp(w + m_current - 1, "ASTEN", 5) == 0) ||
+        (w[m_current - 2] == 'H' &&
+         memcmp(w + m_current - 1, "ASTEN", 5) == 0) ||
+        (w[m_current - 2] == 'L' &&
+         memcmp(w + m_current - 1, "ISTEN", 5) == 0) ||
+        (w[m_current - 2] == 'M' &&
+         memcmp(w + m_current - 1, "USTNT", 5) == 0) ||
+        (w[m_current - 2] == 'R' &&
+         memcmp(w + m_current - 1, "ISTEN", 5) == 0))) ||
+      (m_current >= 3 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 3, "MOISTEN", 7) == 0))
+  {
+    add("S");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Sugar, Metaphone3Spec.txt line 1016.
+bool Metaphone3::encode_Sugar()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 5 <= m_length && memcmp(w + m_current, "SUGAR", 5) == 0)
+  {
+    add("X");
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_SH, Metaphone3Spec.txt line 1021.
+bool Metaphone3::encode_SH()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length &&
+      w[m_current] == 'S' &&
+      w[m_current + 1] == 'H' &&
+      m_current >= 2 &&
+      m_current + 6 <= m_length &&
+      memcmp(w + m_current - 2, "CASHMERE", 8) == 0)
+  {
+    add("J");
+    m_current += 2;
+    return true;
+  }
+
+  if (m_current + 2 <= m_length &&
+      w[m_current] == 'S' &&
+      w[m_current + 1] == 'H')
+  {
+    if (m_current == 0)
+    {
+      add("X");
+    }
+    else if ((m_current == m_last - 3 &&
+              m_current + 4 <= m_length &&
+              w[m_current + 1] == 'H' &&
+              w[m_current + 2] == 'A' &&
+              w[m_current + 3] == 'P') ||
+             (m_current + 5 <= m_length &&
+              w[m_current + 1] == 'H' &&
+              ((w[m_current + 2] == 'A' &&
+                ((w[m_current + 3] == 'A' && w[m_current + 4] == 'R') ||
+                 (w[m_current + 3] == 'W' && w[m_current + 4] == 'K'))) ||
+               (w[m_current + 2] == 'E' &&
+                ((w[m_current + 3] == 'A' && w[m_current + 4] == 'D') ||
+                 (w[m_current + 3] == 'I' &&
+                  (w[m_current + 4] == 'D' || w[m_current + 4] == 'M')) ||
+                 (w[m_current + 3] == 'L' && w[m_current + 4] == 'M'))) ||
+               (w[m_current + 2] == 'I' &&
+                w[m_current + 3] == 'L' &&
+                w[m_current + 4] == 'L') ||
+               (w[m_current + 2] == 'O' &&
+                ((w[m_current + 3] == 'E' && w[m_current + 4] == 'K') ||
+                 (w[m_current + 3] == 'L' &&
+                  (w[m_current + 4] == 'E' ||
+                   w[m_current + 4] == 'M' ||
+                   w[m_current + 4] == 'Z')) ||
+                 (w[m_current + 3] == 'O' && w[m_current + 4] == 'D') ||
+                 (w[m_current + 3] == 'R' && w[m_current + 4] == 'S'))) ||
+               (w[m_current + 2] == 'U' &&
+                w[m_current + 3] == 'N' &&
+                w[m_current + 4] == 'D'))) ||
+             (m_current + 6 <= m_length &&
+              w[m_current + 1] == 'H' &&
+              ((w[m_current + 2] == 'A' &&
+                w[m_current + 3] == 'T' &&
+                w[m_current + 4] == 'C' &&
+                w[m_current + 5] == 'H') ||
+               (w[m_current + 2] == 'E' &&
+                w[m_current + 3] == 'A' &&
+                w[m_current + 4] == 'R' &&
+                w[m_current + 5] == 'T') ||
+               (w[m_current + 2] == 'O' &&
+                ((w[m_current + 3] == 'N' &&
+                  w[m_current + 4] == 'O' &&
+                  w[m_current + 5] == 'R') ||
+                 (w[m_current + 3] == 'U' &&
+                  ((w[m_current + 4] == 'N' && w[m_current + 5] == 'D') ||
+                   (w[m_current + 4] == 'S' &&
+                    w[m_current + 5] == 'E'))))))) ||
+             (m_current == m_last - 4 &&
+              m_current + 5 <= m_length &&
+              w[m_current + 2] == 'E' &&
+              w[m_current + 3] == 'A' &&
+              w[m_current + 4] == 'R') ||
+             (m_current + 5 <= m_length &&
+              w[m_current + 2] == 'O' &&
+              w[m_current + 3] == 'R' &&
+              w[m_current + 4] == 'N' &&
+              ! (m_current >= 2 &&
+                 m_current + 5 <= m_length &&
+                 memcmp(w + m_current - 2, "UNSHORN", 7) == 0)) ||
+             (m_current + 5 <= m_length &&
+              memcmp(w + m_current + 1, "HOUR", 4) == 0 &&
+              ! ((m_length >= 6 && memcmp(w + 0, "ASHOUR", 6) == 0) ||
+                 (m_length >= 7 && memcmp(w + 0, "BASHOUR", 7) == 0) ||
+                 (m_length >= 8 && memcmp(w + 0, "MANSHOUR", 8) == 0))) ||
+             (m_current + 7 <= m_length &&
+              ((w[m_current + 2] == 'A' &&
+                ((w[m_current + 3] == 'L' &&
+                  w[m_current + 4] == 'L' &&
+                  w[m_current + 5] == 'O' &&
+                  w[m_current + 6] == 'W') ||
+                 (w[m_current + 3] == 'N' &&
+                  w[m_current + 4] == 'D' &&
+                  w[m_current + 5] == 'L' &&
+                  w[m_current + 6] == 'E') ||
+                 (w[m_current + 3] == 'R' &&
+                  w[m_current + 4] == 'M' &&
+                  w[m_current + 5] == 'O' &&
+                  w[m_current + 6] == 'N'))) ||
+               (w[m_current + 2] == 'E' &&
+                memcmp(w + m_current + 3, "IMER", 4) == 0) ||
+               (w[m_current + 2] == 'O' &&
+                ((w[m_current + 3] == 'L' &&
+                  w[m_current + 4] == 'D' &&
+                  w[m_current + 5] == 'E' &&
+                  w[m_current + 6] == 'R') ||
+                 (w[m_current + 3] == 'N' &&
+                  ((w[m_current + 4] == 'E' &&
+                    w[m_current + 5] == 'S' &&
+                    w[m_current + 6] == 'T') ||
+                   (w[m_current + 4] == 'O' &&
+                    w[m_current + 5] == 'U' &&
+                    w[m_current + 6] == 'R'))) ||
+                 (w[m_current + 3] == 'P' &&
+                  w[m_current + 4] == 'P' &&
+                  w[m_current + 5] == 'E' &&
+                  w[m_current + 6] == 'R'))))) ||
+             (m_current + 8 <= m_length &&
+              ((w[m_current + 2] == 'A' &&
+                w[m_current + 3] == 'B' &&
+                w[m_current + 4] == 'I' &&
+                ((w[m_current + 5] == 'L' &&
+                  w[m_current + 6] == 'L' &&
+                  w[m_current + 7] == 'E') ||
+                 (w[m_current + 5] == 'T' &&
+                  w[m_current + 6] == 'U' &&
+                  w[m_current + 7] == 'A'))) ||
+               (w[m_current + 2] == 'U' &&
+                memcmp(w + m_current + 3, "MANCE", 5) == 0))))
+    {
+      if (! (m_current >= 1 &&
+             m_current <= m_length &&
+             w[m_current - 1] == 'S'))
+      {
+        add("S");
+      }
+    }
+    else
+    {
+      add("X");
+    }
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_SCH, Metaphone3Spec.txt line 1042.
+bool Metaphone3::encode_SCH()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 3 <= m_length &&
+      w[m_current + 1] == 'C' &&
+      w[m_current + 2] == 'H' &&
+      m_current > 0 &&
+      ((m_current + 6 <= m_length &&
+        ((w[m_current + 3] == 'E' &&
+          w[m_current + 4] == 'A' &&
+          w[m_current + 5] == 'T') ||
+         (w[m_current + 3] == 'I' &&
+          w[m_current + 4] == 'E' &&
+          w[m_current + 5] == 'F'))) ||
+       (m_current + 7 <= m_length &&
+        w[m_current + 3] == 'A' &&
+        ((w[m_current + 4] == 'N' &&
+          w[m_current + 5] == 'C' &&
+          w[m_current + 6] == 'E') ||
+         (w[m_current + 4] == 'R' &&
+          w[m_current + 5] == 'G' &&
+          w[m_current + 6] == 'E'))) ||
+       (m_length >= 6 && memcmp(w + 0, "ESCHEW", 6) == 0)))
+  {
+    add("S");
+    m_current++;
+    return true;
+  }
+
+  if (m_current + 3 <= m_length &&
+      w[m_current + 1] == 'C' &&
+      w[m_current + 2] == 'H')
+  {
+    if ((m_current + 5 <= m_length &&
+         ((w[m_current + 3] == 'E' &&
+           (w[m_current + 4] == 'D' ||
+            w[m_current + 4] == 'M' ||
+            w[m_current + 4] == 'N' ||
+            w[m_current + 4] == 'R')) ||
+          (w[m_current + 3] == 'I' &&
+           (w[m_current + 4] == 'A' ||
+            w[m_current + 4] == 'S' ||
+            w[m_current + 4] == 'Z')) ||
+          (w[m_current + 3] == 'O' &&
+           (w[m_current + 4] == 'L' || w[m_current + 4] == 'O')) ||
+          (w[m_current + 3] == 'U' && w[m_current + 4] == 'Y')) &&
+         ! (m_current + 6 <= m_length &&
+            w[m_current] == 'S' &&
+            w[m_current + 1] == 'C' &&
+            w[m_current + 2] == 'H' &&
+            ((w[m_current + 3] == 'E' &&
+              w[m_current + 4] == 'R' &&
+              w[m_current + 5] == 'R') ||
+             (w[m_current + 3] == 'I' &&
+              w[m_current + 4] == 'S' &&
+              w[m_current + 5] == 'L') ||
+             (w[m_current + 3] == 'O' &&
+              w[m_current + 4] == 'L' &&
+              w[m_current + 5] == 'T')))) ||
+        (m_current + 6 <= m_length &&
+         w[m_current + 3] == 'I' &&
+         w[m_current + 4] == 'S' &&
+         w[m_current + 5] == 'Z') ||
+        (m_current >= 1 &&
+         m_current + 5 <= m_length &&
+         ((w[m_current - 1] == 'A' &&
+           w[m_current] == 'S' &&
+           w[m_current + 1] == 'C' &&
+           w[m_current + 2] == 'H' &&
+           ((w[m_current + 3] == 'A' && w[m_current + 4] == 'L') ||
+            (w[m_current + 3] == 'I' && w[m_current + 4] == 'N'))) ||
+          (w[m_current - 1] == 'E' &&
+           memcmp(w + m_current, "SCHAT", 5) == 0) ||
+          (w[m_current - 1] == 'I' &&
+           w[m_current] == 'S' &&
+           w[m_current + 1] == 'C' &&
+           w[m_current + 2] == 'H' &&
+           ((w[m_current + 3] == 'A' && w[m_current + 4] == 'E') ||
+            (w[m_current + 3] == 'I' && w[m_current + 4] == 'A')))) &&
+         ! (m_current >= 2 &&
+            m_current + 6 <= m_length &&
+            memcmp(w + m_current - 2, "FASCHING", 8) == 0)) ||
+        (m_current == m_last - 3 &&
+         m_current >= 1 &&
+         m_current + 4 <= m_length &&
+         memcmp(w + m_current - 1, "ESCHI", 5) == 0) ||
+        (m_current + 4 <= m_length && w[m_current + 3] == 'Y'))
+    {
+      if (m_current + 5 <= m_length &&
+          ((w[m_current + 3] == 'E' &&
+            (w[m_current + 4] == 'N' || w[m_current + 4] == 'R')) ||
+           (w[m_current + 3] == 'I' && w[m_current + 4] == 'S')) &&
+          (m_current == m_last - 4 ||
+           (m_current + 6 <= m_length &&
+            ((w[m_current + 3] == 'E' &&
+              w[m_current + 4] == 'N' &&
+              (w[m_current + 5] == 'B' || w[m_current + 5] == 'K')) ||
+             (w[m_current + 3] == 'I' &&
+              w[m_current + 4] == 'S' &&
+              w[m_current + 5] == 'T')))))
+      {
+        add("X", "SK");
+      }
+      else
+      {
+        add("SK");
+      }
+    }
+    else
+    {
+      add("X");
+    }
+    m_current += 3;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_SUR, Metaphone3Spec.txt line 1061.
+bool Metaphone3::encode_SUR()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 4 <= m_length &&
+      w[m_current + 1] == 'U' &&
+      w[m_current + 2] == 'R' &&
+      (w[m_current + 3] == 'A' ||
+       w[m_current + 3] == 'E' ||
+       w[m_current + 3] == 'Y'))
+  {
+    if (m_current == 0 ||
+        (m_current >= 1 &&
+         m_current <= m_length &&
+         (w[m_current - 1] == 'K' || w[m_current - 1] == 'N')) ||
+        (m_current >= 2 &&
+         m_current <= m_length &&
+         w[m_current - 2] == 'N' &&
+         w[m_current - 1] == 'O'))
+    {
+      add("X");
+    }
+    else
+    {
+      add("J");
+    }
+    advanceCounter(2, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_SU, Metaphone3Spec.txt line 1069.
+bool Metaphone3::encode_SU()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current != 0 &&
+      m_current + 3 <= m_length &&
+      w[m_current + 1] == 'U' &&
+      (w[m_current + 2] == 'A' || w[m_current + 2] == 'O'))
+  {
+    if (m_current >= 1 &&
+        m_current + 3 <= m_length &&
+        memcmp(w + m_current - 1, "RSUA", 4) == 0)
+    {
+      add("S");
+    }
+    else if (isVowel(m_current - 1))
+    {
+      add("J", "S");
+    }
+    else
+    {
+      add("X", "S");
+    }
+    advanceCounter(3, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_SSIO, Metaphone3Spec.txt line 1079.
+bool Metaphone3::encode_SSIO()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 5 <= m_length && memcmp(w + m_current + 1, "SION", 4) == 0)
+  {
+    if (m_current >= 2 &&
+        m_current <= m_length &&
+        w[m_current - 2] == 'C' &&
+        w[m_current - 1] == 'I')
+    {
+      add("J");
+    }
+    else if (isVowel(m_current - 1))
+    {
+      add("X");
+    }
+    advanceCounter(4, 2);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_SS, Metaphone3Spec.txt line 1087.
+bool Metaphone3::encode_SS()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current >= 1 &&
+       m_current + 4 <= m_length &&
+       ((w[m_current - 1] == 'E' && memcmp(w + m_current, "SSUR", 4) == 0) ||
+        (w[m_current - 1] == 'I' &&
+         w[m_current] == 'S' &&
+         w[m_current + 1] == 'S' &&
+         w[m_current + 2] == 'U' &&
+         (w[m_current + 3] == 'E' || w[m_current + 3] == 'R')) ||
+        (w[m_current - 1] == 'U' &&
+         memcmp(w + m_current, "SSIA", 4) == 0))) ||
+      (m_current >= 1 &&
+       m_current + 5 <= m_length &&
+       ((w[m_current - 1] == 'A' &&
+         w[m_current] == 'S' &&
+         w[m_current + 1] == 'S' &&
+         ((w[m_current + 2] == 'I' &&
+           w[m_current + 3] == 'U' &&
+           w[m_current + 4] == 'S') ||
+          (w[m_current + 2] == 'U' &&
+           w[m_current + 3] == 'R' &&
+           (w[m_current + 4] == 'A' || w[m_current + 4] == 'E')))) ||
+        (w[m_current - 1] == 'E' && memcmp(w + m_current, "SSIAN", 5) == 0) ||
+        (w[m_current - 1] == 'I' &&
+         w[m_current] == 'S' &&
+         w[m_current + 1] == 'S' &&
+         w[m_current + 2] == 'U' &&
+         w[m_current + 3] == 'A' &&
+         (w[m_current + 4] == 'B' || w[m_current + 4] == 'N')))))
+  {
+    add("X");
+    advanceCounter(3, 2);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_SIA, Metaphone3Spec.txt line 1093.
+bool Metaphone3::encode_SIA()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current >= 2 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 2, "CHSIA", 5) == 0) ||
+      (m_current >= 1 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 1, "RSIAL", 5) == 0))
+  {
+    add("X");
+    advanceCounter(3, 1);
+    return true;
+  }
+
+  if ((m_current == 3 &&
+       m_length >= 6 &&
+       ((w[0] == 'A' &&
+         w[1] == 'L' &&
+         ((w[2] == 'E' && w[3] == 'S' && w[4] == 'I' && w[5] == 'A') ||
+          (w[2] == 'I' && w[3] == 'S' && w[4] == 'I' && w[5] == 'A') ||
+          (w[2] == 'Y' && w[3] == 'S' && w[4] == 'I' && w[5] == 'A'))) ||
+        (w[0] == 'S' && memcmp(w + 1, "TASIA", 5) == 0)) &&
+       ! (m_length >= 9 && memcmp(w + 0, "ANASTASIA", 9) == 0)) ||
+      (m_current >= 5 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 5, "THERESIA", 8) == 0) ||
+      (m_current >= 5 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 5, "DIONYSIAN", 9) == 0))
+  {
+    add("X", "S");
+    advanceCounter(3, 1);
+    return true;
+  }
+
+  if ((m_current == m_last - 2 &&
+       m_current + 3 <= m_length &&
+       w[m_current] == 'S' &&
+       w[m_current + 1] == 'I' &&
+       w[m_current + 2] == 'A') ||
+      (m_current == m_last - 3 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current, "SIAN", 4) == 0) ||
+      (m_current >= 5 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 5, "AMBROSIAL", 9) == 0))
+  {
+    if ((isVowel(m_current - 1) ||
+         (m_current >= 1 &&
+          m_current <= m_length &&
+          w[m_current - 1] == 'R')) &&
+        ! ((m_length >= 5 &&
+            ((w[0] == 'J' && memcmp(w + 1, "AMES", 4) == 0) ||
+             (w[0] == 'N' && memcmp(w + 1, "ICOS", 4) == 0) ||
+             (w[0] == 'P' &&
+              w[1] == 'E' &&
+              ((w[2] == 'G' && w[3] == 'A' && w[4] == 'S') ||
+               (w[2] == 'P' && w[3] == 'Y' && w[4] == 'S'))))) ||
+           (m_length >= 6 &&
+            ((w[0] == 'H' &&
+              w[1] == 'O' &&
+              ((w[2] == 'B' && w[3] == 'B' && w[4] == 'E' && w[5] == 'S') ||
+               (w[2] == 'L' && w[3] == 'M' && w[4] == 'E' && w[5] == 'S'))) ||
+             (w[0] == 'J' && memcmp(w + 1, "AQUES", 5) == 0) ||
+             (w[0] == 'K' && memcmp(w + 1, "EYNES", 5) == 0))) ||
+           (m_length >= 7 &&
+            ((w[0] == 'H' && memcmp(w + 1, "OMOOUS", 6) == 0) ||
+             (w[0] == 'M' && memcmp(w + 1, "ALTHUS", 6) == 0))) ||
+           (m_length >= 8 &&
+            ((w[0] == 'H' && memcmp(w + 1, "OMOIOUS", 7) == 0) ||
+             (w[0] == 'M' && memcmp(w + 1, "AGLEMOS", 7) == 0))) ||
+           (m_length >= 9 &&
+            ((w[0] == 'L' && memcmp(w + 1, "EVALLOIS", 8) == 0) ||
+             (w[0] == 'T' && memcmp(w + 1, "ARDENOIS", 8) == 0)))) &&
+        ! (m_current >= 4 &&
+           m_current + 1 <= m_length &&
+           memcmp(w + m_current - 4, "ALGES", 5) == 0))
+    {
+      add("J");
+    }
+    else
+    {
+      add("S");
+    }
+    advanceCounter(2, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_SIO, Metaphone3Spec.txt line 1114.
+bool Metaphone3::encode_SIO()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_length >= 7 && memcmp(w + 0, "SIOBHAN", 7) == 0)
+  {
+    add("X");
+    advanceCounter(3, 1);
+    return true;
+  }
+
+  if (m_current + 4 <= m_length &&
+      w[m_current + 1] == 'I' &&
+      w[m_current + 2] == 'O' &&
+      w[m_current + 3] == 'N')
+  {
+    if (isVowel(m_current - 1) ||
+        (m_current >= 2 &&
+         m_current <= m_length &&
+         ((w[m_current - 2] == 'E' && w[m_current - 1] == 'R') ||
+          (w[m_current - 2] == 'U' && w[m_current - 1] == 'R'))))
+    {
+      add("J");
+    }
+    else
+    {
+      add("X");
+    }
+    advanceCounter(3, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Anglicisations, Metaphone3Spec.txt line 1125.
+bool Metaphone3::encode_Anglicisations()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current == 0 &&
+       m_length >= 2 &&
+       (w[1] == 'L' || w[1] == 'M' || w[1] == 'N')) ||
+      (m_current + 2 <= m_length && w[m_current + 1] == 'Z'))
+  {
+    add("S", "X");
+    if (m_current + 2 <= m_length && w[m_current + 1] == 'Z')
+    {
+      m_current += 2;
+    }
+    else
+    {
+      m_current++;
+    }
+    return true;
+  }
+  return false;
+}
+
+
+// encode_SC, Metaphone3Spec.txt line 1133.
+bool Metaphone3::encode_SC()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length &&
+      w[m_current] == 'S' &&
+      w[m_current + 1] == 'C' &&
+      m_current >= 2 &&
+      m_current + 6 <= m_length &&
+      memcmp(w + m_current - 2, "VISCOUNT", 8) == 0)
+  {
+    m_current++;
+    return true;
+  }
+
+  if (m_current + 2 <= m_length &&
+      w[m_current] == 'S' &&
+      w[m_current + 1] == 'C' &&
+      m_current + 3 <= m_length &&
+      (w[m_current + 2] == 'E' ||
+       w[m_current + 2] == 'I' ||
+       w[m_current + 2] == 'Y'))
+  {
+    if ((m_current + 5 <= m_length &&
+         w[m_current + 2] == 'I' &&
+         w[m_current + 3] == 'U' &&
+         w[m_current + 4] == 'T') ||
+        (m_current + 6 <= m_length &&
+         memcmp(w + m_current + 2, "IOUS", 4) == 0) ||
+        (m_current >= 4 &&
+         m_current + 5 <= m_length &&
+         memcmp(w + m_current - 4, "OMNISCIEN", 9) == 0) ||
+        (m_current >= 3 &&
+         m_current + 5 <= m_length &&
+         w[m_current - 3] == 'C' &&
+         ((w[m_current - 2] == 'O' &&
+           w[m_current - 1] == 'N' &&
+           w[m_current] == 'S' &&
+           w[m_current + 1] == 'C' &&
+           w[m_current + 2] == 'I' &&
+           ((w[m_current + 3] == 'E' && w[m_current + 4] == 'N') ||
+            (w[m_current + 3] == 'O' && w[m_current + 4] == 'N'))) ||
+          (w[m_current - 2] == 'R' &&
+           memcmp(w + m_current - 1, "ESCEND", 6) == 0))) ||
+        (m_current >= 2 &&
+         m_current + 4 <= m_length &&
+         memcmp(w + m_current - 2, "FASCIS", 6) == 0))
+    {
+      add("X");
+    }
+    else if ((m_current + 5 <= m_length &&
+              w[m_current] == 'S' &&
+              w[m_current + 1] == 'C' &&
+              w[m_current + 2] == 'I' &&
+              ((w[m_current + 3] == 'R' && w[m_current + 4] == 'O') ||
+               (w[m_current + 3] == 'V' && w[m_current + 4] == 'V'))) ||
+             (m_current + 6 <= m_length &&
+              memcmp(w + m_current, "SCIPIO", 6) == 0) ||
+             (m_current + 7 <= m_length &&
+              w[m_current] == 'S' &&
+              w[m_current + 1] == 'C' &&
+              w[m_current + 2] == 'E' &&
+              w[m_current + 3] == 'P' &&
+              ((w[m_current + 4] == 'S' &&
+                w[m_current + 5] == 'I' &&
+                w[m_current + 6] == 'S') ||
+               (w[m_current + 4] == 'T' &&
+                w[m_current + 5] == 'I' &&
+                w[m_current + 6] == 'C'))) ||
+             (m_current >= 2 &&
+              m_current + 8 <= m_length &&
+              memcmp(w + m_current - 2, "PISCITELLI", 10) == 0))
+    {
+      add("SK");
+    }
+    else
+    {
+      add("S");
+    }
+    m_current += 2;
+    return true;
+  }
+
+  if (m_current + 2 <= m_length &&
+      w[m_current] == 'S' &&
+      w[m_current + 1] == 'C')
+  {
+    add("SK");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_SEA_SUI_SIER, Metaphone3Spec.txt line 1151.
+bool Metaphone3::encode_SEA_SUI_SIER()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current == m_last - 2 &&
+       m_current >= 3 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 3, "NAUSEA", 6) == 0) ||
+      (m_current >= 2 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 2, "CASUI", 5) == 0) ||
+      (m_current >= 1 &&
+       m_current + 4 <= m_length &&
+       ((w[m_current - 1] == 'A' && memcmp(w + m_current, "SIER", 4) == 0) ||
+        (w[m_current - 1] == 'O' && memcmp(w + m_current, "SIER", 4) == 0)) &&
+       ! ((m_length >= 5 && memcmp(w + 0, "OSIER", 5) == 0) ||
+          (m_length >= 6 && memcmp(w + 0, "EASIER", 6) == 0) ||
+          (m_current >= 2 &&
+           m_current + 4 <= m_length &&
+           ((w[m_current - 2] == 'M' &&
+             memcmp(w + m_current - 1, "OSIER", 5) == 0) ||
+            (w[m_current - 2] == 'R' &&
+             memcmp(w + m_current - 1, "OSIER", 5) == 0))))))
+  {
+    add("J", "X");
+    advanceCounter(3, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_SEA, Metaphone3Spec.txt line 1159.
+bool Metaphone3::encode_SEA()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current == m_last - 3 &&
+       m_length >= 4 &&
+       memcmp(w + 0, "SEAN", 4) == 0) ||
+      (m_current >= 3 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 3, "NAUSEO", 6) == 0 &&
+       ! (m_current >= 3 &&
+          m_current + 4 <= m_length &&
+          memcmp(w + m_current - 3, "NAUSEAT", 7) == 0)))
+  {
+    add("X");
+    advanceCounter(3, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_T_Initial, Metaphone3Spec.txt line 1168.
+bool Metaphone3::encode_T_Initial()
+{
+  const char * w = m_inWord.c_str();
+
+  if (! (m_current == 0))
+    return false;
+
+  if (m_current + 4 <= m_length &&
+      ((w[m_current + 1] == 'S' &&
+        w[m_current + 2] == 'A' &&
+        w[m_current + 3] == 'R') ||
+       (w[m_current + 1] == 'Z' &&
+        w[m_current + 2] == 'A' &&
+        w[m_current + 3] == 'R')))
+  {
+    m_current++;
+    return true;
+  }
+
+  if ((m_length == 3 &&
+       m_current + 3 <= m_length &&
+       w[m_current + 1] == 'S' &&
+       (w[m_current + 2] == 'A' ||
+        w[m_current + 2] == 'O' ||
+        w[m_current + 2] == 'U')) ||
+      (m_length == 4 &&
+       m_current + 4 <= m_length &&
+       w[m_current + 1] == 'S' &&
+       w[m_current + 2] == 'A' &&
+       (w[m_current + 3] == 'I' || w[m_current + 3] == 'O')) ||
+      (m_length == 5 &&
+       m_current + 5 <= m_length &&
+       w[m_current + 1] == 'S' &&
+       ((w[m_current + 2] == 'A' &&
+         w[m_current + 3] == 'N' &&
+         w[m_current + 4] == 'G') ||
+        (w[m_current + 2] == 'I' &&
+         w[m_current + 3] == 'N' &&
+         w[m_current + 4] == 'G'))))
+  {
+    add("X");
+    advanceCounter(3, 2);
+    return true;
+  }
+
+  if (m_current + 2 <= m_length &&
+      w[m_current + 1] == 'S' &&
+      isVowel(m_current + 2))
+  {
+    add("TS", "S");
+    advanceCounter(3, 2);
+    return true;
+  }
+
+  if (m_current + 2 <= m_length && w[m_current + 1] == 'J')
+  {
+    add("X");
+    advanceCounter(3, 2);
+    return true;
+  }
+
+  if ((m_length == 3 &&
+       m_current + 3 <= m_length &&
+       w[m_current + 1] == 'H' &&
+       w[m_current + 2] == 'U') ||
+      (m_current + 4 <= m_length &&
+       w[m_current + 1] == 'H' &&
+       ((w[m_current + 2] == 'A' &&
+         (w[m_current + 3] == 'I' || w[m_current + 3] == 'O')) ||
+        (w[m_current + 2] == 'U' && w[m_current + 3] == 'Y'))) ||
+      (m_current + 5 <= m_length &&
+       w[m_current + 1] == 'H' &&
+       ((w[m_current + 2] == 'A' &&
+         w[m_current + 3] == 'N' &&
+         w[m_current + 4] == 'H') ||
+        (w[m_current + 2] == 'Y' &&
+         w[m_current + 3] == 'M' &&
+         (w[m_current + 4] == 'E' || w[m_current + 4] == 'Y')))) ||
+      (m_current + 6 <= m_length &&
+       memcmp(w + m_current + 1, "HERES", 5) == 0))
+  {
+    add("T");
+    advanceCounter(3, 2);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_TCH, Metaphone3Spec.txt line 1188.
+bool Metaphone3::encode_TCH()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 3 <= m_length &&
+      w[m_current + 1] == 'C' &&
+      w[m_current + 2] == 'H')
+  {
+    add("X");
+    m_current += 3;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Silent_French_T, Metaphone3Spec.txt line 1193.
+bool Metaphone3::encode_Silent_French_T()
+{
+  const char * w = m_inWord.c_str();
+
+  if (((m_current == m_last &&
+        m_current >= 4 &&
+        m_current + 1 <= m_length &&
+        ((w[m_current - 4] == 'C' &&
+          memcmp(w + m_current - 3, "HAUT", 4) == 0) ||
+         (w[m_current - 4] == 'G' &&
+          memcmp(w + m_current - 3, "ENET", 4) == 0) ||
+         (w[m_current - 4] == 'M' &&
+          memcmp(w + m_current - 3, "ONET", 4) == 0))) ||
+       (m_current >= 2 &&
+        m_current + 7 <= m_length &&
+        memcmp(w + m_current - 2, "POTPOURRI", 9) == 0) ||
+       (m_current >= 3 &&
+        m_current + 5 <= m_length &&
+        memcmp(w + m_current - 3, "MORTGAGE", 8) == 0) ||
+       (m_current >= 3 &&
+        m_current + 6 <= m_length &&
+        memcmp(w + m_current - 3, "BOATSWAIN", 9) == 0) ||
+       (m_current >= 4 &&
+        m_current + 1 <= m_length &&
+        ((w[m_current - 4] == 'B' &&
+          ((w[m_current - 3] == 'E' &&
+            w[m_current - 2] == 'R' &&
+            w[m_current - 1] == 'E' &&
+            w[m_current] == 'T') ||
+           (w[m_current - 3] == 'I' &&
+            w[m_current - 2] == 'D' &&
+            w[m_current - 1] == 'E' &&
+            w[m_current] == 'T'))) ||
+         (w[m_current - 4] == 'D' &&
+          w[m_current - 3] == 'E' &&
+          ((w[m_current - 2] == 'B' &&
+            w[m_current - 1] == 'U' &&
+            w[m_current] == 'T') ||
+           (w[m_current - 2] == 'P' &&
+            w[m_current - 1] == 'O' &&
+            w[m_current] == 'T'))) ||
+         (w[m_current - 4] == 'F' &&
+          memcmp(w + m_current - 3, "ILET", 4) == 0) ||
+         (w[m_current - 4] == 'P' &&
+          memcmp(w + m_current - 3, "INOT", 4) == 0) ||
+         (w[m_current - 4] == 'T' &&
+          memcmp(w + m_current - 3, "AROT", 4) == 0))) ||
+       (m_current >= 5 &&
+        m_current + 1 <= m_length &&
+        ((w[m_current - 5] == 'B' &&
+          ((w[m_current - 4] == 'A' &&
+            memcmp(w + m_current - 3, "LLET", 4) == 0) ||
+           (w[m_current - 4] == 'E' &&
+            memcmp(w + m_current - 3, "NOIT", 4) == 0) ||
+           (w[m_current - 4] == 'U' &&
+            memcmp(w + m_current - 3, "FFET", 4) == 0))) ||
+         (w[m_current - 5] == 'C' &&
+          ((w[m_current - 4] == 'A' &&
+            memcmp(w + m_current - 3, "CHET", 4) == 0) ||
+           (w[m_current - 4] == 'H' &&
+            w[m_current - 3] == 'A' &&
+            ((w[m_current - 2] == 'B' &&
+              w[m_current - 1] == 'O' &&
+              w[m_current] == 'T') ||
+             (w[m_current - 2] == 'L' &&
+              w[m_current - 1] == 'E' &&
+              w[m_current] == 'T'))))) ||
+         (w[m_current - 5] == 'E' &&
+          memcmp(w + m_current - 4, "SPRIT", 5) == 0) ||
+         (w[m_current - 5] == 'G' &&
+          memcmp(w + m_current - 4, "OULET", 5) == 0) ||
+         (w[m_current - 5] == 'R' &&
+          memcmp(w + m_current - 4, "AGOUT", 5) == 0))) ||
+       (m_current >= 6 &&
+        m_current + 1 <= m_length &&
+        ((w[m_current - 6] == 'B' &&
+          memcmp(w + m_current - 5, "OUQUET", 6) == 0) ||
+         (w[m_current - 6] == 'C' &&
+          ((w[m_current - 5] == 'A' &&
+            memcmp(w + m_current - 4, "BARET", 5) == 0) ||
+           (w[m_current - 5] == 'O' &&
+            memcmp(w + m_current - 4, "URBET", 5) == 0) ||
+           (w[m_current - 5] == 'R' &&
+            w[m_current - 4] == 'O' &&
+            ((w[m_current - 3] == 'C' &&
+              w[m_current - 2] == 'H' &&
+              w[m_current - 1] == 'E' &&
+              w[m_current] == 'T') ||
+             (w[m_current - 3] == 'Q' &&
+              w[m_current - 2] == 'U' &&
+              w[m_current - 1] == 'E' &&
+              w[m_current] == 'T'))))) ||
+         (w[m_current - 6] == 'D' &&
+          memcmp(w + m_current - 5, "IDEROT", 6) == 0) ||
+         (w[m_current - 6] == 'G' &&
+          memcmp(w + m_current - 5, "OURMET", 6) == 0) ||
+         (w[m_current - 6] == 'P' &&
+          ((w[m_current - 5] == 'A' &&
+            w[m_current - 4] == 'R' &&
+            ((w[m_current - 3] == 'F' &&
+              w[m_current - 2] == 'A' &&
+              w[m_current - 1] == 'I' &&
+              w[m_current] == 'T') ||
+             (w[m_current - 3] == 'Q' &&
+              w[m_current - 2] == 'U' &&
+              w[m_current - 1] == 'E' &&
+              w[m_current] == 'T'))) ||
+           (w[m_current - 5] == 'I' &&
+            memcmp(w + m_current - 4, "NCHOT", 5) == 0))) ||
+         (w[m_current - 6] == 'R' &&
+          memcmp(w + m_current - 5, "APPORT", 6) == 0) ||
+         (w[m_current - 6] == 'T' &&
+          memcmp(w + m_current - 5, "OUCHET", 6) == 0))) ||
+       (m_current >= 7 &&
+        m_current + 1 <= m_length &&
+        ((w[m_current - 7] == 'C' &&
+          memcmp(w + m_current - 6, "ABERNET", 7) == 0) ||
+         (w[m_current - 7] == 'D' &&
+          memcmp(w + m_current - 6, "UBONNET", 7) == 0) ||
+         (w[m_current - 7] == 'E' &&
+          ((w[m_current - 6] == 'N' &&
+            memcmp(w + m_current - 5, "TREPOT", 6) == 0) ||
+           (w[m_current - 6] == 'S' &&
+            memcmp(w + m_current - 5, "CARGOT", 6) == 0))) ||
+         (w[m_current - 7] == 'M' &&
+          ((w[m_current - 6] == 'A' &&
+            memcmp(w + m_current - 5, "SSENET", 6) == 0) ||
+           (w[m_current - 6] == 'U' &&
+            memcmp(w + m_current - 5, "SCADET", 6) == 0))) ||
+         (w[m_current - 7] == 'R' &&
+          memcmp(w + m_current - 6, "ICOCHET", 7) == 0))) ||
+       (m_current >= 8 &&
+        m_current + 1 <= m_length &&
+        ((w[m_current - 8] == 'C' &&
+          w[m_current - 7] == 'A' &&
+          ((w[m_current - 6] == 'B' &&
+            memcmp(w + m_current - 5, "RIOLET", 6) == 0) ||
+           (w[m_current - 6] == 'M' &&
+            memcmp(w + m_current - 5, "EMBERT", 6) == 0) ||
+           (w[m_current - 6] == 'S' &&
+            memcmp(w + m_current - 5, "SOULET", 6) == 0))) ||
+         (w[m_current - 8] == 'O' &&
+          memcmp(w + m_current - 7, "UBRIQUET", 8) == 0) ||
+         (w[m_current - 8] == 'S' &&
+          memcmp(w + m_current - 7, "OBRIQUET", 8) == 0)))) &&
+      ! (m_current + 3 <= m_length &&
+         ((w[m_current + 1] == 'A' && w[m_current + 2] == 'N') ||
+          (w[m_current + 1] == 'I' &&
+           (w[m_current + 2] == 'C' || w[m_current + 2] == 'N')) ||
+          (w[m_current + 1] == 'O' && w[m_current + 2] == 'M') ||
+          (w[m_current + 1] == 'R' && w[m_current + 2] == 'Y'))))
+  {
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_TUN_TUL_TUA_TUO, Metaphone3Spec.txt line 1208.
+bool Metaphone3::encode_TUN_TUL_TUA_TUO()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current >= 3 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 3, "FORTUN", 6) == 0) ||
+      (m_current + 3 <= m_length &&
+       w[m_current] == 'T' &&
+       w[m_current + 1] == 'U' &&
+       w[m_current + 2] == 'L' &&
+       isVowel(m_current - 1) &&
+       isVowel(m_current + 3)) ||
+      (m_current >= 2 &&
+       m_current + 3 <= m_length &&
+       w[m_current - 2] == 'B' &&
+       w[m_current - 1] == 'I' &&
+       w[m_current] == 'T' &&
+       w[m_current + 1] == 'U' &&
+       (w[m_current + 2] == 'A' || w[m_current + 2] == 'E')) ||
+      (m_current > 1 &&
+       m_current + 3 <= m_length &&
+       w[m_current] == 'T' &&
+       w[m_current + 1] == 'U' &&
+       (w[m_current + 2] == 'A' || w[m_current + 2] == 'O')))
+  {
+    add("X", "T");
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_TUE_TEU_TEOU_TUL_TIE, Metaphone3Spec.txt line 1216.
+bool Metaphone3::encode_TUE_TEU_TEOU_TUL_TIE()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current + 5 <= m_length &&
+       memcmp(w + m_current + 1, "UENT", 4) == 0) ||
+      (m_current >= 4 &&
+       m_current + 5 <= m_length &&
+       memcmp(w + m_current - 4, "RIGHTEOUS", 9) == 0) ||
+      (m_current >= 3 &&
+       m_current + 4 <= m_length &&
+       ((w[m_current - 3] == 'A' &&
+         memcmp(w + m_current - 2, "MATEUR", 6) == 0) ||
+        (w[m_current - 3] == 'S' &&
+         memcmp(w + m_current - 2, "TATUTE", 6) == 0))) ||
+      (m_current >= 3 &&
+       m_current + 5 <= m_length &&
+       memcmp(w + m_current - 3, "STATUTOR", 8) == 0) ||
+      (m_current >= 1 &&
+       m_current + 4 <= m_length &&
+       ((w[m_current - 1] == 'N' &&
+         w[m_current] == 'T' &&
+         w[m_current + 1] == 'U' &&
+         w[m_current + 2] == 'L' &&
+         (w[m_current + 3] == 'A' || w[m_current + 3] == 'E')) ||
+        (w[m_current - 1] == 'S' &&
+         w[m_current] == 'T' &&
+         ((w[m_current + 1] == 'E' &&
+           w[m_current + 2] == 'U' &&
+           w[m_current + 3] == 'R') ||
+          (w[m_current + 1] == 'U' &&
+           w[m_current + 2] == 'L' &&
+           (w[m_current + 3] == 'A' || w[m_current + 3] == 'E')))))) ||
+      (m_current == m_last - 2 &&
+       m_current + 3 <= m_length &&
+       w[m_current] == 'T' &&
+       w[m_current + 1] == 'U' &&
+       w[m_current + 2] == 'E') ||
+      (m_current + 5 <= m_length && memcmp(w + m_current, "TUENC", 5) == 0) ||
+      (m_current == m_last - 5 &&
+       m_current + 6 <= m_length &&
+       memcmp(w + m_current, "TIENCE", 6) == 0))
+  {
+    add("X", "T");
+    advanceCounter(2, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_TUR_TIU_Suffixes, Metaphone3Spec.txt line 1227.
+bool Metaphone3::encode_TUR_TIU_Suffixes()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current > 0 &&
+      m_current + 4 <= m_length &&
+      ((w[m_current + 1] == 'I' &&
+        w[m_current + 2] == 'U' &&
+        w[m_current + 3] == 'S') ||
+       (w[m_current + 1] == 'U' &&
+        w[m_current + 2] == 'R' &&
+        (w[m_current + 3] == 'A' ||
+         w[m_current + 3] == 'E' ||
+         w[m_current + 3] == 'I' ||
+         w[m_current + 3] == 'O' ||
+         w[m_current + 3] == 'Y'))))
+  {
+    if ((m_current == m_last - 3 &&
+         m_current + 4 <= m_length &&
+         w[m_current + 1] == 'U' &&
+         w[m_current + 2] == 'R' &&
+         (w[m_current + 3] == 'A' || w[m_current + 3] == 'O') &&
+         ! (m_current >= 3 &&
+            m_current + 4 <= m_length &&
+            memcmp(w + m_current - 3, "VENTURA", 7) == 0)) ||
+        (m_current + 5 <= m_length &&
+         memcmp(w + m_current + 1, "URIA", 4) == 0))
+    {
+      add("T");
+    }
+    else
+    {
+      add("X", "T");
+    }
+    advanceCounter(2, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_TI, Metaphone3Spec.txt line 1235.
+bool Metaphone3::encode_TI()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current + 3 <= m_length &&
+       w[m_current + 1] == 'I' &&
+       w[m_current + 2] == 'O' &&
+       ! (m_current >= 1 &&
+          m_current + 4 <= m_length &&
+          memcmp(w + m_current - 1, "ETIOL", 5) == 0)) ||
+      (m_current + 4 <= m_length &&
+       w[m_current + 1] == 'I' &&
+       w[m_current + 2] == 'A' &&
+       w[m_current + 3] == 'L') ||
+      (m_current >= 1 &&
+       m_current + 4 <= m_length &&
+       ((w[m_current - 1] == 'A' && memcmp(w + m_current, "TIUM", 4) == 0) ||
+        (w[m_current - 1] == 'R' &&
+         memcmp(w + m_current, "TIUM", 4) == 0))) ||
+      (m_current > 0 &&
+       m_current + 4 <= m_length &&
+       w[m_current + 1] == 'I' &&
+       w[m_current + 2] == 'A' &&
+       w[m_current + 3] == 'N' &&
+       ! (m_current >= 4 &&
+          m_current + 4 <= m_length &&
+          memcmp(w + m_current - 4, "FAUSTIAN", 8) == 0) &&
+       ! (m_current >= 5 &&
+          m_current + 4 <= m_length &&
+          memcmp(w + m_current - 5, "PROUSTIAN", 9) == 0) &&
+       ! (m_current >= 2 &&
+          m_current + 5 <= m_length &&
+          memcmp(w + m_current - 2, "TATIANA", 7) == 0) &&
+       ! (m_current >= 3 &&
+          m_current + 4 <= m_length &&
+          ((w[m_current - 3] == 'G' &&
+            memcmp(w + m_current - 2, "ENTIAN", 6) == 0) ||
+           (w[m_current - 3] == 'K' &&
+            memcmp(w + m_current - 2, "ANTIAN", 6) == 0))) &&
+       ! (m_current >= 8 &&
+          m_current + 4 <= m_length &&
+          memcmp(w + m_current - 8, "ROOSEVELTIAN", 12) == 0)) ||
+      (m_current == m_last - 2 &&
+       m_current + 3 <= m_length &&
+       w[m_current] == 'T' &&
+       w[m_current + 1] == 'I' &&
+       w[m_current + 2] == 'A' &&
+       ! (m_current >= 3 &&
+          m_current + 3 <= m_length &&
+          ((w[m_current - 3] == 'H' &&
+            memcmp(w + m_current - 2, "ESTIA", 5) == 0) ||
+           (w[m_current - 3] == 'M' &&
+            memcmp(w + m_current - 2, "ASTIA", 5) == 0))) &&
+       ! (m_current >= 2 &&
+          m_current + 3 <= m_length &&
+          memcmp(w + m_current - 2, "OSTIA", 5) == 0) &&
+       ! (m_length >= 3 && w[0] == 'T' && w[1] == 'I' && w[2] == 'A') &&
+       ! (m_current >= 5 &&
+          m_current + 3 <= m_length &&
+          memcmp(w + m_current - 5, "IZVESTIA", 8) == 0)) ||
+      (m_current + 5 <= m_length &&
+       w[m_current + 1] == 'I' &&
+       w[m_current + 2] == 'A' &&
+       ((w[m_current + 3] == 'B' && w[m_current + 4] == 'L') ||
+        (w[m_current + 3] == 'R' && w[m_current + 4] == 'Y') ||
+        (w[m_current + 3] == 'T' &&
+         (w[m_current + 4] == 'E' ||
+          w[m_current + 4] == 'I' ||
+          w[m_current + 4] == 'O')))) ||
+      (m_current >= 5 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 5, "CHRISTIAN", 9) == 0))
+  {
+    if ((m_current == 2 && m_length >= 4 && memcmp(w + 0, "ANTI", 4) == 0) ||
+        (m_length >= 5 &&
+         ((w[0] == 'D' && memcmp(w + 1, "UTIA", 4) == 0) ||
+          (w[0] == 'P' &&
+           ((w[1] == 'A' && w[2] == 'T' && w[3] == 'I' && w[4] == 'O') ||
+            (w[1] == 'I' && w[2] == 'T' && w[3] == 'I' && w[4] == 'A'))))))
+    {
+      add("T");
+    }
+    else if (m_current >= 4 &&
+             m_current + 4 <= m_length &&
+             memcmp(w + m_current - 4, "EQUATION", 8) == 0)
+    {
+      add("J");
+    }
+    else if (m_current + 4 <= m_length &&
+             memcmp(w + m_current, "TION", 4) == 0)
+    {
+      add("X");
+    }
+    else if (m_length >= 5 &&
+             ((w[0] == 'K' && memcmp(w + 1, "ATIA", 4) == 0) ||
+              (w[0] == 'L' && memcmp(w + 1, "ATIA", 4) == 0)))
+    {
+      add("T", "X");
+    }
+    else
+    {
+      add("X", "T");
+    }
+    advanceCounter(3, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_TIENT, Metaphone3Spec.txt line 1264.
+bool Metaphone3::encode_TIENT()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 5 <= m_length && memcmp(w + m_current + 1, "IENT", 4) == 0)
+  {
+    add("X", "T");
+    advanceCounter(3, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_TSCH, Metaphone3Spec.txt line 1269.
+bool Metaphone3::encode_TSCH()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 4 <= m_length &&
+      memcmp(w + m_current, "TSCH", 4) == 0 &&
+      ! (m_current >= 3 &&
+         m_current + 1 <= m_length &&
+         ((w[m_current - 3] == 'F' &&
+           w[m_current - 2] == 'E' &&
+           w[m_current - 1] == 'S' &&
+           w[m_current] == 'T') ||
+          (w[m_current - 3] == 'K' &&
+           w[m_current - 2] == 'L' &&
+           w[m_current - 1] == 'A' &&
+           w[m_current] == 'T') ||
+          (w[m_current - 3] == 'W' &&
+           w[m_current - 2] == 'E' &&
+           w[m_current - 1] == 'L' &&
+           w[m_current] == 'T'))))
+  {
+    add("X");
+    m_current += 4;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_TZSCH, Metaphone3Spec.txt line 1274.
+bool Metaphone3::encode_TZSCH()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 5 <= m_length && memcmp(w + m_current, "TZSCH", 5) == 0)
+  {
+    add("X");
+    m_current += 5;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_TH_Pronounced_Separately, Metaphone3Spec.txt line 1279.
+bool Metaphone3::encode_TH_Pronounced_Separately()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current > 0 &&
+       m_current + 5 <= m_length &&
+       w[m_current + 1] == 'H' &&
+       ((w[m_current + 2] == 'A' &&
+         ((w[m_current + 3] == 'N' && w[m_current + 4] == 'D') ||
+          (w[m_current + 3] == 'R' && w[m_current + 4] == 'D') ||
+          (w[m_current + 3] == 'U' && w[m_current + 4] == 'S') ||
+          (w[m_current + 3] == 'W' && w[m_current + 4] == 'K'))) ||
+        (w[m_current + 2] == 'E' &&
+         ((w[m_current + 3] == 'A' &&
+           (w[m_current + 4] == 'D' || w[m_current + 4] == 'P')) ||
+          (w[m_current + 3] == 'I' && w[m_current + 4] == 'D') ||
+          (w[m_current + 3] == 'R' && w[m_current + 4] == 'D'))) ||
+        (w[m_current + 2] == 'I' &&
+         w[m_current + 3] == 'L' &&
+         w[m_current + 4] == 'L') ||
+        (w[m_current + 2] == 'O' &&
+         ((w[m_current + 3] == 'F' && w[m_current + 4] == 'F') ||
+          (w[m_current + 3] == 'L' &&
+           (w[m_current + 4] == 'D' || w[m_current + 4] == 'E')) ||
+          (w[m_current + 3] == 'O' &&
+           (w[m_current + 4] == 'D' || w[m_current + 4] == 'K')))) ||
+        (w[m_current + 2] == 'U' &&
+         ((w[m_current + 3] == 'M' && w[m_current + 4] == 'O') ||
+          (w[m_current + 3] == 'N' && w[m_current + 4] == 'T')))) &&
+       ! (m_current >= 3 &&
+          m_current + 2 <= m_length &&
+          ((w[m_current - 3] == 'N' &&
+            memcmp(w + m_current - 2, "ORTH", 4) == 0) ||
+           (w[m_current - 3] == 'S' &&
+            memcmp(w + m_current - 2, "OUTH", 4) == 0)))) ||
+      (m_current + 6 <= m_length &&
+       w[m_current + 1] == 'H' &&
+       ((w[m_current + 2] == 'A' &&
+         w[m_current + 3] == 'S' &&
+         w[m_current + 4] == 'T' &&
+         w[m_current + 5] == 'E') ||
+        (w[m_current + 2] == 'E' &&
+         ((w[m_current + 3] == 'A' &&
+           w[m_current + 4] == 'R' &&
+           w[m_current + 5] == 'T') ||
+          (w[m_current + 3] == 'Q' &&
+           w[m_current + 4] == 'U' &&
+           w[m_current + 5] == 'E'))) ||
+        (w[m_current + 2] == 'O' &&
+         w[m_current + 3] == 'U' &&
+         w[m_current + 4] == 'S' &&
+         w[m_current + 5] == 'E') ||
+        (w[m_current + 2] == 'Y' &&
+         w[m_current + 3] == 'P' &&
+         w[m_current + 4] == 'N' &&
+         w[m_current + 5] == 'O'))) ||
+      (m_current == m_last - 4 &&
+       m_current + 5 <= m_length &&
+       memcmp(w + m_current + 1, "HALL", 4) == 0 &&
+       ! (m_current >= 3 &&
+          m_current + 2 <= m_length &&
+          ((w[m_current - 3] == 'N' &&
+            memcmp(w + m_current - 2, "ORTH", 4) == 0) ||
+           (w[m_current - 3] == 'S' &&
+            memcmp(w + m_current - 2, "OUTH", 4) == 0)))) ||
+      (m_current == m_last - 3 &&
+       m_current + 4 <= m_length &&
+       w[m_current + 1] == 'H' &&
+       w[m_current + 2] == 'A' &&
+       w[m_current + 3] == 'M' &&
+       ! ((m_length >= 6 &&
+           ((w[0] == 'G' && memcmp(w + 1, "OTHAM", 5) == 0) ||
+            (w[0] == 'L' && memcmp(w + 1, "ATHAM", 5) == 0) ||
+            (w[0] == 'W' && memcmp(w + 1, "ITHAM", 5) == 0))) ||
+          (m_length >= 7 &&
+           ((w[0] == 'B' && memcmp(w + 1, "ENTHAM", 6) == 0) ||
+            (w[0] == 'W' &&
+             ((w[1] == 'A' && memcmp(w + 2, "LTHAM", 5) == 0) ||
+              (w[1] == 'O' && memcmp(w + 2, "RTHAM", 5) == 0))))) ||
+          (m_length >= 8 && memcmp(w + 0, "GRANTHAM", 8) == 0))) ||
+      (m_current != 0 &&
+       m_current + 6 <= m_length &&
+       memcmp(w + m_current + 1, "HATCH", 5) == 0 &&
+       ! (m_current >= 2 &&
+          m_current + 6 <= m_length &&
+          memcmp(w + m_current - 2, "UNTHATCH", 8) == 0)) ||
+      (m_current >= 3 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 3, "GOETHE", 6) == 0) ||
+      (m_current >= 3 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 3, "WARTHOG", 7) == 0) ||
+      (m_current >= 2 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 2, "ESTHER", 6) == 0) ||
+      (m_current >= 2 &&
+       m_current + 6 <= m_length &&
+       memcmp(w + m_current - 2, "NATHALIE", 8) == 0))
+  {
+    if (m_current >= 3 &&
+        m_current + 4 <= m_length &&
+        memcmp(w + m_current - 3, "POSTHUM", 7) == 0)
+    {
+      add("X");
+    }
+    else
+    {
+      add("T");
+    }
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_TTH, Metaphone3Spec.txt line 1298.
+bool Metaphone3::encode_TTH()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 3 <= m_length &&
+      w[m_current] == 'T' &&
+      w[m_current + 1] == 'T' &&
+      w[m_current + 2] == 'H')
+  {
+    if (m_current >= 2 &&
+        m_current + 3 <= m_length &&
+        memcmp(w + m_current - 2, "MATTH", 5) == 0)
+    {
+      add("0");
+    }
+    else
+    {
+      add("T0");
+    }
+    m_current += 3;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_TH, Metaphone3Spec.txt line 1306.
+bool Metaphone3::encode_TH()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length &&
+      w[m_current] == 'T' &&
+      w[m_current + 1] == 'H' &&
+      m_current >= 3 &&
+      m_current + 4 <= m_length &&
+      memcmp(w + m_current - 3, "CLOTHES", 7) == 0)
+  {
+    m_current += 3;
+    return true;
+  }
+
+  if (m_current + 2 <= m_length &&
+      w[m_current] == 'T' &&
+      w[m_current + 1] == 'H')
+  {
+    if ((m_current + 6 <= m_length &&
+         ((w[m_current + 2] == 'A' &&
+           w[m_current + 3] == 'M' &&
+           w[m_current + 4] == 'E' &&
+           w[m_current + 5] == 'S') ||
+          (w[m_current + 2] == 'I' &&
+           w[m_current + 3] == 'L' &&
+           w[m_current + 4] == 'D' &&
+           (w[m_current + 5] == 'A' || w[m_current + 5] == 'E')) ||
+          (w[m_current + 2] == 'O' &&
+           ((w[m_current + 3] == 'F' &&
+             w[m_current + 4] == 'E' &&
+             w[m_current + 5] == 'N') ||
+            (w[m_current + 3] == 'M' &&
+             ((w[m_current + 4] == 'A' && w[m_current + 5] == 'S') ||
+              (w[m_current + 4] == 'P' &&
+               (w[m_current + 5] == 'K' || w[m_current + 5] == 'S')) ||
+              (w[m_current + 4] == 'S' &&
+               (w[m_current + 5] == 'E' || w[m_current + 5] == 'O')))) ||
+            (w[m_current + 3] == 'V' &&
+             w[m_current + 4] == 'E' &&
+             w[m_current + 5] == 'N'))))) ||
+        (m_length == 4 && m_length >= 4 && memcmp(w + 0, "THOM", 4) == 0) ||
+        (m_length == 5 && m_length >= 5 && memcmp(w + 0, "THOMS", 5) == 0) ||
+        (m_length >= 3 && w[0] == 'S' && w[1] == 'C' && w[2] == 'H'))
+    {
+      add("T");
+    }
+    else if (m_length >= 2 && w[0] == 'S' && w[1] == 'M')
+    {
+      add("0", "T");
+    }
+    else
+    {
+      add("0");
+    }
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Silent_W_At_Beginning, Metaphone3Spec.txt line 1324.
+bool Metaphone3::encode_Silent_W_At_Beginning()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current == 0 && m_length >= 2 && w[0] == 'W' && w[1] == 'R')
+  {
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_WR, Metaphone3Spec.txt line 1328.
+bool Metaphone3::encode_WR()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length &&
+      w[m_current] == 'W' &&
+      w[m_current + 1] == 'R')
+  {
+    add("R");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Initial_W_Vowel, Metaphone3Spec.txt line 1333.
+bool Metaphone3::encode_Initial_W_Vowel()
+{
+
+  if (m_current == 0 && isVowel(1))
+  {
+    if (! germanic_Or_Slavic_Name_Beginning_With_W())
+    {
+      add("A");
+    }
+    else if (m_encodeVowels)
+    {
+      addExactApprox("A", "VA", "A", "FA");
+    }
+    else
+    {
+      addExactApprox("A", "V", "A", "F");
+    }
+    m_current++;
+    m_current = skipVowels(m_current);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_WH, Metaphone3Spec.txt line 1344.
+bool Metaphone3::encode_WH()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length &&
+      w[m_current] == 'W' &&
+      w[m_current + 1] == 'H' &&
+      m_current + 3 <= m_length &&
+      w[m_current + 2] == 'O' &&
+      ! ((m_current + 4 <= m_length &&
+          w[m_current + 2] == 'O' &&
+          (w[m_current + 3] == 'A' || w[m_current + 3] == 'P')) ||
+         (m_current + 5 <= m_length &&
+          w[m_current + 2] == 'O' &&
+          ((w[m_current + 3] == 'M' && w[m_current + 4] == 'P') ||
+           (w[m_current + 3] == 'O' && w[m_current + 4] == 'P') ||
+           (w[m_current + 3] == 'R' &&
+            (w[m_current + 4] == 'L' || w[m_current + 4] == 'T')))) ||
+         (m_current + 6 <= m_length &&
+          memcmp(w + m_current + 2, "OOSH", 4) == 0)))
+  {
+    add("H");
+    advanceCounter(3, 2);
+    return true;
+  }
+
+  if (m_current + 2 <= m_length &&
+      w[m_current] == 'W' &&
+      w[m_current + 1] == 'H' &&
+      ((m_current + 5 <= m_length &&
+        ((w[m_current + 2] == 'A' &&
+          ((w[m_current + 3] == 'N' && w[m_current + 4] == 'D') ||
+           (w[m_current + 3] == 'R' && w[m_current + 4] == 'D') ||
+           (w[m_current + 3] == 'W' && w[m_current + 4] == 'K'))) ||
+         (w[m_current + 2] == 'E' &&
+          ((w[m_current + 3] == 'A' && w[m_current + 4] == 'D') ||
+           (w[m_current + 3] == 'R' && w[m_current + 4] == 'D'))) ||
+         (w[m_current + 2] == 'I' &&
+          w[m_current + 3] == 'D' &&
+          w[m_current + 4] == 'E') ||
+         (w[m_current + 2] == 'O' &&
+          ((w[m_current + 3] == 'L' && w[m_current + 4] == 'E') ||
+           (w[m_current + 3] == 'O' &&
+            (w[m_current + 4] == 'D' || w[m_current + 4] == 'K')))))) ||
+       (m_current + 6 <= m_length &&
+        ((w[m_current + 2] == 'E' &&
+          w[m_current + 3] == 'A' &&
+          w[m_current + 4] == 'R' &&
+          w[m_current + 5] == 'T') ||
+         (w[m_current + 2] == 'O' &&
+          w[m_current + 3] == 'U' &&
+          ((w[m_current + 4] == 'N' && w[m_current + 5] == 'D') ||
+           (w[m_current + 4] == 'S' && w[m_current + 5] == 'E'))))) ||
+       (m_current + 7 <= m_length &&
+        memcmp(w + m_current + 2, "AMMER", 5) == 0)))
+  {
+    add("H");
+    m_current += 2;
+    return true;
+  }
+
+  if (m_current + 2 <= m_length &&
+      w[m_current] == 'W' &&
+      w[m_current + 1] == 'H' &&
+      m_current == 0)
+  {
+    add("A");
+    m_current += 2;
+    m_current = skipVowels(m_current);
+    return true;
+  }
+
+  if (m_current + 2 <= m_length &&
+      w[m_current] == 'W' &&
+      w[m_current + 1] == 'H')
+  {
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Eastern_European_W, Metaphone3Spec.txt line 1359.
+bool Metaphone3::encode_Eastern_European_W()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current == m_last && isVowel(m_current - 1)) ||
+      (m_current >= 1 &&
+       m_current + 4 <= m_length &&
+       ((w[m_current - 1] == 'E' &&
+         w[m_current] == 'W' &&
+         w[m_current + 1] == 'S' &&
+         w[m_current + 2] == 'K' &&
+         (w[m_current + 3] == 'I' || w[m_current + 3] == 'Y')) ||
+        (w[m_current - 1] == 'O' &&
+         w[m_current] == 'W' &&
+         w[m_current + 1] == 'S' &&
+         w[m_current + 2] == 'K' &&
+         (w[m_current + 3] == 'I' || w[m_current + 3] == 'Y')))) ||
+      (m_current == m_last - 4 &&
+       m_current + 5 <= m_length &&
+       w[m_current] == 'W' &&
+       ((w[m_current + 1] == 'A' &&
+         w[m_current + 2] == 'C' &&
+         w[m_current + 3] == 'K' &&
+         w[m_current + 4] == 'I') ||
+        (w[m_current + 1] == 'I' &&
+         w[m_current + 2] == 'C' &&
+         w[m_current + 3] == 'K' &&
+         w[m_current + 4] == 'I'))) ||
+      (m_current == m_last - 3 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current, "WIAK", 4) == 0) ||
+      (m_length >= 3 && w[0] == 'S' && w[1] == 'C' && w[2] == 'H'))
+  {
+    addExactApprox("", "V", "", "F");
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Initial_X, Metaphone3Spec.txt line 1371.
+bool Metaphone3::encode_Initial_X()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_length >= 2 && w[0] == 'X' && w[1] == 'U') ||
+      (m_length >= 3 &&
+       w[0] == 'X' &&
+       w[1] == 'I' &&
+       (w[2] == 'A' || w[2] == 'E' || w[2] == 'O')))
+  {
+    add("X");
+    m_current++;
+    return true;
+  }
+
+  if (m_current == 0)
+  {
+    add("S");
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_Greek_X, Metaphone3Spec.txt line 1379.
+bool Metaphone3::encode_Greek_X()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current + 4 <= m_length &&
+       ((w[m_current + 1] == 'E' &&
+         w[m_current + 2] == 'N' &&
+         w[m_current + 3] == 'O') ||
+        (w[m_current + 1] == 'Y' &&
+         w[m_current + 2] == 'L' &&
+         (w[m_current + 3] == 'E' || w[m_current + 3] == 'O')))) ||
+      (m_current + 5 <= m_length &&
+       memcmp(w + m_current + 1, "ANTH", 4) == 0))
+  {
+    add("S");
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_X_Special_Cases, Metaphone3Spec.txt line 1384.
+bool Metaphone3::encode_X_Special_Cases()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current >= 2 &&
+      m_current + 3 <= m_length &&
+      memcmp(w + m_current - 2, "LUXUR", 5) == 0)
+  {
+    addExactApprox("GJ", "KJ");
+    m_current++;
+    return true;
+  }
+
+  if ((m_length >= 7 && memcmp(w + 0, "TEXEIRA", 7) == 0) ||
+      (m_length >= 8 && memcmp(w + 0, "TEIXEIRA", 8) == 0))
+  {
+    add("X");
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_X_To_H, Metaphone3Spec.txt line 1392.
+bool Metaphone3::encode_X_To_H()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current >= 2 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 2, "OAXACA", 6) == 0) ||
+      (m_current >= 3 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current - 3, "QUIXOTE", 7) == 0))
+  {
+    add("H");
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_X_Vowel, Metaphone3Spec.txt line 1397.
+bool Metaphone3::encode_X_Vowel()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 4 <= m_length &&
+      ((w[m_current + 1] == 'I' &&
+        w[m_current + 2] == 'O' &&
+        (w[m_current + 3] == 'N' || w[m_current + 3] == 'U')) ||
+       (w[m_current + 1] == 'U' &&
+        w[m_current + 2] == 'A' &&
+        w[m_current + 3] == 'L')))
+  {
+    add("KX", "KS");
+    advanceCounter(3, 1);
+    return true;
+  }
+  return false;
+}
+
+
+// encode_French_X_Final, Metaphone3Spec.txt line 1402.
+bool Metaphone3::encode_French_X_Final()
+{
+  const char * w = m_inWord.c_str();
+
+  if (! (m_current == m_last &&
+         ((m_current >= 3 &&
+           m_current <= m_length &&
+           ((w[m_current - 3] == 'E' &&
+             w[m_current - 2] == 'A' &&
+             w[m_current - 1] == 'U') ||
+            (w[m_current - 3] == 'I' &&
+             ((w[m_current - 2] == 'A' && w[m_current - 1] == 'U') ||
+              (w[m_current - 2] == 'E' && w[m_current - 1] == 'U'))))) ||
+          (m_current >= 2 &&
+           m_current <= m_length &&
+           ((w[m_current - 2] == 'A' &&
+             (w[m_current - 1] == 'I' || w[m_current - 1] == 'U')) ||
+            (w[m_current - 2] == 'E' && w[m_current - 1] == 'U') ||
+            (w[m_current - 2] == 'O' &&
+             (w[m_current - 1] == 'I' || w[m_current - 1] == 'U')))))))
+  {
+    add("KS");
+    return false;
+  }
+  return false;
+}
+
+
+// encode_ZZ, Metaphone3Spec.txt line 1410.
+bool Metaphone3::encode_ZZ()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length &&
+      w[m_current + 1] == 'Z' &&
+      ((m_current == m_last - 2 &&
+        m_last >= 0 &&
+        (w[m_last] == 'A' || w[m_last] == 'I' || w[m_last] == 'O')) ||
+       (m_current >= 2 &&
+        m_current + 7 <= m_length &&
+        ((w[m_current - 2] == 'M' &&
+          memcmp(w + m_current - 1, "OZZARELL", 8) == 0) ||
+         (w[m_current - 2] == 'P' &&
+          ((w[m_current - 1] == 'I' &&
+            memcmp(w + m_current, "ZZICATO", 7) == 0) ||
+           (w[m_current - 1] == 'U' &&
+            memcmp(w + m_current, "ZZONLAN", 7) == 0)))))))
+  {
+    add("TS", "S");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_ZU_ZIER_ZS, Metaphone3Spec.txt line 1417.
+bool Metaphone3::encode_ZU_ZIER_ZS()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current == 1 && m_length >= 4 && memcmp(w + 0, "AZUR", 4) == 0) ||
+      (m_current + 4 <= m_length &&
+       memcmp(w + m_current, "ZIER", 4) == 0 &&
+       ! (m_current >= 2 &&
+          m_current + 4 <= m_length &&
+          memcmp(w + m_current - 2, "VIZIER", 6) == 0)) ||
+      (m_current + 3 <= m_length &&
+       w[m_current] == 'Z' &&
+       w[m_current + 1] == 'S' &&
+       w[m_current + 2] == 'A'))
+  {
+    add("J", "S");
+    if (m_current + 3 <= m_length &&
+        w[m_current] == 'Z' &&
+        w[m_current + 1] == 'S' &&
+        w[m_current + 2] == 'A')
+    {
+      m_current += 2;
+    }
+    else
+    {
+      m_current++;
+    }
+    return true;
+  }
+  return false;
+}
+
+
+// encode_French_EZ, Metaphone3Spec.txt line 1427.
+bool Metaphone3::encode_French_EZ()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current == 3 && m_length >= 4 && memcmp(w + 0, "CHEZ", 4) == 0) ||
+      (m_current >= 5 &&
+       m_current + 1 <= m_length &&
+       memcmp(w + m_current - 5, "RENDEZ", 6) == 0))
+  {
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_German_Z, Metaphone3Spec.txt line 1431.
+bool Metaphone3::encode_German_Z()
+{
+  const char * w = m_inWord.c_str();
+
+  if ((m_current == 2 &&
+       m_current == m_last - 1 &&
+       m_current >= 2 &&
+       m_current + 2 <= m_length &&
+       memcmp(w + m_current - 2, "NAZI", 4) == 0) ||
+      (m_current >= 2 &&
+       m_current + 4 <= m_length &&
+       ((w[m_current - 2] == 'M' &&
+         memcmp(w + m_current - 1, "OZART", 5) == 0) ||
+        (w[m_current - 2] == 'N' &&
+         memcmp(w + m_current - 1, "AZIFY", 5) == 0))) ||
+      (m_current >= 3 &&
+       m_current + 1 <= m_length &&
+       ((w[m_current - 3] == 'F' &&
+         w[m_current - 2] == 'I' &&
+         w[m_current - 1] == 'T' &&
+         w[m_current] == 'Z') ||
+        (w[m_current - 3] == 'H' &&
+         ((w[m_current - 2] == 'E' &&
+           w[m_current - 1] == 'R' &&
+           w[m_current] == 'Z') ||
+          (w[m_current - 2] == 'O' &&
+           w[m_current - 1] == 'L' &&
+           w[m_current] == 'Z'))) ||
+        (w[m_current - 3] == 'M' &&
+         w[m_current - 2] == 'E' &&
+         w[m_current - 1] == 'R' &&
+         w[m_current] == 'Z') ||
+        (w[m_current - 3] == 'W' &&
+         w[m_current - 2] == 'E' &&
+         w[m_current - 1] == 'I' &&
+         w[m_current] == 'Z'))) ||
+      (m_current >= 3 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 3, "HERZOG", 6) == 0) ||
+      (m_current >= 3 &&
+       m_current + 1 <= m_length &&
+       memcmp(w + m_current - 3, "GANZ", 4) == 0 &&
+       ! isVowel(m_current + 1)) ||
+      (m_current >= 4 &&
+       m_current + 1 <= m_length &&
+       ((w[m_current - 4] == 'P' &&
+         memcmp(w + m_current - 3, "RINZ", 4) == 0) ||
+        (w[m_current - 4] == 'S' &&
+         memcmp(w + m_current - 3, "TOLZ", 4) == 0))) ||
+      (m_current >= 4 &&
+       m_current + 3 <= m_length &&
+       memcmp(w + m_current - 4, "VENEZIA", 7) == 0) ||
+      (m_inWord.find("SCH") != string::npos &&
+       ! (m_last >= 2 &&
+          ((w[m_last - 2] == 'I' &&
+            w[m_last - 1] == 'Z' &&
+            w[m_last] == 'E') ||
+           (w[m_last - 2] == 'O' &&
+            w[m_last - 1] == 'Z' &&
+            w[m_last] == 'E') ||
+           (w[m_last - 2] == 'Z' &&
+            w[m_last - 1] == 'E' &&
+            w[m_last] == 'L')))) ||
+      (m_current > 0 &&
+       m_current + 4 <= m_length &&
+       memcmp(w + m_current, "ZEIT", 4) == 0))
+  {
+    if (m_current > 0 &&
+        m_current >= 1 &&
+        m_current <= m_length &&
+        w[m_current - 1] == 'T')
+    {
+      add("S");
+    }
+    else
+    {
+      add("TS");
+    }
+    m_current++;
+    return true;
+  }
+  return false;
+}
+
+
+// encode_ZH, Metaphone3Spec.txt line 1445.
+bool Metaphone3::encode_ZH()
+{
+  const char * w = m_inWord.c_str();
+
+  if (m_current + 2 <= m_length && w[m_current + 1] == 'H')
+  {
+    add("J");
+    m_current += 2;
+    return true;
+  }
+  return false;
+}
+
+#endif
@@ -0,0 +1,153 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <cstring>
+
+#include "NYSIIS.h"
+
+
+NYSIIS::NYSIIS()
+{
+  reset();
+}
+
+
+NYSIIS::~NYSIIS()
+{
+}
+
+
+void NYSIIS::reset()
+{
+  m_inWord.clear();
+  m_key.clear();
+}
+
+
+void NYSIIS::setNormalizedWord(const string_view in)
+{
+  m_inWord.clear();
+  for (const char c: in)
+  {
+    if (c >= 'A' && c <= 'Z')
+      m_inWord.push_back(c);
+  }
+}
+
+
+bool NYSIIS::isVowel(const char c) const
+{
+  return (c == 'A' || c == 'E' || c == 'I' || c == 'O' || c == 'U');
+}
+
+
+void NYSIIS::replacePrefix(
+  const char * from,
+  const char * to)
+{
+  // from and to have the same length.
+  const size_t len = strlen(from);
+  if (m_inWord.compare(0, len, from) == 0)
+    m_inWord.replace(0, len, to);
+}
+
+
+bool NYSIIS::replaceSuffix(
+  const char * from,
+  const char * to)
+{
+  const size_t len = strlen(from);
+  if (m_inWord.size() < len ||
+      m_inWord.compare(m_inWord.size() - len, len, from) != 0)
+    return false;
+
+  m_inWord.replace(m_inWord.size() - len, len, to);
+  return true;
+}
+
+
+void NYSIIS::transcode(const size_t pos)
+{
+  const size_t n = m_inWord.size();
+  const char prev = m_inWord[pos - 1];
+  const char cur = m_inWord[pos];
+  const char next = (pos + 1 < n ? m_inWord[pos + 1] : ' ');
+  const char next2 = (pos + 2 < n ? m_inWord[pos + 2] : ' ');
+
+  if (cur == 'E' && next == 'V')
+    m_inWord.replace(pos, 2, "AF");
+  else if (isVowel(cur))
+    m_inWord[pos] = 'A';
+  else if (cur == 'Q')
+    m_inWord[pos] = 'G';
+  else if (cur == 'Z')
+    m_inWord[pos] = 'S';
+  else if (cur == 'M')
+    m_inWord[pos] = 'N';
+  else if (cur == 'K')
+    m_inWord.replace(pos, (next == 'N' ? 2 : 1), (next == 'N' ? "NN" : "C"));
+  else if (cur == 'S' && next == 'C' && next2 == 'H')
+    m_inWord.replace(pos, 3, "SSS");
+  else if (cur == 'P' && next == 'H')
+    m_inWord.replace(pos, 2, "FF");
+  else if (cur == 'H' && (! isVowel(prev) || ! isVowel(next)))
+    m_inWord[pos] = prev;
+  else if (cur == 'W' && isVowel(prev))
+    m_inWord[pos] = prev;
+}
+
+
+void NYSIIS::encode()
+{
+  m_key.clear();
+  if (m_inWord.empty())
+    return;
+
+  replacePrefix("MAC", "MCC");
+  replacePrefix("KN", "NN");
+  replacePrefix("K", "C");
+  replacePrefix("PH", "FF");
+  replacePrefix("PF", "FF");
+  replacePrefix("SCH", "SSS");
+
+  if (! replaceSuffix("EE", "Y") && ! replaceSuffix("IE", "Y"))
+  {
+    for (const char * s: {"DT", "RT", "RD", "NT", "ND"})
+    {
+      if (replaceSuffix(s, "D"))
+        break;
+    }
+  }
+
+  m_key.push_back(m_inWord[0]);
+  for (size_t i = 1; i < m_inWord.size(); i++)
+  {
+    // A transcoding of several letters overwrites the next ones,
+    // which are then transcoded in their turn.
+    transcode(i);
+    if (m_inWord[i] != m_inWord[i-1])
+      m_key.push_back(m_inWord[i]);
+  }
+
+  if (m_key.size() > 1)
+  {
+    if (m_key.back() == 'S')
+      m_key.pop_back();
+    if (m_key.size() > 2 && m_key.back() == 'Y' &&
+        m_key[m_key.size() - 2] == 'A')
+      m_key.erase(m_key.size() - 2, 1);
+    if (m_key.back() == 'A')
+      m_key.pop_back();
+  }
+
+  if (m_key.size() > NYSIIS_LENGTH)
+    m_key.resize(NYSIIS_LENGTH);
+}
+
+
+const string& NYSIIS::getKey() const
+{
+  return m_key;
+}
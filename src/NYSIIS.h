@@ -0,0 +1,66 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// NYSIIS, the New York State Identification and Intelligence System
+// code (Taft, 1970), as in Apache Commons Codec:  some prefixes and
+// suffixes are rewritten, the first letter is kept, the rest is
+// transcoded letter by letter (vowels to A, Q to G, Z to S, M to N,
+// KN to N, SCH to SSS, PH to FF, H and W absorbed in some contexts),
+// repeats are dropped, and a final S, A or AY is trimmed.  The key is
+// cut to NYSIIS_LENGTH characters as in the original.
+//
+// The word must already be normalized as by Metaphone3::normalize().
+// Anything that is not a letter A..Z is skipped.
+
+#ifndef NYSIIS_H
+#define NYSIIS_H
+
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+#define NYSIIS_LENGTH 6
+
+
+class NYSIIS
+{
+  private:
+
+    // The letters of the word, rewritten in place while encoding.
+    string m_inWord;
+
+    string m_key;
+
+
+    bool isVowel(const char c) const;
+
+    void replacePrefix(
+      const char * from,
+      const char * to);
+
+    bool replaceSuffix(
+      const char * from,
+      const char * to);
+
+    // Transcodes the letter at pos (and perhaps the next ones) in
+    // place.
+    void transcode(const size_t pos);
+
+  public:
+
+    NYSIIS();
+    ~NYSIIS();
+    void reset();
+
+    void setNormalizedWord(const string_view in);
+
+    void encode();
+
+    // Empty if the word has no letter.
+    const string& getKey() const;
+};
+
+#endif
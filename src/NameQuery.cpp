@@ -0,0 +1,337 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <algorithm>
+
+#include "NameQuery.h"
+#include "encode.h"
+
+
+ListCursor::ListCursor()
+{
+  reset();
+}
+
+
+ListCursor::~ListCursor()
+{
+}
+
+
+void ListCursor::reset()
+{
+  m_plain = false;
+  m_data = nullptr;
+  m_size = 0;
+  m_pos = 0;
+  m_reader.reset();
+}
+
+
+void ListCursor::setPlain(const PostingSpan& span)
+{
+  m_plain = true;
+  m_data = span.data;
+  m_size = span.size;
+  m_pos = 0;
+}
+
+
+PostingReader& ListCursor::reader()
+{
+  m_plain = false;
+  return m_reader;
+}
+
+
+size_t ListCursor::size() const
+{
+  return (m_plain ? m_size : m_reader.size());
+}
+
+
+bool ListCursor::atEnd() const
+{
+  return (m_plain ? m_pos >= m_size : m_reader.atEnd());
+}
+
+
+uint32_t ListCursor::value() const
+{
+  return (m_plain ? m_data[m_pos] : m_reader.value());
+}
+
+
+void ListCursor::next()
+{
+  if (m_plain)
+    m_pos++;
+  else
+    m_reader.next();
+}
+
+
+bool ListCursor::advanceTo(const uint32_t target)
+{
+  if (! m_plain)
+    return m_reader.advanceTo(target);
+
+  if (m_pos >= m_size)
+    return false;
+  if (m_data[m_pos] < target)
+    m_pos = seekPosting(m_data, m_pos + 1, m_size, target);
+  return m_pos < m_size;
+}
+
+
+NameQuery::NameQuery()
+{
+  reset();
+}
+
+
+NameQuery::~NameQuery()
+{
+}
+
+
+void NameQuery::reset()
+{
+  m_built = nullptr;
+  m_mapped = nullptr;
+  m_mains.clear();
+  m_alts.clear();
+  m_hasAlt.clear();
+  m_order.clear();
+}
+
+
+void NameQuery::setIndex(const PhoneticIndex& index)
+{
+  reset();
+  m_built = &index;
+}
+
+
+void NameQuery::setIndex(const MappedIndex& index)
+{
+  reset();
+  m_mapped = &index;
+}
+
+
+const NameTokenizer * NameQuery::tokenizer() const
+{
+  return (m_built ? m_built->tokenizer() : m_mapped->tokenizer());
+}
+
+
+void NameQuery::openKey(
+  const unsigned config,
+  const PackedKey key,
+  ListCursor& cursor)
+{
+  cursor.reset();
+  if (key == 0)
+    return;
+
+  if (m_built)
+    cursor.setPlain(m_built->lookupKey(config, key));
+  else
+    m_mapped->openList(config, key, cursor.reader());
+}
+
+
+size_t NameQuery::tokenSize(const size_t token) const
+{
+  return m_mains[token].size() + m_alts[token].size();
+}
+
+
+bool NameQuery::tokenAtEnd(const size_t token) const
+{
+  if (! m_hasAlt[token])
+    return m_mains[token].atEnd();
+  return m_mains[token].atEnd() && m_alts[token].atEnd();
+}
+
+
+uint32_t NameQuery::tokenValue(const size_t token) const
+{
+  const ListCursor& cm = m_mains[token];
+  if (! m_hasAlt[token])
+    return cm.value();
+
+  const ListCursor& ca = m_alts[token];
+  if (cm.atEnd())
+    return ca.value();
+  if (ca.atEnd())
+    return cm.value();
+  return min(cm.value(), ca.value());
+}
+
+
+void NameQuery::tokenNext(const size_t token)
+{
+  if (! m_hasAlt[token])
+  {
+    m_mains[token].next();
+    return;
+  }
+
+  // Both lists move past a record that they share.
+  const uint32_t v = tokenValue(token);
+  ListCursor& cm = m_mains[token];
+  ListCursor& ca = m_alts[token];
+  if (! cm.atEnd() && cm.value() == v)
+    cm.next();
+  if (! ca.atEnd() && ca.value() == v)
+    ca.next();
+}
+
+
+bool NameQuery::tokenAdvanceTo(
+  const size_t token,
+  const uint32_t target)
+{
+  if (! m_hasAlt[token])
+    return m_mains[token].advanceTo(target);
+
+  const bool m = m_mains[token].advanceTo(target);
+  const bool a = m_alts[token].advanceTo(target);
+  return m || a;
+}
+
+
+void NameQuery::intersectAll(vector<uint32_t>& records)
+{
+  // The shortest list proposes each candidate, and the others jump to
+  // it.  Where one lands beyond it, the shortest list jumps there in
+  // turn.
+  const size_t n = m_order.size();
+  const size_t first = m_order[0];
+  while (! tokenAtEnd(first))
+  {
+    const uint32_t candidate = tokenValue(first);
+    uint32_t v = candidate;
+    for (size_t i = 1; i < n && v == candidate; i++)
+    {
+      if (! tokenAdvanceTo(m_order[i], candidate))
+        return;
+      v = tokenValue(m_order[i]);
+    }
+
+    if (v == candidate)
+    {
+      records.push_back(candidate);
+      tokenNext(first);
+    }
+    else
+      tokenAdvanceTo(first, v);
+  }
+}
+
+
+void NameQuery::intersectMost(
+  const size_t needed,
+  vector<uint32_t>& records)
+{
+  const size_t n = m_order.size();
+  const size_t leads = n - needed + 1;
+  while (true)
+  {
+    // The next candidate is the smallest record of the leading lists.
+    bool any = false;
+    uint32_t candidate = 0;
+    for (size_t j = 0; j < leads; j++)
+    {
+      const size_t token = m_order[j];
+      if (tokenAtEnd(token))
+        continue;
+      const uint32_t v = tokenValue(token);
+      if (! any || v < candidate)
+        candidate = v;
+      any = true;
+    }
+    if (! any)
+      break;
+
+    size_t matched = 0;
+    for (size_t j = 0; j < leads; j++)
+    {
+      const size_t token = m_order[j];
+      if (! tokenAtEnd(token) && tokenValue(token) == candidate)
+      {
+        matched++;
+        tokenNext(token);
+      }
+    }
+
+    // The other lists, until the candidate has enough tokens or can
+    // no longer get them.
+    for (size_t j = leads;
+        j < n && matched < needed && matched + (n - j) >= needed; j++)
+    {
+      const size_t token = m_order[j];
+      if (tokenAdvanceTo(token, candidate) &&
+          tokenValue(token) == candidate)
+        matched++;
+    }
+
+    if (matched >= needed)
+      records.push_back(candidate);
+  }
+}
+
+
+void NameQuery::lookup(
+  Metaphone3& mph,
+  const string_view text,
+  const unsigned config,
+  const unsigned maxMissing,
+  vector<uint32_t>& records)
+{
+  records.clear();
+  setIndexConfig(mph, config);
+
+  PackedKey mains[NAME_MAX_TOKENS], alts[NAME_MAX_TOKENS];
+  const size_t n = encodeTokenKeys(mph, text, tokenizer(),
+    mains, alts, NAME_MAX_TOKENS);
+  if (n == 0)
+    return;
+
+  if (m_mains.size() < n)
+  {
+    m_mains.resize(n);
+    m_alts.resize(n);
+    m_hasAlt.resize(n);
+  }
+
+  m_order.clear();
+  for (size_t i = 0; i < n; i++)
+  {
+    openKey(config, mains[i], m_mains[i]);
+    openKey(config, (alts[i] == mains[i] ? 0 : alts[i]), m_alts[i]);
+    if (m_mains[i].size() == 0)
+      swap(m_mains[i], m_alts[i]);
+    m_hasAlt[i] = (m_alts[i].size() > 0);
+    m_order.push_back(i);
+  }
+
+  stable_sort(m_order.begin(), m_order.end(),
+    [this](const size_t a, const size_t b)
+  {
+    return tokenSize(a) < tokenSize(b);
+  });
+
+  const size_t needed = (maxMissing >= n ? 1 : n - maxMissing);
+  if (needed == n)
+  {
+    if (tokenSize(m_order[0]) > 0)
+      intersectAll(records);
+  }
+  else
+    intersectMost(needed, records);
+}
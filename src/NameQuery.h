@@ -0,0 +1,139 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// Multi-token name queries over an index:  the records that have the
+// main or the alternate key of every token of a name, or of all but a
+// few of them (a dropped middle name, say).
+//
+// The posting lists are intersected as cursors, leapfrog style, and
+// nothing per token is ever collected.  Each token is a cursor over
+// the union of its two lists.  The cursors are taken in order of
+// size, and each one jumps forward to the current candidate record:
+// by galloping search in an in-memory index, and over the skip table
+// (see PostingCodec.h) in a mapped one.  If it lands beyond the
+// candidate, where it lands is the next candidate.  So the work goes
+// with the shortest list, not with the longest.
+//
+// With up to m tokens missing, a match must be in at least one of the
+// m + 1 shortest lists.  Their cursors are merged to give the
+// candidates in order, and each candidate is probed in the other
+// lists only as long as it can still match enough tokens.
+
+#ifndef NAMEQUERY_H
+#define NAMEQUERY_H
+
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+#include "Metaphone3.h"
+#include "PhoneticIndex.h"
+#include "MappedIndex.h"
+#include "PostingCodec.h"
+
+using namespace std;
+
+
+// A forward cursor over a posting list of either kind of index.
+class ListCursor
+{
+  private:
+
+    // An in-memory list, or else m_reader.
+    bool m_plain;
+    const uint32_t * m_data;
+    size_t m_size;
+    size_t m_pos;
+
+    PostingReader m_reader;
+
+  public:
+
+    ListCursor();
+    ~ListCursor();
+    void reset();
+
+    void setPlain(const PostingSpan& span);
+
+    PostingReader& reader();
+
+    size_t size() const;
+
+    bool atEnd() const;
+
+    uint32_t value() const;
+
+    void next();
+
+    // As PostingReader::advanceTo().
+    bool advanceTo(const uint32_t target);
+};
+
+
+class NameQuery
+{
+  private:
+
+    // Exactly one of these is set.
+    const PhoneticIndex * m_built;
+    const MappedIndex * m_mapped;
+
+    // Per query token, the cursors over its main and alternate keys.
+    // Most tokens have only the one list, which is then m_mains.
+    vector<ListCursor> m_mains;
+    vector<ListCursor> m_alts;
+    vector<bool> m_hasAlt;
+
+    // Token numbers, shortest lists first.
+    vector<size_t> m_order;
+
+
+    const NameTokenizer * tokenizer() const;
+
+    void openKey(
+      const unsigned config,
+      const PackedKey key,
+      ListCursor& cursor);
+
+    size_t tokenSize(const size_t token) const;
+
+    bool tokenAtEnd(const size_t token) const;
+
+    uint32_t tokenValue(const size_t token) const;
+
+    void tokenNext(const size_t token);
+
+    bool tokenAdvanceTo(
+      const size_t token,
+      const uint32_t target);
+
+    void intersectAll(vector<uint32_t>& records);
+
+    void intersectMost(
+      const size_t needed,
+      vector<uint32_t>& records);
+
+  public:
+
+    NameQuery();
+    ~NameQuery();
+    void reset();
+
+    // The index to query.  It must outlive the queries.
+    void setIndex(const PhoneticIndex& index);
+    void setIndex(const MappedIndex& index);
+
+    // The records, in order, that have the main or the alternate key
+    // in config of all the tokens of text but at most maxMissing.  At
+    // least one token must always match.
+    void lookup(
+      Metaphone3& mph,
+      const string_view text,
+      const unsigned config,
+      const unsigned maxMissing,
+      vector<uint32_t>& records);
+};
+
+#endif
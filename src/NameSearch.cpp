@@ -0,0 +1,333 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <algorithm>
+#include <cstring>
+
+#include "NameSearch.h"
+#include "encode.h"
+
+// Most matches a record can have.
+#define SEARCH_MAX_HITS (INDEX_CONFIGS * NAME_MAX_TOKENS)
+
+// Character classes for the similarity bound.
+#define SEARCH_BUCKETS 32
+
+
+NameSearch::NameSearch()
+{
+  reset();
+}
+
+
+NameSearch::~NameSearch()
+{
+}
+
+
+void NameSearch::reset()
+{
+  m_built = nullptr;
+  m_mapped = nullptr;
+  m_hits.clear();
+  m_lastHit.clear();
+  m_hitNo = 0;
+  m_touched.clear();
+  m_tiers.clear();
+  m_tiers.resize(SEARCH_MAX_HITS + 1);
+  m_decoded.clear();
+}
+
+
+void NameSearch::setIndex(const PhoneticIndex& index)
+{
+  reset();
+  m_built = &index;
+  m_hits.resize(index.numNames(), 0);
+  m_lastHit.resize(index.numNames(), 0);
+}
+
+
+void NameSearch::setIndex(const MappedIndex& index)
+{
+  reset();
+  m_mapped = &index;
+  m_hits.resize(index.numNames(), 0);
+  m_lastHit.resize(index.numNames(), 0);
+}
+
+
+const NameTokenizer * NameSearch::tokenizer() const
+{
+  return (m_built ? m_built->tokenizer() : m_mapped->tokenizer());
+}
+
+
+string_view NameSearch::getName(const uint32_t record) const
+{
+  return (m_built ? m_built->getName(record) : m_mapped->getName(record));
+}
+
+
+void NameSearch::nextHit()
+{
+  if (++m_hitNo == 0)
+  {
+    fill(m_lastHit.begin(), m_lastHit.end(), 0);
+    m_hitNo = 1;
+  }
+}
+
+
+void NameSearch::addRecord(const uint32_t record)
+{
+  // The main and the alternate key of a token count once together.
+  if (m_lastHit[record] == m_hitNo)
+    return;
+  m_lastHit[record] = m_hitNo;
+
+  if (m_hits[record] == 0)
+    m_touched.push_back(record);
+  m_hits[record]++;
+}
+
+
+void NameSearch::addKey(
+  const unsigned config,
+  const PackedKey key)
+{
+  if (m_built)
+  {
+    const PostingSpan span = m_built->lookupKey(config, key);
+    for (size_t i = 0; i < span.size; i++)
+      addRecord(span.data[i]);
+  }
+  else
+  {
+    m_mapped->lookupKey(config, key, m_decoded);
+    for (auto r: m_decoded)
+      addRecord(r);
+  }
+}
+
+
+static size_t foldName(
+  const string_view name,
+  char folded[])
+{
+  const size_t len = min(name.size(),
+    static_cast<size_t>(SEARCH_MAX_LENGTH));
+  for (size_t i = 0; i < len; i++)
+  {
+    const char c = name[i];
+    folded[i] = (c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c);
+  }
+  return len;
+}
+
+
+static double winkler(
+  const double jaro,
+  const char sa[],
+  const size_t la,
+  const char sb[],
+  const size_t lb)
+{
+  if (jaro <= 0.7)
+    return jaro;
+
+  // Winkler's bonus for a common prefix of up to 4 characters.
+  size_t prefix = 0;
+  while (prefix < 4 && prefix < min(la, lb) && sa[prefix] == sb[prefix])
+    prefix++;
+  return jaro + 0.1 * prefix * (1. - jaro);
+}
+
+
+static double jaroWinklerFolded(
+  const char sa[],
+  const size_t la,
+  const char sb[],
+  const size_t lb)
+{
+  if (la == 0 || lb == 0)
+    return (la == lb ? 1. : 0.);
+
+  // Characters match if they are equal and not too far apart.
+  const size_t longer = max(la, lb);
+  const size_t range = (longer >= 2 ? longer / 2 - 1 : 0);
+
+  uint64_t usedA = 0, usedB = 0;
+  size_t matches = 0;
+  for (size_t i = 0; i < la; i++)
+  {
+    const size_t lo = (i > range ? i - range : 0);
+    const size_t hi = min(lb, i + range + 1);
+    for (size_t j = lo; j < hi; j++)
+    {
+      const uint64_t bitB = static_cast<uint64_t>(1) << j;
+      if ((usedB & bitB) == 0 && sa[i] == sb[j])
+      {
+        usedA |= static_cast<uint64_t>(1) << i;
+        usedB |= bitB;
+        matches++;
+        break;
+      }
+    }
+  }
+
+  if (matches == 0)
+    return 0.;
+
+  // Matched characters that are out of order (two per transposition).
+  size_t outOfOrder = 0;
+  size_t j = 0;
+  for (size_t i = 0; i < la; i++)
+  {
+    if ((usedA & (static_cast<uint64_t>(1) << i)) == 0)
+      continue;
+    while ((usedB & (static_cast<uint64_t>(1) << j)) == 0)
+      j++;
+    if (sa[i] != sb[j])
+      outOfOrder++;
+    j++;
+  }
+
+  const double m = static_cast<double>(matches);
+  const double jaro = (m / la + m / lb + (m - outOfOrder / 2.) / m) / 3.;
+  return winkler(jaro, sa, la, sb, lb);
+}
+
+
+static double jaroWinklerBound(
+  const uint8_t counts[],
+  const char sa[],
+  const size_t la,
+  const char sb[],
+  const size_t lb)
+{
+  // At most as many characters match as the two names have in common
+  // regardless of position, and at best none are out of order.  The
+  // characters are counted by their low 5 bits, which keeps the letters
+  // apart, and lumping other characters together only raises the bound.
+  if (la == 0 || lb == 0)
+    return (la == lb ? 1. : 0.);
+
+  uint8_t left[SEARCH_BUCKETS];
+  memcpy(left, counts, sizeof left);
+  size_t common = 0;
+  for (size_t j = 0; j < lb; j++)
+  {
+    uint8_t& c = left[sb[j] & (SEARCH_BUCKETS - 1)];
+    if (c > 0)
+    {
+      c--;
+      common++;
+    }
+  }
+
+  if (common == 0)
+    return 0.;
+
+  const double m = static_cast<double>(common);
+  return winkler((m / la + m / lb + 1.) / 3., sa, la, sb, lb);
+}
+
+
+static bool betterMatch(
+  const NameMatch& a,
+  const NameMatch& b)
+{
+  if (a.score != b.score)
+    return a.score > b.score;
+  return a.record < b.record;
+}
+
+
+void NameSearch::search(
+  const string_view text,
+  const unsigned k,
+  vector<NameMatch>& matches)
+{
+  matches.clear();
+  if (k == 0 || (m_built == nullptr && m_mapped == nullptr))
+    return;
+
+  PackedKey mains[NAME_MAX_TOKENS], alts[NAME_MAX_TOKENS];
+  for (unsigned config = 0; config < INDEX_CONFIGS; config++)
+  {
+    setIndexConfig(m_mph, config);
+    const size_t n = encodeTokenKeys(m_mph, text, tokenizer(),
+      mains, alts, NAME_MAX_TOKENS);
+
+    for (size_t i = 0; i < n; i++)
+    {
+      nextHit();
+      addKey(config, mains[i]);
+      if (alts[i] != 0 && alts[i] != mains[i])
+        addKey(config, alts[i]);
+    }
+  }
+
+  size_t maxTier = 0;
+  for (auto r: m_touched)
+  {
+    const size_t tier = m_hits[r];
+    m_tiers[tier].push_back(r);
+    maxTier = max(maxTier, tier);
+    m_hits[r] = 0;
+  }
+  m_touched.clear();
+
+  char query[SEARCH_MAX_LENGTH], name[SEARCH_MAX_LENGTH];
+  const size_t lq = foldName(text, query);
+  uint8_t counts[SEARCH_BUCKETS] = {0};
+  for (size_t i = 0; i < lq; i++)
+    counts[query[i] & (SEARCH_BUCKETS - 1)]++;
+
+  // matches is a heap with the worst of the best k on top.  Once it is
+  // full, a name is only scored if its bound beats that.  The higher
+  // tiers come first, as they fill the heap with good scores, but a
+  // lower tier can still hold a better name, so all are looked at.
+  for (size_t tier = maxTier; tier > 0; tier--)
+  {
+    for (auto r: m_tiers[tier])
+    {
+      const size_t ln = foldName(getName(r), name);
+      if (matches.size() == k &&
+          jaroWinklerBound(counts, query, lq, name, ln) <
+            matches.front().score)
+        continue;
+
+      const NameMatch m = {r, jaroWinklerFolded(query, lq, name, ln)};
+      if (matches.size() < k)
+      {
+        matches.push_back(m);
+        push_heap(matches.begin(), matches.end(), betterMatch);
+      }
+      else if (betterMatch(m, matches.front()))
+      {
+        pop_heap(matches.begin(), matches.end(), betterMatch);
+        matches.back() = m;
+        push_heap(matches.begin(), matches.end(), betterMatch);
+      }
+    }
+    m_tiers[tier].clear();
+  }
+
+  sort_heap(matches.begin(), matches.end(), betterMatch);
+}
+
+
+double jaroWinkler(
+  const string_view a,
+  const string_view b)
+{
+  char sa[SEARCH_MAX_LENGTH], sb[SEARCH_MAX_LENGTH];
+  const size_t la = foldName(a, sa);
+  const size_t lb = foldName(b, sb);
+  return jaroWinklerFolded(sa, la, sb, lb);
+}
+
@@ -0,0 +1,107 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// Ranked name search over an index:  the k names of a list most like
+// a query name.
+//
+// The phonetic keys pick the candidates.  The query is encoded in all
+// four configurations, and every record that shares the main or the
+// alternate key of some query token in some configuration is a
+// candidate.  A candidate matches more often the more of the query
+// tokens it has, and the more of the configurations agree on them (the
+// ones with encodeVowels and encodeExact are much more selective).
+// The candidates are scored against the query with Jaro-Winkler
+// similarity, those that match most often first, and the best k are
+// returned.  Once there are k, a candidate is only scored if a cheap
+// upper bound on its similarity beats the k-th best so far.
+//
+// A NameSearch holds its own Metaphone3 and scratch space, so use one
+// per thread.  The index itself is only read.
+
+#ifndef NAMESEARCH_H
+#define NAMESEARCH_H
+
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+#include "Metaphone3.h"
+#include "PhoneticIndex.h"
+#include "MappedIndex.h"
+
+using namespace std;
+
+// Longest name (in bytes) that is compared in full.
+#define SEARCH_MAX_LENGTH 64
+
+
+struct NameMatch
+{
+  uint32_t record;
+  double score; // Jaro-Winkler, 0 to 1
+};
+
+
+class NameSearch
+{
+  private:
+
+    // Exactly one of these is set.
+    const PhoneticIndex * m_built;
+    const MappedIndex * m_mapped;
+
+    Metaphone3 m_mph;
+
+    // For each record, the number of (configuration, query token)
+    // pairs it matched, and the last such pair, numbered from 1 over
+    // all searches.  m_touched has the records with any match.
+    vector<uint16_t> m_hits;
+    vector<uint32_t> m_lastHit;
+    uint32_t m_hitNo;
+    vector<uint32_t> m_touched;
+
+    // Candidates by their number of matches.
+    vector<vector<uint32_t>> m_tiers;
+
+    vector<uint32_t> m_decoded;
+
+
+    const NameTokenizer * tokenizer() const;
+
+    string_view getName(const uint32_t record) const;
+
+    void nextHit();
+
+    void addRecord(const uint32_t record);
+
+    void addKey(
+      const unsigned config,
+      const PackedKey key);
+
+  public:
+
+    NameSearch();
+    ~NameSearch();
+    void reset();
+
+    // The index to search.  It must outlive the searches.
+    void setIndex(const PhoneticIndex& index);
+    void setIndex(const MappedIndex& index);
+
+    // The (at most) k best matches for text, best first, and by record
+    // for equal scores.
+    void search(
+      const string_view text,
+      const unsigned k,
+      vector<NameMatch>& matches);
+};
+
+// Jaro-Winkler similarity of two names, ignoring ASCII case.  Only the
+// first SEARCH_MAX_LENGTH bytes of each count.
+double jaroWinkler(
+  const string_view a,
+  const string_view b);
+
+#endif
@@ -0,0 +1,377 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include "NameTokenizer.h"
+
+// Character classes.
+#define CL_SEP 0
+#define CL_LETTER 1
+#define CL_DIGIT 2
+#define CL_HYPHEN 3
+
+static const vector<string> DEFAULT_PARTICLES =
+{
+  // Dutch, German, Scandinavian.
+  "van", "von", "der", "den", "ter", "ten", "het", "zu", "af", "av",
+  // Romance.
+  "de", "del", "della", "dei", "degli", "di", "das", "dos", "du",
+  "des", "la", "le",
+  // Gaelic, Arabic.
+  "mac", "mc", "bin", "ibn"
+};
+
+
+NameTokenizer::NameTokenizer()
+{
+  for (unsigned c = 0; c < 256; c++)
+  {
+    if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c >= 0x80)
+      m_class[c] = CL_LETTER; // Including all UTF-8 bytes
+    else if (c >= '0' && c <= '9')
+      m_class[c] = CL_DIGIT;
+    else if (c == '-')
+      m_class[c] = CL_HYPHEN;
+    else
+      m_class[c] = CL_SEP;
+  }
+
+  reset();
+}
+
+
+NameTokenizer::~NameTokenizer()
+{
+}
+
+
+void NameTokenizer::reset()
+{
+  setPlayerNames();
+}
+
+
+void NameTokenizer::setPlayerNames()
+{
+  m_particles = DEFAULT_PARTICLES;
+  m_particleMode = PARTICLES_JOIN;
+  m_keepInitials = true;
+  m_keepNumbers = false;
+}
+
+
+void NameTokenizer::setEventNames()
+{
+  m_particles = DEFAULT_PARTICLES;
+  m_particleMode = PARTICLES_KEEP;
+  m_keepInitials = true;
+  m_keepNumbers = true;
+}
+
+
+void NameTokenizer::setParticles(const vector<string>& particles)
+{
+  m_particles.clear();
+  for (auto& p: particles)
+  {
+    string lower = p;
+    for (auto& c: lower)
+      c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    m_particles.push_back(lower);
+  }
+}
+
+
+void NameTokenizer::setParticleMode(const ParticleMode mode)
+{
+  m_particleMode = mode;
+}
+
+
+void NameTokenizer::setKeepInitials(const bool keep)
+{
+  m_keepInitials = keep;
+}
+
+
+void NameTokenizer::setKeepNumbers(const bool keep)
+{
+  m_keepNumbers = keep;
+}
+
+
+const vector<string>& NameTokenizer::getParticles() const
+{
+  return m_particles;
+}
+
+
+ParticleMode NameTokenizer::getParticleMode() const
+{
+  return m_particleMode;
+}
+
+
+bool NameTokenizer::getKeepInitials() const
+{
+  return m_keepInitials;
+}
+
+
+bool NameTokenizer::getKeepNumbers() const
+{
+  return m_keepNumbers;
+}
+
+
+bool NameTokenizer::isParticle(const string_view word) const
+{
+  for (auto& p: m_particles)
+  {
+    if (p.size() != word.size())
+      continue;
+
+    size_t i = 0;
+    while (i < p.size() &&
+        tolower(static_cast<unsigned char>(word[i])) == p[i])
+      i++;
+    if (i == p.size())
+      return true;
+  }
+  return false;
+}
+
+
+size_t NameTokenizer::apostropheAt(
+  const string_view text,
+  const size_t pos) const
+{
+  // Returns the length in bytes of an apostrophe at pos, or 0.
+  const char c = text[pos];
+  if (c == '\'' || c == '`')
+    return 1;
+
+  // UTF-8 right and left single quotation marks.
+  if (static_cast<unsigned char>(c) == 0xE2 && pos+2 < text.size() &&
+      static_cast<unsigned char>(text[pos+1]) == 0x80 &&
+      (static_cast<unsigned char>(text[pos+2]) == 0x98 ||
+       static_cast<unsigned char>(text[pos+2]) == 0x99))
+    return 3;
+
+  return 0;
+}
+
+
+size_t NameTokenizer::scan(
+  const string_view text,
+  NameToken tokens[],
+  const size_t maxTokens) const
+{
+  const size_t len = text.size();
+  size_t n = 0;
+  size_t i = 0;
+
+  while (i < len && n < maxTokens)
+  {
+    const size_t a = apostropheAt(text, i);
+    const unsigned cl = m_class[static_cast<unsigned char>(text[i])];
+    if (a > 0 || (cl != CL_LETTER && cl != CL_DIGIT))
+    {
+      i += (a > 0 ? a : 1);
+      continue;
+    }
+
+    // A word runs over letters and digits, and over apostrophes
+    // that are followed by a letter.
+    const size_t start = i;
+    unsigned flags = 0;
+    unsigned numChars = 0;
+    bool digitsOnly = true;
+
+    while (i < len)
+    {
+      const size_t ap = apostropheAt(text, i);
+      if (ap > 0)
+      {
+        if (i+ap < len &&
+            m_class[static_cast<unsigned char>(text[i+ap])] == CL_LETTER)
+        {
+          flags |= NAME_FLAG_APOSTROPHE;
+          i += ap;
+          continue;
+        }
+        break;
+      }
+
+      const unsigned char c = static_cast<unsigned char>(text[i]);
+      const unsigned cc = m_class[c];
+      if (cc == CL_LETTER)
+        digitsOnly = false;
+      else if (cc != CL_DIGIT)
+        break;
+
+      // Count UTF-8 characters, not continuation bytes.
+      if ((c & 0xC0) != 0x80)
+        numChars++;
+      i++;
+    }
+
+    NameTokenType type;
+    if (digitsOnly)
+      type = NAME_TOKEN_NUMBER;
+    else if (numChars == 1)
+      type = NAME_TOKEN_INITIAL;
+    else
+      type = NAME_TOKEN_WORD;
+
+    if ((type == NAME_TOKEN_NUMBER && ! m_keepNumbers) ||
+        (type == NAME_TOKEN_INITIAL && ! m_keepInitials))
+      continue;
+
+    if (start > 0 && text[start-1] == '-' && n > 0 &&
+        tokens[n-1].text.data() + tokens[n-1].text.size() ==
+          text.data() + start - 1)
+      flags |= NAME_FLAG_HYPHEN;
+
+    NameToken& token = tokens[n++];
+    token.text = text.substr(start, i - start);
+    token.type = type;
+    token.flags = flags;
+  }
+  return n;
+}
+
+
+size_t NameTokenizer::handleParticles(
+  const string_view text,
+  NameToken tokens[],
+  const size_t n) const
+{
+  size_t numWords = 0;
+  for (size_t i = 0; i < n; i++)
+  {
+    if (tokens[i].type != NAME_TOKEN_WORD)
+      continue;
+    if (isParticle(tokens[i].text))
+      tokens[i].type = NAME_TOKEN_PARTICLE;
+    else
+      numWords++;
+  }
+
+  // A single particle at the start of a name is a given name ("Van
+  // Cliburn"), whereas a run of them starts a surname ("van der Berg").
+  if (n > 1 && tokens[0].type == NAME_TOKEN_PARTICLE &&
+      tokens[1].type != NAME_TOKEN_PARTICLE)
+  {
+    tokens[0].type = NAME_TOKEN_WORD;
+    numWords++;
+  }
+
+  if (m_particleMode == PARTICLES_KEEP)
+    return n;
+
+  if (m_particleMode == PARTICLES_DROP)
+  {
+    // Unless nothing else is left.
+    if (numWords == 0)
+      return n;
+
+    size_t m = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+      if (tokens[i].type != NAME_TOKEN_PARTICLE)
+        tokens[m++] = tokens[i];
+    }
+    return m;
+  }
+
+  // Join each run of particles onto the following word, as long as
+  // only spaces and hyphens come in between.
+  size_t m = 0;
+  size_t i = 0;
+  while (i < n)
+  {
+    size_t j = i;
+    while (j < n && tokens[j].type == NAME_TOKEN_PARTICLE)
+    {
+      if (j+1 < n)
+      {
+        const char * end = tokens[j].text.data() + tokens[j].text.size();
+        const char * next = tokens[j+1].text.data();
+        bool gapOK = true;
+        for (const char * p = end; p < next; p++)
+        {
+          if (*p != ' ' && *p != '-')
+            gapOK = false;
+        }
+        if (! gapOK)
+          break;
+      }
+      j++;
+    }
+
+    if (j > i && j < n && tokens[j].type == NAME_TOKEN_WORD)
+    {
+      // Particles i .. j-1 and the word j.
+      const size_t start = static_cast<size_t>(
+        tokens[i].text.data() - text.data());
+      const size_t end = static_cast<size_t>(
+        tokens[j].text.data() + tokens[j].text.size() - text.data());
+
+      unsigned flags = tokens[j].flags | NAME_FLAG_JOINED;
+      for (size_t k = i; k < j; k++)
+        flags |= (tokens[k].flags & NAME_FLAG_APOSTROPHE);
+      flags = (flags & ~static_cast<unsigned>(NAME_FLAG_HYPHEN)) |
+        (tokens[i].flags & NAME_FLAG_HYPHEN);
+
+      NameToken& token = tokens[m++];
+      token.text = text.substr(start, end - start);
+      token.type = NAME_TOKEN_WORD;
+      token.flags = flags;
+      i = j+1;
+    }
+    else
+    {
+      // No word to join onto.
+      tokens[m++] = tokens[i];
+      i++;
+    }
+  }
+  return m;
+}
+
+
+size_t NameTokenizer::split(
+  const string_view text,
+  NameToken tokens[],
+  const size_t maxTokens) const
+{
+  const size_t n = scan(text, tokens, maxTokens);
+  return handleParticles(text, tokens, n);
+}
+
+
+string_view NameTokenizer::compact(
+  const NameToken& token,
+  char buf[]) const
+{
+  if ((token.flags & (NAME_FLAG_APOSTROPHE | NAME_FLAG_JOINED)) == 0)
+    return token.text;
+
+  const string_view& text = token.text;
+  size_t len = 0;
+  size_t i = 0;
+  while (i < text.size() && len < NAME_MAX_TOKEN)
+  {
+    const size_t a = apostropheAt(text, i);
+    if (a > 0)
+      i += a;
+    else if (text[i] == ' ' || text[i] == '-')
+      i++;
+    else
+      buf[len++] = text[i++];
+  }
+  return string_view(buf, len);
+}
+
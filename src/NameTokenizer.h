@@ -0,0 +1,134 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// Splits player and event names into tokens for the encoder, without
+// allocating.  Tokens are string_view spans into the input.
+//
+// - Hyphens split: "Jean-Pierre" gives "Jean" and "Pierre", the second
+//   one marked NAME_FLAG_HYPHEN, so it encodes like "Jean Pierre".
+// - Apostrophes inside a word stay: "O'Brien" is one token.
+// - Single letters, with or without a dot, are initials: "J. Smith",
+//   "J.R. Smith".  Dots and other punctuation otherwise separate.
+// - Particles ("van", "der", "de", ...) are joined onto the following
+//   word by default, so "van der Berg" encodes like "Vanderberg".
+//   A single particle at the start of a name is a given name, so
+//   "Van Cliburn" stays two tokens.  Particles can also be kept as
+//   tokens of their own or dropped.
+//
+// compact() removes the spaces and apostrophes from a token into a
+// caller buffer, which is what the encoder should see.
+
+#ifndef NAMETOKENIZER_H
+#define NAMETOKENIZER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// Longest token that compact() passes on.
+#define NAME_MAX_TOKEN 128
+
+// Enough tokens for any sensible name line.
+#define NAME_MAX_TOKENS 64
+
+
+enum NameTokenType
+{
+  NAME_TOKEN_WORD = 0,
+  NAME_TOKEN_INITIAL = 1,
+  NAME_TOKEN_PARTICLE = 2,
+  NAME_TOKEN_NUMBER = 3
+};
+
+// Bits in NameToken::flags.
+#define NAME_FLAG_HYPHEN 0x1 // Joined to the previous token by a hyphen
+#define NAME_FLAG_APOSTROPHE 0x2 // Contains an apostrophe
+#define NAME_FLAG_JOINED 0x4 // Particles joined on, contains spaces
+
+enum ParticleMode
+{
+  PARTICLES_JOIN = 0,
+  PARTICLES_KEEP = 1,
+  PARTICLES_DROP = 2
+};
+
+struct NameToken
+{
+  string_view text;
+  NameTokenType type;
+  unsigned flags;
+};
+
+
+class NameTokenizer
+{
+  private:
+
+    // Lower-case particles.
+    vector<string> m_particles;
+
+    ParticleMode m_particleMode;
+
+    bool m_keepInitials;
+
+    bool m_keepNumbers;
+
+    // Character classes of all bytes.
+    unsigned char m_class[256];
+
+
+    size_t apostropheAt(
+      const string_view text,
+      const size_t pos) const;
+
+    size_t scan(
+      const string_view text,
+      NameToken tokens[],
+      const size_t maxTokens) const;
+
+    size_t handleParticles(
+      const string_view text,
+      NameToken tokens[],
+      const size_t n) const;
+
+  public:
+
+    NameTokenizer();
+    ~NameTokenizer();
+    void reset();
+
+    // Defaults for player names (particles joined) and for event
+    // names (particles kept as ordinary words).
+    void setPlayerNames();
+    void setEventNames();
+
+    void setParticles(const vector<string>& particles);
+    void setParticleMode(const ParticleMode mode);
+    void setKeepInitials(const bool keep);
+    void setKeepNumbers(const bool keep);
+
+    const vector<string>& getParticles() const;
+    ParticleMode getParticleMode() const;
+    bool getKeepInitials() const;
+    bool getKeepNumbers() const;
+
+    bool isParticle(const string_view word) const;
+
+    // Fills in at most maxTokens tokens and returns their number.
+    size_t split(
+      const string_view text,
+      NameToken tokens[],
+      const size_t maxTokens) const;
+
+    // The token text without spaces and apostrophes.  Uses buf (of
+    // NAME_MAX_TOKEN bytes) only if something has to be removed.
+    string_view compact(
+      const NameToken& token,
+      char buf[]) const;
+};
+
+#endif
@@ -0,0 +1,181 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include "PackedKey.h"
+
+// Bit position of the first symbol in the ordered layout.
+#define ORDERED_TOP (PACKED_KEY_BITS * (PACKED_KEY_MAX_LENGTH - 1))
+
+
+static inline unsigned symbolCode(const char c)
+{
+  if (c >= 'A' && c <= 'Z')
+    return static_cast<unsigned>(c - 'A') + 2;
+  else if (c == '0')
+    return 1;
+  else
+    return 0;
+}
+
+
+static inline char codeSymbol(const unsigned code)
+{
+  return (code == 1 ? '0' : static_cast<char>('A' + code - 2));
+}
+
+
+bool packKey(
+  const string_view key,
+  PackedKey& packed)
+{
+  if (key.size() > PACKED_KEY_MAX_LENGTH)
+    return false;
+
+  packed = 0;
+  unsigned shift = 0;
+  for (const char c: key)
+  {
+    const unsigned code = symbolCode(c);
+    if (code == 0)
+      return false;
+    packed |= static_cast<PackedKey>(code) << shift;
+    shift += PACKED_KEY_BITS;
+  }
+  return true;
+}
+
+
+bool packKeyOrdered(
+  const string_view key,
+  PackedKey& packed)
+{
+  if (key.size() > PACKED_KEY_MAX_LENGTH)
+    return false;
+
+  packed = 0;
+  int shift = ORDERED_TOP;
+  for (const char c: key)
+  {
+    const unsigned code = symbolCode(c);
+    if (code == 0)
+      return false;
+    packed |= static_cast<PackedKey>(code) << shift;
+    shift -= PACKED_KEY_BITS;
+  }
+  return true;
+}
+
+
+PackedKey packKeyPrefix(const string_view key)
+{
+  PackedKey packed = 0;
+  unsigned shift = 0;
+  for (size_t i = 0; i < key.size() &&
+      shift < PACKED_KEY_BITS * PACKED_KEY_MAX_LENGTH; i++)
+  {
+    const unsigned code = symbolCode(key[i]);
+    if (code == 0)
+      continue;
+    packed |= static_cast<PackedKey>(code) << shift;
+    shift += PACKED_KEY_BITS;
+  }
+  return packed;
+}
+
+
+PackedKey packKeyOrderedPrefix(const string_view key)
+{
+  PackedKey packed = 0;
+  int shift = ORDERED_TOP;
+  for (size_t i = 0; i < key.size() && shift >= 0; i++)
+  {
+    const unsigned code = symbolCode(key[i]);
+    if (code == 0)
+      continue;
+    packed |= static_cast<PackedKey>(code) << shift;
+    shift -= PACKED_KEY_BITS;
+  }
+  return packed;
+}
+
+
+void unpackKey(
+  const PackedKey packed,
+  string& key)
+{
+  key.clear();
+  for (PackedKey p = packed; p != 0; p >>= PACKED_KEY_BITS)
+    key.push_back(codeSymbol(static_cast<unsigned>(p & PACKED_KEY_MASK)));
+}
+
+
+void unpackKeyOrdered(
+  const PackedKey packed,
+  string& key)
+{
+  key.clear();
+  for (int shift = ORDERED_TOP; shift >= 0; shift -= PACKED_KEY_BITS)
+  {
+    const unsigned code =
+      static_cast<unsigned>((packed >> shift) & PACKED_KEY_MASK);
+    if (code == 0)
+      break;
+    key.push_back(codeSymbol(code));
+  }
+}
+
+
+unsigned packedKeyLength(const PackedKey packed)
+{
+  unsigned len = 0;
+  for (PackedKey p = packed; p != 0; p >>= PACKED_KEY_BITS)
+    len++;
+  return len;
+}
+
+
+unsigned packedKeyOrderedLength(const PackedKey packed)
+{
+  // The symbols are contiguous from the top, so count the
+  // padding symbols at the bottom.
+  unsigned len = PACKED_KEY_MAX_LENGTH;
+  for (int shift = 0; shift <= ORDERED_TOP; shift += PACKED_KEY_BITS)
+  {
+    if (((packed >> shift) & PACKED_KEY_MASK) != 0)
+      break;
+    len--;
+  }
+  return len;
+}
+
+
+PackedKey packedKeyToOrdered(const PackedKey packed)
+{
+  PackedKey ordered = 0;
+  int shift = ORDERED_TOP;
+  for (PackedKey p = packed; p != 0; p >>= PACKED_KEY_BITS)
+  {
+    ordered |= (p & PACKED_KEY_MASK) << shift;
+    shift -= PACKED_KEY_BITS;
+  }
+  return ordered;
+}
+
+
+PackedKey packedKeyFromOrdered(const PackedKey ordered)
+{
+  PackedKey packed = 0;
+  unsigned shift = 0;
+  for (int s = ORDERED_TOP; s >= 0; s -= PACKED_KEY_BITS)
+  {
+    const PackedKey code = (ordered >> s) & PACKED_KEY_MASK;
+    if (code == 0)
+      break;
+    packed |= code << shift;
+    shift += PACKED_KEY_BITS;
+  }
+  return packed;
+}
+
@@ -0,0 +1,92 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// Metaphone3 keys packed into a 64-bit integer.
+//
+// Keys only use '0' (for TH) and 'A'..'Z', so each symbol fits in
+// 5 bits:  '0' is 1 and 'A'..'Z' are 2..27, and 0 is padding.  A key
+// of up to PACKED_KEY_MAX_LENGTH symbols then takes 60 bits.  The
+// empty key packs to 0.
+//
+// There are two layouts of the same symbols.
+//
+// - Canonical:  symbol i in bits 5i .. 5i+4.  Cheap to build and to
+//   unpack, and fine for hashing and equality.
+// - Ordered:  symbol i in bits 55-5i .. 59-5i, so the first symbol is
+//   the most significant one.  Comparing two ordered keys as integers
+//   gives the same result as comparing the key strings, a key sorts
+//   before its extensions, and all keys with a given prefix form one
+//   contiguous range.
+
+#ifndef PACKEDKEY_H
+#define PACKEDKEY_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+typedef uint64_t PackedKey;
+
+#define PACKED_KEY_BITS 5
+#define PACKED_KEY_MASK 0x1f
+#define PACKED_KEY_MAX_LENGTH 12
+
+
+// Returns false if the key is too long or has a symbol outside the
+// key alphabet.  packed is then undefined.
+bool packKey(
+  const string_view key,
+  PackedKey& packed);
+
+bool packKeyOrdered(
+  const string_view key,
+  PackedKey& packed);
+
+// Packs at most the first PACKED_KEY_MAX_LENGTH symbols, and skips
+// symbols outside the alphabet.  For keys known to be valid.
+PackedKey packKeyPrefix(const string_view key);
+PackedKey packKeyOrderedPrefix(const string_view key);
+
+void unpackKey(
+  const PackedKey packed,
+  string& key);
+
+void unpackKeyOrdered(
+  const PackedKey packed,
+  string& key);
+
+// Number of symbols.
+unsigned packedKeyLength(const PackedKey packed);
+unsigned packedKeyOrderedLength(const PackedKey packed);
+
+// Converts between the two layouts.
+PackedKey packedKeyToOrdered(const PackedKey packed);
+PackedKey packedKeyFromOrdered(const PackedKey ordered);
+
+// A well-mixed hash of either layout, for open-addressing tables
+// (the keys themselves have most of their entropy in few bits).
+inline uint64_t packedKeyHash(const PackedKey packed)
+{
+  // The finalizer of splitmix64.
+  uint64_t h = packed + 0x9e3779b97f4a7c15ull;
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+  return h ^ (h >> 31);
+}
+
+// A hash of a sequence of keys, such as the tokens of a name.
+inline uint64_t packedKeysHash(
+  const PackedKey keys[],
+  const size_t numKeys)
+{
+  uint64_t h = numKeys;
+  for (size_t i = 0; i < numKeys; i++)
+    h = packedKeyHash(h ^ keys[i]);
+  return h;
+}
+
+#endif
@@ -0,0 +1,399 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <algorithm>
+#include <cstring>
+
+#include "PhoneticIndex.h"
+#include "encode.h"
+#include "files.h"
+#include "IndexFormat.h"
+#include "PostingCodec.h"
+#include "MappedIndex.h"
+#include "NameQuery.h"
+#include "Scheduler.h"
+
+
+PhoneticIndex::PhoneticIndex()
+{
+  reset();
+}
+
+
+PhoneticIndex::~PhoneticIndex()
+{
+}
+
+
+void PhoneticIndex::reset()
+{
+  for (auto& table: m_tables)
+  {
+    table.keys.clear();
+    table.offsets.clear();
+    table.offsets.push_back(0);
+    table.postings.clear();
+  }
+
+  m_pool.clear();
+  m_nameStart.clear();
+  m_nameStart.push_back(0);
+
+  m_useTokenizer = false;
+  m_tokenizer.reset();
+}
+
+
+const NameTokenizer * PhoneticIndex::tokenizer() const
+{
+  return (m_useTokenizer ? &m_tokenizer : nullptr);
+}
+
+
+void PhoneticIndex::build(
+  const vector<string>& names,
+  const NameTokenizer * tokenizerIn,
+  const unsigned numThreads)
+{
+  reset();
+  if (tokenizerIn)
+  {
+    m_useTokenizer = true;
+    m_tokenizer = * tokenizerIn;
+  }
+
+  // The name pool, without the \r of DOS line ends.
+  size_t poolSize = 0;
+  for (auto& name: names)
+    poolSize += name.size();
+  m_pool.reserve(poolSize);
+  m_nameStart.reserve(names.size() + 1);
+
+  for (auto& name: names)
+  {
+    string_view view(name);
+    if (! view.empty() && view.back() == '\r')
+      view.remove_suffix(1);
+    m_pool.append(view);
+    m_nameStart.push_back(static_cast<uint32_t>(m_pool.size()));
+  }
+
+  // Encode the names in chunks.  Within a chunk, the entries come in
+  // record order.
+  struct Entry
+  {
+    PackedKey key;
+    uint32_t record;
+  };
+
+  const size_t numChunks = (names.size() + INDEX_CHUNK - 1) / INDEX_CHUNK;
+  vector<vector<Entry>> entries(numChunks * INDEX_CONFIGS);
+
+  Scheduler scheduler;
+  scheduler.setThreads(numThreads);
+  vector<Metaphone3> encoders(scheduler.getThreads());
+  const NameTokenizer * tok = tokenizer();
+
+  scheduler.run(vector<size_t>(numChunks, 1), [&](size_t chunk,
+    unsigned thrNo)
+  {
+    Metaphone3& mph = encoders[thrNo];
+    PackedKey mains[NAME_MAX_TOKENS], alts[NAME_MAX_TOKENS];
+    const size_t first = chunk * INDEX_CHUNK;
+    const size_t last = min(first + INDEX_CHUNK, names.size());
+
+    for (unsigned config = 0; config < INDEX_CONFIGS; config++)
+    {
+      setIndexConfig(mph, config);
+      vector<Entry>& list = entries[chunk * INDEX_CONFIGS + config];
+      for (size_t r = first; r < last; r++)
+      {
+        const size_t n = encodeTokenKeys(mph, names[r], tok,
+          mains, alts, NAME_MAX_TOKENS);
+        const uint32_t record = static_cast<uint32_t>(r);
+        for (size_t i = 0; i < n; i++)
+        {
+          list.push_back({mains[i], record});
+          if (alts[i] != 0)
+            list.push_back({alts[i], record});
+        }
+      }
+    }
+  });
+
+  // Then group each configuration by key.  The chunks are in record
+  // order, so a stable sort by key leaves each posting list sorted.
+  scheduler.run(vector<size_t>(INDEX_CONFIGS, 1), [&](size_t config,
+    unsigned)
+  {
+    vector<Entry> all;
+    size_t total = 0;
+    for (size_t chunk = 0; chunk < numChunks; chunk++)
+      total += entries[chunk * INDEX_CONFIGS + config].size();
+    all.reserve(total);
+
+    for (size_t chunk = 0; chunk < numChunks; chunk++)
+    {
+      vector<Entry>& list = entries[chunk * INDEX_CONFIGS + config];
+      all.insert(all.end(), list.begin(), list.end());
+      vector<Entry>().swap(list);
+    }
+
+    stable_sort(all.begin(), all.end(), [](const Entry& a, const Entry& b)
+    {
+      return a.key < b.key;
+    });
+
+    KeyTable& table = m_tables[config];
+    vector<uint32_t>& postings = table.postings;
+    table.offsets.clear();
+    postings.reserve(all.size());
+    for (size_t i = 0; i < all.size(); i++)
+    {
+      if (i == 0 || all[i].key != all[i-1].key)
+      {
+        table.keys.push_back(all[i].key);
+        table.offsets.push_back(static_cast<uint32_t>(postings.size()));
+        postings.push_back(all[i].record);
+      }
+      else if (all[i].record != postings.back())
+        postings.push_back(all[i].record);
+    }
+    table.offsets.push_back(static_cast<uint32_t>(postings.size()));
+    postings.shrink_to_fit();
+  });
+}
+
+
+bool PhoneticIndex::buildFromFile(
+  const string& fname,
+  const NameTokenizer * tokenizerIn,
+  const unsigned numThreads)
+{
+  vector<string> names;
+  if (! readFile(fname, names))
+    return false;
+
+  build(names, tokenizerIn, numThreads);
+  return true;
+}
+
+
+void PhoneticIndex::merge(const vector<const PhoneticIndex *>& parts)
+{
+  reset();
+  if (parts.empty())
+    return;
+
+  m_useTokenizer = parts[0]->m_useTokenizer;
+  m_tokenizer = parts[0]->m_tokenizer;
+
+  size_t poolSize = 0, numNamesAll = 0;
+  for (auto part: parts)
+  {
+    poolSize += part->m_pool.size();
+    numNamesAll += part->numNames();
+  }
+  m_pool.reserve(poolSize);
+  m_nameStart.reserve(numNamesAll + 1);
+
+  vector<uint32_t> bases;
+  for (auto part: parts)
+  {
+    bases.push_back(static_cast<uint32_t>(numNames()));
+    const uint32_t offset = static_cast<uint32_t>(m_pool.size());
+    m_pool.append(part->m_pool);
+    for (size_t i = 1; i < part->m_nameStart.size(); i++)
+      m_nameStart.push_back(offset + part->m_nameStart[i]);
+  }
+
+  // The parts are in record order, so appending the posting lists of
+  // a key part by part keeps them sorted.
+  for (unsigned config = 0; config < INDEX_CONFIGS; config++)
+  {
+    KeyTable& table = m_tables[config];
+    size_t numPostingsAll = 0;
+    for (auto part: parts)
+    {
+      const KeyTable& pt = part->m_tables[config];
+      table.keys.insert(table.keys.end(), pt.keys.begin(), pt.keys.end());
+      numPostingsAll += pt.postings.size();
+    }
+    sort(table.keys.begin(), table.keys.end());
+    table.keys.erase(unique(table.keys.begin(), table.keys.end()),
+      table.keys.end());
+
+    table.offsets.clear();
+    table.offsets.reserve(table.keys.size() + 1);
+    table.postings.reserve(numPostingsAll);
+    vector<size_t> next(parts.size(), 0);
+
+    for (auto key: table.keys)
+    {
+      table.offsets.push_back(static_cast<uint32_t>(table.postings.size()));
+      for (size_t p = 0; p < parts.size(); p++)
+      {
+        const KeyTable& pt = parts[p]->m_tables[config];
+        const size_t k = next[p];
+        if (k == pt.keys.size() || pt.keys[k] != key)
+          continue;
+
+        for (uint32_t i = pt.offsets[k]; i < pt.offsets[k+1]; i++)
+          table.postings.push_back(bases[p] + pt.postings[i]);
+        next[p]++;
+      }
+    }
+    table.offsets.push_back(static_cast<uint32_t>(table.postings.size()));
+  }
+}
+
+
+static void alignTo8(string& out)
+{
+  while (out.size() % 8 != 0)
+    out.push_back('\0');
+}
+
+
+template<class T>
+static void appendArray(
+  string& out,
+  const T * data,
+  const size_t count)
+{
+  out.append(reinterpret_cast<const char *>(data), count * sizeof(T));
+}
+
+
+bool PhoneticIndex::save(const string& fname) const
+{
+  IndexHeader header;
+  memset(&header, 0, sizeof header);
+  memcpy(header.magic, INDEX_MAGIC, sizeof header.magic);
+  header.version = INDEX_VERSION;
+  header.headerSize = sizeof header;
+  header.numNames = static_cast<uint32_t>(numNames());
+
+  string out(sizeof header, '\0');
+
+  // The tokenizer, so that name lookups split names the same way.
+  header.tokenizerOffset = out.size();
+  IndexTokenizer tok;
+  tok.useTokenizer = (m_useTokenizer ? 1 : 0);
+  tok.particleMode = static_cast<uint32_t>(m_tokenizer.getParticleMode());
+  tok.keepInitials = (m_tokenizer.getKeepInitials() ? 1 : 0);
+  tok.keepNumbers = (m_tokenizer.getKeepNumbers() ? 1 : 0);
+  appendArray(out, &tok, 1);
+  for (auto& p: m_tokenizer.getParticles())
+    out += p + " ";
+  header.tokenizerSize = out.size() - header.tokenizerOffset;
+  alignTo8(out);
+
+  header.nameStartOffset = out.size();
+  appendArray(out, m_nameStart.data(), m_nameStart.size());
+  alignTo8(out);
+
+  header.poolOffset = out.size();
+  header.poolSize = m_pool.size();
+  out += m_pool;
+  alignTo8(out);
+
+  vector<IndexDirEntry> dir;
+  string postings;
+  for (unsigned config = 0; config < INDEX_CONFIGS; config++)
+  {
+    const KeyTable& table = m_tables[config];
+    IndexSection& section = header.configs[config];
+
+    dir.resize(table.keys.size());
+    postings.clear();
+    for (size_t k = 0; k < table.keys.size(); k++)
+    {
+      dir[k].key = table.keys[k];
+      dir[k].offset = postings.size();
+      dir[k].count = table.offsets[k+1] - table.offsets[k];
+      dir[k].reserved = 0;
+      encodePostings(table.postings.data() + table.offsets[k],
+        dir[k].count, postings);
+    }
+
+    section.dirOffset = out.size();
+    section.numKeys = dir.size();
+    appendArray(out, dir.data(), dir.size());
+
+    section.postingsOffset = out.size();
+    section.postingsSize = postings.size();
+    section.numPostings = table.postings.size();
+    out += postings;
+    alignTo8(out);
+  }
+
+  header.fileSize = out.size();
+  header.checksum = indexChecksum(out.data() + sizeof header,
+    out.size() - sizeof header);
+  memcpy(&out[0], &header, sizeof header);
+
+  return writeFile(fname, out);
+}
+
+
+size_t PhoneticIndex::numNames() const
+{
+  return m_nameStart.size() - 1;
+}
+
+
+size_t PhoneticIndex::numKeys(const unsigned config) const
+{
+  return m_tables[config].keys.size();
+}
+
+
+size_t PhoneticIndex::numPostings(const unsigned config) const
+{
+  return m_tables[config].postings.size();
+}
+
+
+string_view PhoneticIndex::getName(const uint32_t record) const
+{
+  return string_view(m_pool).substr(m_nameStart[record],
+    m_nameStart[record+1] - m_nameStart[record]);
+}
+
+
+const vector<PackedKey>& PhoneticIndex::getKeys(
+  const unsigned config) const
+{
+  return m_tables[config].keys;
+}
+
+
+PostingSpan PhoneticIndex::lookupKey(
+  const unsigned config,
+  const PackedKey key) const
+{
+  const KeyTable& table = m_tables[config];
+  auto it = lower_bound(table.keys.begin(), table.keys.end(), key);
+  if (it == table.keys.end() || * it != key)
+    return {nullptr, 0};
+
+  const size_t k = static_cast<size_t>(it - table.keys.begin());
+  return {table.postings.data() + table.offsets[k],
+    table.offsets[k+1] - table.offsets[k]};
+}
+
+
+void PhoneticIndex::lookupName(
+  Metaphone3& mph,
+  const string_view text,
+  const unsigned config,
+  vector<uint32_t>& records) const
+{
+  NameQuery query;
+  query.setIndex(* this);
+  query.lookup(mph, text, config, 0, records);
+}
+
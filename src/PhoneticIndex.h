@@ -0,0 +1,125 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// An inverted index from Metaphone3 keys to the records (names) that
+// have them, for finding the same player across lists.
+//
+// Each name is split into tokens, and each token is encoded in all
+// four configurations.  For each configuration, both the main and the
+// alternate key of a token lead to the record.  The keys are ordered
+// packed keys (see PackedKey.h).
+//
+// Each configuration is stored in compressed sparse row form:  a
+// sorted array of the distinct keys, an array of offsets, and one
+// array of all posting lists back to back, each list sorted and
+// without duplicates.  Record numbers are the 0-based line numbers
+// of the input.  The names themselves live in one string pool.
+
+#ifndef PHONETICINDEX_H
+#define PHONETICINDEX_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+#include "Metaphone3.h"
+#include "NameTokenizer.h"
+#include "PackedKey.h"
+
+using namespace std;
+
+// The four combinations of encodeVowels and encodeExact, numbered
+// 2 * encodeVowels + encodeExact as in the driver output.
+#define INDEX_CONFIGS 4
+
+// Names per encoding job in build().
+#define INDEX_CHUNK 4096
+
+
+struct PostingSpan
+{
+  const uint32_t * data;
+  size_t size;
+};
+
+
+class PhoneticIndex
+{
+  private:
+
+    struct KeyTable
+    {
+      vector<PackedKey> keys;
+      vector<uint32_t> offsets; // keys.size() + 1 entries
+      vector<uint32_t> postings;
+    };
+
+    KeyTable m_tables[INDEX_CONFIGS];
+
+    // Name i is m_pool[m_nameStart[i] .. m_nameStart[i+1]-1].
+    string m_pool;
+    vector<uint32_t> m_nameStart;
+
+    bool m_useTokenizer;
+    NameTokenizer m_tokenizer;
+
+  public:
+
+    PhoneticIndex();
+    ~PhoneticIndex();
+    void reset();
+
+    // Indexes names, encoding them on numThreads threads (0: one per
+    // hardware thread).  Without a tokenizer, names are split on
+    // spaces.  The tokenizer is copied and later used for lookups.
+    void build(
+      const vector<string>& names,
+      const NameTokenizer * tokenizer,
+      const unsigned numThreads);
+
+    // The same for the lines of a (possibly compressed) name file.
+    bool buildFromFile(
+      const string& fname,
+      const NameTokenizer * tokenizer,
+      const unsigned numThreads);
+
+    // Indexes the names of parts one after the other, so record r of
+    // the second part becomes parts[0]->numNames() + r and so on.  The
+    // keys are merged without encoding the names again.  The
+    // tokenizer is that of the first part.
+    void merge(const vector<const PhoneticIndex *>& parts);
+
+    size_t numNames() const;
+    size_t numKeys(const unsigned config) const;
+    size_t numPostings(const unsigned config) const;
+
+    string_view getName(const uint32_t record) const;
+
+    // The tokenizer given to build(), or nullptr if there was none.
+    const NameTokenizer * tokenizer() const;
+
+    // The distinct keys of config, sorted.
+    const vector<PackedKey>& getKeys(const unsigned config) const;
+
+    // Writes the index in the format of IndexFormat.h.
+    bool save(const string& fname) const;
+
+    // The records with key (ordered packed) in config.  Empty if the
+    // key does not occur.  The span is valid as long as the index.
+    PostingSpan lookupKey(
+      const unsigned config,
+      const PackedKey key) const;
+
+    // The records that share, for every token of text, the main or
+    // the alternate key of that token in config.
+    void lookupName(
+      Metaphone3& mph,
+      const string_view text,
+      const unsigned config,
+      vector<uint32_t>& records) const;
+};
+
+#endif
@@ -0,0 +1,178 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include "PhoneticKeys.h"
+#include "encode.h"
+
+static const char * ALGO_NAMES[ALGO_COUNT] =
+{
+  "metaphone3",
+  "dmetaphone",
+  "soundex",
+  "nysiis"
+};
+
+// Whether an algorithm gives alternate keys.
+static const bool ALGO_HAS_ALT[ALGO_COUNT] =
+{
+  true,
+  true,
+  false,
+  false
+};
+
+
+bool parseAlgorithms(
+  const string& text,
+  unsigned& mask)
+{
+  vector<string> names;
+  tokenize(text, names, ",");
+
+  mask = 0;
+  for (auto& name: names)
+  {
+    if (name == "all")
+    {
+      mask |= ALGO_ALL;
+      continue;
+    }
+
+    unsigned a;
+    for (a = 0; a < ALGO_COUNT; a++)
+    {
+      if (name == ALGO_NAMES[a])
+        break;
+    }
+    if (a == ALGO_COUNT)
+      return false;
+    mask |= 1u << a;
+  }
+  return (mask != 0);
+}
+
+
+const char * algorithmName(const PhoneticAlgorithm algo)
+{
+  return ALGO_NAMES[algo];
+}
+
+
+PhoneticKeys::PhoneticKeys()
+{
+  reset();
+}
+
+
+PhoneticKeys::~PhoneticKeys()
+{
+}
+
+
+void PhoneticKeys::reset()
+{
+  m_algorithms = ALGO_ALL;
+  m_doubleMetaphone.reset();
+  m_soundex.reset();
+  m_nysiis.reset();
+  m_normal.clear();
+}
+
+
+void PhoneticKeys::setAlgorithms(const unsigned mask)
+{
+  m_algorithms = mask & ALGO_ALL;
+}
+
+
+unsigned PhoneticKeys::getAlgorithms() const
+{
+  return m_algorithms;
+}
+
+
+Metaphone3& PhoneticKeys::metaphone3()
+{
+  return m_metaphone3;
+}
+
+
+void PhoneticKeys::encodeToken(
+  const string_view word,
+  TokenKeys& keys)
+{
+  m_metaphone3.normalize(word, m_normal);
+
+  for (unsigned a = 0; a < ALGO_COUNT; a++)
+  {
+    keys.main[a].clear();
+    keys.alt[a].clear();
+  }
+
+  if (m_algorithms & (1u << ALGO_METAPHONE3))
+  {
+    m_metaphone3.setNormalizedWord(m_normal);
+    m_metaphone3.encode();
+    keys.main[ALGO_METAPHONE3] = m_metaphone3.getMetaph();
+    keys.alt[ALGO_METAPHONE3] = m_metaphone3.getAlternateMetaph();
+  }
+
+  if (m_algorithms & (1u << ALGO_DOUBLE_METAPHONE))
+  {
+    m_doubleMetaphone.setNormalizedWord(m_normal);
+    m_doubleMetaphone.encode();
+    keys.main[ALGO_DOUBLE_METAPHONE] = m_doubleMetaphone.getMetaph();
+    keys.alt[ALGO_DOUBLE_METAPHONE] =
+      m_doubleMetaphone.getAlternateMetaph();
+  }
+
+  if (m_algorithms & (1u << ALGO_SOUNDEX))
+  {
+    m_soundex.setNormalizedWord(m_normal);
+    m_soundex.encode();
+    keys.main[ALGO_SOUNDEX] = m_soundex.getKey();
+  }
+
+  if (m_algorithms & (1u << ALGO_NYSIIS))
+  {
+    m_nysiis.setNormalizedWord(m_normal);
+    m_nysiis.encode();
+    keys.main[ALGO_NYSIIS] = m_nysiis.getKey();
+  }
+}
+
+
+void PhoneticKeys::encodeLine(
+  const string_view text,
+  const NameTokenizer * tokenizer,
+  string& out)
+{
+  string mains[ALGO_COUNT], alts[ALGO_COUNT];
+  TokenKeys keys;
+  forEachToken(text, tokenizer, NAME_MAX_TOKENS,
+    [&](const string_view word)
+  {
+    encodeToken(word, keys);
+    for (unsigned a = 0; a < ALGO_COUNT; a++)
+    {
+      if (! keys.main[a].empty())
+        mains[a] += (mains[a].empty() ? "" : " ") + keys.main[a];
+      if (! keys.alt[a].empty())
+        alts[a] += (alts[a].empty() ? "" : " ") + keys.alt[a];
+    }
+    return true;
+  });
+
+  out.append(text);
+  for (unsigned a = 0; a < ALGO_COUNT; a++)
+  {
+    if ((m_algorithms & (1u << a)) == 0)
+      continue;
+    out += ";" + mains[a];
+    if (ALGO_HAS_ALT[a])
+      out += ";" + alts[a];
+  }
+  out += "\n";
+}
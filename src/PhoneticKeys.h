@@ -0,0 +1,103 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// Several phonetic algorithms at once:  Metaphone 3, Double Metaphone,
+// Soundex and NYSIIS.  A token is normalized (upper-cased, accents
+// mapped) once by Metaphone3::normalize(), and every selected
+// algorithm encodes that same word, so comparing the algorithms costs
+// one normalization and one tokenization per token rather than one
+// per algorithm.
+
+#ifndef PHONETICKEYS_H
+#define PHONETICKEYS_H
+
+#include <string>
+#include <string_view>
+
+#include "Metaphone3.h"
+#include "DoubleMetaphone.h"
+#include "Soundex.h"
+#include "NYSIIS.h"
+#include "NameTokenizer.h"
+
+using namespace std;
+
+
+enum PhoneticAlgorithm
+{
+  ALGO_METAPHONE3 = 0,
+  ALGO_DOUBLE_METAPHONE = 1,
+  ALGO_SOUNDEX = 2,
+  ALGO_NYSIIS = 3,
+  ALGO_COUNT = 4
+};
+
+#define ALGO_ALL ((1u << ALGO_COUNT) - 1)
+
+
+// The keys of one token.  Only Metaphone 3 and Double Metaphone have
+// alternate keys, and those are empty if they equal the main key.
+// The keys of algorithms that were not selected are empty.
+struct TokenKeys
+{
+  string main[ALGO_COUNT];
+  string alt[ALGO_COUNT];
+};
+
+
+// Parses a comma-separated list of metaphone3, dmetaphone, soundex and
+// nysiis, or all, into a mask of 1 << PhoneticAlgorithm.
+bool parseAlgorithms(
+  const string& text,
+  unsigned& mask);
+
+const char * algorithmName(const PhoneticAlgorithm algo);
+
+
+class PhoneticKeys
+{
+  private:
+
+    unsigned m_algorithms;
+
+    Metaphone3 m_metaphone3;
+    DoubleMetaphone m_doubleMetaphone;
+    Soundex m_soundex;
+    NYSIIS m_nysiis;
+
+    // The normalized token, shared by all the algorithms.
+    string m_normal;
+
+  public:
+
+    PhoneticKeys();
+    ~PhoneticKeys();
+    void reset();
+
+    // A mask of 1 << PhoneticAlgorithm (default ALGO_ALL).
+    void setAlgorithms(const unsigned mask);
+    unsigned getAlgorithms() const;
+
+    // For the settings of Metaphone 3 (vowels, exact, key length).
+    Metaphone3& metaphone3();
+
+    // Normalizes word once and encodes it with every selected
+    // algorithm.
+    void encodeToken(
+      const string_view word,
+      TokenKeys& keys);
+
+    // Appends text and then, for each selected algorithm in the order
+    // of PhoneticAlgorithm, the main keys of the tokens and their
+    // alternate keys (if the algorithm has them), all separated by
+    // semicolons, and a newline.  Within a field the keys are separated
+    // by spaces.  Without a tokenizer, text is split on spaces.
+    void encodeLine(
+      const string_view text,
+      const NameTokenizer * tokenizer,
+      string& out);
+};
+
+#endif
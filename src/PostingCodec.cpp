@@ -0,0 +1,461 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+  #define POSTING_SSE2
+#endif
+
+#include <algorithm>
+#include <utility>
+#include <cstring>
+#include <cstdint>
+
+#include "PostingCodec.h"
+#include "IndexFormat.h"
+
+#define POSTING_LANES 4
+#define POSTING_ROWS (POSTING_BLOCK / POSTING_LANES)
+
+// Bytes per skip table entry.
+#define POSTING_SKIP 8
+
+
+static unsigned bitWidth(uint32_t value)
+{
+  unsigned width = 0;
+  while (value != 0)
+  {
+    width++;
+    value >>= 1;
+  }
+  return width;
+}
+
+
+static void putUint32(
+  const uint32_t value,
+  string& out,
+  const size_t pos)
+{
+  memcpy(&out[pos], &value, sizeof value);
+}
+
+
+static uint32_t getUint32(const uint8_t * p)
+{
+  uint32_t value;
+  memcpy(&value, p, sizeof value);
+  return value;
+}
+
+
+// Packs the deltas of one block (see PostingCodec.h) into 16 * width
+// bytes at the end of out.
+static void packBlock(
+  const uint32_t deltas[],
+  const unsigned width,
+  string& out)
+{
+  vector<uint32_t> words(POSTING_LANES * width, 0);
+  for (unsigned lane = 0; lane < POSTING_LANES; lane++)
+  {
+    unsigned word = 0, bit = 0;
+    for (unsigned row = 0; row < POSTING_ROWS; row++)
+    {
+      const uint32_t d = deltas[POSTING_LANES * row + lane];
+      words[POSTING_LANES * word + lane] |= d << bit;
+      if (bit + width > 32)
+        words[POSTING_LANES * (word + 1) + lane] |= d >> (32 - bit);
+
+      bit += width;
+      if (bit >= 32)
+      {
+        bit -= 32;
+        word++;
+      }
+    }
+  }
+
+  const size_t pos = out.size();
+  out.resize(pos + words.size() * sizeof(uint32_t));
+  if (! words.empty())
+    memcpy(&out[pos], words.data(), words.size() * sizeof(uint32_t));
+}
+
+
+void encodePostings(
+  const uint32_t records[],
+  const size_t count,
+  string& out)
+{
+  const size_t numBlocks = count / POSTING_BLOCK;
+  const size_t start = out.size();
+  out.resize(start + numBlocks * POSTING_SKIP);
+
+  uint32_t base = 0;
+  uint32_t deltas[POSTING_BLOCK];
+  for (size_t b = 0; b < numBlocks; b++)
+  {
+    const uint32_t * block = records + b * POSTING_BLOCK;
+    uint32_t maxDelta = 0;
+    for (unsigned i = 0; i < POSTING_BLOCK; i++)
+    {
+      deltas[i] = block[i] - (i == 0 ? base : block[i - 1]);
+      maxDelta = max(maxDelta, deltas[i]);
+    }
+
+    const unsigned width = bitWidth(maxDelta);
+    putUint32(block[POSTING_BLOCK - 1], out, start + b * POSTING_SKIP);
+    putUint32(static_cast<uint32_t>(out.size() - start), out,
+      start + b * POSTING_SKIP + 4);
+
+    out.push_back(static_cast<char>(width));
+    packBlock(deltas, width, out);
+    base = block[POSTING_BLOCK - 1];
+  }
+
+  for (size_t i = numBlocks * POSTING_BLOCK; i < count; i++)
+  {
+    putVarint(records[i] - base, out);
+    base = records[i];
+  }
+}
+
+
+#if defined(POSTING_SSE2)
+
+// With the width known at compile time, the loop unrolls into straight
+// shifts and masks.
+template<unsigned W>
+static void unpackWidth(
+  const __m128i * words,
+  __m128i sum,
+  uint32_t out[])
+{
+  const __m128i mask = _mm_set1_epi32(static_cast<int>(
+    W == 32 ? 0xffffffffu : (1u << W) - 1));
+  __m128i word = _mm_loadu_si128(words);
+
+  for (unsigned row = 0; row < POSTING_ROWS; row++)
+  {
+    const unsigned bit = (row * W) % 32;
+    __m128i d = _mm_srli_epi32(word, bit);
+    if (bit + W >= 32 && row + 1 < POSTING_ROWS)
+    {
+      word = _mm_loadu_si128(++words);
+      if (bit + W > 32)
+        d = _mm_or_si128(d, _mm_slli_epi32(word, 32 - bit));
+    }
+
+    if (W < 32)
+      d = _mm_and_si128(d, mask);
+
+    // Prefix sum of the four deltas, plus the last record so far.
+    d = _mm_add_epi32(d, _mm_slli_si128(d, 4));
+    d = _mm_add_epi32(d, _mm_slli_si128(d, 8));
+    sum = _mm_add_epi32(d, _mm_shuffle_epi32(sum, _MM_SHUFFLE(3, 3, 3, 3)));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + POSTING_LANES * row),
+      sum);
+  }
+}
+
+
+template<unsigned... W>
+static void unpackSwitch(
+  const unsigned width,
+  const __m128i * words,
+  const __m128i sum,
+  uint32_t out[],
+  integer_sequence<unsigned, W...>)
+{
+  using Unpacker = void (*)(const __m128i *, __m128i, uint32_t []);
+  static const Unpacker unpackers[] = { unpackWidth<W + 1>... };
+  unpackers[width - 1](words, sum, out);
+}
+
+
+static void unpackBlock(
+  const uint8_t * p,
+  const uint32_t base,
+  uint32_t out[])
+{
+  const unsigned width = * p++;
+  const __m128i sum = _mm_set1_epi32(static_cast<int>(base));
+  if (width == 0)
+  {
+    // Only possible for a list with a repeated record.
+    for (unsigned row = 0; row < POSTING_ROWS; row++)
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(
+        out + POSTING_LANES * row), sum);
+    return;
+  }
+
+  unpackSwitch(width, reinterpret_cast<const __m128i *>(p), sum, out,
+    make_integer_sequence<unsigned, 32>());
+}
+
+
+const char * postingDecoder()
+{
+  return "SSE2";
+}
+
+#else
+
+static void unpackBlock(
+  const uint8_t * p,
+  const uint32_t base,
+  uint32_t out[])
+{
+  const unsigned width = * p++;
+  const uint32_t mask = (width == 32 ? 0xffffffffu : (1u << width) - 1);
+
+  for (unsigned lane = 0; lane < POSTING_LANES; lane++)
+  {
+    unsigned word = 0, bit = 0;
+    for (unsigned row = 0; row < POSTING_ROWS; row++)
+    {
+      const uint8_t * w = p + 4 * (POSTING_LANES * word + lane);
+      uint32_t d = (width == 0 ? 0 : getUint32(w) >> bit);
+      if (bit + width > 32)
+        d |= getUint32(w + 4 * POSTING_LANES) << (32 - bit);
+
+      bit += width;
+      if (bit >= 32)
+      {
+        bit -= 32;
+        word++;
+      }
+
+      out[POSTING_LANES * row + lane] = d & mask;
+    }
+  }
+
+  uint32_t sum = base;
+  for (unsigned i = 0; i < POSTING_BLOCK; i++)
+  {
+    sum += out[i];
+    out[i] = sum;
+  }
+}
+
+
+const char * postingDecoder()
+{
+  return "plain";
+}
+
+#endif
+
+
+size_t seekPosting(
+  const uint32_t records[],
+  const size_t pos,
+  const size_t size,
+  const uint32_t target)
+{
+  size_t lo = pos;
+
+#if defined(POSTING_SSE2)
+  if (lo + POSTING_LANES <= size)
+  {
+    // SSE2 only compares signed, so flip the top bits.
+    const __m128i bias = _mm_set1_epi32(INT32_MIN);
+    const __m128i t = _mm_xor_si128(
+      _mm_set1_epi32(static_cast<int>(target)), bias);
+    const __m128i v = _mm_xor_si128(bias,
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(records + lo)));
+    const unsigned below = static_cast<unsigned>(
+      _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(v, t))));
+
+    // The records below target come first, so below is 0, 1, 3, 7 or 15.
+    if (below != 0xf)
+      return lo + (below & 1) + ((below >> 1) & 1) + ((below >> 2) & 1);
+    lo += POSTING_LANES;
+  }
+#endif
+
+  size_t step = 1;
+  while (lo + step <= size && records[lo + step - 1] < target)
+  {
+    lo += step;
+    step *= 2;
+  }
+  return static_cast<size_t>(lower_bound(records + lo,
+    records + min(lo + step, size), target) - records);
+}
+
+
+PostingReader::PostingReader()
+{
+  reset();
+}
+
+
+PostingReader::~PostingReader()
+{
+}
+
+
+void PostingReader::reset()
+{
+  m_data = nullptr;
+  m_count = 0;
+  m_numBlocks = 0;
+  m_block = 0;
+  m_pos = 0;
+}
+
+
+uint32_t PostingReader::skipLast(const uint32_t block) const
+{
+  return getUint32(m_data + block * POSTING_SKIP);
+}
+
+
+uint32_t PostingReader::skipOffset(const uint32_t block) const
+{
+  return getUint32(m_data + block * POSTING_SKIP + 4);
+}
+
+
+void PostingReader::loadBlock(const uint32_t block)
+{
+  m_block = block;
+  const uint32_t base = (block == 0 ? 0 : skipLast(block - 1));
+  if (block < m_numBlocks)
+  {
+    unpackBlock(m_data + skipOffset(block), base, m_buffer);
+    return;
+  }
+
+  // The tail follows the last full block.
+  const uint8_t * p;
+  if (m_numBlocks == 0)
+    p = m_data;
+  else
+  {
+    const uint8_t * last = m_data + skipOffset(m_numBlocks - 1);
+    p = last + 1 + 4 * POSTING_LANES * last[0];
+  }
+
+  uint32_t record = base;
+  const uint32_t tail = m_count - m_numBlocks * POSTING_BLOCK;
+  for (uint32_t i = 0; i < tail; i++)
+  {
+    uint32_t gap;
+    p = getVarint(p, gap);
+    record += gap;
+    m_buffer[i] = record;
+  }
+}
+
+
+void PostingReader::init(
+  const uint8_t * data,
+  const uint32_t count)
+{
+  m_data = data;
+  m_count = count;
+  m_numBlocks = count / POSTING_BLOCK;
+  m_pos = 0;
+  if (count > 0)
+    loadBlock(0);
+}
+
+
+uint32_t PostingReader::size() const
+{
+  return m_count;
+}
+
+
+void PostingReader::decodeAll(vector<uint32_t>& records)
+{
+  records.resize(m_count);
+  for (uint32_t b = 0; b * POSTING_BLOCK < m_count; b++)
+  {
+    loadBlock(b);
+    const uint32_t n = min(static_cast<uint32_t>(POSTING_BLOCK),
+      m_count - b * POSTING_BLOCK);
+    memcpy(records.data() + b * POSTING_BLOCK, m_buffer,
+      n * sizeof(uint32_t));
+  }
+
+  m_pos = 0;
+  if (m_count > 0)
+    loadBlock(0);
+}
+
+
+bool PostingReader::atEnd() const
+{
+  return m_pos >= m_count;
+}
+
+
+uint32_t PostingReader::value() const
+{
+  return m_buffer[m_pos % POSTING_BLOCK];
+}
+
+
+void PostingReader::next()
+{
+  m_pos++;
+  if (m_pos < m_count && m_pos % POSTING_BLOCK == 0)
+    loadBlock(m_pos / POSTING_BLOCK);
+}
+
+
+bool PostingReader::advanceTo(const uint32_t target)
+{
+  if (m_pos >= m_count)
+    return false;
+  if (value() >= target)
+    return true;
+
+  // Gallop over the skip table to the first block whose last record
+  // is >= target, or else the tail.
+  uint32_t block = m_block;
+  if (block < m_numBlocks && skipLast(block) < target)
+  {
+    uint32_t lo = block + 1, step = 1;
+    while (lo + step <= m_numBlocks && skipLast(lo + step - 1) < target)
+    {
+      lo += step;
+      step *= 2;
+    }
+    uint32_t hi = min(lo + step, m_numBlocks);
+    while (lo < hi)
+    {
+      const uint32_t mid = lo + (hi - lo) / 2;
+      if (skipLast(mid) < target)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    block = lo;
+    if (block * POSTING_BLOCK >= m_count)
+    {
+      m_pos = m_count;
+      return false;
+    }
+  }
+
+  uint32_t from = m_pos % POSTING_BLOCK;
+  if (block != m_block)
+  {
+    loadBlock(block);
+    from = 0;
+  }
+
+  const uint32_t n = min(static_cast<uint32_t>(POSTING_BLOCK),
+    m_count - block * POSTING_BLOCK);
+  m_pos = block * POSTING_BLOCK +
+    static_cast<uint32_t>(seekPosting(m_buffer, from, n, target));
+  return m_pos < m_count;
+}
@@ -0,0 +1,113 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// Compressed posting lists (sorted, distinct record numbers) with
+// skip pointers, as stored in index files (see IndexFormat.h).
+//
+// A list is cut into blocks of POSTING_BLOCK records, plus a tail of
+// fewer.  In a full block, each record is stored as its gap from the
+// previous one (the last record of the previous block for the first),
+// and the gaps are bit-packed with the smallest width that fits all of
+// them.  The packing is four lanes wide:  lane l holds the gaps of
+// records l, l+4, l+8, ... in its own 32-bit words, and the words of
+// the four lanes are interleaved.  So one 128-bit load gives the same
+// word of every lane, and unpacking is the same shift and mask in all
+// lanes.  Each unpacked vector holds four consecutive gaps, which two
+// shifted adds turn into records.
+//
+//   skip table:  per full block, the last record and the byte offset
+//                of the block from the start of the list (uint32_t
+//                each, unaligned)
+//   blocks:      per full block, a width byte and 16 * width bytes
+//   tail:        gaps from the previous record as LEB128 varints
+//
+// The skip table lets a reader jump to the block that holds a given
+// record without decoding the ones before it.  Lists shorter than a
+// block are just the tail, and cost the same as plain varints.
+
+#ifndef POSTINGCODEC_H
+#define POSTINGCODEC_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+#define POSTING_BLOCK 128
+
+
+// Appends the encoding of the count records to out.
+void encodePostings(
+  const uint32_t records[],
+  const size_t count,
+  string& out);
+
+// "SSE2" or "plain", the block decoder in use.
+const char * postingDecoder();
+
+// The position of the first of records[pos .. size-1] (in order) that
+// is >= target, or size.  Most searches in an intersection only go a
+// few records, so the next four are compared at once before galloping.
+size_t seekPosting(
+  const uint32_t records[],
+  const size_t pos,
+  const size_t size,
+  const uint32_t target);
+
+
+// A cursor over an encoded list.  It decodes one block at a time, and
+// only the blocks it lands in.
+class PostingReader
+{
+  private:
+
+    const uint8_t * m_data;
+    uint32_t m_count;
+    uint32_t m_numBlocks; // Full ones
+
+    // Block m_block (m_numBlocks for the tail) is in m_buffer, and
+    // the cursor is at record m_pos of the list.
+    uint32_t m_block;
+    uint32_t m_pos;
+    uint32_t m_buffer[POSTING_BLOCK];
+
+
+    uint32_t skipLast(const uint32_t block) const;
+
+    uint32_t skipOffset(const uint32_t block) const;
+
+    void loadBlock(const uint32_t block);
+
+  public:
+
+    PostingReader();
+    ~PostingReader();
+    void reset();
+
+    // data is the start of a list of count records.  The cursor is
+    // then at the first record.
+    void init(
+      const uint8_t * data,
+      const uint32_t count);
+
+    uint32_t size() const;
+
+    // Decodes the whole list into records.
+    void decodeAll(vector<uint32_t>& records);
+
+    bool atEnd() const;
+
+    // The record at the cursor, unless atEnd().
+    uint32_t value() const;
+
+    void next();
+
+    // Moves the cursor forward to the first record >= target, if any.
+    // Returns false if there is none.
+    bool advanceTo(const uint32_t target);
+};
+
+#endif
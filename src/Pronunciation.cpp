@@ -0,0 +1,231 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <unordered_map>
+#include <cctype>
+
+#include "Pronunciation.h"
+
+struct SoundEntry
+{
+  const char * sound;
+
+  // The key fragment in configurations 0 to 3, where vowels only
+  // show up with encodeVowels.
+  const char * keys[INDEX_CONFIGS];
+};
+
+// The table of phon2mp.pl, in the order of the configurations.
+static const SoundEntry SOUND_TABLE[] =
+{
+  // "Vowels".
+  {"&", {"", "", "A", "A"}},
+  {"@", {"", "", "A", "A"}},
+  {"(@)", {"", "", "A", "A"}},
+  {"[@]", {"", "", "A", "A"}},
+  {"-", {"", "", "A", "A"}},
+  {"A", {"", "", "A", "A"}},
+  {"AU", {"", "", "A", "A"}},
+  {"aI", {"", "", "A", "A"}},
+  {"E", {"", "", "A", "A"}},
+  {"eI", {"", "", "A", "A"}},
+  {"hw", {"", "", "A", "A"}},
+  {"I", {"", "", "A", "A"}},
+  {"i", {"", "", "A", "A"}},
+  {"j", {"", "", "A", "A"}},
+  {"O", {"", "", "A", "A"}},
+  {"Oi", {"", "", "A", "A"}},
+  {"oU", {"", "", "A", "A"}},
+  {"U", {"", "", "A", "A"}},
+  {"u", {"", "", "A", "A"}},
+  {"w", {"", "", "A", "A"}},
+  {"y", {"", "", "A", "A"}},
+  {"Y", {"", "", "A", "A"}},
+
+  // Consonants.
+  {"b", {"P", "B", "P", "B"}},
+  {"c", {"S", "S", "S", "S"}},
+  {"D", {"0", "0", "0", "0"}}, // Zero
+  {"d", {"T", "D", "T", "D"}},
+  {"dZ", {"J", "J", "J", "J"}},
+  {"f", {"F", "F", "F", "F"}},
+  {"g", {"K", "G", "K", "G"}},
+  {"h", {"H", "H", "H", "H"}},
+  {"k", {"K", "K", "K", "K"}},
+  {"l", {"L", "L", "L", "L"}},
+  {"m", {"M", "M", "M", "M"}},
+  {"N", {"NK", "NG", "NK", "NG"}},
+  {"n", {"N", "N", "N", "N"}},
+  {"p", {"P", "P", "P", "P"}},
+  {"r", {"R", "R", "R", "R"}},
+  {"R", {"R", "R", "R", "R"}},
+  {"S", {"X", "X", "X", "X"}},
+  {"s", {"S", "S", "S", "S"}},
+  {"T", {"0", "0", "0", "0"}}, // Zero
+  {"t", {"T", "T", "T", "T"}},
+  {"tS", {"X", "X", "X", "X"}},
+  {"v", {"F", "V", "F", "V"}},
+  {"x", {"X", "X", "X", "X"}},
+  {"Z", {"J", "J", "J", "J"}},
+  {"z", {"S", "S", "S", "S"}}
+};
+
+
+static const SoundEntry * findSound(const string_view sound)
+{
+  static const unordered_map<string_view, const SoundEntry *> table =
+    []()
+  {
+    unordered_map<string_view, const SoundEntry *> t;
+    for (auto& entry: SOUND_TABLE)
+      t[entry.sound] = &entry;
+    return t;
+  }();
+
+  auto it = table.find(sound);
+  return (it == table.end() ? nullptr : it->second);
+}
+
+
+static void splitOn(
+  const string_view text,
+  const string_view separators,
+  vector<string_view>& parts)
+{
+  parts.clear();
+  size_t start = 0;
+  while (true)
+  {
+    const size_t end = text.find_first_of(separators, start);
+    parts.push_back(text.substr(start,
+      end == string_view::npos ? string_view::npos : end - start));
+    if (end == string_view::npos)
+      break;
+    start = end + 1;
+  }
+}
+
+
+static bool isStress(const char c)
+{
+  return (c == '\'' || c == ',');
+}
+
+
+static bool salvage(
+  const string_view plain2,
+  const string_view pron,
+  vector<string_view>& prons)
+{
+  // A stress mark at the very start does not count.
+  const size_t from = (! pron.empty() && isStress(pron[0]) ? 1 : 0);
+  size_t cand = string_view::npos;
+  unsigned marks = 0;
+  for (size_t i = from; i < pron.size(); i++)
+  {
+    if (! isStress(pron[i]))
+      continue;
+    if (marks++ == 0)
+      cand = i;
+  }
+  if (marks != 1 || plain2.empty())
+    return false;
+
+  size_t next = cand + 1;
+  if (next < pron.size() && pron[next] == '/')
+    next++;
+  if (next >= pron.size() ||
+      tolower(static_cast<unsigned char>(pron[next])) !=
+      tolower(static_cast<unsigned char>(plain2[0])))
+    return false;
+
+  prons.clear();
+  prons.push_back(pron.substr(0, cand));
+  prons.push_back(pron.substr(cand + 1));
+  return true;
+}
+
+
+static void referenceKeys(
+  const string_view pron,
+  PronouncedWord& pw)
+{
+  vector<string_view> sounds;
+  splitOn(pron, "/',", sounds);
+
+  for (auto& key: pw.keys)
+    key.clear();
+  pw.unknown.clear();
+
+  bool first = true;
+  for (auto& s: sounds)
+  {
+    if (s.empty())
+      continue;
+
+    const SoundEntry * entry = findSound(s);
+    if (entry == nullptr)
+    {
+      for (auto& key: pw.keys)
+        key.clear();
+      pw.unknown = string(s);
+      return;
+    }
+
+    for (unsigned c = 0; c < INDEX_CONFIGS; c++)
+    {
+      string& key = pw.keys[c];
+      const char * frag = entry->keys[c];
+
+      // Metaphone 3 encodes an initial vowel as A in any case.
+      if (frag[0] == '\0' && first)
+        frag = "A";
+
+      if (frag[0] == '\0')
+        continue;
+      if (frag[0] == 'A' && ! key.empty() && key.back() == 'A')
+        continue;
+      key += frag;
+    }
+    first = false;
+  }
+}
+
+
+PronunciationStatus parsePronunciation(
+  const string_view lineIn,
+  vector<PronouncedWord>& words)
+{
+  words.clear();
+
+  string_view line = lineIn;
+  if (! line.empty() && line.back() == '\r')
+    line.remove_suffix(1);
+
+  const size_t space = line.find(' ');
+  if (space == string_view::npos || space == 0 ||
+      line.find(' ', space + 1) != string_view::npos)
+    return PRON_BAD_LINE;
+
+  const string_view headword = line.substr(0, space);
+  const string_view pron = line.substr(space + 1);
+
+  vector<string_view> plains, prons;
+  splitOn(headword, "_-", plains);
+  splitOn(pron, "_", prons);
+
+  if (plains.size() != prons.size() &&
+      ! (plains.size() == 2 && prons.size() == 1 &&
+        salvage(plains[1], pron, prons)))
+    return PRON_MISMATCH;
+
+  words.resize(plains.size());
+  for (size_t i = 0; i < plains.size(); i++)
+  {
+    words[i].word = string(plains[i]);
+    referenceKeys(prons[i], words[i]);
+  }
+  return PRON_OK;
+}
@@ -0,0 +1,53 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// Reference keys from the Moby pronunciation dictionary (mpron.txt),
+// as scripts/phon2mp.pl derives them.  Each line is a headword and
+// its pronunciation, separated by one space.  The parts of a compound
+// headword are separated by '_' or '-', and their pronunciations by
+// '_'.  A pronunciation is a sequence of sounds separated by '/',
+// where the stress marks ' and , also separate sounds.  Each sound
+// maps to a key fragment in each configuration (see setIndexConfig),
+// so each word gets the key that Metaphone 3 should ideally give it.
+
+#ifndef PRONUNCIATION_H
+#define PRONUNCIATION_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "PhoneticIndex.h"
+
+using namespace std;
+
+
+enum PronunciationStatus
+{
+  PRON_OK = 0,
+  PRON_BAD_LINE = 1, // Not a headword and a pronunciation
+  PRON_MISMATCH = 2 // Headword parts and pronunciations differ
+};
+
+struct PronouncedWord
+{
+  string word;
+
+  // The reference key in each configuration.  Empty if some sound
+  // is not in the table, and then unknown is that sound.
+  string keys[INDEX_CONFIGS];
+  string unknown;
+};
+
+
+// Splits a line of mpron.txt into its words with their reference
+// keys.  Like phon2mp.pl, a two-part headword with a one-part
+// pronunciation is split at its only stress mark, if the sound
+// after it starts with the first letter of the second part.
+PronunciationStatus parsePronunciation(
+  const string_view line,
+  vector<PronouncedWord>& words);
+
+#endif
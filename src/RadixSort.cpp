@@ -0,0 +1,99 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <algorithm>
+
+#include "RadixSort.h"
+#include "Scheduler.h"
+
+#define RADIX_BITS 8
+#define RADIX_SIZE (1 << RADIX_BITS)
+#define RADIX_PASSES (64 / RADIX_BITS)
+
+// Below this, one thread is faster than the set-up of several.
+#define RADIX_MIN_SLICE 65536
+
+
+void radixSort(
+  vector<KeyRecord>& items,
+  const unsigned numThreads)
+{
+  const size_t n = items.size();
+  if (n < 2)
+    return;
+
+  Scheduler scheduler;
+  scheduler.setThreads(numThreads);
+  const size_t numSlices = max(static_cast<size_t>(1),
+    min(static_cast<size_t>(scheduler.getThreads()), n / RADIX_MIN_SLICE));
+  const size_t sliceSize = (n + numSlices - 1) / numSlices;
+  const vector<size_t> weights(numSlices, 1);
+
+  vector<KeyRecord> buffer(n);
+  vector<KeyRecord> * from = &items;
+  vector<KeyRecord> * to = &buffer;
+
+  // counts[slice][digit], then turned into output positions.
+  vector<vector<size_t>> counts(numSlices, vector<size_t>(RADIX_SIZE));
+
+  for (unsigned pass = 0; pass < RADIX_PASSES; pass++)
+  {
+    const unsigned shift = pass * RADIX_BITS;
+
+    scheduler.run(weights, [&](size_t slice, unsigned)
+    {
+      vector<size_t>& count = counts[slice];
+      fill(count.begin(), count.end(), 0);
+      const size_t first = slice * sliceSize;
+      const size_t last = min(first + sliceSize, n);
+      for (size_t i = first; i < last; i++)
+        count[((* from)[i].key >> shift) & (RADIX_SIZE - 1)]++;
+    });
+
+    // A pass in which all keys have the same digit changes nothing.
+    bool trivial = false;
+    for (unsigned d = 0; d < RADIX_SIZE && ! trivial; d++)
+    {
+      size_t total = 0;
+      for (size_t s = 0; s < numSlices; s++)
+        total += counts[s][d];
+      if (total == n)
+        trivial = true;
+      else if (total > 0)
+        break;
+    }
+    if (trivial)
+      continue;
+
+    size_t pos = 0;
+    for (unsigned d = 0; d < RADIX_SIZE; d++)
+    {
+      for (size_t s = 0; s < numSlices; s++)
+      {
+        const size_t c = counts[s][d];
+        counts[s][d] = pos;
+        pos += c;
+      }
+    }
+
+    scheduler.run(weights, [&](size_t slice, unsigned)
+    {
+      vector<size_t>& next = counts[slice];
+      const size_t first = slice * sliceSize;
+      const size_t last = min(first + sliceSize, n);
+      for (size_t i = first; i < last; i++)
+      {
+        const KeyRecord& item = (* from)[i];
+        (* to)[next[(item.key >> shift) & (RADIX_SIZE - 1)]++] = item;
+      }
+    });
+
+    swap(from, to);
+  }
+
+  if (from != &items)
+    items.swap(buffer);
+}
+
@@ -0,0 +1,37 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// A parallel, stable LSD radix sort of (key, record) pairs by key.
+//
+// Each pass sorts on one byte of the key.  The items are cut into one
+// slice per thread; each thread counts the bytes in its slice, the
+// counts give every (slice, byte) its place in the output, and each
+// thread then scatters its slice there.  Passes on a byte that is the
+// same for all keys are skipped, so short keys cost fewer passes.
+
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+
+struct KeyRecord
+{
+  uint64_t key;
+  uint32_t record;
+  uint32_t source; // Free for the caller, e.g. a file number
+};
+
+
+// Sorts items by key on numThreads threads (0: one per hardware
+// thread).  Items with the same key keep their order.
+void radixSort(
+  vector<KeyRecord>& items,
+  const unsigned numThreads);
+
+#endif
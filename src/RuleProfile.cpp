@@ -0,0 +1,339 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iomanip>
+#include <algorithm>
+#include <sstream>
+
+#include "RuleProfile.h"
+
+
+RuleProfile::RuleProfile()
+{
+  reset();
+}
+
+
+RuleProfile::~RuleProfile()
+{
+}
+
+
+void RuleProfile::reset()
+{
+  m_chains.clear();
+  m_consistent = true;
+}
+
+
+void RuleProfile::addChain(
+  const string& name,
+  const vector<string>& source,
+  const vector<string>& compiled,
+  const vector<vector<bool>>& swappable)
+{
+  m_chains.push_back(RuleChainProfile());
+  RuleChainProfile& chain = m_chains.back();
+  const size_t n = source.size();
+
+  chain.name = name;
+  chain.rules = source;
+  chain.calls = 0;
+  chain.hits.assign(n, 0);
+  chain.fires.assign(n, 0);
+  chain.changed.assign(n, 0);
+  chain.together.assign(n, vector<size_t>(n, 0));
+  chain.swappable = swappable;
+
+  vector<bool> seen(n, false);
+  for (auto& rule: compiled)
+  {
+    unsigned r;
+    for (r = 0; r < n && source[r] != rule; r++);
+    if (r == n || seen[r])
+    {
+      m_consistent = false;
+      continue;
+    }
+    seen[r] = true;
+    chain.compiled.push_back(r);
+  }
+  if (chain.compiled.size() != n)
+    m_consistent = false;
+}
+
+
+unsigned RuleProfile::numChains() const
+{
+  return static_cast<unsigned>(m_chains.size());
+}
+
+
+bool RuleProfile::consistent() const
+{
+  return m_consistent;
+}
+
+
+void RuleProfile::count(
+  const unsigned chainNo,
+  const vector<bool>& fired,
+  const vector<bool>& changed)
+{
+  RuleChainProfile& chain = m_chains[chainNo];
+  const unsigned n = static_cast<unsigned>(fired.size());
+  chain.calls++;
+
+  bool first = true;
+  for (unsigned i = 0; i < n; i++)
+  {
+    if (changed[i])
+      chain.changed[i]++;
+    if (! fired[i])
+      continue;
+
+    chain.fires[i]++;
+    if (first)
+    {
+      chain.hits[i]++;
+      first = false;
+    }
+    for (unsigned j = i+1; j < n; j++)
+    {
+      if (fired[j])
+        chain.together[i][j]++;
+    }
+  }
+}
+
+
+void RuleProfile::merge(const RuleProfile& other)
+{
+  if (m_chains.empty())
+  {
+    * this = other;
+    return;
+  }
+
+  for (unsigned c = 0; c < m_chains.size(); c++)
+  {
+    RuleChainProfile& chain = m_chains[c];
+    const RuleChainProfile& oc = other.m_chains[c];
+    chain.calls += oc.calls;
+    for (unsigned i = 0; i < chain.rules.size(); i++)
+    {
+      chain.hits[i] += oc.hits[i];
+      chain.fires[i] += oc.fires[i];
+      chain.changed[i] += oc.changed[i];
+      for (unsigned j = 0; j < chain.rules.size(); j++)
+        chain.together[i][j] += oc.together[i][j];
+    }
+  }
+}
+
+
+bool RuleProfile::mustPrecede(
+  const RuleChainProfile& chain,
+  const unsigned i,
+  const unsigned j) const
+{
+  // Rule i comes before j in source order.  The counts of the profile
+  // can only veto a swap.
+  return (! chain.swappable[i][j] ||
+    chain.together[i][j] > 0 ||
+    chain.changed[i] > 0 ||
+    chain.changed[j] > 0);
+}
+
+
+unsigned RuleProfile::numContradictions() const
+{
+  unsigned n = 0;
+  for (auto& chain: m_chains)
+  {
+    for (unsigned i = 0; i < chain.rules.size(); i++)
+    {
+      for (unsigned j = i+1; j < chain.rules.size(); j++)
+      {
+        if (chain.swappable[i][j] &&
+            (chain.together[i][j] > 0 ||
+             chain.changed[i] > 0 ||
+             chain.changed[j] > 0))
+          n++;
+      }
+    }
+  }
+  return n;
+}
+
+
+void RuleProfile::reorder(
+  const unsigned chainNo,
+  vector<unsigned>& order) const
+{
+  const RuleChainProfile& chain = m_chains[chainNo];
+  const unsigned n = static_cast<unsigned>(chain.rules.size());
+  vector<bool> placed(n, false);
+  order.clear();
+
+  while (order.size() < n)
+  {
+    unsigned best = n;
+    for (unsigned j = 0; j < n; j++)
+    {
+      if (placed[j])
+        continue;
+
+      bool ready = true;
+      for (unsigned i = 0; i < j && ready; i++)
+      {
+        if (! placed[i] && mustPrecede(chain, i, j))
+          ready = false;
+      }
+
+      // Ties keep the source order.
+      if (ready && (best == n || chain.hits[j] > chain.hits[best]))
+        best = j;
+    }
+
+    placed[best] = true;
+    order.push_back(best);
+  }
+
+  // The greedy order may try more rules than the source order.
+  vector<unsigned> identity(n);
+  for (unsigned r = 0; r < n; r++)
+    identity[r] = r;
+  if (triesPerCall(chain, order) > triesPerCall(chain, identity))
+    order = identity;
+}
+
+
+void RuleProfile::reorderAll(vector<vector<unsigned>>& table) const
+{
+  table.resize(m_chains.size());
+  for (unsigned c = 0; c < m_chains.size(); c++)
+    reorder(c, table[c]);
+}
+
+
+bool RuleProfile::isCompiled() const
+{
+  vector<unsigned> order;
+  for (unsigned c = 0; c < m_chains.size(); c++)
+  {
+    reorder(c, order);
+    if (order != m_chains[c].compiled)
+      return false;
+  }
+  return true;
+}
+
+
+double RuleProfile::triesPerCall(
+  const RuleChainProfile& chain,
+  const vector<unsigned>& order) const
+{
+  if (chain.calls == 0)
+    return 0.;
+
+  size_t tries = 0, hits = 0;
+  for (unsigned p = 0; p < order.size(); p++)
+  {
+    tries += (p+1) * chain.hits[order[p]];
+    hits += chain.hits[order[p]];
+  }
+  tries += order.size() * (chain.calls - hits);
+  return static_cast<double>(tries) / chain.calls;
+}
+
+
+string RuleProfile::str() const
+{
+  stringstream ss;
+  ss << left << setw(16) << "chain" << right <<
+    setw(10) << "calls" << setw(8) << "rules" <<
+    setw(10) << "source" << setw(10) << "compiled" <<
+    setw(10) << "new" << "   (rules tried per call)\n";
+
+  size_t calls = 0;
+  double source = 0., compiled = 0., reordered = 0.;
+  vector<unsigned> order, identity;
+  for (unsigned c = 0; c < m_chains.size(); c++)
+  {
+    const RuleChainProfile& chain = m_chains[c];
+    identity.resize(chain.rules.size());
+    for (unsigned r = 0; r < identity.size(); r++)
+      identity[r] = r;
+    reorder(c, order);
+
+    const double s = triesPerCall(chain, identity);
+    const double p = triesPerCall(chain, chain.compiled);
+    const double r = triesPerCall(chain, order);
+
+    ss << left << setw(16) << chain.name << right <<
+      setw(10) << chain.calls << setw(8) << chain.rules.size() <<
+      fixed << setprecision(2) <<
+      setw(10) << s << setw(10) << p << setw(10) << r << "\n";
+
+    calls += chain.calls;
+    source += s * chain.calls;
+    compiled += p * chain.calls;
+    reordered += r * chain.calls;
+  }
+
+  const double d = static_cast<double>(max(calls, size_t(1)));
+  ss << left << setw(16) << "all" << right <<
+    setw(10) << calls << setw(8) << "" <<
+    setw(10) << source / d << setw(10) << compiled / d <<
+    setw(10) << reordered / d << "\n";
+  return ss.str();
+}
+
+
+string RuleProfile::header(const string& origin) const
+{
+  stringstream ss;
+  ss << "// Extension of Metaphone3.\n" <<
+    "// Copyright (C) 2017 by Soren Hein.\n" <<
+    "// No restrictions on copying and modifying, as long as credit " <<
+    "is given.\n" <<
+    "// No warranties.\n\n";
+
+  ss << "// The order in which the letter functions of Metaphone3 try " <<
+    "their\n" <<
+    "// rules, the most hits first where that gives the same keys " <<
+    "(see\n" <<
+    "// RuleProfile.h).  Generated by test -R, so do not edit.  The " <<
+    "source\n" <<
+    "// order is SOURCE_RULES_* in Metaphone3.cpp.\n" <<
+    "// " << origin << "\n\n";
+
+  ss << "#ifndef METAPHONE3RULES_H\n#define METAPHONE3RULES_H\n";
+
+  vector<unsigned> order;
+  for (unsigned c = 0; c < m_chains.size(); c++)
+  {
+    const RuleChainProfile& chain = m_chains[c];
+    reorder(c, order);
+
+    ss << "\n// " << chain.name;
+    if (chain.calls > 0)
+      ss << ":  " << chain.calls << " calls, " << fixed <<
+        setprecision(2) << triesPerCall(chain, order) <<
+        " rules tried per call";
+    ss << "\n#define RULES_" << chain.name << "(R)";
+    for (auto r: order)
+    {
+      ss << " \\\n  R(" << chain.rules[r] << ")";
+      if (chain.calls > 0)
+        ss << " /* " << chain.hits[r] << " */";
+    }
+    ss << "\n";
+  }
+
+  ss << "\n#endif\n";
+  return ss.str();
+}
@@ -0,0 +1,124 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// Rule hit counts of the letter functions of Metaphone3, for putting
+// the common rules of each rule chain first (see Metaphone3Rules.h).
+// Two rules of a chain may only swap if both come from the spec, the
+// spec proves that they never fire on the same state, and neither
+// changes the state without firing (see RuleSpec.h).  Then the first
+// rule to fire is the same in either order, and so are the keys, on
+// every word.  In profiling mode, Metaphone3 tries every rule of a
+// chain from the same state, so the profile also sees which rules fire
+// together and which ones change the state even when they do not
+// fire, which would show a flaw in the proof.
+
+#ifndef RULEPROFILE_H
+#define RULEPROFILE_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+struct RuleChainProfile
+{
+  // E.g. "C" for the chain of encode_C.
+  string name;
+
+  // The rules in source order, and the order of Metaphone3Rules.h as
+  // numbers of rules.
+  vector<string> rules;
+  vector<unsigned> compiled;
+
+  size_t calls;
+
+  // Per rule, the calls where it fired first in source order (so it
+  // is the one that counts), where it fired at all, and where it did
+  // not fire but changed the state.
+  vector<size_t> hits;
+  vector<size_t> fires;
+  vector<size_t> changed;
+
+  // together[i][j] for i < j:  the calls where both fired.
+  vector<vector<size_t>> together;
+
+  // swappable[i][j]:  rules i and j may swap, as proven from the spec.
+  vector<vector<bool>> swappable;
+};
+
+
+class RuleProfile
+{
+  private:
+
+    vector<RuleChainProfile> m_chains;
+
+    // False if some compiled order is not a permutation of the rules.
+    bool m_consistent;
+
+
+    bool mustPrecede(
+      const RuleChainProfile& chain,
+      const unsigned i,
+      const unsigned j) const;
+
+    // Rules tried per call on average with the rules in order.
+    double triesPerCall(
+      const RuleChainProfile& chain,
+      const vector<unsigned>& order) const;
+
+  public:
+
+    RuleProfile();
+    ~RuleProfile();
+    void reset();
+
+    void addChain(
+      const string& name,
+      const vector<string>& source,
+      const vector<string>& compiled,
+      const vector<vector<bool>>& swappable);
+
+    unsigned numChains() const;
+
+    bool consistent() const;
+
+    void count(
+      const unsigned chainNo,
+      const vector<bool>& fired,
+      const vector<bool>& changed);
+
+    void merge(const RuleProfile& other);
+
+    // Most hits first, except that each rule stays behind the rules
+    // that must precede it in source order.  The source order if that
+    // tries fewer rules per call on the profile.
+    void reorder(
+      const unsigned chainNo,
+      vector<unsigned>& order) const;
+
+    // The reordered chains, one order per chain, for
+    // Metaphone3::setRuleTable().
+    void reorderAll(vector<vector<unsigned>>& table) const;
+
+    // The number of pairs of rules that may swap, but that fired
+    // together or changed the state without firing.  Not 0 only if
+    // the proof of RuleSpec is wrong.
+    unsigned numContradictions() const;
+
+    // True if the reordered chains are those of Metaphone3Rules.h.
+    bool isCompiled() const;
+
+    // A table of the calls and rules tried per call of each chain, in
+    // source order, compiled order and reordered.
+    string str() const;
+
+    // The text of Metaphone3Rules.h with the chains reordered.  origin
+    // says where the profile came from.
+    string header(const string& origin) const;
+};
+
+#endif
@@ -0,0 +1,1539 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <map>
+#include <cctype>
+#include <cstdint>
+
+#include "RuleSpec.h"
+#include "files.h"
+
+// Generated lines are broken before they get longer than this.
+#define SPEC_WIDTH 78
+
+// Literal tails at least this long are compared with memcmp.
+#define SPEC_MEMCMP_LENGTH 4
+
+// Guards per rule, beyond which the rest of a condition is left out of
+// the proof that two rules never fire together.
+#define SPEC_MAX_GUARDS 1024
+
+// Stands for an unbounded position or length in a guard.
+#define SPEC_UNBOUNDED 1000000
+
+// Letters put around the literals for probe words.
+static const vector<string> PROBE_PREFIXES = {"", "A", "S", "MC"};
+static const vector<string> PROBE_SUFFIXES = {"", "A", "S", "ER"};
+
+
+// A line of the spec, with the lines that continue it.
+struct SpecLine
+{
+  unsigned indent;
+  unsigned line;
+  vector<string> tokens;
+  vector<SpecLine> children;
+};
+
+// Expression tokens of a line from some position.
+struct SpecTokens
+{
+  const vector<string> * tokens;
+  size_t next;
+  unsigned line;
+};
+
+// Generated C++ for an expression.  op is "" for a leaf, or "&&", "||"
+// or "!".  An atomic leaf such as a call needs no parentheses.
+struct SpecCode
+{
+  string op;
+  string text;
+  bool atomic;
+  vector<SpecCode> parts;
+};
+
+
+RuleSpec::RuleSpec()
+{
+  RuleSpec::reset();
+}
+
+
+RuleSpec::~RuleSpec()
+{
+}
+
+
+void RuleSpec::reset()
+{
+  m_name = "";
+  m_rules.clear();
+  m_checksum = 0;
+}
+
+
+static bool specError(
+  const unsigned line,
+  const string& text)
+{
+  cout << "Spec line " << line << ":  " << text << "\n";
+  return false;
+}
+
+
+static bool tokenizeSpec(
+  const string& text,
+  vector<string>& tokens)
+{
+  // Splits on spaces, with parentheses as tokens of their own and
+  // "quoted literals" as one token.  # starts a comment.
+  tokens.clear();
+  size_t i = 0;
+  while (i < text.size())
+  {
+    const char c = text[i];
+    if (c == '#')
+      break;
+    else if (c == ' ')
+      i++;
+    else if (c == '(' || c == ')')
+    {
+      tokens.push_back(string(1, c));
+      i++;
+    }
+    else if (c == '"')
+    {
+      const size_t j = text.find('"', i+1);
+      if (j == string::npos)
+        return false;
+      tokens.push_back(text.substr(i, j+1-i));
+      i = j+1;
+    }
+    else
+    {
+      size_t j = i;
+      while (j < text.size() && text[j] != ' ' && text[j] != '(' &&
+          text[j] != ')' && text[j] != '#' && text[j] != '"')
+        j++;
+      tokens.push_back(text.substr(i, j-i));
+      i = j;
+    }
+  }
+  return true;
+}
+
+
+static bool isLiteral(const string& token)
+{
+  return (token[0] == '"' || (token[0] >= 'A' && token[0] <= 'Z'));
+}
+
+
+static bool literalText(
+  const string& token,
+  string& text)
+{
+  // Literals are upper-case letters, and spaces when quoted.
+  text = (token[0] == '"' ? token.substr(1, token.size()-2) : token);
+  if (text.empty())
+    return false;
+  for (auto c: text)
+  {
+    if ((c < 'A' || c > 'Z') && (c != ' ' || token[0] != '"'))
+      return false;
+  }
+  return true;
+}
+
+
+static bool parseNumber(
+  const string& text,
+  int& number)
+{
+  if (text.empty() || text.size() > 6 ||
+      ! all_of(text.begin(), text.end(), ::isdigit))
+    return false;
+  number = stoi(text);
+  return true;
+}
+
+
+static bool parsePosition(
+  const string& text,
+  SpecBase& base,
+  int& offset)
+{
+  // 0, +n and -n count from m_current, ^n from the start of the word,
+  // $ and $-n from m_last.
+  int n;
+  if (text == "0")
+  {
+    base = SPEC_BASE_CURRENT;
+    offset = 0;
+  }
+  else if ((text[0] == '+' || text[0] == '-') &&
+      parseNumber(text.substr(1), n))
+  {
+    base = SPEC_BASE_CURRENT;
+    offset = (text[0] == '+' ? n : -n);
+  }
+  else if (text[0] == '^' && parseNumber(text.substr(1), n))
+  {
+    base = SPEC_BASE_START;
+    offset = n;
+  }
+  else if (text == "$")
+  {
+    base = SPEC_BASE_LAST;
+    offset = 0;
+  }
+  else if (text.substr(0, 2) == "$-" && parseNumber(text.substr(2), n))
+  {
+    base = SPEC_BASE_LAST;
+    offset = -n;
+  }
+  else
+    return false;
+  return true;
+}
+
+
+static bool nextToken(
+  SpecTokens& st,
+  string& token)
+{
+  if (st.next >= st.tokens->size())
+    return specError(st.line, "Expression ends too early");
+  token = (*st.tokens)[st.next++];
+  return true;
+}
+
+
+static bool peekToken(
+  const SpecTokens& st,
+  const string& token)
+{
+  return (st.next < st.tokens->size() && (*st.tokens)[st.next] == token);
+}
+
+
+static bool parseOr(
+  SpecTokens& st,
+  SpecExpr& expr);
+
+
+static bool parseTerm(
+  SpecTokens& st,
+  SpecExpr& expr)
+{
+  expr.args.clear();
+  expr.base = SPEC_BASE_CURRENT;
+  expr.offset = 0;
+  expr.op = "";
+  expr.number = 0;
+  expr.words.clear();
+
+  string token, arg;
+  if (! nextToken(st, token))
+    return false;
+
+  if (token == "(")
+  {
+    if (! parseOr(st, expr))
+      return false;
+    if (! nextToken(st, token) || token != ")")
+      return specError(st.line, "Missing )");
+  }
+  else if (token == "not")
+  {
+    expr.type = SPEC_TERM_NOT;
+    expr.args.resize(1);
+    return parseTerm(st, expr.args[0]);
+  }
+  else if (token == "at" || token == "vowel" || token == "front")
+  {
+    expr.type = (token == "at" ? SPEC_TERM_AT :
+      token == "vowel" ? SPEC_TERM_VOWEL : SPEC_TERM_FRONT);
+    if (! nextToken(st, arg))
+      return false;
+    if (! parsePosition(arg, expr.base, expr.offset))
+      return specError(st.line, "Bad position " + arg);
+
+    while (token == "at" && st.next < st.tokens->size() &&
+        isLiteral((*st.tokens)[st.next]))
+    {
+      string text;
+      if (! literalText((*st.tokens)[st.next++], text))
+        return specError(st.line, "Bad literal " + text);
+      if (expr.base == SPEC_BASE_LAST &&
+          static_cast<int>(text.size()) > 1 - expr.offset)
+        return specError(st.line, text + " goes past the end");
+      expr.words.push_back(text);
+    }
+    if (token == "at" && expr.words.empty())
+      return specError(st.line, "at without literals");
+  }
+  else if (token == "pos" || token == "length")
+  {
+    expr.type = (token == "pos" ? SPEC_TERM_POS : SPEC_TERM_LENGTH);
+    if (! nextToken(st, expr.op) || ! nextToken(st, arg))
+      return false;
+    if (expr.op != "==" && expr.op != "!=" && expr.op != "<" &&
+        expr.op != "<=" && expr.op != ">" && expr.op != ">=")
+      return specError(st.line, "Bad comparison " + expr.op);
+
+    // pos compares m_current with n or with $ or $-n.
+    if (parseNumber(arg, expr.number))
+    {
+      expr.base = SPEC_BASE_START;
+      expr.offset = expr.number;
+    }
+    else if (token == "length" ||
+        ! parsePosition(arg, expr.base, expr.offset) ||
+        expr.base != SPEC_BASE_LAST)
+      return specError(st.line, "Bad number " + arg);
+  }
+  else if (token == "vowels")
+    expr.type = SPEC_TERM_VOWELS;
+  else if (token == "exact")
+    expr.type = SPEC_TERM_EXACT;
+  else if (token == "call")
+  {
+    expr.type = SPEC_TERM_CALL;
+    if (! nextToken(st, arg))
+      return false;
+    if (! all_of(arg.begin(), arg.end(), [](const char c)
+        { return isalnum(c) || c == '_'; }))
+      return specError(st.line, "Bad function " + arg);
+    expr.words.push_back(arg);
+  }
+  else if (token == "root" || token == "has")
+  {
+    expr.type = (token == "root" ? SPEC_TERM_ROOT : SPEC_TERM_HAS);
+    string text;
+    if (! nextToken(st, arg))
+      return false;
+    if (! isLiteral(arg) || ! literalText(arg, text))
+      return specError(st.line, "Bad literal " + arg);
+    expr.words.push_back(text);
+  }
+  else
+    return specError(st.line, "Unknown term " + token);
+
+  return true;
+}
+
+
+static bool parseAnd(
+  SpecTokens& st,
+  SpecExpr& expr)
+{
+  SpecExpr term;
+  if (! parseTerm(st, term))
+    return false;
+  if (! peekToken(st, "and"))
+  {
+    expr = term;
+    return true;
+  }
+
+  expr.type = SPEC_TERM_AND;
+  expr.args.clear();
+  expr.args.push_back(term);
+  while (peekToken(st, "and"))
+  {
+    st.next++;
+    expr.args.push_back(SpecExpr());
+    if (! parseTerm(st, expr.args.back()))
+      return false;
+  }
+  return true;
+}
+
+
+static bool parseOr(
+  SpecTokens& st,
+  SpecExpr& expr)
+{
+  SpecExpr term;
+  if (! parseAnd(st, term))
+    return false;
+  if (! peekToken(st, "or"))
+  {
+    expr = term;
+    return true;
+  }
+
+  expr.type = SPEC_TERM_OR;
+  expr.args.clear();
+  expr.args.push_back(term);
+  while (peekToken(st, "or"))
+  {
+    st.next++;
+    expr.args.push_back(SpecExpr());
+    if (! parseAnd(st, expr.args.back()))
+      return false;
+  }
+  return true;
+}
+
+
+static bool parseCondition(
+  const SpecLine& sl,
+  SpecExpr& expr)
+{
+  // The tokens after the keyword.
+  SpecTokens st;
+  st.tokens = &sl.tokens;
+  st.next = 1;
+  st.line = sl.line;
+  if (! parseOr(st, expr))
+    return false;
+  if (st.next != sl.tokens.size())
+    return specError(sl.line, "Unexpected " + sl.tokens[st.next]);
+  return true;
+}
+
+
+static bool parseCode(
+  const string& token,
+  string& code)
+{
+  // - is the empty code.
+  if (token == "-")
+  {
+    code = "";
+    return true;
+  }
+  code = (token[0] == '"' && token.size() >= 2 ?
+    token.substr(1, token.size()-2) : token);
+  return all_of(code.begin(), code.end(), [](const char c)
+    { return (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'); });
+}
+
+
+static bool parseAdd(
+  const SpecLine& sl,
+  SpecAction& action)
+{
+  // add M [A] [exact|vowels M' [A']].
+  vector<string> codes[2];
+  unsigned part = 0;
+  for (size_t i = 1; i < sl.tokens.size(); i++)
+  {
+    const string& token = sl.tokens[i];
+    if (token == "exact" || token == "vowels")
+    {
+      if (part == 1)
+        return specError(sl.line, "Two variants");
+      action.variant = token;
+      part = 1;
+      continue;
+    }
+
+    string code;
+    if (! parseCode(token, code))
+      return specError(sl.line, "Bad code " + token);
+    codes[part].push_back(code);
+  }
+
+  if (codes[0].empty() || codes[0].size() > 2 ||
+      (part == 1 && codes[1].size() != codes[0].size()))
+    return specError(sl.line, "add needs one or two codes");
+
+  action.main = codes[0][0];
+  action.alt = codes[0].back();
+  if (part == 1)
+  {
+    action.variantMain = codes[1][0];
+    action.variantAlt = codes[1].back();
+  }
+  return true;
+}
+
+
+static bool parseActions(
+  const vector<SpecLine>& lines,
+  vector<SpecAction>& actions,
+  bool * fail)
+{
+  // fail is nullptr where fail is not allowed.
+  for (size_t i = 0; i < lines.size(); i++)
+  {
+    const SpecLine& sl = lines[i];
+    const string& key = sl.tokens[0];
+    const size_t n = sl.tokens.size();
+    if (! sl.children.empty() && key != "if" && key != "elif" &&
+        key != "else")
+      return specError(sl.children[0].line, "Unexpected indentation");
+
+    if (key == "fail")
+    {
+      if (fail == nullptr || i+1 != lines.size() || n != 1)
+        return specError(sl.line, "fail must end a when case");
+      *fail = true;
+      continue;
+    }
+
+    actions.push_back(SpecAction());
+    SpecAction& action = actions.back();
+    action.steps = 0;
+    action.stepsVowels = 0;
+
+    if (key == "add")
+    {
+      action.type = SPEC_ACTION_ADD;
+      if (! parseAdd(sl, action))
+        return false;
+    }
+    else if (key == "skip")
+    {
+      // skip n [vowels m].
+      action.type = SPEC_ACTION_SKIP;
+      if ((n != 2 && n != 4) ||
+          ! parseNumber(sl.tokens[1], action.steps) ||
+          (n == 4 && (sl.tokens[2] != "vowels" ||
+            ! parseNumber(sl.tokens[3], action.stepsVowels))))
+        return specError(sl.line, "Bad skip");
+      if (n == 2)
+        action.stepsVowels = action.steps;
+    }
+    else if (key == "skipvowels" && n == 1)
+      action.type = SPEC_ACTION_SKIP_VOWELS;
+    else if (key == "flag" && n == 2)
+    {
+      action.type = SPEC_ACTION_FLAG;
+      action.flag = sl.tokens[1];
+    }
+    else if (key == "if")
+    {
+      action.type = SPEC_ACTION_IF;
+      while (true)
+      {
+        const SpecLine& branch = lines[i];
+        action.branches.push_back(SpecBranch());
+        SpecBranch& sb = action.branches.back();
+        sb.conditional = (branch.tokens[0] != "else");
+        if (sb.conditional && ! parseCondition(branch, sb.cond))
+          return false;
+        if (! sb.conditional && branch.tokens.size() != 1)
+          return specError(branch.line, "else takes no condition");
+        if (! parseActions(branch.children, sb.actions, nullptr))
+          return false;
+
+        if (! sb.conditional || i+1 == lines.size() ||
+            (lines[i+1].tokens[0] != "elif" &&
+             lines[i+1].tokens[0] != "else"))
+          break;
+        i++;
+      }
+    }
+    else
+      return specError(sl.line, "Unknown action " + key);
+  }
+  return true;
+}
+
+
+static size_t nestLines(
+  const vector<SpecLine>& flat,
+  size_t i,
+  vector<SpecLine>& nested)
+{
+  // Lines more indented than the one before are its children.
+  const unsigned indent = flat[i].indent;
+  while (i < flat.size() && flat[i].indent == indent)
+  {
+    nested.push_back(flat[i]);
+    i++;
+    if (i < flat.size() && flat[i].indent > indent)
+      i = nestLines(flat, i, nested.back().children);
+  }
+  return i;
+}
+
+
+bool RuleSpec::read(const string& fname)
+{
+  RuleSpec::reset();
+  const size_t slash = fname.find_last_of("/\\");
+  m_name = (slash == string::npos ? fname : fname.substr(slash+1));
+
+  vector<string> text;
+  if (! readFile(fname, text))
+  {
+    cout << "File " << fname << " not found\n";
+    return false;
+  }
+
+  // FNV-1a.
+  m_checksum = 2166136261u;
+  for (auto& line: text)
+  {
+    for (auto c: line)
+      m_checksum = (m_checksum ^ static_cast<unsigned char>(c)) *
+        16777619u;
+    m_checksum = (m_checksum ^ '\n') * 16777619u;
+  }
+
+  // A line continues the one before if that one has open parentheses
+  // or ends on and, or or not, or if it starts with and, or or a
+  // literal.
+  vector<SpecLine> flat;
+  int depth = 0;
+  for (unsigned l = 0; l < text.size(); l++)
+  {
+    const string& line = text[l];
+    vector<string> tokens;
+    if (! tokenizeSpec(line, tokens))
+      return specError(l+1, "Unterminated literal");
+    if (tokens.empty())
+      continue;
+    if (line.find('\t') != string::npos)
+      return specError(l+1, "Tab");
+
+    const string& last = (flat.empty() ? "" : flat.back().tokens.back());
+    if (! flat.empty() &&
+        (depth > 0 || last == "and" || last == "or" || last == "not" ||
+         tokens[0] == "and" || tokens[0] == "or" || isLiteral(tokens[0])))
+      flat.back().tokens.insert(flat.back().tokens.end(),
+        tokens.begin(), tokens.end());
+    else
+    {
+      flat.push_back(SpecLine());
+      flat.back().indent = static_cast<unsigned>(
+        line.find_first_not_of(' '));
+      flat.back().line = l+1;
+      flat.back().tokens = tokens;
+      depth = 0;
+    }
+
+    for (auto& token: tokens)
+    {
+      if (token == "(")
+        depth++;
+      else if (token == ")")
+        depth--;
+    }
+    if (depth < 0)
+      return specError(l+1, "Unbalanced )");
+  }
+  if (depth > 0)
+    return specError(flat.back().line, "Unbalanced (");
+
+  vector<SpecLine> top;
+  if (! flat.empty())
+  {
+    const size_t n = nestLines(flat, 0, top);
+    if (n != flat.size())
+      return specError(flat[n].line, "Bad indentation");
+  }
+
+  map<string, unsigned> seen;
+  for (auto& sl: top)
+  {
+    if (sl.tokens[0] != "rule" || sl.tokens.size() != 2)
+      return specError(sl.line, "Expected rule name");
+
+    m_rules.push_back(SpecRule());
+    SpecRule& rule = m_rules.back();
+    rule.name = "encode_" + sl.tokens[1];
+    rule.line = sl.line;
+    if (seen.count(rule.name))
+      return specError(sl.line, "Rule also on line " +
+        to_string(seen[rule.name]));
+    seen[rule.name] = sl.line;
+
+    for (auto& sc: sl.children)
+    {
+      rule.cases.push_back(SpecCase());
+      SpecCase& c = rule.cases.back();
+      c.require = (sc.tokens[0] == "require");
+      c.fail = false;
+      c.line = sc.line;
+      if (! c.require && sc.tokens[0] != "when")
+        return specError(sc.line, "Expected when or require");
+      if (c.require && ! sc.children.empty())
+        return specError(sc.children[0].line, "require has no actions");
+      if (! parseCondition(sc, c.cond))
+        return false;
+      if (! parseActions(sc.children, c.actions, &c.fail))
+        return false;
+    }
+    if (rule.cases.empty())
+      return specError(sl.line, "Rule without cases");
+  }
+  return true;
+}
+
+
+unsigned RuleSpec::numRules() const
+{
+  return static_cast<unsigned>(m_rules.size());
+}
+
+
+unsigned RuleSpec::checksum() const
+{
+  return m_checksum;
+}
+
+
+void RuleSpec::names(vector<string>& names) const
+{
+  names.clear();
+  for (auto& rule: m_rules)
+    names.push_back(rule.name);
+}
+
+
+void RuleSpec::probeExpr(
+  const SpecExpr& expr,
+  vector<string>& words) const
+{
+  for (auto& arg: expr.args)
+    RuleSpec::probeExpr(arg, words);
+
+  if (expr.type != SPEC_TERM_AT && expr.type != SPEC_TERM_ROOT &&
+      expr.type != SPEC_TERM_HAS)
+    return;
+
+  for (auto& word: expr.words)
+    for (auto& prefix: PROBE_PREFIXES)
+      for (auto& suffix: PROBE_SUFFIXES)
+        words.push_back(prefix + word + suffix);
+}
+
+
+void RuleSpec::probeActions(
+  const vector<SpecAction>& actions,
+  vector<string>& words) const
+{
+  for (auto& action: actions)
+  {
+    for (auto& branch: action.branches)
+    {
+      if (branch.conditional)
+        RuleSpec::probeExpr(branch.cond, words);
+      RuleSpec::probeActions(branch.actions, words);
+    }
+  }
+}
+
+
+void RuleSpec::probes(vector<string>& words) const
+{
+  words.clear();
+  for (auto& rule: m_rules)
+  {
+    for (auto& c: rule.cases)
+    {
+      RuleSpec::probeExpr(c.cond, words);
+      RuleSpec::probeActions(c.actions, words);
+    }
+  }
+  sort(words.begin(), words.end());
+  words.erase(unique(words.begin(), words.end()), words.end());
+}
+
+
+// Conditions that hold when a case of a rule fires:  letters at
+// positions (base and offset, as in SpecExpr), and bounds on m_current,
+// on m_last - m_current and on m_length, which is m_last + 1.
+struct SpecGuard
+{
+  map<pair<int, int>, char> letters;
+  int current[2];
+  int rest[2];
+  int length[2];
+};
+
+
+static SpecGuard anyGuard()
+{
+  SpecGuard guard;
+  guard.current[0] = 0;
+  guard.current[1] = SPEC_UNBOUNDED;
+  guard.rest[0] = -SPEC_UNBOUNDED;
+  guard.rest[1] = SPEC_UNBOUNDED;
+  guard.length[0] = 0;
+  guard.length[1] = SPEC_UNBOUNDED;
+  return guard;
+}
+
+
+static void boundGuard(
+  int range[],
+  const string& op,
+  const int n)
+{
+  // != leaves the range as it is.
+  if (op == "==" || op == ">=")
+    range[0] = max(range[0], n);
+  if (op == "==" || op == "<=")
+    range[1] = min(range[1], n);
+  if (op == ">")
+    range[0] = max(range[0], n+1);
+  if (op == "<")
+    range[1] = min(range[1], n-1);
+}
+
+
+static string mirrorOp(const string& op)
+{
+  // a op b as b op' a.
+  if (op == "<")
+    return ">";
+  else if (op == "<=")
+    return ">=";
+  else if (op == ">")
+    return "<";
+  else if (op == ">=")
+    return "<=";
+  else
+    return op;
+}
+
+
+static bool guardHolds(SpecGuard& guard)
+{
+  // Narrows the bounds through m_length = m_current + rest + 1 and
+  // moves letters to m_current where the bounds fix their position.
+  // False if the guard can never hold.
+  int * c = guard.current;
+  int * r = guard.rest;
+  int * l = guard.length;
+  for (unsigned round = 0; round < 2; round++)
+  {
+    c[0] = max(c[0], l[0] - 1 - r[1]);
+    c[1] = min(c[1], l[1] - 1 - r[0]);
+    r[0] = max(r[0], l[0] - 1 - c[1]);
+    r[1] = min(r[1], l[1] - 1 - c[0]);
+    l[0] = max(l[0], c[0] + r[0] + 1);
+    l[1] = min(l[1], c[1] + r[1] + 1);
+  }
+  if (c[0] > c[1] || r[0] > r[1] || l[0] > l[1])
+    return false;
+
+  map<pair<int, int>, char> letters;
+  for (auto& entry: guard.letters)
+  {
+    int base = entry.first.first;
+    int offset = entry.first.second;
+    if (base == SPEC_BASE_LAST && r[0] == r[1])
+    {
+      base = SPEC_BASE_CURRENT;
+      offset += r[0];
+    }
+    else if (base == SPEC_BASE_START && c[0] == c[1])
+    {
+      base = SPEC_BASE_CURRENT;
+      offset -= c[0];
+    }
+    else if (base == SPEC_BASE_LAST && l[0] == l[1])
+    {
+      base = SPEC_BASE_START;
+      offset += l[0] - 1;
+    }
+
+    auto it = letters.find(make_pair(base, offset));
+    if (it == letters.end())
+      letters[make_pair(base, offset)] = entry.second;
+    else if (it->second != entry.second)
+      return false;
+  }
+  guard.letters = letters;
+  return true;
+}
+
+
+static bool joinGuards(
+  const SpecGuard& guard1,
+  const SpecGuard& guard2,
+  SpecGuard& joined)
+{
+  // Both guards.  False if that can never hold.
+  joined = guard1;
+  for (auto& entry: guard2.letters)
+  {
+    auto it = joined.letters.find(entry.first);
+    if (it == joined.letters.end())
+      joined.letters.insert(entry);
+    else if (it->second != entry.second)
+      return false;
+  }
+  for (unsigned i = 0; i < 2; i++)
+  {
+    const bool low = (i == 0);
+    joined.current[i] = (low ?
+      max(guard1.current[i], guard2.current[i]) :
+      min(guard1.current[i], guard2.current[i]));
+    joined.rest[i] = (low ?
+      max(guard1.rest[i], guard2.rest[i]) :
+      min(guard1.rest[i], guard2.rest[i]));
+    joined.length[i] = (low ?
+      max(guard1.length[i], guard2.length[i]) :
+      min(guard1.length[i], guard2.length[i]));
+  }
+  return guardHolds(joined);
+}
+
+
+static void andGuards(
+  vector<SpecGuard>& guards,
+  const vector<SpecGuard>& others)
+{
+  // Too many combinations leave others out, which only weakens the
+  // guards.
+  if (guards.size() * others.size() > SPEC_MAX_GUARDS)
+    return;
+
+  vector<SpecGuard> product;
+  SpecGuard joined;
+  for (auto& guard: guards)
+  {
+    for (auto& other: others)
+    {
+      if (joinGuards(guard, other, joined))
+        product.push_back(joined);
+    }
+  }
+  guards = product;
+}
+
+
+static void exprGuards(
+  const SpecExpr& expr,
+  vector<SpecGuard>& guards)
+{
+  // Guards of which one holds whenever expr does.  Terms other than
+  // letters, positions and lengths are left out, and so is not.
+  guards.clear();
+  vector<SpecGuard> part;
+  switch (expr.type)
+  {
+    case SPEC_TERM_OR:
+      for (auto& arg: expr.args)
+      {
+        exprGuards(arg, part);
+        guards.insert(guards.end(), part.begin(), part.end());
+      }
+      if (guards.size() > SPEC_MAX_GUARDS)
+        guards.assign(1, anyGuard());
+      return;
+
+    case SPEC_TERM_AND:
+      guards.assign(1, anyGuard());
+      for (auto& arg: expr.args)
+      {
+        exprGuards(arg, part);
+        andGuards(guards, part);
+      }
+      return;
+
+    case SPEC_TERM_AT:
+      // As stringAt():  the literal lies within the word.
+      for (auto& word: expr.words)
+      {
+        SpecGuard guard = anyGuard();
+        const int len = static_cast<int>(word.size());
+        for (int i = 0; i < len; i++)
+          guard.letters[make_pair(static_cast<int>(expr.base),
+            expr.offset + i)] = word[i];
+
+        if (expr.base == SPEC_BASE_CURRENT)
+        {
+          guard.current[0] = max(0, -expr.offset);
+          guard.rest[0] = expr.offset + len - 1;
+        }
+        else if (expr.base == SPEC_BASE_START)
+          guard.length[0] = expr.offset + len;
+        else
+          guard.length[0] = 1 - expr.offset;
+
+        if (guardHolds(guard))
+          guards.push_back(guard);
+      }
+      return;
+
+    case SPEC_TERM_POS:
+      guards.assign(1, anyGuard());
+      if (expr.base == SPEC_BASE_START)
+        boundGuard(guards[0].current, expr.op, expr.offset);
+      else
+        boundGuard(guards[0].rest, mirrorOp(expr.op), -expr.offset);
+      if (! guardHolds(guards[0]))
+        guards.clear();
+      return;
+
+    case SPEC_TERM_LENGTH:
+      guards.assign(1, anyGuard());
+      boundGuard(guards[0].length, expr.op, expr.number);
+      if (! guardHolds(guards[0]))
+        guards.clear();
+      return;
+
+    default:
+      guards.assign(1, anyGuard());
+      return;
+  }
+}
+
+
+static void ruleGuards(
+  const SpecRule& rule,
+  vector<SpecGuard>& guards)
+{
+  // A case fires only if its condition and the requires before it
+  // hold.
+  guards.clear();
+  vector<SpecGuard> required(1, anyGuard()), part;
+  for (auto& c: rule.cases)
+  {
+    exprGuards(c.cond, part);
+    if (c.require)
+      andGuards(required, part);
+    else if (! c.fail)
+    {
+      andGuards(part, required);
+      guards.insert(guards.end(), part.begin(), part.end());
+    }
+  }
+}
+
+
+static bool rulePure(const SpecRule& rule)
+{
+  // True if the rule only changes the state when it fires.
+  for (auto& c: rule.cases)
+  {
+    if (c.fail && ! c.actions.empty())
+      return false;
+  }
+  return true;
+}
+
+
+void RuleSpec::exclusions(vector<vector<bool>>& apart) const
+{
+  const size_t n = m_rules.size();
+  vector<vector<SpecGuard>> guards(n);
+  for (size_t r = 0; r < n; r++)
+    ruleGuards(m_rules[r], guards[r]);
+
+  apart.assign(n, vector<bool>(n, false));
+  SpecGuard joined;
+  for (size_t r1 = 0; r1 < n; r1++)
+  {
+    for (size_t r2 = r1+1; r2 < n; r2++)
+    {
+      bool together = false;
+      for (auto& g1: guards[r1])
+      {
+        for (auto& g2: guards[r2])
+        {
+          if (joinGuards(g1, g2, joined))
+          {
+            together = true;
+            break;
+          }
+        }
+        if (together)
+          break;
+      }
+      apart[r1][r2] = ! together;
+      apart[r2][r1] = ! together;
+    }
+  }
+}
+
+
+static SpecCode leafCode(
+  const string& text,
+  const bool atomic)
+{
+  SpecCode code;
+  code.op = "";
+  code.text = text;
+  code.atomic = atomic;
+  return code;
+}
+
+
+static SpecCode joinCode(
+  const string& op,
+  const vector<SpecCode>& parts)
+{
+  // Nested and's (or's) are flattened into one.
+  if (parts.size() == 1)
+    return parts[0];
+
+  SpecCode code;
+  code.op = op;
+  code.atomic = false;
+  for (auto& part: parts)
+  {
+    if (part.op == op)
+      code.parts.insert(code.parts.end(), part.parts.begin(),
+        part.parts.end());
+    else
+      code.parts.push_back(part);
+  }
+  return code;
+}
+
+
+static SpecCode notCode(const SpecCode& part)
+{
+  SpecCode code;
+  code.op = "!";
+  code.atomic = false;
+  code.parts.push_back(part);
+  return code;
+}
+
+
+static string signedTerm(
+  const string& base,
+  const int offset)
+{
+  // E.g. "m_current + 2", "m_last - 1" or "m_current".
+  if (offset == 0)
+    return base;
+  return base + (offset > 0 ? " + " : " - ") + to_string(abs(offset));
+}
+
+
+static string indexCode(
+  const SpecBase base,
+  const int offset)
+{
+  if (base == SPEC_BASE_CURRENT)
+    return signedTerm("m_current", offset);
+  else if (base == SPEC_BASE_START)
+    return to_string(offset);
+  else
+    return signedTerm("m_last", offset);
+}
+
+
+static SpecCode trieCode(
+  const vector<string>& literals,
+  const size_t depth,
+  const SpecBase base,
+  const int offset)
+{
+  // The literals all have the same length and share their first
+  // depth letters.  One comparison per distinct next letter.
+  const size_t len = literals[0].size();
+  const string index = indexCode(base, offset + static_cast<int>(depth));
+  if (literals.size() == 1 && len - depth >= SPEC_MEMCMP_LENGTH)
+    return leafCode("memcmp(w + " + index + ", \"" +
+      literals[0].substr(depth) + "\", " + to_string(len - depth) +
+      ") == 0", false);
+
+  vector<SpecCode> alternatives;
+  size_t i = 0;
+  while (i < literals.size())
+  {
+    const char c = literals[i][depth];
+    vector<string> same;
+    while (i < literals.size() && literals[i][depth] == c)
+      same.push_back(literals[i++]);
+
+    vector<SpecCode> parts;
+    parts.push_back(leafCode("w[" + index + "] == '" + string(1, c) +
+      "'", false));
+    if (depth+1 < len)
+      parts.push_back(trieCode(same, depth+1, base, offset));
+    alternatives.push_back(joinCode("&&", parts));
+  }
+  return joinCode("||", alternatives);
+}
+
+
+static SpecCode atCode(const SpecExpr& expr)
+{
+  // As stringAt():  the literals must lie within the word.  One trie
+  // per literal length.
+  map<size_t, vector<string>> byLength;
+  for (auto& word: expr.words)
+    byLength[word.size()].push_back(word);
+
+  vector<SpecCode> alternatives;
+  for (auto& entry: byLength)
+  {
+    vector<string>& literals = entry.second;
+    sort(literals.begin(), literals.end());
+    literals.erase(unique(literals.begin(), literals.end()),
+      literals.end());
+
+    const int len = static_cast<int>(entry.first);
+    vector<SpecCode> parts;
+    if (expr.base == SPEC_BASE_CURRENT)
+    {
+      if (expr.offset < 0)
+        parts.push_back(leafCode("m_current >= " +
+          to_string(-expr.offset), false));
+      parts.push_back(leafCode(signedTerm("m_current",
+        expr.offset + len) + " <= m_length", false));
+    }
+    else if (expr.base == SPEC_BASE_START)
+      parts.push_back(leafCode("m_length >= " +
+        to_string(expr.offset + len), false));
+    else
+      parts.push_back(leafCode("m_last >= " + to_string(-expr.offset),
+        false));
+
+    parts.push_back(trieCode(literals, 0, expr.base, expr.offset));
+    alternatives.push_back(joinCode("&&", parts));
+  }
+  return joinCode("||", alternatives);
+}
+
+
+static SpecCode exprCode(const SpecExpr& expr)
+{
+  vector<SpecCode> parts;
+  switch (expr.type)
+  {
+    case SPEC_TERM_OR:
+    case SPEC_TERM_AND:
+      for (auto& arg: expr.args)
+        parts.push_back(exprCode(arg));
+      return joinCode(expr.type == SPEC_TERM_OR ? "||" : "&&", parts);
+
+    case SPEC_TERM_NOT:
+      return notCode(exprCode(expr.args[0]));
+
+    case SPEC_TERM_AT:
+      return atCode(expr);
+
+    case SPEC_TERM_VOWEL:
+      return leafCode("isVowel(" + indexCode(expr.base, expr.offset) +
+        ")", true);
+
+    case SPEC_TERM_FRONT:
+      return leafCode("front_Vowel(" + indexCode(expr.base, expr.offset) +
+        ")", true);
+
+    case SPEC_TERM_POS:
+      return leafCode("m_current " + expr.op + " " +
+        indexCode(expr.base, expr.offset), false);
+
+    case SPEC_TERM_LENGTH:
+      return leafCode("m_length " + expr.op + " " +
+        to_string(expr.number), false);
+
+    case SPEC_TERM_VOWELS:
+      return leafCode("m_encodeVowels", true);
+
+    case SPEC_TERM_EXACT:
+      return leafCode("m_encodeExact", true);
+
+    case SPEC_TERM_CALL:
+      return leafCode(expr.words[0] + "()", true);
+
+    case SPEC_TERM_ROOT:
+      return leafCode("rootOrInflections(m_inWord, \"" + expr.words[0] +
+        "\")", true);
+
+    case SPEC_TERM_HAS:
+      return leafCode("m_inWord.find(\"" + expr.words[0] +
+        "\") != string::npos", false);
+
+    default:
+      return leafCode("false", true);
+  }
+}
+
+
+static bool usesWord(const SpecExpr& expr)
+{
+  // True if the code of expr reads the letters through w.
+  if (expr.type == SPEC_TERM_AT)
+    return true;
+  for (auto& arg: expr.args)
+  {
+    if (usesWord(arg))
+      return true;
+  }
+  return false;
+}
+
+
+static bool usesWord(const vector<SpecAction>& actions)
+{
+  for (auto& action: actions)
+  {
+    for (auto& branch: action.branches)
+    {
+      if ((branch.conditional && usesWord(branch.cond)) ||
+          usesWord(branch.actions))
+        return true;
+    }
+  }
+  return false;
+}
+
+
+static string flatCode(
+  const SpecCode& code,
+  const string& parentOp)
+{
+  if (code.op == "")
+    return code.text;
+  else if (code.op == "!")
+  {
+    const SpecCode& part = code.parts[0];
+    return (part.atomic ? "! " + part.text :
+      "! (" + flatCode(part, "") + ")");
+  }
+
+  string s;
+  for (auto& part: code.parts)
+    s += (s.empty() ? "" : " " + code.op + " ") + flatCode(part, code.op);
+  return (parentOp == "" || parentOp == code.op ? s : "(" + s + ")");
+}
+
+
+static string formatCode(
+  const SpecCode& code,
+  const size_t column,
+  const size_t tail,
+  const string& parentOp)
+{
+  // Breaks after the operators of and's and or's that do not fit on
+  // the line.  tail is the width of what follows code on its last
+  // line, such as " ||" or ")".
+  const string flat = flatCode(code, parentOp);
+  if (column + flat.size() + tail <= SPEC_WIDTH || code.op == "")
+    return flat;
+
+  if (code.op == "!")
+  {
+    const SpecCode& part = code.parts[0];
+    return (part.atomic ? flat :
+      "! (" + formatCode(part, column+3, tail+1, "") + ")");
+  }
+
+  const bool paren = (parentOp != "" && parentOp != code.op);
+  const size_t inner = column + (paren ? 1 : 0);
+  string s = (paren ? "(" : "");
+  for (size_t i = 0; i < code.parts.size(); i++)
+  {
+    const bool last = (i+1 == code.parts.size());
+    s += formatCode(code.parts[i], inner,
+      last ? tail + (paren ? 1 : 0) : code.op.size() + 1, code.op);
+    if (! last)
+      s += " " + code.op + "\n" + string(inner, ' ');
+  }
+  return s + (paren ? ")" : "");
+}
+
+
+static string quoteCode(const string& code)
+{
+  return "\"" + code + "\"";
+}
+
+
+void RuleSpec::codeActions(
+  const vector<SpecAction>& actions,
+  const unsigned indent,
+  string& text) const
+{
+  const string pad(indent, ' ');
+  for (auto& action: actions)
+  {
+    switch (action.type)
+    {
+      case SPEC_ACTION_ADD:
+        if (action.variant == "exact")
+        {
+          if (action.main == action.alt &&
+              action.variantMain == action.variantAlt)
+            text += pad + "addExactApprox(" +
+              quoteCode(action.variantMain) + ", " +
+              quoteCode(action.main) + ");\n";
+          else
+            text += pad + "addExactApprox(" +
+              quoteCode(action.variantMain) + ", " +
+              quoteCode(action.variantAlt) + ", " +
+              quoteCode(action.main) + ", " +
+              quoteCode(action.alt) + ");\n";
+        }
+        else if (action.variant == "vowels")
+        {
+          const string main = "m_encodeVowels ? " +
+            quoteCode(action.variantMain) + " : " + quoteCode(action.main);
+          const string alt = (action.alt == action.variantAlt ?
+            quoteCode(action.alt) : "m_encodeVowels ? " +
+            quoteCode(action.variantAlt) + " : " + quoteCode(action.alt));
+          if (action.main == action.alt &&
+              action.variantMain == action.variantAlt)
+            text += pad + "add(" + main + ");\n";
+          else
+            text += pad + "add(" + main + ",\n" + pad + "  " + alt + ");\n";
+        }
+        else if (action.main == action.alt)
+          text += pad + "add(" + quoteCode(action.main) + ");\n";
+        else
+          text += pad + "add(" + quoteCode(action.main) + ", " +
+            quoteCode(action.alt) + ");\n";
+        break;
+
+      case SPEC_ACTION_SKIP:
+        if (action.steps != action.stepsVowels)
+          text += pad + "advanceCounter(" + to_string(action.steps) +
+            ", " + to_string(action.stepsVowels) + ");\n";
+        else if (action.steps == 1)
+          text += pad + "m_current++;\n";
+        else
+          text += pad + "m_current += " + to_string(action.steps) + ";\n";
+        break;
+
+      case SPEC_ACTION_SKIP_VOWELS:
+        text += pad + "m_current = skipVowels(m_current);\n";
+        break;
+
+      case SPEC_ACTION_FLAG:
+        text += pad + "flag_" + action.flag + " = true;\n";
+        break;
+
+      case SPEC_ACTION_IF:
+        for (size_t b = 0; b < action.branches.size(); b++)
+        {
+          const SpecBranch& branch = action.branches[b];
+          if (branch.conditional)
+          {
+            const string key = (b == 0 ? "if (" : "else if (");
+            text += pad + key + formatCode(exprCode(branch.cond),
+              indent + key.size(), 1, "") + ")\n";
+          }
+          else
+            text += pad + "else\n";
+          text += pad + "{\n";
+          RuleSpec::codeActions(branch.actions, indent+2, text);
+          text += pad + "}\n";
+        }
+        break;
+
+      default:
+        break;
+    }
+  }
+}
+
+
+void RuleSpec::codeRule(
+  const SpecRule& rule,
+  string& text) const
+{
+  // Metaphone3.h declares the rule, so a misspelled name does not
+  // compile, and neither does a rule that Metaphone3.cpp also defines.
+  text += "\n\n// " + rule.name + ", " + m_name + " line " +
+    to_string(rule.line) + ".\n";
+  text += "bool Metaphone3::" + rule.name + "()\n{\n";
+
+  bool word = false;
+  for (auto& c: rule.cases)
+  {
+    if (usesWord(c.cond) || usesWord(c.actions))
+      word = true;
+  }
+  if (word)
+    text += "  const char * w = m_inWord.c_str();\n";
+
+  for (auto& c: rule.cases)
+  {
+    text += "\n";
+    if (c.require)
+    {
+      const SpecCode code = (c.cond.type == SPEC_TERM_NOT ?
+        exprCode(c.cond.args[0]) : notCode(exprCode(c.cond)));
+      text += "  if (" + formatCode(code, 6, 1, "") + ")\n" +
+        "    return false;\n";
+      continue;
+    }
+
+    text += "  if (" + formatCode(exprCode(c.cond), 6, 1, "") + ")\n  {\n";
+    RuleSpec::codeActions(c.actions, 4, text);
+    text += string("    return ") + (c.fail ? "false" : "true") +
+      ";\n  }\n";
+  }
+  text += "  return false;\n}\n";
+}
+
+
+string RuleSpec::header() const
+{
+  stringstream ss;
+  ss << "// Extension of Metaphone3.\n" <<
+    "// Copyright (C) 2017 by Soren Hein.\n" <<
+    "// No restrictions on copying and modifying, as long as credit " <<
+    "is given.\n" <<
+    "// No warranties.\n\n";
+
+  ss << "// The Metaphone3 rules of " << m_name << " compiled into C++ " <<
+    "(see\n" <<
+    "// RuleSpec.h).  Generated by test -S, so do not edit.  " <<
+    "These are the\n" <<
+    "// only definitions of the rules;  Metaphone3.cpp has the " <<
+    "others.\n\n";
+
+  ss << "#ifndef METAPHONE3SPEC_H\n#define METAPHONE3SPEC_H\n\n" <<
+    "#include <cstdint>\n\n";
+  ss << "#define METAPHONE3_SPEC_CHECKSUM 0x" << hex << setw(8) <<
+    setfill('0') << m_checksum << dec << setfill(' ') << "u\n\n";
+  ss << "#define SPEC_RULE_COUNT " << m_rules.size() << "\n\n";
+
+  // Which rules may swap in a chain (see RuleProfile.h).
+  const size_t words = (m_rules.size() + 63) / 64;
+  ss << "#define SPEC_RULE_WORDS " << words << "\n\n" <<
+    "// Per rule:  whether it only changes the state when it fires, " <<
+    "and the\n" <<
+    "// rules that can never fire together with it (rule r is bit " <<
+    "r % 64 of\n" <<
+    "// word r / 64).\n" <<
+    "struct SpecRuleInfo\n{\n" <<
+    "  const char * name;\n" <<
+    "  bool pure;\n" <<
+    "  uint64_t apart[SPEC_RULE_WORDS];\n};\n\n";
+
+  vector<vector<bool>> apart;
+  RuleSpec::exclusions(apart);
+  ss << "static const SpecRuleInfo SPEC_RULES[] =\n{\n";
+  for (size_t r1 = 0; r1 < m_rules.size(); r1++)
+  {
+    ss << "  {\"" << m_rules[r1].name << "\", " <<
+      (rulePure(m_rules[r1]) ? "true" : "false") << ",\n    {";
+    for (size_t w = 0; w < words; w++)
+    {
+      uint64_t bits = 0;
+      for (size_t r2 = 64 * w; r2 < min(64 * (w+1), m_rules.size()); r2++)
+      {
+        if (apart[r1][r2])
+          bits |= uint64_t(1) << (r2 % 64);
+      }
+      ss << (w == 0 ? "" : ", ") << "0x" << hex << setw(16) <<
+        setfill('0') << bits << dec << setfill(' ') << "ull";
+    }
+    ss << "}}" << (r1+1 == m_rules.size() ? "" : ",") << "\n";
+  }
+  ss << "};\n";
+
+  string text;
+  for (auto& rule: m_rules)
+    RuleSpec::codeRule(rule, text);
+  ss << text << "\n#endif\n";
+  return ss.str();
+}
+
@@ -0,0 +1,196 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// A specification of Metaphone3 rules (Metaphone3Spec.txt), and its
+// compilation into C++ (Metaphone3Spec.h), which test -S writes.  The
+// spec is the only source of its rules:  Metaphone3Spec.h defines the
+// rule functions that Metaphone3.h declares.  The spec says where to look for which letters and
+// what to add, and the generated code tests all the literals at one
+// position as a single tree of character comparisons instead of one
+// string comparison per literal.  The language is described at the
+// top of Metaphone3Spec.txt.
+
+#ifndef RULESPEC_H
+#define RULESPEC_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+// Where a position is counted from:  m_current, the start of the
+// word, or m_last.
+enum SpecBase
+{
+  SPEC_BASE_CURRENT = 0,
+  SPEC_BASE_START = 1,
+  SPEC_BASE_LAST = 2
+};
+
+enum SpecTermType
+{
+  SPEC_TERM_OR = 0,
+  SPEC_TERM_AND = 1,
+  SPEC_TERM_NOT = 2,
+  SPEC_TERM_AT = 3,
+  SPEC_TERM_VOWEL = 4,
+  SPEC_TERM_FRONT = 5,
+  SPEC_TERM_POS = 6,
+  SPEC_TERM_LENGTH = 7,
+  SPEC_TERM_VOWELS = 8,
+  SPEC_TERM_EXACT = 9,
+  SPEC_TERM_CALL = 10,
+  SPEC_TERM_ROOT = 11,
+  SPEC_TERM_HAS = 12
+};
+
+enum SpecActionType
+{
+  SPEC_ACTION_ADD = 0,
+  SPEC_ACTION_SKIP = 1,
+  SPEC_ACTION_SKIP_VOWELS = 2,
+  SPEC_ACTION_FLAG = 3,
+  SPEC_ACTION_IF = 4
+};
+
+struct SpecExpr
+{
+  SpecTermType type;
+
+  // The operands of or, and and not.
+  vector<SpecExpr> args;
+
+  // The position of at, vowel, front and pos, as base plus offset.
+  SpecBase base;
+  int offset;
+
+  // The comparison of pos and length, such as "<=", and the number
+  // of length.
+  string op;
+  int number;
+
+  // The literals of at, or the argument of call, root and has.
+  vector<string> words;
+};
+
+struct SpecAction;
+
+struct SpecBranch
+{
+  // False for else.
+  bool conditional;
+  SpecExpr cond;
+
+  vector<SpecAction> actions;
+};
+
+struct SpecAction
+{
+  SpecActionType type;
+
+  // add:  the main and alternate code, and the codes that replace
+  // them when m_encodeExact (variant "exact") or m_encodeVowels
+  // (variant "vowels").
+  string main;
+  string alt;
+  string variant;
+  string variantMain;
+  string variantAlt;
+
+  // skip:  the letters to skip without and with m_encodeVowels.
+  int steps;
+  int stepsVowels;
+
+  // flag:  e.g. "AL_inversion".
+  string flag;
+
+  // if, elif and else.
+  vector<SpecBranch> branches;
+};
+
+// A rule fires on the first of its when cases that holds, and then
+// returns true, or false if the case ends with fail.  A failed
+// require returns false at once.
+struct SpecCase
+{
+  bool require;
+  bool fail;
+  unsigned line;
+  SpecExpr cond;
+  vector<SpecAction> actions;
+};
+
+struct SpecRule
+{
+  // E.g. "encode_SKJ" for rule SKJ.
+  string name;
+  unsigned line;
+  vector<SpecCase> cases;
+};
+
+
+class RuleSpec
+{
+  private:
+
+    // The file name without its directory, for the generated comments.
+    string m_name;
+
+    vector<SpecRule> m_rules;
+
+    unsigned m_checksum;
+
+
+    void codeRule(
+      const SpecRule& rule,
+      string& text) const;
+
+    void codeActions(
+      const vector<SpecAction>& actions,
+      const unsigned indent,
+      string& text) const;
+
+    // apart[r1][r2]:  rules r1 and r2 never fire on the same state.
+    // This is a proof from the letters, positions and lengths that
+    // the rules look at, so apart may be false for rules that never
+    // fire together all the same.
+    void exclusions(vector<vector<bool>>& apart) const;
+
+    void probeExpr(
+      const SpecExpr& expr,
+      vector<string>& words) const;
+
+    void probeActions(
+      const vector<SpecAction>& actions,
+      vector<string>& words) const;
+
+  public:
+
+    RuleSpec();
+    ~RuleSpec();
+    void reset();
+
+    // Prints the line of the first error.
+    bool read(const string& fname);
+
+    unsigned numRules() const;
+
+    // Of the text of the spec, so a build can tell whether its
+    // Metaphone3Spec.h is up to date.
+    unsigned checksum() const;
+
+    // The rule names, e.g. "encode_SKJ".
+    void names(vector<string>& names) const;
+
+    // Words that make the rules fire or nearly fire:  the literals of
+    // the spec on their own and inside other letters.
+    void probes(vector<string>& words) const;
+
+    // The text of Metaphone3Spec.h.
+    string header() const;
+};
+
+#endif
@@ -0,0 +1,146 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <thread>
+#include <numeric>
+#include <algorithm>
+
+#include "Scheduler.h"
+
+
+Scheduler::Scheduler()
+{
+  reset();
+}
+
+
+Scheduler::~Scheduler()
+{
+}
+
+
+void Scheduler::reset()
+{
+  setThreads(0);
+}
+
+
+void Scheduler::setThreads(const unsigned numThreads)
+{
+  // 0 means one thread per hardware thread.
+  if (numThreads > 0)
+    m_numThreads = numThreads;
+  else
+  {
+    const unsigned hw = thread::hardware_concurrency();
+    m_numThreads = (hw == 0 ? 1 : hw);
+  }
+}
+
+
+unsigned Scheduler::getThreads() const
+{
+  return m_numThreads;
+}
+
+
+void Scheduler::distribute(const vector<size_t>& weights)
+{
+  // Largest job first onto the least-loaded queue, so the queues
+  // start out roughly balanced and each is ordered largest first.
+  vector<size_t> order(weights.size());
+  iota(order.begin(), order.end(), 0);
+  stable_sort(order.begin(), order.end(),
+    [&weights](const size_t a, const size_t b)
+    {
+      return weights[a] > weights[b];
+    });
+
+  vector<size_t> load(m_queues.size(), 0);
+  for (auto job: order)
+  {
+    const size_t q = static_cast<size_t>(
+      min_element(load.begin(), load.end()) - load.begin());
+    m_queues[q].jobs.push_back(job);
+    load[q] += weights[job] + 1;
+  }
+}
+
+
+bool Scheduler::takeOwn(
+  const unsigned thrNo,
+  size_t& job)
+{
+  WorkQueue& wq = m_queues[thrNo];
+  lock_guard<mutex> lck(wq.mtx);
+  if (wq.jobs.empty())
+    return false;
+
+  job = wq.jobs.front();
+  wq.jobs.pop_front();
+  return true;
+}
+
+
+bool Scheduler::steal(
+  const unsigned thrNo,
+  size_t& job)
+{
+  // Take the smallest job of the first victim that has any work.
+  const unsigned n = static_cast<unsigned>(m_queues.size());
+  for (unsigned i = 1; i < n; i++)
+  {
+    WorkQueue& wq = m_queues[(thrNo + i) % n];
+    lock_guard<mutex> lck(wq.mtx);
+    if (wq.jobs.empty())
+      continue;
+
+    job = wq.jobs.back();
+    wq.jobs.pop_back();
+    return true;
+  }
+  return false;
+}
+
+
+void Scheduler::work(
+  const unsigned thrNo,
+  const function<void(size_t, unsigned)>& fnc)
+{
+  // Jobs are never added while running, so once both the own queue
+  // and all the others are empty, we are done.
+  size_t job;
+  while (takeOwn(thrNo, job) || steal(thrNo, job))
+    fnc(job, thrNo);
+}
+
+
+void Scheduler::run(
+  const vector<size_t>& weights,
+  const function<void(size_t, unsigned)>& fnc)
+{
+  const unsigned n = static_cast<unsigned>(
+    min(static_cast<size_t>(m_numThreads), weights.size()));
+
+  if (n <= 1)
+  {
+    for (size_t job = 0; job < weights.size(); job++)
+      fnc(job, 0);
+    return;
+  }
+
+  m_queues = vector<WorkQueue>(n);
+  distribute(weights);
+
+  vector<thread> threads;
+  for (unsigned t = 1; t < n; t++)
+    threads.emplace_back(&Scheduler::work, this, t, cref(fnc));
+
+  work(0, fnc);
+
+  for (auto& thr: threads)
+    thr.join();
+}
+
@@ -0,0 +1,69 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// A small work-stealing thread pool.  Each worker owns a queue of
+// job numbers.  Jobs are dealt out largest first to the least-loaded
+// queue, a worker takes its own jobs from the front (largest first),
+// and an idle worker steals from the back (smallest) of another
+// worker's queue.  This keeps all threads busy even when the jobs
+// differ wildly in size, as the Moby and tournament files do.
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <functional>
+
+using namespace std;
+
+
+class Scheduler
+{
+  private:
+
+    struct WorkQueue
+    {
+      mutex mtx;
+      deque<size_t> jobs;
+    };
+
+    unsigned m_numThreads;
+
+    vector<WorkQueue> m_queues;
+
+
+    void distribute(const vector<size_t>& weights);
+
+    bool takeOwn(
+      const unsigned thrNo,
+      size_t& job);
+
+    bool steal(
+      const unsigned thrNo,
+      size_t& job);
+
+    void work(
+      const unsigned thrNo,
+      const function<void(size_t, unsigned)>& fnc);
+
+  public:
+
+    Scheduler();
+    ~Scheduler();
+    void reset();
+
+    void setThreads(const unsigned numThreads);
+    unsigned getThreads() const;
+
+    // Calls fnc(job, thrNo) once for every job 0 .. weights.size()-1.
+    // The weights are only used to balance the initial queues.
+    void run(
+      const vector<size_t>& weights,
+      const function<void(size_t, unsigned)>& fnc);
+};
+
+#endif
@@ -0,0 +1,275 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <algorithm>
+#include <cmath>
+
+#include "Sketches.h"
+
+
+CountMinSketch::CountMinSketch()
+{
+  reset();
+}
+
+
+CountMinSketch::~CountMinSketch()
+{
+}
+
+
+void CountMinSketch::reset()
+{
+  m_counts.clear();
+  m_depth = 0;
+  m_mask = 0;
+}
+
+
+void CountMinSketch::setSize(
+  const unsigned depth,
+  const size_t width)
+{
+  size_t w = 1;
+  while (w < width)
+    w <<= 1;
+
+  m_depth = depth;
+  m_mask = w - 1;
+  m_counts.assign(depth * w, 0);
+}
+
+
+// Row i uses the column lo + i * step (double hashing), with an odd
+// step so that the rows differ.
+static inline size_t cmsColumn(
+  const uint64_t hash,
+  const unsigned row,
+  const uint64_t mask)
+{
+  const uint64_t lo = hash & 0xffffffffULL;
+  const uint64_t step = (hash >> 32) | 1;
+  return static_cast<size_t>((lo + row * step) & mask);
+}
+
+
+uint32_t CountMinSketch::add(const uint64_t hash)
+{
+  const size_t width = m_mask + 1;
+  uint32_t result = UINT32_MAX;
+  for (unsigned i = 0; i < m_depth; i++)
+  {
+    uint32_t& c = m_counts[i * width + cmsColumn(hash, i, m_mask)];
+    if (c < UINT32_MAX)
+      c++;
+    result = min(result, c);
+  }
+  return result;
+}
+
+
+uint32_t CountMinSketch::estimate(const uint64_t hash) const
+{
+  const size_t width = m_mask + 1;
+  uint32_t result = UINT32_MAX;
+  for (unsigned i = 0; i < m_depth; i++)
+    result = min(result, m_counts[i * width + cmsColumn(hash, i, m_mask)]);
+  return (m_depth == 0 ? 0 : result);
+}
+
+
+void CountMinSketch::merge(const CountMinSketch& other)
+{
+  for (size_t i = 0; i < m_counts.size(); i++)
+  {
+    const uint64_t sum =
+      static_cast<uint64_t>(m_counts[i]) + other.m_counts[i];
+    m_counts[i] = static_cast<uint32_t>(min(sum,
+      static_cast<uint64_t>(UINT32_MAX)));
+  }
+}
+
+
+size_t CountMinSketch::bytes() const
+{
+  return m_counts.size() * sizeof(uint32_t);
+}
+
+
+HyperLogLog::HyperLogLog()
+{
+  reset();
+}
+
+
+HyperLogLog::~HyperLogLog()
+{
+}
+
+
+void HyperLogLog::reset()
+{
+  m_registers.clear();
+  m_precision = 0;
+}
+
+
+void HyperLogLog::setPrecision(const unsigned precision)
+{
+  m_precision = min(max(precision, 4u), 18u);
+  m_registers.assign(size_t(1) << m_precision, 0);
+}
+
+
+void HyperLogLog::add(const uint64_t hash)
+{
+  // The top bits pick the register, which keeps the longest run of
+  // leading zeros (plus one) seen in the other bits.
+  const size_t reg = static_cast<size_t>(hash >> (64 - m_precision));
+  uint64_t w = hash << m_precision;
+  const unsigned limit = 64 - m_precision + 1;
+  unsigned rank = 1;
+  while (rank < limit && (w >> 63) == 0)
+  {
+    rank++;
+    w <<= 1;
+  }
+
+  uint8_t& r = m_registers[reg];
+  if (rank > r)
+    r = static_cast<uint8_t>(rank);
+}
+
+
+double HyperLogLog::estimate() const
+{
+  const double m = static_cast<double>(m_registers.size());
+  if (m == 0.)
+    return 0.;
+
+  double sum = 0.;
+  size_t zeros = 0;
+  for (const uint8_t r: m_registers)
+  {
+    sum += ldexp(1., -static_cast<int>(r));
+    if (r == 0)
+      zeros++;
+  }
+
+  const double alpha = 0.7213 / (1. + 1.079 / m);
+  const double raw = alpha * m * m / sum;
+
+  // Small counts:  linear counting of the empty registers is better.
+  if (raw <= 2.5 * m && zeros > 0)
+    return m * log(m / static_cast<double>(zeros));
+  return raw;
+}
+
+
+void HyperLogLog::merge(const HyperLogLog& other)
+{
+  for (size_t i = 0; i < m_registers.size(); i++)
+    m_registers[i] = max(m_registers[i], other.m_registers[i]);
+}
+
+
+size_t HyperLogLog::bytes() const
+{
+  return m_registers.size();
+}
+
+
+HeavyHitters::HeavyHitters()
+{
+  reset();
+}
+
+
+HeavyHitters::~HeavyHitters()
+{
+}
+
+
+void HeavyHitters::reset()
+{
+  m_counts.clear();
+  m_capacity = 0;
+  m_minKey = 0;
+  m_minCount = 0;
+  m_minValid = false;
+}
+
+
+void HeavyHitters::setCapacity(const size_t capacity)
+{
+  reset();
+  m_capacity = capacity;
+  m_counts.reserve(capacity);
+}
+
+
+void HeavyHitters::findMin()
+{
+  m_minValid = true;
+  m_minCount = UINT32_MAX;
+  for (auto& p: m_counts)
+  {
+    if (p.second < m_minCount)
+    {
+      m_minKey = p.first;
+      m_minCount = p.second;
+    }
+  }
+}
+
+
+void HeavyHitters::offer(
+  const PackedKey key,
+  const uint32_t estimate)
+{
+  auto it = m_counts.find(key);
+  if (it != m_counts.end())
+  {
+    it->second = estimate;
+    if (key == m_minKey)
+      m_minValid = false;
+    return;
+  }
+
+  if (m_counts.size() < m_capacity)
+  {
+    m_counts.emplace(key, estimate);
+    if (m_minValid && estimate < m_minCount)
+    {
+      m_minKey = key;
+      m_minCount = estimate;
+    }
+    return;
+  }
+
+  if (m_capacity == 0)
+    return;
+  if (! m_minValid)
+    findMin();
+  if (estimate <= m_minCount)
+    return;
+
+  m_counts.erase(m_minKey);
+  m_counts.emplace(key, estimate);
+  m_minValid = false;
+}
+
+
+void HeavyHitters::keys(vector<PackedKey>& result) const
+{
+  for (auto& p: m_counts)
+    result.push_back(p.first);
+}
+
+
+size_t HeavyHitters::bytes() const
+{
+  return m_counts.size() * (sizeof(PackedKey) + sizeof(uint32_t));
+}
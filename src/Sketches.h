@@ -0,0 +1,126 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// Fixed-size summaries of a stream of keys, for statistics over
+// streams too long to count exactly.  Two sketches of the same size
+// merge into the sketch of both streams, so threads can each keep
+// their own.  Heavy hitters of several threads are pooled and
+// estimated again in the merged CountMinSketch.
+//
+// - CountMinSketch:  an estimate of how often a key occurred, never
+//   too low and too high by at most about e / width of the stream
+//   (with high probability), from depth rows of width counters.
+// - HyperLogLog:  an estimate of the number of distinct hashes, from
+//   2^precision one-byte registers, with a relative error of about
+//   1.04 / sqrt(2^precision).
+// - HeavyHitters:  a fixed number of keys with the highest estimates
+//   so far, given the estimates of a CountMinSketch.  A key that is
+//   not held replaces the lightest one if its estimate is higher.
+
+#ifndef SKETCHES_H
+#define SKETCHES_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#include "PackedKey.h"
+
+using namespace std;
+
+
+class CountMinSketch
+{
+  private:
+
+    vector<uint32_t> m_counts;
+    unsigned m_depth;
+    uint64_t m_mask;
+
+  public:
+
+    CountMinSketch();
+    ~CountMinSketch();
+    void reset();
+
+    // width is rounded up to a power of 2.
+    void setSize(
+      const unsigned depth,
+      const size_t width);
+
+    // Returns the new estimate.
+    uint32_t add(const uint64_t hash);
+
+    uint32_t estimate(const uint64_t hash) const;
+
+    // other must be of the same size.
+    void merge(const CountMinSketch& other);
+
+    size_t bytes() const;
+};
+
+
+class HyperLogLog
+{
+  private:
+
+    vector<uint8_t> m_registers;
+    unsigned m_precision;
+
+  public:
+
+    HyperLogLog();
+    ~HyperLogLog();
+    void reset();
+
+    // precision from 4 to 18.
+    void setPrecision(const unsigned precision);
+
+    void add(const uint64_t hash);
+
+    double estimate() const;
+
+    // other must be of the same precision.
+    void merge(const HyperLogLog& other);
+
+    size_t bytes() const;
+};
+
+
+class HeavyHitters
+{
+  private:
+
+    unordered_map<PackedKey, uint32_t> m_counts;
+    size_t m_capacity;
+
+    // The lightest key held, unless m_minValid is false.
+    PackedKey m_minKey;
+    uint32_t m_minCount;
+    bool m_minValid;
+
+
+    void findMin();
+
+  public:
+
+    HeavyHitters();
+    ~HeavyHitters();
+    void reset();
+
+    void setCapacity(const size_t capacity);
+
+    // Offers key with its current estimate.
+    void offer(
+      const PackedKey key,
+      const uint32_t estimate);
+
+    // Appends the keys held.
+    void keys(vector<PackedKey>& result) const;
+
+    size_t bytes() const;
+};
+
+#endif
@@ -0,0 +1,74 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include "Soundex.h"
+
+// The digit of each letter A..Z.  '0' for the vowels and Y, which
+// separate equal digits, and '-' for H and W, which do not.
+static const char SOUNDEX_DIGITS[] = "01230120022455012623010202";
+
+
+Soundex::Soundex()
+{
+  reset();
+}
+
+
+Soundex::~Soundex()
+{
+}
+
+
+void Soundex::reset()
+{
+  m_inWord.clear();
+  m_key.clear();
+}
+
+
+void Soundex::setNormalizedWord(const string_view in)
+{
+  m_inWord = in;
+}
+
+
+void Soundex::encode()
+{
+  m_key.clear();
+  char last = 0;
+  for (const char c: m_inWord)
+  {
+    if (c < 'A' || c > 'Z')
+      continue;
+
+    const char digit = (c == 'H' || c == 'W' ? '-' :
+      SOUNDEX_DIGITS[c - 'A']);
+    if (m_key.empty())
+    {
+      m_key.push_back(c);
+      last = digit;
+      continue;
+    }
+
+    if (digit == '-')
+      continue;
+    if (digit != '0' && digit != last)
+    {
+      m_key.push_back(digit);
+      if (m_key.size() == SOUNDEX_LENGTH)
+        return;
+    }
+    last = digit;
+  }
+
+  if (! m_key.empty())
+    m_key.resize(SOUNDEX_LENGTH, '0');
+}
+
+
+const string& Soundex::getKey() const
+{
+  return m_key;
+}
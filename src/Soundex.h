@@ -0,0 +1,49 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// American Soundex, as used for the US census:  the first letter,
+// then the digits of the following consonants (BFPV 1, CGJKQSXZ 2,
+// DT 3, L 4, MN 5, R 6), padded with zeros to SOUNDEX_LENGTH.  Equal
+// digits next to each other, or separated only by H or W, count once,
+// while a vowel between them makes them count twice.
+//
+// The word must already be normalized as by Metaphone3::normalize(),
+// so all the algorithms share one upper-casing pass.  Anything that is
+// not a letter A..Z is skipped.
+
+#ifndef SOUNDEX_H
+#define SOUNDEX_H
+
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+#define SOUNDEX_LENGTH 4
+
+
+class Soundex
+{
+  private:
+
+    string m_inWord;
+
+    string m_key;
+
+  public:
+
+    Soundex();
+    ~Soundex();
+    void reset();
+
+    void setNormalizedWord(const string_view in);
+
+    void encode();
+
+    // Empty if the word has no letter.
+    const string& getKey() const;
+};
+
+#endif
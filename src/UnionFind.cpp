@@ -0,0 +1,82 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <utility>
+
+#include "UnionFind.h"
+
+
+UnionFind::UnionFind()
+{
+  reset();
+}
+
+
+UnionFind::~UnionFind()
+{
+}
+
+
+void UnionFind::reset()
+{
+  m_parent.reset();
+  m_size = 0;
+}
+
+
+void UnionFind::init(const size_t n)
+{
+  m_parent.reset(new atomic<uint32_t>[n]);
+  m_size = n;
+  for (size_t i = 0; i < n; i++)
+    m_parent[i].store(static_cast<uint32_t>(i), memory_order_relaxed);
+}
+
+
+size_t UnionFind::size() const
+{
+  return m_size;
+}
+
+
+uint32_t UnionFind::find(uint32_t x) const
+{
+  while (true)
+  {
+    uint32_t parent = m_parent[x].load(memory_order_relaxed);
+    if (parent == x)
+      return x;
+
+    // Point x at its grandparent, unless someone got there first.
+    const uint32_t grand = m_parent[parent].load(memory_order_relaxed);
+    if (grand != parent)
+      m_parent[x].compare_exchange_weak(parent, grand,
+        memory_order_relaxed);
+    x = grand;
+  }
+}
+
+
+bool UnionFind::unite(
+  uint32_t a,
+  uint32_t b)
+{
+  while (true)
+  {
+    a = find(a);
+    b = find(b);
+    if (a == b)
+      return false;
+
+    if (a < b)
+      swap(a, b);
+
+    // a is now the larger root.  If it is still a root, link it.
+    uint32_t expected = a;
+    if (m_parent[a].compare_exchange_strong(expected, b,
+        memory_order_relaxed))
+      return true;
+  }
+}
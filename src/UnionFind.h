@@ -0,0 +1,52 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// A union-find (disjoint set) structure that several threads can
+// update at once without locks.
+//
+// Each element has an atomic parent.  A root is linked below another
+// root with a compare-and-swap, always the larger index below the
+// smaller one, so no cycles can form and the root of a set is its
+// smallest element.  find() halves the path as it goes, also with
+// compare-and-swap, so concurrent finds only ever shorten paths.
+
+#ifndef UNIONFIND_H
+#define UNIONFIND_H
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+using namespace std;
+
+
+class UnionFind
+{
+  private:
+
+    unique_ptr<atomic<uint32_t>[]> m_parent;
+    size_t m_size;
+
+  public:
+
+    UnionFind();
+    ~UnionFind();
+    void reset();
+
+    // Makes n singletons 0 .. n-1.
+    void init(const size_t n);
+
+    size_t size() const;
+
+    // The smallest element of the set of x.
+    uint32_t find(uint32_t x) const;
+
+    // Returns true if a and b were in different sets.
+    bool unite(
+      uint32_t a,
+      uint32_t b);
+};
+
+#endif
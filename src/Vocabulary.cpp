@@ -0,0 +1,196 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include "Vocabulary.h"
+#include "files.h"
+
+
+Vocabulary::Vocabulary()
+{
+  reset();
+}
+
+
+Vocabulary::~Vocabulary()
+{
+}
+
+
+void Vocabulary::reset()
+{
+  m_lookup.clear();
+  m_entries.clear();
+  clearLines();
+  m_numEncoded = 0;
+}
+
+
+void Vocabulary::clearLines()
+{
+  m_ids.clear();
+  m_lineStart.clear();
+  m_lineStart.push_back(0);
+}
+
+
+void Vocabulary::addToken(
+  Metaphone3& mph,
+  const string_view token,
+  string& normal)
+{
+  mph.normalize(token, normal);
+
+  auto it = m_lookup.find(normal);
+  if (it == m_lookup.end())
+  {
+    const unsigned no = static_cast<unsigned>(m_entries.size());
+    it = m_lookup.emplace(normal, no).first;
+    m_entries.push_back(Entry());
+    m_entries.back().token = normal;
+  }
+  m_ids.push_back(it->second);
+}
+
+
+void Vocabulary::addLine(
+  Metaphone3& mph,
+  const string& text,
+  const NameTokenizer * tokenizer)
+{
+  string normal;
+  if (tokenizer)
+  {
+    NameToken names[NAME_MAX_TOKENS];
+    char buf[NAME_MAX_TOKEN];
+    const size_t n = tokenizer->split(text, names, NAME_MAX_TOKENS);
+    for (size_t i = 0; i < n; i++)
+      addToken(mph, tokenizer->compact(names[i], buf), normal);
+    m_lineStart.push_back(m_ids.size());
+    return;
+  }
+
+  // Same splitting as tokenize(text, tokens, " "), without the
+  // intermediate vector.
+  const string_view view(text);
+  size_t lastPos = 0;
+  while (true)
+  {
+    size_t pos = text.find(' ', lastPos);
+    if (pos == string::npos)
+      pos = text.length();
+
+    addToken(mph, view.substr(lastPos, pos - lastPos), normal);
+
+    if (pos == text.length())
+      break;
+    lastPos = pos + 1;
+  }
+  m_lineStart.push_back(m_ids.size());
+}
+
+
+void Vocabulary::encode(Metaphone3& mph)
+{
+  for (size_t i = m_numEncoded; i < m_entries.size(); i++)
+  {
+    Entry& entry = m_entries[i];
+    unsigned config = 0;
+    for (bool encodeVowels: {false, true})
+    {
+      mph.setEncodeVowels(encodeVowels);
+      for (bool encodeExact: {false, true})
+      {
+        mph.setEncodeExact(encodeExact);
+        mph.setNormalizedWord(entry.token);
+        mph.encode();
+        entry.main[config] = mph.getMetaph();
+        entry.alt[config] = mph.getAlternateMetaph();
+        config++;
+      }
+    }
+  }
+  m_numEncoded = m_entries.size();
+}
+
+
+size_t Vocabulary::numLines() const
+{
+  return m_lineStart.size() - 1;
+}
+
+
+size_t Vocabulary::numTokens() const
+{
+  return m_ids.size();
+}
+
+
+size_t Vocabulary::numDistinct() const
+{
+  return m_entries.size();
+}
+
+
+void Vocabulary::appendLine(
+  const size_t lineNo,
+  const string& text,
+  string& out) const
+{
+  out += text + ";";
+
+  const size_t first = m_lineStart[lineNo];
+  const size_t last = m_lineStart[lineNo+1];
+  for (unsigned config = 0; config < VOCAB_CONFIGS; config++)
+  {
+    string main, alt;
+    for (size_t i = first; i < last; i++)
+    {
+      const Entry& entry = m_entries[m_ids[i]];
+      if (entry.main[config] != "")
+        main += entry.main[config] + " ";
+      if (entry.alt[config] != "")
+        alt += entry.alt[config] + " ";
+    }
+    if (main != "")
+      main.pop_back(); // Drop trailing space
+    if (alt != "")
+      alt.pop_back();
+    out += main + ";" + alt + ";";
+  }
+  out += "\n";
+}
+
+
+bool Vocabulary::writeVocabulary(const string& fname) const
+{
+  string text;
+  for (size_t i = 0; i < m_entries.size(); i++)
+  {
+    const Entry& entry = m_entries[i];
+    text += to_string(i) + ";" + entry.token + ";";
+    for (unsigned config = 0; config < VOCAB_CONFIGS; config++)
+      text += entry.main[config] + ";" + entry.alt[config] + ";";
+    text += "\n";
+  }
+  return writeFile(fname, text);
+}
+
+
+bool Vocabulary::writeIndex(const string& fname) const
+{
+  string text;
+  for (size_t l = 0; l+1 < m_lineStart.size(); l++)
+  {
+    for (size_t i = m_lineStart[l]; i < m_lineStart[l+1]; i++)
+    {
+      if (i > m_lineStart[l])
+        text += " ";
+      text += to_string(m_ids[i]);
+    }
+    text += "\n";
+  }
+  return writeFile(fname, text);
+}
+
@@ -0,0 +1,92 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// A vocabulary of the distinct normalized tokens in a set of lines.
+// Word lists and player lists repeat the same first and last names
+// over and over, so each distinct token is encoded only once, and the
+// keys are then fanned back out to every occurrence.
+
+#ifndef VOCABULARY_H
+#define VOCABULARY_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "Metaphone3.h"
+#include "NameTokenizer.h"
+
+using namespace std;
+
+// The four combinations of encodeVowels and encodeExact,
+// in the order of the driver output.
+#define VOCAB_CONFIGS 4
+
+
+class Vocabulary
+{
+  private:
+
+    struct Entry
+    {
+      string token;
+      string main[VOCAB_CONFIGS];
+      string alt[VOCAB_CONFIGS];
+    };
+
+    unordered_map<string, unsigned> m_lookup;
+
+    vector<Entry> m_entries;
+
+    // Index stream: the token numbers of line i are
+    // m_ids[m_lineStart[i] .. m_lineStart[i+1]-1].
+    vector<unsigned> m_ids;
+    vector<size_t> m_lineStart;
+
+    // Number of entries that have been encoded.
+    size_t m_numEncoded;
+
+
+    void addToken(
+      Metaphone3& mph,
+      const string_view token,
+      string& normal);
+
+  public:
+
+    Vocabulary();
+    ~Vocabulary();
+    void reset();
+
+    // Forgets the lines, but keeps the tokens and their keys.
+    void clearLines();
+
+    // Splits text on spaces (or with tokenizer, if given), normalizes
+    // each token and adds the line to the index stream.
+    void addLine(
+      Metaphone3& mph,
+      const string& text,
+      const NameTokenizer * tokenizer);
+
+    // Encodes the entries that are not yet encoded.
+    void encode(Metaphone3& mph);
+
+    size_t numLines() const;
+    size_t numTokens() const;
+    size_t numDistinct() const;
+
+    // Appends the same output line as encodeLine() would.
+    void appendLine(
+      const size_t lineNo,
+      const string& text,
+      string& out) const;
+
+    // Vocabulary file: "number;token;main;alt;..." per entry.
+    // Index file: the token numbers of each line.
+    bool writeVocabulary(const string& fname) const;
+    bool writeIndex(const string& fname) const;
+};
+
+#endif
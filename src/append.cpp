@@ -0,0 +1,120 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iostream>
+#include <sstream>
+#include <chrono>
+
+#include "append.h"
+#include "files.h"
+#include "IncrementalIndex.h"
+
+using namespace std::chrono;
+
+
+static void printRecords(
+  const IndexSnapshot& view,
+  const vector<uint32_t>& records,
+  stringstream& ss)
+{
+  for (auto r: records)
+    ss << "  " << r << ";" << view.getName(r) << "\n";
+}
+
+
+unsigned runAppend(const Options& options)
+{
+  PackedKey key = 0;
+  if (options.lookupKey != "" &&
+      ! packKeyOrdered(options.lookupKey, key))
+  {
+    cout << "Bad key " << options.lookupKey << "\n";
+    return 1;
+  }
+
+  vector<string> names;
+  for (auto& input: options.inputs)
+  {
+    vector<string> lines;
+    if (! readFile(input, lines))
+    {
+      cout << "File " << input << " not found\n";
+      return 1;
+    }
+    names.insert(names.end(), lines.begin(), lines.end());
+  }
+
+  NameTokenizer tokenizer;
+  if (options.names == NAMES_EVENT)
+    tokenizer.setEventNames();
+
+  IncrementalIndex index;
+  index.setTokenizer(options.names == NAMES_NONE ? nullptr : &tokenizer);
+
+  const auto start = steady_clock::now();
+  long long total = 0, longest = 0;
+  size_t numBatches = 0;
+  vector<string> batch;
+
+  for (size_t first = 0; first < names.size();
+      first += options.appendBatch)
+  {
+    const size_t last = min(first + options.appendBatch, names.size());
+    batch.assign(names.begin() + static_cast<long>(first),
+      names.begin() + static_cast<long>(last));
+
+    const auto batchStart = steady_clock::now();
+    index.add(batch);
+    const long long us = duration_cast<microseconds>(
+      steady_clock::now() - batchStart).count();
+    total += us;
+    longest = max(longest, us);
+    numBatches++;
+  }
+
+  const auto addMs = duration_cast<milliseconds>(
+    steady_clock::now() - start).count();
+  index.waitForMerges();
+  const auto allMs = duration_cast<milliseconds>(
+    steady_clock::now() - start).count();
+
+  const shared_ptr<const IndexSnapshot> view = index.snapshot();
+  stringstream ss;
+  ss << numBatches << " batches of up to " << options.appendBatch <<
+    " names:  " << (numBatches == 0 ? 0 : total /
+      static_cast<long long>(numBatches)) <<
+    " us on average, " << longest << " us at most\n";
+  ss << view->numNames() << " names in " << view->numSegments() <<
+    " segments after " << index.numMerges() << " merges, " <<
+    addMs << " ms to add, " << allMs << " ms with the merges\n";
+
+  Metaphone3 mph;
+  vector<uint32_t> records;
+  for (unsigned config = 0; config < INDEX_CONFIGS; config++)
+  {
+    if (options.lookupName == "" && options.lookupKey == "")
+      break;
+
+    ss << "\nvowels " << (config >= 2 ? 1 : 0) <<
+      ", exact " << (config & 1) << "\n";
+
+    if (options.lookupName != "")
+    {
+      view->lookupName(mph, options.lookupName, config, records);
+      ss << options.lookupName << ": " << records.size() << " records\n";
+      printRecords(* view, records, ss);
+    }
+
+    if (options.lookupKey != "")
+    {
+      view->lookupKey(config, key, records);
+      ss << options.lookupKey << ": " << records.size() << " records\n";
+      printRecords(* view, records, ss);
+    }
+  }
+
+  cout << ss.str();
+  return 0;
+}
@@ -0,0 +1,21 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifndef APPEND_H
+#define APPEND_H
+
+#include "args.h"
+
+using namespace std;
+
+
+// Feeds the names of the input files, in batches of options.appendBatch
+// as if each were a new event, to an IncrementalIndex, which merges
+// its segments in the background meanwhile.  Prints how long the
+// batches took, and then, like runLookup(), the records that match
+// options.lookupName or options.lookupKey.  Returns 0 on success.
+unsigned runAppend(const Options& options);
+
+#endif
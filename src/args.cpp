@@ -0,0 +1,461 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iostream>
+#include <cstdlib>
+
+#include "args.h"
+#include "KeyNeighbours.h"
+#include "PackedKey.h"
+#include "PhoneticKeys.h"
+#include "packs.h"
+
+
+struct OptEntry
+{
+  string shortName;
+  string longName;
+  unsigned numArgs;
+};
+
+static const vector<OptEntry> OPT_LIST =
+{
+  {"a", "append", 1},
+  {"A", "algorithms", 1},
+  {"b", "bloom", 1},
+  {"c", "config", 1},
+  {"d", "dedup", 0},
+  {"e", "distance", 1},
+  {"f", "missing", 1},
+  {"g", "cluster", 0},
+  {"h", "stats", 1},
+  {"i", "index", 1},
+  {"j", "join", 0},
+  {"k", "key", 1},
+  {"l", "lookup", 1},
+  {"m", "memory", 1},
+  {"M", "moby", 1},
+  {"n", "names", 1},
+  {"N", "noverify", 0},
+  {"o", "outdir", 1},
+  {"p", "prefix", 1},
+  {"P", "packs", 1},
+  {"q", "queries", 1},
+  {"r", "rank", 1},
+  {"R", "rules", 1},
+  {"s", "save", 1},
+  {"S", "spec", 1},
+  {"t", "threads", 1},
+  {"u", "dups", 0},
+  {"v", "validate", 1},
+  {"w", "vocab", 1},
+  {"x", "scan", 1},
+  {"y", "dict", 1},
+  {"z", "compress", 1}
+};
+
+
+void usage(const char base[])
+{
+  cout <<
+    "Usage: " << base << " [options] [input_file|directory ...]\n\n" <<
+    "With a single input file and no options, writes to stdout.\n" <<
+    "Inputs may be plain, gzip or zstd files.\n\n" <<
+    "-a, --append n     Add the names of the input files to an\n" <<
+    "                   incremental index in batches of n, as if each\n" <<
+    "                   batch were a new event, while it merges its\n" <<
+    "                   segments in the background.  Prints the time\n" <<
+    "                   per batch, and with -l or -k the matches.\n\n" <<
+    "-b, --bloom f      Print the names of file f that may be in some\n" <<
+    "                   of the input files (and directories), with\n" <<
+    "                   those lists.  A name is in a list if its main\n" <<
+    "                   or alternate keys (those of all tokens) agree\n" <<
+    "                   with those of a name there.  Each list x gets\n" <<
+    "                   a Bloom filter x.bloom, built again only when\n" <<
+    "                   x or the configuration changes.\n\n" <<
+    "-A, --algorithms l Instead of the Metaphone3 keys in all four\n" <<
+    "                   configurations, print those of configuration\n" <<
+    "                   -c next to the keys of the other algorithms in\n" <<
+    "                   the comma-separated list l (metaphone3,\n" <<
+    "                   dmetaphone, soundex, nysiis or all), from one\n" <<
+    "                   normalization of each token.\n\n" <<
+    "-c, --config n     Use configuration n for -A, -b, -g, -h, -j, -M,\n" <<
+    "                   -u, -x and -y, where n = 2 * encodeVowels +\n" <<
+    "                   encodeExact is 0 to 3 (default 0).\n\n" <<
+    "-d, --dedup        Encode each distinct token only once and fan\n" <<
+    "                   the keys back out to every occurrence.  The\n" <<
+    "                   output is the same, only faster on lists with\n" <<
+    "                   many repeated names.\n\n" <<
+    "-e, --distance d   With -k, also look up the keys within edit\n" <<
+    "                   distance d (1 or 2) of k.\n\n" <<
+    "-f, --missing n    With -l, also print the lines that lack the\n" <<
+    "                   keys of up to n of the tokens of the name\n" <<
+    "                   (such as a middle name).\n\n" <<
+    "-g, --cluster      Cluster the names of the single input file:\n" <<
+    "                   names are linked if their main or alternate\n" <<
+    "                   keys (those of all tokens) agree, and each\n" <<
+    "                   connected group is printed with its most\n" <<
+    "                   common name.\n\n" <<
+    "-h, --stats k      Estimate key statistics of the input files (and\n" <<
+    "                   directories) in constant memory:  the distinct\n" <<
+    "                   keys per configuration, the collision rate\n" <<
+    "                   when the keys are cut to each length, and the\n" <<
+    "                   k most frequent keys in configuration -c.\n\n" <<
+    "-i, --index f      Look up in the index file f (see -s) instead\n" <<
+    "                   of indexing an input file.\n\n" <<
+    "-j, --join         Find the players in more than one of the input\n" <<
+    "                   files (and directories):  pairs of names from\n" <<
+    "                   different files whose main keys agree for\n" <<
+    "                   every token.  Writes key;file;line;file;line\n" <<
+    "                   for each pair.  Uses an external merge sort.\n\n" <<
+    "-k, --key k        Like -l, but look up the key k (such as SM0).\n\n" <<
+    "-l, --lookup s     Index the single input file by key and print\n" <<
+    "                   the lines that share the keys of the name s,\n" <<
+    "                   for each configuration.\n\n" <<
+    "-m, --memory n     Sort at most n MB in memory for -j, and spill\n" <<
+    "                   the rest to temporary files (default 512).\n\n" <<
+    "-M, --moby f       Evaluate Metaphone3 against the pronunciations\n" <<
+    "                   of the Moby file f (mpron.txt).  Prints the\n" <<
+    "                   share of words whose keys agree with them in\n" <<
+    "                   each configuration, and for configuration -c\n" <<
+    "                   the agreement by rule and by letter.\n\n" <<
+    "-n, --names k      Split the names with the name tokenizer for\n" <<
+    "                   k = player (particles such as van der joined\n" <<
+    "                   onto the surname, numbers dropped) or k = event\n" <<
+    "                   (particles and numbers kept).  By default, split\n" <<
+    "                   on spaces like java/Metaphone3.jar.\n\n" <<
+    "-N, --noverify     With -i, do not verify the checksum of the\n" <<
+    "                   index file.  Opens faster on large files, as\n" <<
+    "                   the check reads the whole file.\n\n" <<
+    "-o, --outdir d     Batch mode: Encode every input file (and every\n" <<
+    "                   file in every input directory) and write one\n" <<
+    "                   output file per input to directory d.\n\n" <<
+    "-p, --prefix n     With -x, only compare the first n symbols of\n" <<
+    "                   the keys.\n\n" <<
+    "-P, --packs l      Encode the tokens of the input files (and\n" <<
+    "                   directories) with every rule pack of Metaphone3\n" <<
+    "                   on, with each pack in the comma-separated list\n" <<
+    "                   l (english, germanic, slavic, romance, french,\n" <<
+    "                   greek, translit or all) off, and with all of\n" <<
+    "                   them off.  Prints the time per token and the\n" <<
+    "                   keys that change.\n\n" <<
+    "-q, --queries f    With -r, rank the matches for each name in the\n" <<
+    "                   file f instead of for a single name.\n\n" <<
+    "-r, --rank k       With -l or -q, print the k names of the index\n" <<
+    "                   most like the name (Jaro-Winkler), among those\n" <<
+    "                   sharing keys with it in any configuration.\n\n" <<
+    "-R, --rules f      Count the rule hits of Metaphone3 on the tokens\n" <<
+    "                   of the input files (and directories), and put\n" <<
+    "                   the common rules first where the rule spec\n" <<
+    "                   proves that this gives the same keys.  Check\n" <<
+    "                   the new rule order against the source order on\n" <<
+    "                   the tokens, and with -S on the words made from\n" <<
+    "                   the spec as well.  If all keys agree, write f,\n" <<
+    "                   a Metaphone3Rules.h, and time both orders.\n\n" <<
+    "-s, --save f       Index the single input file by key and save\n" <<
+    "                   the index to f for later use with -i.\n\n" <<
+    "-S, --spec f       Compile the Metaphone3 rule spec f (such as\n" <<
+    "                   Metaphone3Spec.txt) into the header f ending\n" <<
+    "                   on .h, and write words made from the spec to\n" <<
+    "                   f ending on Probes.txt.  If this build has the\n" <<
+    "                   rules of f, validate those words and the input\n" <<
+    "                   files against golden output g (-v g, which\n" <<
+    "                   must then be a directory).  Otherwise build\n" <<
+    "                   again with the new header first.\n\n" <<
+    "-t, --threads n    Use n worker threads (default: one per core).\n\n" <<
+    "-u, --dups         Find candidate duplicates in the single input\n" <<
+    "                   file:  names whose main keys agree for every\n" <<
+    "                   token.  Prints each cluster with its size and\n" <<
+    "                   the line numbers of its names.\n\n" <<
+    "-v, --validate g   Compare the output for the input files against\n" <<
+    "                   golden output from java/Metaphone3.jar, which\n" <<
+    "                   may be compressed.  g is a file for a single\n" <<
+    "                   input, or else a directory holding x.gz, x.zst\n" <<
+    "                   or x for each input x.  Prints differing lines\n" <<
+    "                   with the rule trace.\n\n" <<
+    "-w, --vocab b      For a single input, write the distinct tokens\n" <<
+    "                   with their keys to b.vocab, and the token\n" <<
+    "                   numbers of each line to b.index, instead of\n" <<
+    "                   writing the keys of each line to stdout.\n\n" <<
+    "-x, --scan s       Print the lines of the single input file that\n" <<
+    "                   share a main or alternate token key with the\n" <<
+    "                   name s, found by a vector scan over all keys\n" <<
+    "                   rather than an index.  Also times the scan\n" <<
+    "                   against a plain loop.\n\n" <<
+    "-y, --dict f       Collect the distinct main and alternate keys\n" <<
+    "                   of the input files (and directories) into the\n" <<
+    "                   front-coded key dictionary f.  Without inputs,\n" <<
+    "                   open f instead.  With -k p, print the keys\n" <<
+    "                   that start with p.\n\n" <<
+    "-z, --compress f   Compress the output with f (gz or zst).  In\n" <<
+    "                   batch mode, the output names get .gz or .zst.\n" <<
+    endl;
+}
+
+
+static bool lookupOption(
+  const string& arg,
+  unsigned& no)
+{
+  string name;
+  if (arg.size() > 2 && arg[0] == '-' && arg[1] == '-')
+    name = arg.substr(2);
+  else if (arg.size() == 2 && arg[0] == '-')
+    name = arg.substr(1);
+  else
+    return false;
+
+  for (no = 0; no < OPT_LIST.size(); no++)
+  {
+    if (name == OPT_LIST[no].shortName || name == OPT_LIST[no].longName)
+      return true;
+  }
+  return false;
+}
+
+
+static bool parseUnsigned(
+  const string& text,
+  unsigned& value)
+{
+  if (text.empty())
+    return false;
+
+  char * end;
+  const unsigned long v = strtoul(text.c_str(), &end, 10);
+  if (*end != '\0')
+    return false;
+
+  value = static_cast<unsigned>(v);
+  return true;
+}
+
+
+void readArgs(
+  int argc,
+  char * argv[],
+  Options& options)
+{
+  options.inputs.clear();
+  options.outDir = "";
+  options.compress = COMPRESS_NONE;
+  options.golden = "";
+  options.dedup = false;
+  options.names = NAMES_NONE;
+  options.duplicates = false;
+  options.cluster = false;
+  options.join = false;
+  options.memoryMB = 512;
+  options.config = 0;
+  options.scanName = "";
+  options.dictFile = "";
+  options.bloomFile = "";
+  options.pronFile = "";
+  options.rulesFile = "";
+  options.rulePacks = 0;
+  options.specFile = "";
+  options.statsTop = 0;
+  options.algorithms = 0;
+  options.prefixLength = 0;
+  options.lookupName = "";
+  options.lookupKey = "";
+  options.distance = 0;
+  options.missing = 0;
+  options.rank = 0;
+  options.appendBatch = 0;
+  options.queryFile = "";
+  options.saveIndex = "";
+  options.indexFile = "";
+  options.verifyIndex = true;
+  options.vocabBase = "";
+  options.numThreads = 0;
+
+  for (int i = 1; i < argc; i++)
+  {
+    const string arg(argv[i]);
+    if (arg.empty() || arg[0] != '-')
+    {
+      options.inputs.push_back(arg);
+      continue;
+    }
+
+    unsigned no;
+    if (! lookupOption(arg, no))
+    {
+      cout << "Unknown option " << arg << "\n";
+      usage(argv[0]);
+      exit(0);
+    }
+
+    if (i + static_cast<int>(OPT_LIST[no].numArgs) >= argc)
+    {
+      cout << "Option " << arg << " needs an argument\n";
+      usage(argv[0]);
+      exit(0);
+    }
+
+    const string value(OPT_LIST[no].numArgs == 0 ? "" : argv[++i]);
+    const string& name = OPT_LIST[no].shortName;
+
+    if (name == "a")
+    {
+      if (! parseUnsigned(value, options.appendBatch) ||
+          options.appendBatch == 0)
+      {
+        cout << "Bad batch size " << value << "\n";
+        exit(0);
+      }
+    }
+    else if (name == "A")
+    {
+      if (! parseAlgorithms(value, options.algorithms))
+      {
+        cout << "Bad algorithm list " << value << "\n";
+        exit(0);
+      }
+    }
+    else if (name == "b")
+      options.bloomFile = value;
+    else if (name == "c")
+    {
+      if (! parseUnsigned(value, options.config) || options.config > 3)
+      {
+        cout << "Bad configuration " << value << "\n";
+        exit(0);
+      }
+    }
+    else if (name == "d")
+      options.dedup = true;
+    else if (name == "e")
+    {
+      if (! parseUnsigned(value, options.distance) ||
+          options.distance > NEIGHBOUR_MAX_DISTANCE)
+      {
+        cout << "Bad edit distance " << value << "\n";
+        exit(0);
+      }
+    }
+    else if (name == "f")
+    {
+      if (! parseUnsigned(value, options.missing))
+      {
+        cout << "Bad number of missing tokens " << value << "\n";
+        exit(0);
+      }
+    }
+    else if (name == "g")
+      options.cluster = true;
+    else if (name == "h")
+    {
+      if (! parseUnsigned(value, options.statsTop) || options.statsTop == 0)
+      {
+        cout << "Bad number of keys " << value << "\n";
+        exit(0);
+      }
+    }
+    else if (name == "i")
+      options.indexFile = value;
+    else if (name == "j")
+      options.join = true;
+    else if (name == "k")
+      options.lookupKey = value;
+    else if (name == "l")
+      options.lookupName = value;
+    else if (name == "m")
+    {
+      if (! parseUnsigned(value, options.memoryMB) || options.memoryMB == 0)
+      {
+        cout << "Bad memory size " << value << "\n";
+        exit(0);
+      }
+    }
+    else if (name == "M")
+      options.pronFile = value;
+    else if (name == "n")
+    {
+      if (value == "player")
+        options.names = NAMES_PLAYER;
+      else if (value == "event")
+        options.names = NAMES_EVENT;
+      else
+      {
+        cout << "Bad name kind " << value << "\n";
+        exit(0);
+      }
+    }
+    else if (name == "N")
+      options.verifyIndex = false;
+    else if (name == "o")
+      options.outDir = value;
+    else if (name == "p")
+    {
+      if (! parseUnsigned(value, options.prefixLength) ||
+          options.prefixLength == 0 ||
+          options.prefixLength > PACKED_KEY_MAX_LENGTH)
+      {
+        cout << "Bad prefix length " << value << "\n";
+        exit(0);
+      }
+    }
+    else if (name == "P")
+    {
+      if (! parseRulePacks(value, options.rulePacks))
+      {
+        cout << "Bad rule pack list " << value << "\n";
+        exit(0);
+      }
+    }
+    else if (name == "q")
+      options.queryFile = value;
+    else if (name == "r")
+    {
+      if (! parseUnsigned(value, options.rank) || options.rank == 0)
+      {
+        cout << "Bad rank count " << value << "\n";
+        exit(0);
+      }
+    }
+    else if (name == "R")
+      options.rulesFile = value;
+    else if (name == "s")
+      options.saveIndex = value;
+    else if (name == "S")
+      options.specFile = value;
+    else if (name == "u")
+      options.duplicates = true;
+    else if (name == "v")
+      options.golden = value;
+    else if (name == "w")
+      options.vocabBase = value;
+    else if (name == "x")
+      options.scanName = value;
+    else if (name == "y")
+      options.dictFile = value;
+    else if (name == "z")
+    {
+      if (! parseCompressFormat(value, options.compress))
+      {
+        cout << "Bad compression format " << value << "\n";
+        exit(0);
+      }
+#ifndef USE_ZSTD
+      if (options.compress == COMPRESS_ZSTD)
+      {
+        cout << "Compiled without zstd support (USE_ZSTD)\n";
+        exit(0);
+      }
+#endif
+    }
+    else if (name == "t")
+    {
+      if (! parseUnsigned(value, options.numThreads))
+      {
+        cout << "Bad thread count " << value << "\n";
+        exit(0);
+      }
+    }
+  }
+}
+
@@ -0,0 +1,134 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifndef ARGS_H
+#define ARGS_H
+
+#include <string>
+#include <vector>
+
+#include "files.h"
+
+using namespace std;
+
+enum NameMode
+{
+  NAMES_NONE = 0,
+  NAMES_PLAYER = 1,
+  NAMES_EVENT = 2
+};
+
+
+struct Options
+{
+  // Input files and/or directories, in command-line order.
+  vector<string> inputs;
+
+  // Output directory for per-file results (batch mode).
+  string outDir;
+
+  // Compression of the output.
+  CompressFormat compress;
+
+  // Golden file or directory to validate against.
+  string golden;
+
+  // Encode each distinct token only once.
+  bool dedup;
+
+  // Mask of phonetic algorithms to print (see PhoneticKeys.h), or 0
+  // for the Metaphone3 keys in all configurations.
+  unsigned algorithms;
+
+  // Split the names with a NameTokenizer (NAMES_NONE: on spaces).
+  NameMode names;
+
+  // Name or key to look up in an index of the input.
+  string lookupName;
+  string lookupKey;
+
+  // Also match the names that lack this many tokens of lookupName.
+  unsigned missing;
+
+  // Also look up the keys within this edit distance of lookupKey.
+  unsigned distance;
+
+  // With lookupName or queryFile, the number of best matches to rank
+  // instead (0: print the key matches).
+  unsigned rank;
+
+  // File of names to look up, one per line.
+  string queryFile;
+
+  // Add the inputs to an incremental index in batches of this many
+  // names (0: no incremental index).
+  unsigned appendBatch;
+
+  // Index file to write, or to look up in instead of the input.
+  string saveIndex;
+  string indexFile;
+
+  // Verify the checksum of indexFile when opening it.
+  bool verifyIndex;
+
+  // Find candidate duplicates within the input.
+  bool duplicates;
+
+  // Cluster the input by key collision.
+  bool cluster;
+
+  // Pair up the players that occur in more than one input.
+  bool join;
+
+  // Memory for the sorted runs of a join, in MB.
+  unsigned memoryMB;
+
+  // Name to match by scanning all keys of the input, and the number
+  // of key symbols to compare (0: all).
+  string scanName;
+  unsigned prefixLength;
+
+  // Key dictionary file to write from the inputs, or to open.
+  string dictFile;
+
+  // Print statistics of the keys of the inputs, with this many of the
+  // most frequent keys (0: no statistics).
+  unsigned statsTop;
+
+  // File of new names to screen against the inputs with Bloom filters.
+  string bloomFile;
+
+  // Moby pronunciation file (mpron.txt) to evaluate Metaphone3 against.
+  string pronFile;
+
+  // Metaphone3Rules.h to generate from the rule hits on the inputs.
+  string rulesFile;
+
+  // Mask of rule packs (see Metaphone3.h) whose cost and effect to
+  // report on the inputs, or 0.
+  unsigned rulePacks;
+
+  // Rule spec (Metaphone3Spec.txt) to compile and check.
+  string specFile;
+
+  // Configuration (2 * encodeVowels + encodeExact) for joins.
+  unsigned config;
+
+  // Base name for vocabulary and index files.
+  string vocabBase;
+
+  // Number of worker threads (0: one per hardware thread).
+  unsigned numThreads;
+};
+
+
+void usage(const char base[]);
+
+void readArgs(
+  int argc,
+  char * argv[],
+  Options& options);
+
+#endif
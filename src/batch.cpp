@@ -0,0 +1,103 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iostream>
+#include <sstream>
+#include <filesystem>
+#include <mutex>
+#include <set>
+
+#include "batch.h"
+#include "files.h"
+#include "encode.h"
+#include "Scheduler.h"
+
+namespace fs = std::filesystem;
+
+
+unsigned runBatch(const Options& options)
+{
+  vector<InputFile> files;
+  if (! expandInputs(options.inputs, files))
+    return 1;
+
+  // Two inputs with the same name would race for one output file.
+  // Output names drop any compression suffix of the input.
+  set<string> bases;
+  vector<string> outNames;
+  for (auto& f: files)
+  {
+    const string base = stripCompressSuffix(f.base);
+    if (! bases.insert(base).second)
+    {
+      cout << "Input name " << base << " occurs more than once\n";
+      return 1;
+    }
+    outNames.push_back((fs::path(options.outDir) /
+      (base + compressSuffix(options.compress))).string());
+  }
+
+  error_code ec;
+  fs::create_directories(options.outDir, ec);
+  if (! fs::is_directory(options.outDir, ec))
+  {
+    cout << "Cannot create directory " << options.outDir << "\n";
+    return 1;
+  }
+
+  Scheduler scheduler;
+  scheduler.setThreads(options.numThreads);
+
+  // One encoder per thread, as Metaphone3 keeps per-word state.
+  vector<Metaphone3> encoders(scheduler.getThreads());
+
+  // The tokenizer is const after setup and shared by all threads.
+  NameTokenizer tokenizer;
+  if (options.names == NAMES_EVENT)
+    tokenizer.setEventNames();
+  const NameTokenizer * tokenizerPtr =
+    (options.names == NAMES_NONE ? nullptr : &tokenizer);
+
+  vector<size_t> weights;
+  for (auto& f: files)
+    weights.push_back(f.size);
+
+  mutex mtxOut;
+  unsigned numErrors = 0;
+
+  scheduler.run(weights, [&](size_t job, unsigned thrNo)
+  {
+    const InputFile& in = files[job];
+
+    // Decompression and compression run on their own threads.
+    LineReader reader;
+    LineWriter writer;
+    size_t numLines = 0;
+    bool ok = reader.open(in.name) &&
+      writer.open(outNames[job], options.compress);
+    if (ok)
+    {
+      numLines = encodeStream(encoders[thrNo], reader, writer,
+        options.dedup, tokenizerPtr);
+      ok = reader.close();
+      ok = writer.close() && ok;
+    }
+
+    // Report whole lines, so the output of threads does not mix.
+    stringstream ss;
+    if (ok)
+      ss << in.base << ": " << numLines << " lines\n";
+    else
+      ss << "File " << in.name << " failed\n";
+
+    lock_guard<mutex> lck(mtxOut);
+    cout << ss.str();
+    if (! ok)
+      numErrors++;
+  });
+
+  return numErrors;
+}
+
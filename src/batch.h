@@ -0,0 +1,19 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "args.h"
+
+using namespace std;
+
+
+// Encodes every input file on a thread pool and writes the results
+// to one output file per input in options.outDir.
+// Returns the number of files that failed.
+unsigned runBatch(const Options& options);
+
+#endif
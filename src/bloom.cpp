@@ -0,0 +1,253 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <filesystem>
+#include <algorithm>
+#include <memory>
+#include <chrono>
+
+#include "bloom.h"
+#include "files.h"
+#include "encode.h"
+#include "PhoneticIndex.h"
+#include "BloomFilter.h"
+#include "Scheduler.h"
+
+namespace fs = std::filesystem;
+using namespace std::chrono;
+
+// Names per encoding or probing job.
+#define BLOOM_CHUNK 4096
+
+// The suffix of the filter file of a list.
+#define BLOOM_SUFFIX ".bloom"
+
+
+// Sets hashes[2r] and hashes[2r+1] to the hashes of the main and the
+// alternate key sequence of name r.  The alternate one is 0 if it is
+// the main one, and both are 0 if the name has no keys.
+static void hashNames(
+  const Options& options,
+  const vector<string>& names,
+  vector<uint64_t>& hashes)
+{
+  NameTokenizer tokenizer;
+  if (options.names == NAMES_EVENT)
+    tokenizer.setEventNames();
+  const NameTokenizer * tok =
+    (options.names == NAMES_NONE ? nullptr : &tokenizer);
+
+  const size_t n = names.size();
+  const size_t numChunks = (n + BLOOM_CHUNK - 1) / BLOOM_CHUNK;
+  hashes.assign(2 * n, 0);
+
+  Scheduler scheduler;
+  scheduler.setThreads(options.numThreads);
+  vector<Metaphone3> encoders(scheduler.getThreads());
+
+  scheduler.run(vector<size_t>(numChunks, 1), [&](size_t chunk,
+    unsigned thrNo)
+  {
+    Metaphone3& mph = encoders[thrNo];
+    setIndexConfig(mph, options.config);
+
+    PackedKey mains[NAME_MAX_TOKENS], alts[NAME_MAX_TOKENS];
+    const size_t first = chunk * BLOOM_CHUNK;
+    const size_t last = min(first + BLOOM_CHUNK, n);
+
+    for (size_t r = first; r < last; r++)
+    {
+      const size_t numKeys = encodeTokenKeys(mph, names[r], tok,
+        mains, alts, NAME_MAX_TOKENS);
+      if (numKeys == 0)
+        continue;
+
+      bool differs = false;
+      for (size_t i = 0; i < numKeys; i++)
+      {
+        if (alts[i] == 0)
+          alts[i] = mains[i];
+        else if (alts[i] != mains[i])
+          differs = true;
+      }
+
+      hashes[2*r] = packedKeysHash(mains, numKeys);
+      if (differs)
+        hashes[2*r + 1] = packedKeysHash(alts, numKeys);
+    }
+  });
+}
+
+
+static bool sourceOf(
+  const Options& options,
+  const InputFile& file,
+  BloomSource& source)
+{
+  error_code ec;
+  const auto time = fs::last_write_time(file.name, ec);
+  if (ec)
+    return false;
+
+  source.size = file.size;
+  source.time = static_cast<int64_t>(time.time_since_epoch().count());
+  source.config = options.config;
+  source.names = static_cast<uint32_t>(options.names);
+  return true;
+}
+
+
+// Opens the filter of a list, or builds and saves it if it is missing
+// or stale.  built says which.
+static bool loadFilter(
+  const Options& options,
+  const InputFile& file,
+  BloomFilter& filter,
+  bool& built)
+{
+  BloomSource source;
+  if (! sourceOf(options, file, source))
+  {
+    cout << "File " << file.name << " not found\n";
+    return false;
+  }
+
+  const string fname = file.name + BLOOM_SUFFIX;
+  built = false;
+  if (filter.open(fname, false) && filter.builtFrom(source))
+    return true;
+
+  vector<string> names;
+  if (! readFile(file.name, names))
+  {
+    cout << "File " << file.name << " not found\n";
+    return false;
+  }
+
+  vector<uint64_t> hashes;
+  hashNames(options, names, hashes);
+  hashes.erase(remove(hashes.begin(), hashes.end(), 0), hashes.end());
+
+  filter.build(hashes, source);
+  if (! filter.save(fname))
+  {
+    cout << "Cannot write " << fname << "\n";
+    return false;
+  }
+  built = true;
+  return true;
+}
+
+
+unsigned runBloom(const Options& options)
+{
+  vector<InputFile> all, files;
+  if (! expandInputs(options.inputs, all))
+    return 1;
+
+  // Directories hold the filters next to the lists.
+  const string suffix = BLOOM_SUFFIX;
+  for (auto& file: all)
+  {
+    if (file.name.size() < suffix.size() ||
+        file.name.compare(file.name.size() - suffix.size(),
+          suffix.size(), suffix) != 0)
+      files.push_back(file);
+  }
+
+  const auto startLoad = steady_clock::now();
+  vector<unique_ptr<BloomFilter>> filters;
+  size_t numBuilt = 0, filterBytes = 0;
+  for (auto& file: files)
+  {
+    filters.emplace_back(new BloomFilter);
+    bool built;
+    if (! loadFilter(options, file, * filters.back(), built))
+      return 1;
+    numBuilt += (built ? 1 : 0);
+    filterBytes += filters.back()->numBytes();
+  }
+  const auto msLoad = duration_cast<milliseconds>(
+    steady_clock::now() - startLoad).count();
+
+  vector<string> names;
+  if (! readFile(options.bloomFile, names))
+  {
+    cout << "File " << options.bloomFile << " not found\n";
+    return 1;
+  }
+
+  vector<uint64_t> hashes;
+  hashNames(options, names, hashes);
+
+  // Per job, (name, list) for each list that a name may be in.
+  const size_t n = names.size();
+  const size_t numChunks = (n + BLOOM_CHUNK - 1) / BLOOM_CHUNK;
+  vector<vector<pair<uint32_t, uint32_t>>> hits(numChunks);
+
+  Scheduler scheduler;
+  scheduler.setThreads(options.numThreads);
+
+  const auto startProbe = steady_clock::now();
+  scheduler.run(vector<size_t>(numChunks, 1), [&](size_t chunk,
+    unsigned)
+  {
+    const size_t first = chunk * BLOOM_CHUNK;
+    const size_t last = min(first + BLOOM_CHUNK, n);
+    for (size_t r = first; r < last; r++)
+    {
+      const uint64_t hm = hashes[2*r], ha = hashes[2*r + 1];
+      if (hm == 0)
+        continue;
+      for (size_t f = 0; f < filters.size(); f++)
+      {
+        if (filters[f]->mayContain(hm) ||
+            (ha != 0 && filters[f]->mayContain(ha)))
+          hits[chunk].emplace_back(static_cast<uint32_t>(r),
+            static_cast<uint32_t>(f));
+      }
+    }
+  });
+  const long long nsProbe = duration_cast<nanoseconds>(
+    steady_clock::now() - startProbe).count();
+
+  stringstream ss;
+  size_t numHit = 0;
+  for (auto& part: hits)
+  {
+    for (size_t i = 0; i < part.size(); i++)
+    {
+      const uint32_t r = part[i].first;
+      const bool firstList = (i == 0 || part[i-1].first != r);
+      if (firstList)
+      {
+        ss << (numHit == 0 ? "" : "\n") << r + 1 << ";" <<
+          names[r] << ";";
+        numHit++;
+      }
+      else
+        ss << ",";
+      ss << files[part[i].second].base;
+    }
+  }
+  if (numHit > 0)
+    ss << "\n";
+
+  ss << files.size() << " lists, " << numBuilt <<
+    " filters built, " << files.size() - numBuilt << " reused (" <<
+    filterBytes << " bytes) in " << msLoad << " ms\n";
+  ss << n << " names, " << n - numHit << " in no list, " << numHit <<
+    " possibly in some\n";
+  if (n > 0 && ! files.empty())
+    ss << fixed << setprecision(1) << static_cast<double>(nsProbe) /
+      (n * files.size()) << " ns per name and list, " <<
+      static_cast<double>(nsProbe) / n << " ns per name\n";
+
+  cout << ss.str();
+  return 0;
+}
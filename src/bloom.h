@@ -0,0 +1,23 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifndef BLOOM_H
+#define BLOOM_H
+
+#include "args.h"
+
+using namespace std;
+
+
+// Screens the names of options.bloomFile against the input files (and
+// directories), the existing lists, in configuration options.config.
+// Each list x has a BloomFilter over the key sequences of its names in
+// x.bloom, which is built (and saved) if it is missing or stale.
+// Prints line;name;lists for each new name that may be in some lists,
+// and how many names were told apart by the filters alone.  Returns 0
+// on success.
+unsigned runBloom(const Options& options);
+
+#endif
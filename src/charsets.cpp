@@ -282,7 +282,7 @@ void setCharTables(
 
 
 void convertToUpper(
-  const string& textIn,
+  const string_view textIn,
   string& textOut,
   const CharTables& charTables)
 {
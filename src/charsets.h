@@ -7,6 +7,7 @@
 #define CHARSETS_H
 
 #include <string>
+#include <string_view>
 // #include <vector>
 
 using namespace std;
@@ -30,7 +31,7 @@ void setCharTables(
   CharTables& tablesExtend);
 
 void convertToUpper(
-  const string& textIn,
+  const string_view textIn,
   string& textOut,
   const CharTables& charTables);
 
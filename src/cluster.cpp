@@ -0,0 +1,240 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+
+#include "cluster.h"
+#include "files.h"
+#include "encode.h"
+#include "PhoneticIndex.h"
+#include "RadixSort.h"
+#include "UnionFind.h"
+#include "Scheduler.h"
+
+using namespace std::chrono;
+
+// Names per encoding job, and items per linking job.
+#define CLUSTER_CHUNK 4096
+#define CLUSTER_LINK_CHUNK 65536
+
+
+// Items 2r and 2r+1 get the hashes of the main and the alternate key
+// of name r.  Items that are not needed (no keys, or an alternate key
+// that is the main key) get source 0, the others 1.  The keys are
+// only compared by their 64-bit hashes.
+static void encodeNames(
+  const Options& options,
+  const vector<string>& names,
+  vector<KeyRecord>& items)
+{
+  NameTokenizer tokenizer;
+  if (options.names == NAMES_EVENT)
+    tokenizer.setEventNames();
+  const NameTokenizer * tok =
+    (options.names == NAMES_NONE ? nullptr : &tokenizer);
+
+  const size_t n = names.size();
+  const size_t numChunks = (n + CLUSTER_CHUNK - 1) / CLUSTER_CHUNK;
+  items.resize(2 * n);
+
+  Scheduler scheduler;
+  scheduler.setThreads(options.numThreads);
+  vector<Metaphone3> encoders(scheduler.getThreads());
+
+  scheduler.run(vector<size_t>(numChunks, 1), [&](size_t chunk,
+    unsigned thrNo)
+  {
+    Metaphone3& mph = encoders[thrNo];
+    setIndexConfig(mph, options.config);
+
+    PackedKey mains[NAME_MAX_TOKENS], alts[NAME_MAX_TOKENS];
+    const size_t first = chunk * CLUSTER_CHUNK;
+    const size_t last = min(first + CLUSTER_CHUNK, n);
+
+    for (size_t r = first; r < last; r++)
+    {
+      const size_t numKeys = encodeTokenKeys(mph, names[r], tok,
+        mains, alts, NAME_MAX_TOKENS);
+
+      bool hasAlt = false;
+      for (size_t i = 0; i < numKeys; i++)
+      {
+        if (alts[i] == 0)
+          alts[i] = mains[i];
+        else if (alts[i] != mains[i])
+          hasAlt = true;
+      }
+
+      const uint32_t record = static_cast<uint32_t>(r);
+      items[2*r] = {packedKeysHash(mains, numKeys), record,
+        numKeys > 0 ? 1u : 0u};
+      items[2*r + 1] = {packedKeysHash(alts, numKeys), record,
+        hasAlt ? 1u : 0u};
+    }
+  });
+
+  items.erase(remove_if(items.begin(), items.end(),
+    [](const KeyRecord& item)
+  {
+    return item.source == 0;
+  }), items.end());
+}
+
+
+// Links the records of equal adjacent keys.
+static void linkRecords(
+  const Options& options,
+  const vector<KeyRecord>& items,
+  UnionFind& sets)
+{
+  const size_t numChunks =
+    (items.size() + CLUSTER_LINK_CHUNK - 1) / CLUSTER_LINK_CHUNK;
+
+  Scheduler scheduler;
+  scheduler.setThreads(options.numThreads);
+  scheduler.run(vector<size_t>(numChunks, 1), [&](size_t chunk, unsigned)
+  {
+    const size_t first = max(chunk * CLUSTER_LINK_CHUNK,
+      static_cast<size_t>(1));
+    const size_t last = min((chunk + 1) * CLUSTER_LINK_CHUNK,
+      items.size());
+    for (size_t i = first; i < last; i++)
+    {
+      if (items[i].key == items[i-1].key)
+        sets.unite(items[i].record, items[i-1].record);
+    }
+  });
+}
+
+
+// The most common name of the members, the first one for a tie.
+static string_view representative(
+  const vector<string_view>& lines,
+  const KeyRecord * members,
+  const size_t numMembers)
+{
+  vector<pair<string_view, uint32_t>> byName(numMembers);
+  for (size_t i = 0; i < numMembers; i++)
+    byName[i] = {lines[members[i].record], members[i].record};
+  sort(byName.begin(), byName.end());
+
+  string_view best;
+  size_t bestCount = 0;
+  uint32_t bestFirst = 0;
+  size_t i = 0;
+  while (i < byName.size())
+  {
+    size_t j = i + 1;
+    while (j < byName.size() && byName[j].first == byName[i].first)
+      j++;
+    if (j - i > bestCount ||
+        (j - i == bestCount && byName[i].second < bestFirst))
+    {
+      best = byName[i].first;
+      bestCount = j - i;
+      bestFirst = byName[i].second;
+    }
+    i = j;
+  }
+  return best;
+}
+
+
+unsigned runCluster(const Options& options)
+{
+  vector<string> names;
+  if (! readFile(options.inputs[0], names))
+  {
+    cout << "File " << options.inputs[0] << " not found\n";
+    return 1;
+  }
+
+  const auto start = steady_clock::now();
+
+  vector<KeyRecord> items;
+  encodeNames(options, names, items);
+  radixSort(items, options.numThreads);
+
+  UnionFind sets;
+  sets.init(names.size());
+  linkRecords(options, items, sets);
+  vector<KeyRecord>().swap(items);
+
+  // Group the records by their root.  The sort is stable, so the
+  // members of a cluster stay in line order.
+  vector<KeyRecord> members(names.size());
+  Scheduler scheduler;
+  scheduler.setThreads(options.numThreads);
+  const size_t numChunks =
+    (names.size() + CLUSTER_LINK_CHUNK - 1) / CLUSTER_LINK_CHUNK;
+  scheduler.run(vector<size_t>(numChunks, 1), [&](size_t chunk, unsigned)
+  {
+    const size_t first = chunk * CLUSTER_LINK_CHUNK;
+    const size_t last = min(first + CLUSTER_LINK_CHUNK, names.size());
+    for (size_t r = first; r < last; r++)
+      members[r] = {sets.find(static_cast<uint32_t>(r)),
+        static_cast<uint32_t>(r), 0};
+  });
+  radixSort(members, options.numThreads);
+
+  struct Cluster
+  {
+    size_t first;
+    size_t last;
+  };
+  vector<Cluster> clusters;
+  for (size_t i = 0; i < members.size(); )
+  {
+    size_t j = i + 1;
+    while (j < members.size() && members[j].key == members[i].key)
+      j++;
+    if (j - i >= 2)
+      clusters.push_back({i, j});
+    i = j;
+  }
+
+  // Largest clusters first, then in order of their first line.
+  sort(clusters.begin(), clusters.end(),
+    [&](const Cluster& a, const Cluster& b)
+  {
+    if (a.last - a.first != b.last - b.first)
+      return a.last - a.first > b.last - b.first;
+    return members[a.first].record < members[b.first].record;
+  });
+
+  vector<string_view> lines(names.size());
+  for (size_t r = 0; r < names.size(); r++)
+  {
+    lines[r] = names[r];
+    if (! lines[r].empty() && lines[r].back() == '\r')
+      lines[r].remove_suffix(1);
+  }
+
+  stringstream ss;
+  size_t numClustered = 0;
+  for (auto& c: clusters)
+  {
+    const size_t size = c.last - c.first;
+    numClustered += size;
+    ss << size << ";" <<
+      representative(lines, members.data() + c.first, size) << "\n";
+    for (size_t k = c.first; k < c.last; k++)
+    {
+      const uint32_t r = members[k].record;
+      ss << "  " << r + 1 << ";" << lines[r] << "\n";
+    }
+  }
+
+  const auto ms = duration_cast<milliseconds>(
+    steady_clock::now() - start).count();
+
+  ss << names.size() << " names, " << clusters.size() <<
+    " clusters with " << numClustered << " names, " << ms << " ms\n";
+  cout << ss.str();
+  return 0;
+}
@@ -0,0 +1,24 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifndef CLUSTER_H
+#define CLUSTER_H
+
+#include "args.h"
+
+using namespace std;
+
+
+// Clusters the names of the single input file by key collision, as
+// in OpenRefine:  a name has a main key (the main keys of its tokens)
+// and an alternate key (the alternate keys of its tokens, or the main
+// ones where there are none) in configuration options.config, and two
+// names are linked if any of these keys agree.  The clusters are the
+// connected components, found with a parallel union-find.  Prints the
+// clusters of two or more names, largest first, each with its most
+// common name as representative.  Returns 0 on success.
+unsigned runCluster(const Options& options);
+
+#endif
@@ -0,0 +1,202 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+
+#include "dict.h"
+#include "files.h"
+#include "encode.h"
+#include "PhoneticIndex.h"
+#include "KeyDictionary.h"
+#include "Scheduler.h"
+
+using namespace std::chrono;
+
+// Names per encoding job.
+#define DICT_CHUNK 4096
+
+// Each prefix query is timed this often, and the best time counts.
+#define DICT_REPEATS 10
+
+
+// Adds the distinct keys of names to keys, which stays sorted and
+// distinct.
+static void collectKeys(
+  const Options& options,
+  const vector<string>& names,
+  vector<PackedKey>& keys)
+{
+  NameTokenizer tokenizer;
+  if (options.names == NAMES_EVENT)
+    tokenizer.setEventNames();
+  const NameTokenizer * tok =
+    (options.names == NAMES_NONE ? nullptr : &tokenizer);
+
+  const size_t numChunks = (names.size() + DICT_CHUNK - 1) / DICT_CHUNK;
+  vector<vector<PackedKey>> parts(numChunks);
+
+  Scheduler scheduler;
+  scheduler.setThreads(options.numThreads);
+  vector<Metaphone3> encoders(scheduler.getThreads());
+
+  scheduler.run(vector<size_t>(numChunks, 1), [&](size_t chunk,
+    unsigned thrNo)
+  {
+    Metaphone3& mph = encoders[thrNo];
+    setIndexConfig(mph, options.config);
+
+    PackedKey mains[NAME_MAX_TOKENS], alts[NAME_MAX_TOKENS];
+    const size_t first = chunk * DICT_CHUNK;
+    const size_t last = min(first + DICT_CHUNK, names.size());
+    vector<PackedKey>& part = parts[chunk];
+
+    for (size_t r = first; r < last; r++)
+    {
+      const size_t n = encodeTokenKeys(mph, names[r], tok,
+        mains, alts, NAME_MAX_TOKENS);
+      part.insert(part.end(), mains, mains + n);
+      for (size_t i = 0; i < n; i++)
+        if (alts[i] != 0)
+          part.push_back(alts[i]);
+    }
+    sort(part.begin(), part.end());
+    part.erase(unique(part.begin(), part.end()), part.end());
+  });
+
+  for (auto& part: parts)
+    keys.insert(keys.end(), part.begin(), part.end());
+  sort(keys.begin(), keys.end());
+  keys.erase(unique(keys.begin(), keys.end()), keys.end());
+}
+
+
+static unsigned buildDict(
+  const Options& options,
+  KeyDictionary& dict)
+{
+  vector<InputFile> files;
+  if (! expandInputs(options.inputs, files))
+    return 1;
+
+  const auto start = steady_clock::now();
+  vector<PackedKey> packed;
+  size_t numNames = 0;
+  for (auto& file: files)
+  {
+    vector<string> names;
+    if (! readFile(file.name, names))
+    {
+      cout << "File " << file.name << " not found\n";
+      return 1;
+    }
+    numNames += names.size();
+    collectKeys(options, names, packed);
+  }
+
+  // Ordered packed keys sort like their strings.
+  vector<string> keys(packed.size());
+  for (size_t i = 0; i < packed.size(); i++)
+    unpackKeyOrdered(packed[i], keys[i]);
+  if (! dict.build(keys))
+  {
+    cout << "Cannot build the key dictionary\n";
+    return 1;
+  }
+  const auto ms = duration_cast<milliseconds>(
+    steady_clock::now() - start).count();
+  cout << numNames << " names in " << files.size() <<
+    " files, collected in " << ms << " ms\n";
+
+  if (! dict.save(options.dictFile))
+  {
+    cout << "Cannot write " << options.dictFile << "\n";
+    return 1;
+  }
+  cout << "Dictionary saved to " << options.dictFile << "\n";
+  return 0;
+}
+
+
+// The best time of DICT_REPEATS runs of fn.
+template<class Fn>
+static long long timeBest(Fn fn)
+{
+  long long best = 0;
+  for (unsigned rep = 0; rep < DICT_REPEATS; rep++)
+  {
+    const auto start = steady_clock::now();
+    fn();
+    const long long ns = duration_cast<nanoseconds>(
+      steady_clock::now() - start).count();
+    if (rep == 0 || ns < best)
+      best = ns;
+  }
+  return best;
+}
+
+
+unsigned runDict(const Options& options)
+{
+  KeyDictionary dict;
+  if (! options.inputs.empty())
+  {
+    if (buildDict(options, dict) != 0)
+      return 1;
+  }
+  else if (! dict.open(options.dictFile, true))
+  {
+    cout << "Dictionary file " << options.dictFile <<
+      " is missing, damaged or of another version\n";
+    return 1;
+  }
+
+  // The same keys as a plain array:  a pool and an offset per key.
+  vector<string> all;
+  dict.prefixRange("", all);
+  size_t plainBytes = all.size() * sizeof(uint32_t);
+  for (auto& k: all)
+    plainBytes += k.size();
+
+  stringstream ss;
+  ss << dict.numKeys() << " distinct keys:  " << dict.numBytes() <<
+    " bytes front-coded, " << plainBytes << " bytes as a plain array\n";
+
+  if (options.lookupKey != "")
+  {
+    const string& prefix = options.lookupKey;
+    vector<string> keys, scanned;
+    const long long ns = timeBest([&]()
+    {
+      keys.clear();
+      dict.prefixRange(prefix, keys);
+    });
+    const long long nsScan = timeBest([&]()
+    {
+      scanned.clear();
+      for (auto& k: all)
+        if (k.compare(0, prefix.size(), prefix) == 0)
+          scanned.push_back(k);
+    });
+
+    if (keys != scanned)
+    {
+      cout << "The dictionary and the scan differ\n";
+      return 1;
+    }
+
+    ss << prefix << ": " << keys.size() << " keys, " << fixed <<
+      setprecision(1) << ns / 1000. << " us, against " <<
+      nsScan / 1000. << " us for a scan of all keys\n";
+    for (auto& k: keys)
+      ss << "  " << k << "\n";
+  }
+
+  cout << ss.str();
+  return 0;
+}
@@ -0,0 +1,23 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifndef DICT_H
+#define DICT_H
+
+#include "args.h"
+
+using namespace std;
+
+
+// Collects the distinct main and alternate token keys of all input
+// files (and directories) in configuration options.config into a
+// KeyDictionary, saved to options.dictFile, or opens that file if
+// there are no inputs.  Prints its size against a plain array of the
+// keys.  With options.lookupKey, also prints the keys with that
+// prefix, and times the prefix query against a scan of all the keys.
+// Returns 0 on success.
+unsigned runDict(const Options& options);
+
+#endif
@@ -0,0 +1,295 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <algorithm>
+#include <sstream>
+#include <chrono>
+
+#include "encode.h"
+#include "Vocabulary.h"
+#include "PhoneticIndex.h"
+#include "Scheduler.h"
+
+using namespace std::chrono;
+
+// Tokens per parallel job of timeAllConfigs() and compareAllConfigs().
+#define ENCODE_CHUNK 4096
+
+
+// tokenize splits a string into tokens separated by delimiter.
+// http://stackoverflow.com/questions/236129/split-a-string-in-c
+
+void tokenize(
+  const string& text,
+  vector<string>& tokens,
+  const string& delimiters)
+{
+  string::size_type pos, lastPos = 0;
+
+  while (true)
+  {
+    pos = text.find_first_of(delimiters, lastPos);
+    if (pos == std::string::npos)
+    {
+      pos = text.length();
+      tokens.push_back(string(text.data()+lastPos,
+        static_cast<string::size_type>(pos - lastPos)));
+      break;
+    }
+    else
+    {
+      tokens.push_back(string(text.data()+lastPos,
+        static_cast<string::size_type>(pos - lastPos)));
+    }
+    lastPos = pos + 1;
+  }
+}
+
+
+void encodeLine(
+  Metaphone3& mph,
+  const string& text,
+  string& out,
+  const NameTokenizer * tokenizer)
+{
+  out += text + ";";
+  vector<string> tokens;
+  NameToken names[NAME_MAX_TOKENS];
+  char buf[NAME_MAX_TOKEN];
+  size_t numTokens;
+  if (tokenizer)
+    numTokens = tokenizer->split(text, names, NAME_MAX_TOKENS);
+  else
+  {
+    tokenize(text, tokens, " ");
+    numTokens = tokens.size();
+  }
+
+  for (bool encodeVowels: {false, true})
+  {
+    mph.setEncodeVowels(encodeVowels);
+    for (bool encodeExact: {false, true})
+    {
+      mph.setEncodeExact(encodeExact);
+
+      string main, alt;
+      for (size_t i = 0; i < numTokens; i++)
+      {
+        if (tokenizer)
+          mph.setWord(tokenizer->compact(names[i], buf));
+        else
+          mph.setWord(tokens[i]);
+        mph.encode();
+
+        string x = mph.getMetaph();
+        if (x != "")
+          main += x + " ";
+        x = mph.getAlternateMetaph();
+        if (x != "")
+          alt += x + " ";
+      }
+      if (main != "")
+        main.pop_back(); // Drop trailing space
+      if (alt != "")
+        alt.pop_back();
+      out += main + ";" + alt + ";";
+    }
+  }
+  out += "\n";
+}
+
+
+void setIndexConfig(
+  Metaphone3& mph,
+  const unsigned config)
+{
+  mph.setEncodeVowels(config >= 2);
+  mph.setEncodeExact((config & 1) != 0);
+}
+
+
+void encodeAllConfigs(
+  Metaphone3& mph,
+  const string& token,
+  string& normal,
+  string keys[])
+{
+  mph.normalize(token, normal);
+  for (unsigned c = 0; c < INDEX_CONFIGS; c++)
+  {
+    setIndexConfig(mph, c);
+    mph.setNormalizedWord(normal);
+    mph.encode();
+    if (keys)
+    {
+      keys[2*c] = mph.getMetaph();
+      keys[2*c+1] = mph.getAlternateMetaph();
+    }
+  }
+}
+
+
+double timeAllConfigs(
+  Scheduler& scheduler,
+  vector<Metaphone3>& encoders,
+  const vector<string>& tokens)
+{
+  const size_t numChunks = (tokens.size() + ENCODE_CHUNK - 1) /
+    ENCODE_CHUNK;
+  vector<string> normals(encoders.size());
+
+  const auto start = steady_clock::now();
+  scheduler.run(vector<size_t>(numChunks, 1), [&](size_t chunk,
+    unsigned thrNo)
+  {
+    const size_t first = chunk * ENCODE_CHUNK;
+    const size_t last = min(first + ENCODE_CHUNK, tokens.size());
+    for (size_t i = first; i < last; i++)
+      encodeAllConfigs(encoders[thrNo], tokens[i], normals[thrNo],
+        nullptr);
+  });
+  return duration<double, nano>(steady_clock::now() - start).count();
+}
+
+
+static void compareChunk(
+  Metaphone3& mph,
+  Metaphone3& reference,
+  const vector<string>& tokens,
+  const size_t first,
+  const size_t last,
+  const size_t maxReported,
+  KeyDiffs& diffs)
+{
+  string normal;
+  string mk[2 * INDEX_CONFIGS], rk[2 * INDEX_CONFIGS];
+  stringstream ss;
+  diffs.numKeys = 0;
+  diffs.numTokens = 0;
+
+  for (size_t i = first; i < last; i++)
+  {
+    encodeAllConfigs(mph, tokens[i], normal, mk);
+    encodeAllConfigs(reference, tokens[i], normal, rk);
+
+    // Report the first differing key of a token.
+    bool differs = false;
+    for (unsigned k = 0; k < 2 * INDEX_CONFIGS; k++)
+    {
+      if (mk[k] == rk[k])
+        continue;
+      diffs.numKeys++;
+      if (! differs && diffs.numTokens < maxReported)
+        ss << "  " << tokens[i] << ", configuration " << k/2 <<
+          (k % 2 ? " alternate" : " main") << ":  " << mk[k] <<
+          " instead of " << rk[k] << "\n";
+      differs = true;
+    }
+    if (differs)
+      diffs.numTokens++;
+  }
+  diffs.report = ss.str();
+}
+
+
+void compareAllConfigs(
+  Scheduler& scheduler,
+  vector<Metaphone3>& encoders,
+  vector<Metaphone3>& references,
+  const vector<string>& tokens,
+  const size_t maxReported,
+  KeyDiffs& diffs)
+{
+  const size_t numChunks = (tokens.size() + ENCODE_CHUNK - 1) /
+    ENCODE_CHUNK;
+  vector<KeyDiffs> chunks(numChunks);
+  scheduler.run(vector<size_t>(numChunks, 1), [&](size_t chunk,
+    unsigned thrNo)
+  {
+    const size_t first = chunk * ENCODE_CHUNK;
+    const size_t last = min(first + ENCODE_CHUNK, tokens.size());
+    compareChunk(encoders[thrNo], references[thrNo], tokens, first, last,
+      maxReported, chunks[chunk]);
+  });
+
+  // In token order, so the report does not depend on the threads.
+  diffs.numKeys = 0;
+  diffs.numTokens = 0;
+  diffs.report = "";
+  for (auto& chunk: chunks)
+  {
+    if (diffs.numTokens < maxReported)
+      diffs.report += chunk.report;
+    diffs.numKeys += chunk.numKeys;
+    diffs.numTokens += chunk.numTokens;
+  }
+}
+
+
+size_t encodeTokenKeys(
+  Metaphone3& mph,
+  const string_view text,
+  const NameTokenizer * tokenizer,
+  PackedKey mains[],
+  PackedKey alts[],
+  const size_t maxTokens)
+{
+  size_t n = 0;
+  forEachToken(text, tokenizer, maxTokens, [&](const string_view word)
+  {
+    mph.setWord(word);
+    mph.encode();
+    const PackedKey main = mph.getOrderedMetaph();
+    if (main == 0)
+      return false;
+    mains[n] = main;
+    alts[n] = mph.getOrderedAlternateMetaph();
+    n++;
+    return true;
+  });
+  return n;
+}
+
+
+size_t encodeStream(
+  Metaphone3& mph,
+  LineReader& reader,
+  LineWriter& writer,
+  const bool dedup,
+  const NameTokenizer * tokenizer)
+{
+  // The vocabulary lives across blocks, so a token is encoded once
+  // per stream and not once per block.
+  Vocabulary vocab;
+  vector<string> lines;
+  size_t numLines = 0;
+
+  while (reader.getBlock(lines))
+  {
+    string out;
+    if (dedup)
+    {
+      vocab.clearLines();
+      for (auto& line: lines)
+        vocab.addLine(mph, line, tokenizer);
+
+      vocab.encode(mph);
+
+      for (size_t i = 0; i < lines.size(); i++)
+        vocab.appendLine(i, lines[i], out);
+    }
+    else
+    {
+      for (auto& line: lines)
+        encodeLine(mph, line, out, tokenizer);
+    }
+
+    numLines += lines.size();
+    if (! writer.write(move(out)))
+      break;
+  }
+  return numLines;
+}
+
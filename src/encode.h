@@ -0,0 +1,142 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifndef ENCODE_H
+#define ENCODE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Metaphone3.h"
+#include "LineReader.h"
+#include "LineWriter.h"
+#include "NameTokenizer.h"
+
+using namespace std;
+
+class Scheduler;
+
+
+void tokenize(
+  const string& text,
+  vector<string>& tokens,
+  const string& delimiters);
+
+// Appends the driver output line for text, i.e. the text followed by
+// the main and alternate keys for all four combinations of
+// encodeVowels and encodeExact, all separated by semicolons.
+// Without a tokenizer the text is split on spaces like the Java driver.
+void encodeLine(
+  Metaphone3& mph,
+  const string& text,
+  string& out,
+  const NameTokenizer * tokenizer);
+
+// Calls fn(word) for the tokens of text, as split by the tokenizer or
+// else on spaces, until fn has returned true maxTokens times.  The
+// tokens for which fn returns false (such as those without a key) do
+// not count.
+template<class Fn>
+void forEachToken(
+  const string_view text,
+  const NameTokenizer * tokenizer,
+  const size_t maxTokens,
+  Fn fn)
+{
+  if (tokenizer)
+  {
+    NameToken names[NAME_MAX_TOKENS];
+    char buf[NAME_MAX_TOKEN];
+    const size_t numNames = tokenizer->split(text, names,
+      NAME_MAX_TOKENS);
+    size_t n = 0;
+    for (size_t i = 0; i < numNames && n < maxTokens; i++)
+    {
+      if (fn(tokenizer->compact(names[i], buf)))
+        n++;
+    }
+    return;
+  }
+
+  size_t n = 0;
+  size_t lastPos = 0;
+  while (n < maxTokens && lastPos < text.size())
+  {
+    size_t pos = text.find(' ', lastPos);
+    if (pos == string_view::npos)
+      pos = text.size();
+    if (pos > lastPos && fn(text.substr(lastPos, pos - lastPos)))
+      n++;
+    lastPos = pos + 1;
+  }
+}
+
+// Sets encodeVowels and encodeExact for config (0 to INDEX_CONFIGS-1).
+void setIndexConfig(
+  Metaphone3& mph,
+  const unsigned config);
+
+// Encodes token in all configurations, normalizing it only once.
+// keys, if given, gets the main and the alternate key of configuration
+// c in keys[2*c] and keys[2*c+1].
+void encodeAllConfigs(
+  Metaphone3& mph,
+  const string& token,
+  string& normal,
+  string keys[]);
+
+// Encodes the tokens in all configurations in parallel chunks, with
+// one encoder per thread of scheduler, and returns the time in ns.
+double timeAllConfigs(
+  Scheduler& scheduler,
+  vector<Metaphone3>& encoders,
+  const vector<string>& tokens);
+
+struct KeyDiffs
+{
+  // The keys that differ, and the tokens with such a key.
+  size_t numKeys;
+  size_t numTokens;
+
+  // The first differing key of each of the first maxReported tokens.
+  string report;
+};
+
+// Encodes the tokens in all configurations with encoders[t] and with
+// references[t] (one pair per thread of scheduler), in parallel
+// chunks, and counts the keys of encoders that differ.
+void compareAllConfigs(
+  Scheduler& scheduler,
+  vector<Metaphone3>& encoders,
+  vector<Metaphone3>& references,
+  const vector<string>& tokens,
+  const size_t maxReported,
+  KeyDiffs& diffs);
+
+// Fills in the ordered packed keys (see PackedKey.h) of the tokens
+// of text, in the current configuration of mph, and returns their
+// number.  alts[i] is 0 if token i has no alternate key.  Tokens
+// without a key are left out.  Without a tokenizer, text is split on
+// spaces.
+size_t encodeTokenKeys(
+  Metaphone3& mph,
+  const string_view text,
+  const NameTokenizer * tokenizer,
+  PackedKey mains[],
+  PackedKey alts[],
+  const size_t maxTokens);
+
+// Encodes the lines from reader block by block and passes the output
+// to writer.  With dedup, each distinct token is encoded only once
+// (see Vocabulary).  Returns the number of lines.
+size_t encodeStream(
+  Metaphone3& mph,
+  LineReader& reader,
+  LineWriter& writer,
+  const bool dedup,
+  const NameTokenizer * tokenizer);
+
+#endif
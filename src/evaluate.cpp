@@ -0,0 +1,348 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <map>
+#include <chrono>
+
+#include "evaluate.h"
+#include "files.h"
+#include "encode.h"
+#include "Pronunciation.h"
+#include "PhoneticIndex.h"
+#include "Scheduler.h"
+
+using namespace std::chrono;
+
+// Lines per parallel evaluation job.
+#define EVAL_CHUNK 2048
+
+// Rules used by fewer words are not printed.
+#define EVAL_MIN_WORDS 10
+
+// The most common unknown sounds that are printed.
+#define EVAL_UNKNOWN_SOUNDS 10
+
+
+struct EvalCount
+{
+  size_t words = 0;
+  size_t agree = 0;
+
+  // A word that did not agree, with its keys.
+  string example;
+
+  void add(
+    const bool agrees,
+    const string& failure)
+  {
+    words++;
+    if (agrees)
+      agree++;
+    else if (example.empty())
+      example = failure;
+  }
+
+  void merge(const EvalCount& other)
+  {
+    words += other.words;
+    agree += other.agree;
+    if (example.empty())
+      example = other.example;
+  }
+};
+
+// The counts of one job, or all of them merged.
+struct EvalStats
+{
+  size_t numLines = 0;
+  size_t numBadLines = 0;
+  size_t numMismatches = 0;
+  size_t numWords = 0;
+  size_t numUnknown = 0;
+
+  map<string, size_t> unknownSounds;
+
+  EvalCount configs[INDEX_CONFIGS];
+
+  // In the chosen configuration.
+  map<string, EvalCount> rules;
+  EvalCount letters[26];
+
+  void merge(const EvalStats& other)
+  {
+    numLines += other.numLines;
+    numBadLines += other.numBadLines;
+    numMismatches += other.numMismatches;
+    numWords += other.numWords;
+    numUnknown += other.numUnknown;
+    for (auto& p: other.unknownSounds)
+      unknownSounds[p.first] += p.second;
+    for (unsigned c = 0; c < INDEX_CONFIGS; c++)
+      configs[c].merge(other.configs[c]);
+    for (auto& p: other.rules)
+      rules[p.first].merge(p.second);
+    for (unsigned l = 0; l < 26; l++)
+      letters[l].merge(other.letters[l]);
+  }
+};
+
+
+static void evaluateWord(
+  Metaphone3& mph,
+  const PronouncedWord& pw,
+  const unsigned config,
+  string& normal,
+  vector<string>& rules,
+  EvalStats& stats)
+{
+  mph.normalize(pw.word, normal);
+
+  for (unsigned c = 0; c < INDEX_CONFIGS; c++)
+  {
+    setIndexConfig(mph, c);
+    mph.setTrace(c == config);
+    mph.setNormalizedWord(normal);
+    mph.encode();
+
+    const string main = mph.getMetaph();
+    const string alt = mph.getAlternateMetaph();
+    const string& ref = pw.keys[c];
+    const bool agrees = (main == ref || alt == ref);
+    const string failure = (agrees ? "" :
+      pw.word + ": " + main + (alt.empty() ? "" : "/" + alt) +
+      ", expected " + ref);
+
+    stats.configs[c].add(agrees, failure);
+    if (c != config)
+      continue;
+
+    // Each rule and letter counts once per word.
+    rules.clear();
+    for (auto& step: mph.getTraceSteps())
+      rules.push_back(mph.getStepRule(step));
+    sort(rules.begin(), rules.end());
+    rules.erase(unique(rules.begin(), rules.end()), rules.end());
+    for (auto& rule: rules)
+      stats.rules[rule].add(agrees, failure);
+
+    bool seen[26] = {false};
+    for (auto ch: normal)
+    {
+      if (ch < 'A' || ch > 'Z' || seen[ch - 'A'])
+        continue;
+      seen[ch - 'A'] = true;
+      stats.letters[ch - 'A'].add(agrees, failure);
+    }
+  }
+  mph.setTrace(false);
+}
+
+
+static void evaluateChunk(
+  Metaphone3& mph,
+  const vector<string>& lines,
+  const size_t first,
+  const size_t last,
+  const unsigned config,
+  EvalStats& stats)
+{
+  vector<PronouncedWord> words;
+  vector<string> rules;
+  string normal;
+
+  for (size_t i = first; i < last; i++)
+  {
+    if (lines[i].empty())
+      continue;
+    stats.numLines++;
+
+    const PronunciationStatus status =
+      parsePronunciation(lines[i], words);
+    if (status == PRON_BAD_LINE)
+    {
+      stats.numBadLines++;
+      continue;
+    }
+    else if (status == PRON_MISMATCH)
+    {
+      stats.numMismatches++;
+      continue;
+    }
+
+    for (auto& pw: words)
+    {
+      if (pw.word.empty())
+        continue;
+      if (! pw.unknown.empty())
+      {
+        stats.numUnknown++;
+        stats.unknownSounds[pw.unknown]++;
+        continue;
+      }
+
+      stats.numWords++;
+      evaluateWord(mph, pw, config, normal, rules, stats);
+    }
+  }
+}
+
+
+static string percent(const EvalCount& count)
+{
+  stringstream ss;
+  ss << fixed << setprecision(1) <<
+    100. * count.agree / max(count.words, size_t(1)) << "%";
+  return ss.str();
+}
+
+
+static bool lessAgreement(
+  const EvalCount& a,
+  const EvalCount& b)
+{
+  // a.agree / a.words < b.agree / b.words, without rounding.
+  return a.agree * b.words < b.agree * a.words;
+}
+
+
+static void printCount(
+  const string& name,
+  const unsigned width,
+  const EvalCount& count,
+  stringstream& ss)
+{
+  ss << "  " << left << setw(width) << name << right <<
+    setw(8) << count.words << setw(8) << percent(count) <<
+    "  " << count.example << "\n";
+}
+
+
+static void printReport(
+  const Options& options,
+  const EvalStats& all,
+  const long long ms)
+{
+  stringstream ss;
+  ss << options.pronFile << ": " << all.numLines << " lines, " <<
+    all.numWords << " words in " << ms << " ms (" <<
+    fixed << setprecision(0) <<
+    1000. * all.numWords / max(ms, 1LL) << " words/s, " <<
+    INDEX_CONFIGS << " configurations)\n";
+  ss << "Skipped " << all.numBadLines << " bad lines, " <<
+    all.numMismatches << " lines with a different number of words " <<
+    "and pronunciations,\nand " << all.numUnknown <<
+    " words with sounds not in the table";
+
+  vector<pair<size_t, string>> sounds;
+  for (auto& p: all.unknownSounds)
+    sounds.emplace_back(p.second, p.first);
+  sort(sounds.begin(), sounds.end(),
+    [](const pair<size_t, string>& a, const pair<size_t, string>& b)
+  {
+    return (a.first != b.first ? a.first > b.first : a.second < b.second);
+  });
+  if (sounds.size() > EVAL_UNKNOWN_SOUNDS)
+    sounds.resize(EVAL_UNKNOWN_SOUNDS);
+  for (size_t i = 0; i < sounds.size(); i++)
+    ss << (i == 0 ? " (" : ", ") << sounds[i].second << " " <<
+      sounds[i].first;
+  ss << (sounds.empty() ? "\n" : ")\n");
+
+  ss << "\nAgreement of the main or alternate key with the " <<
+    "pronunciation\n";
+  for (unsigned c = 0; c < INDEX_CONFIGS; c++)
+    ss << "  configuration " << c << ":  " << setw(6) <<
+      percent(all.configs[c]) << "  " << all.configs[c].example << "\n";
+
+  vector<pair<string, const EvalCount *>> rules;
+  unsigned width = 4;
+  for (auto& p: all.rules)
+  {
+    if (p.second.words < EVAL_MIN_WORDS)
+      continue;
+    rules.emplace_back(p.first, &p.second);
+    width = max(width, static_cast<unsigned>(p.first.size()));
+  }
+  stable_sort(rules.begin(), rules.end(),
+    [](const pair<string, const EvalCount *>& a,
+      const pair<string, const EvalCount *>& b)
+  {
+    return lessAgreement(* a.second, * b.second);
+  });
+
+  ss << "\nRules in configuration " << options.config <<
+    " by the agreement of the words they took part in\n(used by at " <<
+    "least " << EVAL_MIN_WORDS << " words), least agreement first\n";
+  ss << "  " << left << setw(width) << "rule" << right <<
+    setw(8) << "words" << setw(8) << "agree" << "  example\n";
+  for (auto& p: rules)
+    printCount(p.first, width, * p.second, ss);
+
+  vector<unsigned> letters;
+  for (unsigned l = 0; l < 26; l++)
+  {
+    if (all.letters[l].words > 0)
+      letters.push_back(l);
+  }
+  stable_sort(letters.begin(), letters.end(),
+    [&all](const unsigned a, const unsigned b)
+  {
+    return lessAgreement(all.letters[a], all.letters[b]);
+  });
+
+  ss << "\nLetters in configuration " << options.config <<
+    " by the agreement of the words they occur in\n";
+  for (auto l: letters)
+    printCount(string(1, static_cast<char>('A' + l)), width,
+      all.letters[l], ss);
+
+  cout << ss.str();
+}
+
+
+unsigned runEvaluate(const Options& options)
+{
+  vector<string> lines;
+  if (! readFile(options.pronFile, lines))
+  {
+    cout << "File " << options.pronFile << " not found\n";
+    return 1;
+  }
+
+  Scheduler scheduler;
+  scheduler.setThreads(options.numThreads);
+  vector<Metaphone3> encoders(scheduler.getThreads());
+  for (auto& mph: encoders)
+    mph.setKeyLength(mph.getMaximumKeyLength());
+
+  // One set of counts per job, merged in line order, so that the
+  // examples do not depend on the threads.
+  const size_t numChunks = (lines.size() + EVAL_CHUNK - 1) / EVAL_CHUNK;
+  vector<EvalStats> perChunk(numChunks);
+
+  const auto start = steady_clock::now();
+  scheduler.run(vector<size_t>(numChunks, 1), [&](size_t chunk,
+    unsigned thrNo)
+  {
+    const size_t first = chunk * EVAL_CHUNK;
+    const size_t last = min(first + EVAL_CHUNK, lines.size());
+    evaluateChunk(encoders[thrNo], lines, first, last, options.config,
+      perChunk[chunk]);
+  });
+
+  EvalStats all;
+  for (auto& stats: perChunk)
+    all.merge(stats);
+
+  const long long ms = duration_cast<milliseconds>(
+    steady_clock::now() - start).count();
+
+  printReport(options, all, ms);
+  return 0;
+}
@@ -0,0 +1,25 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifndef EVALUATE_H
+#define EVALUATE_H
+
+#include "args.h"
+
+using namespace std;
+
+
+// Evaluates Metaphone 3 against the Moby pronunciation dictionary
+// options.pronFile (mpron.txt, see Pronunciation.h).  Every word is
+// encoded in parallel in all four configurations with keys of the
+// maximum length, and it agrees if its main or alternate key is the
+// reference key from its pronunciation.  Prints the agreement per
+// configuration, the time taken, and for configuration options.config
+// the agreement of the words that each rule (or letter) took part in,
+// least agreement first, with an example of a disagreeing word.
+// Returns 0 on success.
+unsigned runEvaluate(const Options& options);
+
+#endif
@@ -0,0 +1,144 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+
+#include "files.h"
+#include "LineReader.h"
+
+namespace fs = std::filesystem;
+
+
+bool readFile(
+  const string& fname,
+  vector<string>& lines)
+{
+  LineReader reader;
+  if (! reader.open(fname))
+    return false;
+
+  vector<string> block;
+  while (reader.getBlock(block))
+    lines.insert(lines.end(),
+      make_move_iterator(block.begin()), make_move_iterator(block.end()));
+
+  return reader.close();
+}
+
+
+bool writeFile(
+  const string& fname,
+  const string& text)
+{
+  ofstream f(fname.c_str(), ios::binary);
+  if (! f.good())
+    return false;
+
+  f << text;
+  f.close();
+  return f.good();
+}
+
+
+bool parseCompressFormat(
+  const string& text,
+  CompressFormat& format)
+{
+  if (text == "" || text == "none")
+    format = COMPRESS_NONE;
+  else if (text == "gz" || text == "gzip")
+    format = COMPRESS_GZIP;
+  else if (text == "zst" || text == "zstd")
+    format = COMPRESS_ZSTD;
+  else
+    return false;
+  return true;
+}
+
+
+string compressSuffix(const CompressFormat format)
+{
+  if (format == COMPRESS_GZIP)
+    return ".gz";
+  else if (format == COMPRESS_ZSTD)
+    return ".zst";
+  else
+    return "";
+}
+
+
+static bool endsWith(
+  const string& text,
+  const string& suffix)
+{
+  return (text.size() >= suffix.size() &&
+    text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0);
+}
+
+
+string stripCompressSuffix(const string& fname)
+{
+  for (auto format: {COMPRESS_GZIP, COMPRESS_ZSTD})
+  {
+    const string suffix = compressSuffix(format);
+    if (endsWith(fname, suffix))
+      return fname.substr(0, fname.size() - suffix.size());
+  }
+  return fname;
+}
+
+
+static void addFile(
+  const fs::path& path,
+  vector<InputFile>& files)
+{
+  error_code ec;
+  const uintmax_t size = fs::file_size(path, ec);
+
+  files.push_back(InputFile());
+  InputFile& entry = files.back();
+  entry.name = path.string();
+  entry.base = path.filename().string();
+  entry.size = (ec ? 0 : static_cast<size_t>(size));
+}
+
+
+bool expandInputs(
+  const vector<string>& inputs,
+  vector<InputFile>& files)
+{
+  bool ok = true;
+  for (auto& input: inputs)
+  {
+    const fs::path path(input);
+    error_code ec;
+    if (fs::is_directory(path, ec))
+    {
+      // Directory order is unspecified, so sort for stable output.
+      vector<fs::path> entries;
+      for (auto& de: fs::directory_iterator(path, ec))
+      {
+        if (de.is_regular_file(ec))
+          entries.push_back(de.path());
+      }
+      sort(entries.begin(), entries.end());
+
+      for (auto& e: entries)
+        addFile(e, files);
+    }
+    else if (fs::is_regular_file(path, ec))
+      addFile(path, files);
+    else
+    {
+      cout << "File " << input << " not found\n";
+      ok = false;
+    }
+  }
+  return ok;
+}
+
@@ -0,0 +1,56 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifndef FILES_H
+#define FILES_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+enum CompressFormat
+{
+  COMPRESS_NONE = 0,
+  COMPRESS_GZIP = 1,
+  COMPRESS_ZSTD = 2
+};
+
+struct InputFile
+{
+  string name;
+  string base;
+  size_t size;
+};
+
+
+// Reads a plain, gzip or zstd file (see LineReader).
+bool readFile(
+  const string& fname,
+  vector<string>& lines);
+
+bool writeFile(
+  const string& fname,
+  const string& text);
+
+// "gz", "zst" or "" (none).  Returns false for anything else.
+bool parseCompressFormat(
+  const string& text,
+  CompressFormat& format);
+
+// The file name suffix for a format, e.g. ".gz".
+string compressSuffix(const CompressFormat format);
+
+// The name without a ".gz" or ".zst" suffix.
+string stripCompressSuffix(const string& fname);
+
+// Expands directories (not recursively) into their regular files.
+// Returns false if some input does not exist.
+bool expandInputs(
+  const vector<string>& inputs,
+  vector<InputFile>& files);
+
+#endif
@@ -0,0 +1,442 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+#include <queue>
+#include <chrono>
+#include <cstdio>
+
+#include "join.h"
+#include "files.h"
+#include "encode.h"
+#include "PhoneticIndex.h"
+#include "RadixSort.h"
+#include "Scheduler.h"
+#include "LineReader.h"
+#include "LineWriter.h"
+
+namespace fs = std::filesystem;
+using namespace std::chrono;
+
+// Lines per encoding job, and jobs per batch read from a file.
+#define JOIN_CHUNK 4096
+#define JOIN_BATCH_CHUNKS 16
+
+// Output bytes per write.
+#define JOIN_OUT_BYTES (1 << 20)
+
+
+// A name in a run.  In a run file, each head is followed by its keys.
+struct JoinHead
+{
+  uint64_t hash;
+  uint32_t file;
+  uint32_t line;
+  uint32_t numKeys;
+  uint32_t keyPos; // Only used in memory
+};
+
+// The names of a run, and after sortRun() their order.
+struct JoinRun
+{
+  vector<JoinHead> heads;
+  vector<PackedKey> keys;
+  vector<uint32_t> order;
+
+  size_t bytes() const
+  {
+    // Including the buffers of the sort.
+    return heads.size() * (sizeof(JoinHead) + 2 * sizeof(KeyRecord) +
+      sizeof(uint32_t)) + keys.size() * sizeof(PackedKey);
+  }
+};
+
+// A sorted run being merged, either from a file or from memory.
+struct RunSource
+{
+  FILE * file;
+  const JoinRun * run;
+  size_t pos;
+
+  JoinHead head;
+  vector<PackedKey> keys;
+
+  bool next()
+  {
+    if (file == nullptr)
+    {
+      if (pos >= run->order.size())
+        return false;
+      head = run->heads[run->order[pos++]];
+      keys.assign(run->keys.begin() + head.keyPos,
+        run->keys.begin() + head.keyPos + head.numKeys);
+      return true;
+    }
+
+    if (fread(&head, sizeof head, 1, file) != 1)
+      return false;
+    keys.resize(head.numKeys);
+    return head.numKeys == 0 ||
+      fread(keys.data(), sizeof(PackedKey), head.numKeys, file) ==
+        head.numKeys;
+  }
+};
+
+
+// Orders names by hash, then by their keys.  The hash decides almost
+// always, and the keys separate the rare collisions.
+static int compareNames(
+  const JoinHead& h1,
+  const PackedKey * k1,
+  const JoinHead& h2,
+  const PackedKey * k2)
+{
+  if (h1.hash != h2.hash)
+    return (h1.hash < h2.hash ? -1 : 1);
+
+  const uint32_t n = min(h1.numKeys, h2.numKeys);
+  for (uint32_t i = 0; i < n; i++)
+  {
+    if (k1[i] != k2[i])
+      return (k1[i] < k2[i] ? -1 : 1);
+  }
+
+  if (h1.numKeys != h2.numKeys)
+    return (h1.numKeys < h2.numKeys ? -1 : 1);
+  return 0;
+}
+
+
+static void encodeBatch(
+  const vector<string>& lines,
+  const uint32_t fileNo,
+  const uint32_t firstLine,
+  const unsigned config,
+  const NameTokenizer * tokenizer,
+  Scheduler& scheduler,
+  vector<Metaphone3>& encoders,
+  JoinRun& run)
+{
+  const size_t numChunks = (lines.size() + JOIN_CHUNK - 1) / JOIN_CHUNK;
+  vector<JoinRun> parts(numChunks);
+
+  scheduler.run(vector<size_t>(numChunks, 1), [&](size_t chunk,
+    unsigned thrNo)
+  {
+    Metaphone3& mph = encoders[thrNo];
+    setIndexConfig(mph, config);
+
+    PackedKey mains[NAME_MAX_TOKENS], alts[NAME_MAX_TOKENS];
+    JoinRun& part = parts[chunk];
+    const size_t first = chunk * JOIN_CHUNK;
+    const size_t last = min(first + JOIN_CHUNK, lines.size());
+
+    for (size_t i = first; i < last; i++)
+    {
+      const size_t numKeys = encodeTokenKeys(mph, lines[i], tokenizer,
+        mains, alts, NAME_MAX_TOKENS);
+      if (numKeys == 0)
+        continue;
+
+      JoinHead head;
+      head.hash = packedKeysHash(mains, numKeys);
+      head.file = fileNo;
+      head.line = firstLine + static_cast<uint32_t>(i) + 1;
+      head.numKeys = static_cast<uint32_t>(numKeys);
+      head.keyPos = static_cast<uint32_t>(part.keys.size());
+      part.heads.push_back(head);
+      part.keys.insert(part.keys.end(), mains, mains + numKeys);
+    }
+  });
+
+  for (auto& part: parts)
+  {
+    const uint32_t offset = static_cast<uint32_t>(run.keys.size());
+    for (auto& head: part.heads)
+    {
+      run.heads.push_back(head);
+      run.heads.back().keyPos += offset;
+    }
+    run.keys.insert(run.keys.end(), part.keys.begin(), part.keys.end());
+  }
+}
+
+
+static void sortRun(
+  JoinRun& run,
+  const unsigned numThreads)
+{
+  const size_t n = run.heads.size();
+  vector<KeyRecord> items(n);
+  for (size_t i = 0; i < n; i++)
+    items[i] = {run.heads[i].hash, static_cast<uint32_t>(i), 0};
+
+  // The sort is stable, so equal names stay in file and line order.
+  radixSort(items, numThreads);
+
+  auto less = [&](const KeyRecord& a, const KeyRecord& b)
+  {
+    const JoinHead& ha = run.heads[a.record];
+    const JoinHead& hb = run.heads[b.record];
+    return compareNames(ha, &run.keys[ha.keyPos],
+      hb, &run.keys[hb.keyPos]) < 0;
+  };
+
+  size_t i = 0;
+  while (i < n)
+  {
+    size_t j = i + 1;
+    while (j < n && items[j].key == items[i].key)
+      j++;
+    if (j - i >= 2 && ! is_sorted(items.begin() + static_cast<long>(i),
+        items.begin() + static_cast<long>(j), less))
+      stable_sort(items.begin() + static_cast<long>(i),
+        items.begin() + static_cast<long>(j), less);
+    i = j;
+  }
+
+  run.order.resize(n);
+  for (i = 0; i < n; i++)
+    run.order[i] = items[i].record;
+}
+
+
+static bool writeRun(
+  const JoinRun& run,
+  const string& fname)
+{
+  FILE * f = fopen(fname.c_str(), "wb");
+  if (f == nullptr)
+    return false;
+
+  bool ok = true;
+  for (auto r: run.order)
+  {
+    const JoinHead& head = run.heads[r];
+    ok = ok && fwrite(&head, sizeof head, 1, f) == 1 &&
+      fwrite(&run.keys[head.keyPos], sizeof(PackedKey), head.numKeys, f) ==
+        head.numKeys;
+  }
+  return (fclose(f) == 0 && ok);
+}
+
+
+static void removeRuns(const vector<string>& runNames)
+{
+  error_code ec;
+  for (auto& name: runNames)
+    fs::remove(name, ec);
+}
+
+
+unsigned runJoin(const Options& options)
+{
+  vector<InputFile> files;
+  if (! expandInputs(options.inputs, files))
+    return 1;
+  if (files.size() < 2)
+  {
+    cout << "A join needs at least two lists\n";
+    return 1;
+  }
+
+  NameTokenizer tokenizer;
+  if (options.names == NAMES_EVENT)
+    tokenizer.setEventNames();
+  const NameTokenizer * tok =
+    (options.names == NAMES_NONE ? nullptr : &tokenizer);
+
+  Scheduler scheduler;
+  scheduler.setThreads(options.numThreads);
+  vector<Metaphone3> encoders(scheduler.getThreads());
+
+  error_code ec;
+  const fs::path tmpDir = fs::temp_directory_path(ec);
+  const string tmpBase = (tmpDir / ("mph3join-" +
+    to_string(steady_clock::now().time_since_epoch().count()))).string();
+
+  const auto start = steady_clock::now();
+  const size_t budget = static_cast<size_t>(options.memoryMB) << 20;
+  vector<string> runNames;
+  JoinRun run;
+  size_t numNames = 0;
+
+  // Phase 1:  Encode the lists into sorted runs.
+  vector<string> batch, block;
+  for (uint32_t f = 0; f < files.size(); f++)
+  {
+    LineReader reader;
+    if (! reader.open(files[f].name))
+    {
+      cout << "File " << files[f].name << " not found\n";
+      removeRuns(runNames);
+      return 1;
+    }
+
+    uint32_t lineNo = 0;
+    bool more = true;
+    while (more)
+    {
+      batch.clear();
+      while (batch.size() < JOIN_BATCH_CHUNKS * JOIN_CHUNK &&
+          (more = reader.getBlock(block)))
+        batch.insert(batch.end(), make_move_iterator(block.begin()),
+          make_move_iterator(block.end()));
+
+      encodeBatch(batch, f, lineNo, options.config, tok,
+        scheduler, encoders, run);
+      lineNo += static_cast<uint32_t>(batch.size());
+
+      if (run.bytes() >= budget)
+      {
+        sortRun(run, options.numThreads);
+        runNames.push_back(tmpBase + "." + to_string(runNames.size()));
+        if (! writeRun(run, runNames.back()))
+        {
+          cout << "Cannot write " << runNames.back() << "\n";
+          removeRuns(runNames);
+          return 1;
+        }
+        run = JoinRun();
+      }
+    }
+
+    if (! reader.close())
+    {
+      cout << "File " << files[f].name << " could not be read\n";
+      removeRuns(runNames);
+      return 1;
+    }
+    numNames += lineNo;
+  }
+
+  // The last run stays in memory.
+  sortRun(run, options.numThreads);
+
+  // Phase 2:  Merge the runs and pair up the names with equal keys.
+  vector<RunSource> sources(runNames.size() + 1);
+  for (size_t s = 0; s < runNames.size(); s++)
+  {
+    sources[s].file = fopen(runNames[s].c_str(), "rb");
+    if (sources[s].file == nullptr)
+    {
+      cout << "Cannot read " << runNames[s] << "\n";
+      removeRuns(runNames);
+      return 1;
+    }
+  }
+  sources.back().file = nullptr;
+  sources.back().run = &run;
+  sources.back().pos = 0;
+
+  // Ties go to the earlier run, which keeps files and lines in order.
+  auto later = [&](const size_t a, const size_t b)
+  {
+    const int c = compareNames(sources[a].head, sources[a].keys.data(),
+      sources[b].head, sources[b].keys.data());
+    return (c > 0 || (c == 0 && a > b));
+  };
+  priority_queue<size_t, vector<size_t>, decltype(later)> heap(later);
+  for (size_t s = 0; s < sources.size(); s++)
+  {
+    if (sources[s].next())
+      heap.push(s);
+  }
+
+  LineWriter writer;
+  if (! writer.open("", options.compress))
+  {
+    cout << "Cannot write to stdout\n";
+    removeRuns(runNames);
+    return 1;
+  }
+
+  // One group of equal names, as (file, line).
+  vector<pair<uint32_t, uint32_t>> group;
+  JoinHead groupHead = {0, 0, 0, 0, 0};
+  vector<PackedKey> groupKeys;
+  string out;
+  size_t numPairs = 0;
+
+  auto flushGroup = [&]()
+  {
+    if (group.size() < 2 || group.front().first == group.back().first)
+      return;
+
+    string keyText, key;
+    for (size_t k = 0; k < groupKeys.size(); k++)
+    {
+      unpackKeyOrdered(groupKeys[k], key);
+      keyText += (k == 0 ? "" : " ") + key;
+    }
+
+    // The group is ordered by file, so the partners of a name from a
+    // different file are all further on.
+    size_t next = 0;
+    for (size_t i = 0; i < group.size(); i++)
+    {
+      if (next <= i)
+        next = i + 1;
+      while (next < group.size() && group[next].first == group[i].first)
+        next++;
+
+      for (size_t j = next; j < group.size(); j++)
+      {
+        out += keyText + ";" + files[group[i].first].name + ";" +
+          to_string(group[i].second) + ";" +
+          files[group[j].first].name + ";" +
+          to_string(group[j].second) + "\n";
+        numPairs++;
+
+        if (out.size() >= JOIN_OUT_BYTES)
+        {
+          writer.write(move(out));
+          out.clear();
+        }
+      }
+    }
+  };
+
+  while (! heap.empty())
+  {
+    const size_t s = heap.top();
+    heap.pop();
+    RunSource& src = sources[s];
+
+    if (group.empty() || compareNames(groupHead, groupKeys.data(),
+        src.head, src.keys.data()) != 0)
+    {
+      flushGroup();
+      group.clear();
+      groupHead = src.head;
+      groupKeys = src.keys;
+    }
+    group.emplace_back(src.head.file, src.head.line);
+
+    if (src.next())
+      heap.push(s);
+  }
+  flushGroup();
+
+  if (! out.empty())
+    writer.write(move(out));
+  const bool ok = writer.close();
+
+  for (auto& src: sources)
+  {
+    if (src.file)
+      fclose(src.file);
+  }
+  removeRuns(runNames);
+
+  const auto ms = duration_cast<milliseconds>(
+    steady_clock::now() - start).count();
+  cerr << numNames << " names in " << files.size() << " files, " <<
+    runNames.size() + 1 << " runs, " << numPairs << " pairs, " <<
+    ms << " ms\n";
+  return (ok ? 0 : 1);
+}
@@ -0,0 +1,25 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifndef JOIN_H
+#define JOIN_H
+
+#include "args.h"
+
+using namespace std;
+
+
+// Finds the players that occur in more than one of the input lists:
+// pairs of names from different files whose main keys agree token for
+// token in configuration options.config.
+//
+// This is a sort-merge join.  The lists are encoded in parallel into
+// runs sorted by key, which are written to temporary files whenever
+// options.memoryMB is used up, and the runs are then merged.  Writes
+// "key;file1;line1;file2;line2" for each pair to stdout.  Returns 0
+// on success.
+unsigned runJoin(const Options& options);
+
+#endif
@@ -0,0 +1,261 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <functional>
+
+#include "lookup.h"
+#include "PhoneticIndex.h"
+#include "MappedIndex.h"
+#include "KeyNeighbours.h"
+#include "NameSearch.h"
+#include "NameQuery.h"
+#include "Scheduler.h"
+#include "files.h"
+
+using namespace std::chrono;
+
+
+static void printRecords(
+  const vector<uint32_t>& records,
+  const function<string_view(uint32_t)>& getName,
+  stringstream& ss)
+{
+  for (auto r: records)
+    ss << "  " << r << ";" << getName(r) << "\n";
+}
+
+
+static unsigned buildIndex(
+  const Options& options,
+  PhoneticIndex& index)
+{
+  NameTokenizer tokenizer;
+  if (options.names == NAMES_EVENT)
+    tokenizer.setEventNames();
+
+  const auto start = steady_clock::now();
+  if (! index.buildFromFile(options.inputs[0],
+      options.names == NAMES_NONE ? nullptr : &tokenizer,
+      options.numThreads))
+  {
+    cout << "File " << options.inputs[0] << " not found\n";
+    return 1;
+  }
+  const auto ms = duration_cast<milliseconds>(
+    steady_clock::now() - start).count();
+  cout << index.numNames() << " names indexed in " << ms << " ms\n";
+
+  if (options.saveIndex != "")
+  {
+    if (! index.save(options.saveIndex))
+    {
+      cout << "Cannot write " << options.saveIndex << "\n";
+      return 1;
+    }
+    cout << "Index saved to " << options.saveIndex << "\n";
+  }
+  return 0;
+}
+
+
+static unsigned openIndex(
+  const Options& options,
+  MappedIndex& index)
+{
+  const auto start = steady_clock::now();
+  if (! index.open(options.indexFile, options.verifyIndex))
+  {
+    cout << "Index file " << options.indexFile <<
+      " is missing, damaged or of another version\n";
+    return 1;
+  }
+  const auto us = duration_cast<microseconds>(
+    steady_clock::now() - start).count();
+  cout << index.numNames() << " names, index opened in " << us << " us\n";
+
+  const uint64_t postings = index.numPostings();
+  if (postings > 0)
+    cout << postings << " postings in " << index.postingBytes() <<
+      " bytes, " << fixed << setprecision(2) <<
+      8. * static_cast<double>(index.postingBytes()) /
+      static_cast<double>(postings) << " bits each (" <<
+      postingDecoder() << " decoder)\n";
+  return 0;
+}
+
+
+static unsigned rankNames(
+  const Options& options,
+  const function<void(NameSearch&)>& attach,
+  const function<string_view(uint32_t)>& getName)
+{
+  vector<string> queries;
+  if (options.queryFile == "")
+    queries.push_back(options.lookupName);
+  else if (! readFile(options.queryFile, queries))
+  {
+    cout << "File " << options.queryFile << " not found\n";
+    return 1;
+  }
+
+  Scheduler scheduler;
+  scheduler.setThreads(options.numThreads);
+  vector<NameSearch> searches(scheduler.getThreads());
+  for (auto& search: searches)
+    attach(search);
+
+  // Only the searches themselves are timed.
+  vector<string> results(queries.size());
+  vector<long long> times(queries.size());
+  scheduler.run(vector<size_t>(queries.size(), 1),
+    [&](size_t q, unsigned thrNo)
+  {
+    vector<NameMatch> matches;
+    const auto start = steady_clock::now();
+    searches[thrNo].search(queries[q], options.rank, matches);
+    times[q] = duration_cast<microseconds>(
+      steady_clock::now() - start).count();
+
+    stringstream ss;
+    ss << queries[q] << ": " << matches.size() << " matches\n";
+    for (auto& m: matches)
+      ss << "  " << m.record << ";" << fixed << setprecision(3) <<
+        m.score << ";" << getName(m.record) << "\n";
+    results[q] = ss.str();
+  });
+
+  long long total = 0, longest = 0;
+  for (size_t q = 0; q < queries.size(); q++)
+  {
+    cout << results[q];
+    total += times[q];
+    longest = max(longest, times[q]);
+  }
+  if (! queries.empty())
+    cout << queries.size() << " queries, " <<
+      total / static_cast<long long>(queries.size()) <<
+      " us on average, " << longest << " us at most\n";
+  return 0;
+}
+
+
+unsigned runLookup(const Options& options)
+{
+  PackedKey key = 0;
+  if (options.lookupKey != "" &&
+      ! packKeyOrdered(options.lookupKey, key))
+  {
+    cout << "Bad key " << options.lookupKey << "\n";
+    return 1;
+  }
+
+  // Either index, behind the same functions.
+  PhoneticIndex built;
+  MappedIndex mapped;
+  function<size_t(unsigned)> numKeys;
+  function<string_view(uint32_t)> getName;
+  function<void(unsigned, PackedKey, vector<uint32_t>&)> byKey;
+  function<void(unsigned, vector<PackedKey>&)> allKeys;
+  function<void(NameSearch&)> attach;
+  function<void(NameQuery&)> attachQuery;
+
+  if (options.indexFile != "")
+  {
+    if (openIndex(options, mapped) != 0)
+      return 1;
+    numKeys = [&](unsigned config) { return mapped.numKeys(config); };
+    getName = [&](uint32_t r) { return mapped.getName(r); };
+    byKey = [&](unsigned config, PackedKey k, vector<uint32_t>& recs)
+    {
+      mapped.lookupKey(config, k, recs);
+    };
+    allKeys = [&](unsigned config, vector<PackedKey>& keys)
+    {
+      keys.resize(mapped.numKeys(config));
+      for (size_t i = 0; i < keys.size(); i++)
+        keys[i] = mapped.getKey(config, i);
+    };
+    attach = [&](NameSearch& search) { search.setIndex(mapped); };
+    attachQuery = [&](NameQuery& query) { query.setIndex(mapped); };
+  }
+  else
+  {
+    if (buildIndex(options, built) != 0)
+      return 1;
+    numKeys = [&](unsigned config) { return built.numKeys(config); };
+    getName = [&](uint32_t r) { return built.getName(r); };
+    byKey = [&](unsigned config, PackedKey k, vector<uint32_t>& recs)
+    {
+      const PostingSpan span = built.lookupKey(config, k);
+      recs.assign(span.data, span.data + span.size);
+    };
+    allKeys = [&](unsigned config, vector<PackedKey>& keys)
+    {
+      keys = built.getKeys(config);
+    };
+    attach = [&](NameSearch& search) { search.setIndex(built); };
+    attachQuery = [&](NameQuery& query) { query.setIndex(built); };
+  }
+
+  if (options.rank > 0 &&
+      (options.lookupName != "" || options.queryFile != ""))
+    return rankNames(options, attach, getName);
+
+  if (options.lookupName == "" && options.lookupKey == "")
+    return 0;
+
+  stringstream ss;
+  Metaphone3 mph;
+  NameQuery query;
+  attachQuery(query);
+  vector<uint32_t> records;
+  for (unsigned config = 0; config < INDEX_CONFIGS; config++)
+  {
+    ss << "\nvowels " << (config >= 2 ? 1 : 0) <<
+      ", exact " << (config & 1) << ": " << numKeys(config) << " keys\n";
+
+    if (options.lookupName != "")
+    {
+      query.lookup(mph, options.lookupName, config, options.missing,
+        records);
+      ss << options.lookupName << ": " << records.size() << " records\n";
+      printRecords(records, getName, ss);
+    }
+
+    if (options.lookupKey != "" && options.distance == 0)
+    {
+      byKey(config, key, records);
+      ss << options.lookupKey << ": " << records.size() << " records\n";
+      printRecords(records, getName, ss);
+    }
+    else if (options.lookupKey != "")
+    {
+      // The neighbour index is built per configuration on demand.
+      vector<PackedKey> keys;
+      allKeys(config, keys);
+      KeyNeighbours neighbours;
+      neighbours.build(keys, options.distance, options.numThreads);
+
+      vector<KeyNeighbour> found;
+      neighbours.lookup(key, options.distance, found);
+      string text;
+      for (auto& nb: found)
+      {
+        byKey(config, nb.key, records);
+        unpackKeyOrdered(nb.key, text);
+        ss << text << " (distance " << nb.distance << "): " <<
+          records.size() << " records\n";
+        printRecords(records, getName, ss);
+      }
+    }
+  }
+
+  cout << ss.str();
+  return 0;
+}
@@ -0,0 +1,20 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifndef LOOKUP_H
+#define LOOKUP_H
+
+#include "args.h"
+
+using namespace std;
+
+
+// Builds a PhoneticIndex of the single input file (and saves it to
+// options.saveIndex), or maps options.indexFile, and prints for each
+// configuration the records that match options.lookupName or
+// options.lookupKey.  Returns 0 on success.
+unsigned runLookup(const Options& options);
+
+#endif
@@ -0,0 +1,219 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+
+#include "packs.h"
+#include "files.h"
+#include "Metaphone3.h"
+#include "encode.h"
+#include "PhoneticIndex.h"
+#include "Scheduler.h"
+
+// Timed passes per setting;  the fastest one counts.
+#define PACKS_ROUNDS 3
+
+// Tokens with differing keys that are printed per setting.
+#define PACKS_MAX_DIFFS 5
+
+struct RulePackName
+{
+  const char * name;
+  unsigned pack;
+};
+
+static const RulePackName PACK_NAMES[] =
+{
+  {"english", RULE_PACK_ENGLISH},
+  {"germanic", RULE_PACK_GERMANIC},
+  {"slavic", RULE_PACK_SLAVIC},
+  {"romance", RULE_PACK_ROMANCE},
+  {"french", RULE_PACK_FRENCH},
+  {"greek", RULE_PACK_GREEK},
+  {"translit", RULE_PACK_TRANSLIT}
+};
+
+
+bool parseRulePacks(
+  const string& text,
+  unsigned& mask)
+{
+  vector<string> names;
+  tokenize(text, names, ",");
+
+  mask = 0;
+  for (auto& name: names)
+  {
+    if (name == "all")
+    {
+      mask |= RULE_PACKS_ALL;
+      continue;
+    }
+
+    bool found = false;
+    for (auto& entry: PACK_NAMES)
+    {
+      if (name == entry.name)
+      {
+        mask |= entry.pack;
+        found = true;
+      }
+    }
+    if (! found)
+      return false;
+  }
+  return (mask != 0);
+}
+
+
+string rulePackNames(const unsigned mask)
+{
+  string s;
+  for (auto& entry: PACK_NAMES)
+  {
+    if (mask & entry.pack)
+      s += (s.empty() ? "" : ",") + string(entry.name);
+  }
+  return (s.empty() ? "none" : s);
+}
+
+
+static double timePacks(
+  Scheduler& scheduler,
+  vector<Metaphone3>& encoders,
+  const unsigned packs,
+  const vector<string>& tokens)
+{
+  for (auto& mph: encoders)
+    mph.setRulePacks(packs);
+  return timeAllConfigs(scheduler, encoders, tokens);
+}
+
+
+unsigned runPacks(const Options& options)
+{
+  vector<InputFile> files;
+  if (! expandInputs(options.inputs, files))
+    return 1;
+
+  NameTokenizer tokenizer;
+  if (options.names == NAMES_EVENT)
+    tokenizer.setEventNames();
+  const NameTokenizer * tok =
+    (options.names == NAMES_NONE ? nullptr : &tokenizer);
+
+  vector<string> tokens, lines;
+  for (auto& file: files)
+  {
+    if (! readFile(file.name, lines))
+    {
+      cout << "File " << file.name << " not found\n";
+      return 1;
+    }
+    for (auto& line: lines)
+      forEachToken(line, tok, NAME_MAX_TOKENS, [&](const string_view word)
+      {
+        tokens.emplace_back(word);
+        return true;
+      });
+  }
+
+  // The packs that are off in each setting:  none, each listed pack
+  // on its own, and all listed packs together.
+  vector<unsigned> offs;
+  offs.push_back(0);
+  for (auto& entry: PACK_NAMES)
+  {
+    if (options.rulePacks & entry.pack)
+      offs.push_back(entry.pack);
+  }
+  if (offs.size() > 2)
+    offs.push_back(options.rulePacks);
+
+  Scheduler scheduler;
+  scheduler.setThreads(options.numThreads);
+  const unsigned numThreads = scheduler.getThreads();
+
+  // Keys against those with every pack on.
+  vector<Metaphone3> encoders(numThreads), fulls(numThreads);
+  vector<size_t> numKeys(offs.size(), 0), numTokens(offs.size(), 0);
+  vector<string> diffs(offs.size());
+  for (unsigned s = 1; s < offs.size(); s++)
+  {
+    for (auto& mph: encoders)
+      mph.setRulePacks(RULE_PACKS_ALL & ~offs[s]);
+
+    KeyDiffs kd;
+    compareAllConfigs(scheduler, encoders, fulls, tokens, PACKS_MAX_DIFFS,
+      kd);
+    numKeys[s] = kd.numKeys;
+    numTokens[s] = kd.numTokens;
+    diffs[s] = kd.report;
+  }
+
+  // Benchmark, alternating the settings.
+  vector<double> best(offs.size(), 0.);
+  for (unsigned round = 0; round < PACKS_ROUNDS; round++)
+  {
+    for (unsigned s = 0; s < offs.size(); s++)
+    {
+      const double ns = timePacks(scheduler, encoders,
+        RULE_PACKS_ALL & ~offs[s], tokens);
+      if (round == 0 || ns < best[s])
+        best[s] = ns;
+    }
+  }
+
+  stringstream ss;
+  ss << "Rule packs on " << tokens.size() << " tokens in " <<
+    INDEX_CONFIGS << " configurations (best of " << PACKS_ROUNDS <<
+    ")\n";
+  if (METAPHONE3_RULE_PACKS != RULE_PACKS_ALL)
+    ss << "Not compiled in:  " <<
+      rulePackNames(RULE_PACKS_ALL & ~METAPHONE3_RULE_PACKS) << "\n";
+
+  vector<string> labels(offs.size());
+  for (unsigned s = 0; s < offs.size(); s++)
+    labels[s] = (s > 1 && s+1 == offs.size() ?
+      "all listed" : rulePackNames(offs[s]));
+
+  ss << "\n" << left << setw(12) << "packs off" << right <<
+    setw(6) << "rules" << setw(10) << "ns/token" << setw(9) << "faster" <<
+    setw(12) << "keys" << setw(10) << "tokens" << "\n";
+
+  const double n = static_cast<double>(max(tokens.size(), size_t(1)));
+  for (unsigned s = 0; s < offs.size(); s++)
+  {
+    ss << left << setw(12) << labels[s] << right <<
+      setw(6) << Metaphone3::numPackRules(offs[s]) <<
+      fixed << setprecision(0) << setw(10) << best[s] / n;
+    if (s == 0)
+    {
+      ss << "\n";
+      continue;
+    }
+    ss << setprecision(1) << setw(8) <<
+      100. * (best[0] - best[s]) / max(best[0], 1.) << "%" <<
+      setw(12) << numKeys[s] << setw(10) << numTokens[s] << "\n";
+  }
+  ss << "\n(keys and tokens:  the keys that differ from those with " <<
+    "every pack on,\nof " << 2 * INDEX_CONFIGS * tokens.size() <<
+    ", and the tokens with such a key)\n";
+
+  for (unsigned s = 1; s < offs.size(); s++)
+  {
+    if (numKeys[s] == 0)
+      continue;
+    ss << "\nWith " << labels[s] << " off:\n" << diffs[s];
+    if (numTokens[s] > PACKS_MAX_DIFFS)
+      ss << "  ...\n";
+  }
+
+  cout << ss.str();
+  return 0;
+}
@@ -0,0 +1,34 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifndef PACKS_H
+#define PACKS_H
+
+#include <string>
+
+#include "args.h"
+
+using namespace std;
+
+
+// Parses a comma-separated list of english, germanic, slavic, romance,
+// french, greek and translit, or all, into a mask of RulePack bits
+// (see Metaphone3.h).
+bool parseRulePacks(
+  const string& text,
+  unsigned& mask);
+
+// Comma-separated names of the packs in mask, or "none".
+string rulePackNames(const unsigned mask);
+
+// Encodes the tokens of the input files (and directories) in all four
+// configurations with every rule pack on, with each pack of
+// options.rulePacks off and with all of them off.  Prints the time
+// per token and the keys that change for each, so a deployment can
+// see what turning the packs off (or leaving them out of the build)
+// costs and saves.
+unsigned runPacks(const Options& options);
+
+#endif
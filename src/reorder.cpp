@@ -0,0 +1,196 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+
+#include "reorder.h"
+#include "files.h"
+#include "encode.h"
+#include "PhoneticIndex.h"
+#include "RuleProfile.h"
+#include "RuleSpec.h"
+#include "Scheduler.h"
+
+// Timed passes per rule order;  the fastest one counts.
+#define REORDER_ROUNDS 3
+
+// Tokens with differing keys that are printed.
+#define REORDER_MAX_DIFFS 10
+
+
+static double timeOrder(
+  Scheduler& scheduler,
+  vector<Metaphone3>& encoders,
+  const vector<vector<unsigned>>& table,
+  const vector<string>& tokens)
+{
+  for (auto& mph: encoders)
+    mph.setRuleTable(table);
+  return timeAllConfigs(scheduler, encoders, tokens);
+}
+
+
+unsigned runReorder(const Options& options)
+{
+  vector<InputFile> files;
+  if (! expandInputs(options.inputs, files))
+    return 1;
+
+  NameTokenizer tokenizer;
+  if (options.names == NAMES_EVENT)
+    tokenizer.setEventNames();
+  const NameTokenizer * tok =
+    (options.names == NAMES_NONE ? nullptr : &tokenizer);
+
+  vector<string> tokens, lines;
+  string origin;
+  for (auto& file: files)
+  {
+    if (! readFile(file.name, lines))
+    {
+      cout << "File " << file.name << " not found\n";
+      return 1;
+    }
+    for (auto& line: lines)
+      forEachToken(line, tok, NAME_MAX_TOKENS, [&](const string_view word)
+      {
+        tokens.emplace_back(word);
+        return true;
+      });
+    origin += (origin.empty() ? "" : " ") + file.base;
+  }
+
+  // The probe words of the spec, which make its rules fire or nearly
+  // fire, also go into the check of the new order.
+  vector<string> probes;
+  if (options.specFile != "")
+  {
+    RuleSpec spec;
+    if (! spec.read(options.specFile))
+      return 1;
+    if (spec.checksum() != Metaphone3::getSpecChecksum())
+    {
+      cout << "This build does not have the rules of " <<
+        options.specFile << "\n";
+      return 1;
+    }
+    spec.probes(probes);
+  }
+
+  Scheduler scheduler;
+  scheduler.setThreads(options.numThreads);
+  const unsigned numThreads = scheduler.getThreads();
+
+  // Profile in source order.
+  vector<Metaphone3> encoders(numThreads);
+  vector<RuleProfile> profiles(numThreads);
+  for (unsigned t = 0; t < numThreads; t++)
+  {
+    if (! encoders[t].setRuleProfile(&profiles[t]))
+    {
+      cout << "Metaphone3Rules.h does not have the rules of " <<
+        "Metaphone3.cpp\n";
+      return 1;
+    }
+  }
+
+  timeAllConfigs(scheduler, encoders, tokens);
+
+  RuleProfile profile;
+  for (auto& p: profiles)
+    profile.merge(p);
+
+  stringstream ss;
+  ss << "Profile of " << tokens.size() << " tokens in " <<
+    INDEX_CONFIGS << " configurations\n\n" << profile.str();
+
+  // The proof of the spec is wrong if rules that may swap fired
+  // together.
+  const unsigned contra = profile.numContradictions();
+  if (contra > 0)
+  {
+    cout << ss.str() << "\n" << contra << " pairs of rules that " <<
+      "never fire together according to the spec did\n" <<
+      "on the profile, so " << options.rulesFile << " was not written.\n";
+    return 1;
+  }
+
+  // Differential test of the new order against the source order.  Both
+  // run through the rule table of Metaphone3, so the test does not
+  // depend on the Metaphone3Rules.h of this build.
+  vector<vector<unsigned>> tables[2];
+  Metaphone3::getSourceTable(tables[0]);
+  profile.reorderAll(tables[1]);
+
+  vector<Metaphone3> sources(numThreads);
+  for (unsigned t = 0; t < numThreads; t++)
+  {
+    if (! encoders[t].setRuleTable(tables[1]) ||
+        ! sources[t].setRuleTable(tables[0]))
+    {
+      cout << "The new rule order does not fit Metaphone3.cpp\n";
+      return 1;
+    }
+  }
+
+  vector<string> words = probes;
+  words.insert(words.end(), tokens.begin(), tokens.end());
+  KeyDiffs diffs;
+  compareAllConfigs(scheduler, encoders, sources, words,
+    REORDER_MAX_DIFFS, diffs);
+  ss << "\nNew order against source order on " << probes.size() <<
+    " probe words and " << tokens.size() << " tokens:  " <<
+    diffs.numKeys << " differing keys of " <<
+    2 * INDEX_CONFIGS * words.size() << "\n" << diffs.report;
+  if (diffs.numKeys > 0)
+  {
+    cout << ss.str() << "\nThe new order gives other keys, so " <<
+      options.rulesFile << " was not written.\n";
+    return 1;
+  }
+
+  const string header = profile.header("Profiled on " +
+    to_string(tokens.size()) + " tokens of " + origin + ".");
+  if (! writeFile(options.rulesFile, header))
+  {
+    cout << ss.str() << "Cannot write " << options.rulesFile << "\n";
+    return 1;
+  }
+  ss << "\nWrote " << options.rulesFile << "\n";
+
+  // Benchmark, alternating the orders.
+  double best[2] = {0., 0.};
+  for (unsigned round = 0; round < REORDER_ROUNDS; round++)
+  {
+    for (unsigned o = 0; o < 2; o++)
+    {
+      const double ns = timeOrder(scheduler, encoders, tables[o], tokens);
+      if (round == 0 || ns < best[o])
+        best[o] = ns;
+    }
+  }
+
+  const double n = static_cast<double>(max(tokens.size(), size_t(1)));
+  ss << "\nTime per token in " << INDEX_CONFIGS <<
+    " configurations through the rule table (best of " <<
+    REORDER_ROUNDS << ")\n" <<
+    fixed << setprecision(0) <<
+    "  source order:  " << best[0] / n << " ns\n" <<
+    "  new order:     " << best[1] / n << " ns (" <<
+    setprecision(1) << 100. * (best[0] - best[1]) / max(best[0], 1.) <<
+    "% faster)\n";
+
+  if (profile.isCompiled())
+    ss << "\nThis build already has the new order.\n";
+  else
+    ss << "\nBuild again with " << options.rulesFile <<
+      " as src/Metaphone3Rules.h to use the new order.\n";
+
+  cout << ss.str();
+  return 0;
+}
@@ -0,0 +1,28 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifndef REORDER_H
+#define REORDER_H
+
+#include "args.h"
+
+using namespace std;
+
+
+// Profiles the rule chains of Metaphone3 on the tokens of the input
+// files (and directories) in all four configurations, and reorders
+// the rules of each chain by their hits where the spec proves that
+// this gives the same keys (see RuleProfile.h).  Then checks that the
+// new order gives the same keys as the source order on every token,
+// and on the probe words of options.specFile if set.  Both run through
+// the rule table of Metaphone3 (setRuleTable()), so this checks the
+// new order and not the one compiled in.  Only if all keys agree, it
+// writes options.rulesFile, a Metaphone3Rules.h with the new order,
+// and times the two orders.  The new order takes effect when the file
+// replaces src/Metaphone3Rules.h and the program is built again.
+// Returns 0 if all keys agree.
+unsigned runReorder(const Options& options);
+
+#endif
@@ -0,0 +1,187 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+
+#include "scan.h"
+#include "files.h"
+#include "encode.h"
+#include "PhoneticIndex.h"
+#include "KeyScan.h"
+#include "Scheduler.h"
+
+using namespace std::chrono;
+
+// Names per encoding job.
+#define SCAN_CHUNK 4096
+
+// Each scan is timed this often, and the best time counts.
+#define SCAN_REPEATS 10
+
+
+// The token keys of all names:  the main keys of all tokens and then
+// their alternate keys (0 for none).  Token i is in record records[i]
+// and has the keys keys[i] and keys[i + records.size()].
+struct ScanKeys
+{
+  vector<PackedKey> keys;
+  vector<uint32_t> records;
+};
+
+
+static void encodeNames(
+  const Options& options,
+  const vector<string>& names,
+  ScanKeys& allKeys)
+{
+  NameTokenizer tokenizer;
+  if (options.names == NAMES_EVENT)
+    tokenizer.setEventNames();
+  const NameTokenizer * tok =
+    (options.names == NAMES_NONE ? nullptr : &tokenizer);
+
+  const size_t numChunks = (names.size() + SCAN_CHUNK - 1) / SCAN_CHUNK;
+  vector<ScanKeys> mainParts(numChunks), altParts(numChunks);
+
+  Scheduler scheduler;
+  scheduler.setThreads(options.numThreads);
+  vector<Metaphone3> encoders(scheduler.getThreads());
+
+  scheduler.run(vector<size_t>(numChunks, 1), [&](size_t chunk,
+    unsigned thrNo)
+  {
+    Metaphone3& mph = encoders[thrNo];
+    setIndexConfig(mph, options.config);
+
+    PackedKey mains[NAME_MAX_TOKENS], alts[NAME_MAX_TOKENS];
+    const size_t first = chunk * SCAN_CHUNK;
+    const size_t last = min(first + SCAN_CHUNK, names.size());
+
+    for (size_t r = first; r < last; r++)
+    {
+      const size_t n = encodeTokenKeys(mph, names[r], tok,
+        mains, alts, NAME_MAX_TOKENS);
+      mainParts[chunk].keys.insert(mainParts[chunk].keys.end(),
+        mains, mains + n);
+      altParts[chunk].keys.insert(altParts[chunk].keys.end(),
+        alts, alts + n);
+      mainParts[chunk].records.insert(mainParts[chunk].records.end(),
+        n, static_cast<uint32_t>(r));
+    }
+  });
+
+  for (auto parts: {&mainParts, &altParts})
+  {
+    for (auto& part: * parts)
+    {
+      allKeys.keys.insert(allKeys.keys.end(),
+        part.keys.begin(), part.keys.end());
+      allKeys.records.insert(allKeys.records.end(),
+        part.records.begin(), part.records.end());
+      vector<PackedKey>().swap(part.keys);
+    }
+  }
+}
+
+
+// Scans for all tokens of the query, and returns the best time of
+// SCAN_REPEATS.
+static long long timeScan(
+  const bool plain,
+  const ScanKeys& allKeys,
+  const PackedKey mains[],
+  const PackedKey alts[],
+  const size_t numTokens,
+  const unsigned prefixLength,
+  vector<uint32_t>& hits)
+{
+  long long best = 0;
+  for (unsigned rep = 0; rep < SCAN_REPEATS; rep++)
+  {
+    hits.clear();
+    const auto start = steady_clock::now();
+    for (size_t t = 0; t < numTokens; t++)
+    {
+      const PackedKey alt = (alts[t] == 0 ? mains[t] : alts[t]);
+      if (plain)
+        scanKeysPlain(allKeys.keys.data(), allKeys.keys.size(),
+          mains[t], alt, prefixLength, hits);
+      else
+        scanKeys(allKeys.keys.data(), allKeys.keys.size(),
+          mains[t], alt, prefixLength, hits);
+    }
+    const long long us = duration_cast<microseconds>(
+      steady_clock::now() - start).count();
+    if (rep == 0 || us < best)
+      best = us;
+  }
+  return best;
+}
+
+
+unsigned runScan(const Options& options)
+{
+  vector<string> names;
+  if (! readFile(options.inputs[0], names))
+  {
+    cout << "File " << options.inputs[0] << " not found\n";
+    return 1;
+  }
+
+  const auto start = steady_clock::now();
+  ScanKeys allKeys;
+  encodeNames(options, names, allKeys);
+  const auto ms = duration_cast<milliseconds>(
+    steady_clock::now() - start).count();
+
+  NameTokenizer tokenizer;
+  if (options.names == NAMES_EVENT)
+    tokenizer.setEventNames();
+
+  Metaphone3 mph;
+  setIndexConfig(mph, options.config);
+  PackedKey mains[NAME_MAX_TOKENS], alts[NAME_MAX_TOKENS];
+  const size_t numTokens = encodeTokenKeys(mph, options.scanName,
+    options.names == NAMES_NONE ? nullptr : &tokenizer,
+    mains, alts, NAME_MAX_TOKENS);
+
+  vector<uint32_t> hits, plainHits;
+  const long long us = timeScan(false, allKeys, mains, alts,
+    numTokens, options.prefixLength, hits);
+  const long long usPlain = timeScan(true, allKeys, mains, alts,
+    numTokens, options.prefixLength, plainHits);
+
+  if (hits != plainHits)
+  {
+    cout << "The " << scanKernel() << " scan and the plain loop differ\n";
+    return 1;
+  }
+
+  vector<uint32_t> records;
+  records.reserve(hits.size());
+  for (auto h: hits)
+    records.push_back(allKeys.records[h % allKeys.records.size()]);
+  sort(records.begin(), records.end());
+  records.erase(unique(records.begin(), records.end()), records.end());
+
+  stringstream ss;
+  ss << names.size() << " names, " << allKeys.keys.size() <<
+    " keys, encoded in " << ms << " ms\n";
+  ss << numTokens << " query tokens:  " << scanKernel() << " scan " <<
+    us << " us, plain loop " << usPlain << " us\n";
+  ss << options.scanName << ": " << records.size() << " lines\n";
+  for (auto r: records)
+  {
+    string_view name(names[r]);
+    if (! name.empty() && name.back() == '\r')
+      name.remove_suffix(1);
+    ss << "  " << r + 1 << ";" << name << "\n";
+  }
+  cout << ss.str();
+  return 0;
+}
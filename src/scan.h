@@ -0,0 +1,24 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifndef SCAN_H
+#define SCAN_H
+
+#include "args.h"
+
+using namespace std;
+
+
+// Finds the names in the single input file that share a main or
+// alternate token key with options.scanName in configuration
+// options.config (or only the first options.prefixLength symbols of
+// the keys), by brute force without an index.  The keys of the list
+// are encoded in parallel into one flat array, which is then scanned
+// with the vector kernel of KeyScan.h and, for comparison, with a
+// plain loop.  Prints both times and the matching lines.  Returns 0
+// on success.
+unsigned runScan(const Options& options);
+
+#endif
@@ -0,0 +1,220 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+
+#include "selfjoin.h"
+#include "files.h"
+#include "encode.h"
+#include "PhoneticIndex.h"
+#include "RadixSort.h"
+#include "Scheduler.h"
+
+using namespace std::chrono;
+
+// Names per encoding job.
+#define JOIN_CHUNK 4096
+
+
+// The main keys of the tokens of each name.  Record r has
+// keyCount[r] keys from chunkKeys[r / JOIN_CHUNK][keyPos[r]] on.
+struct NameKeys
+{
+  vector<vector<PackedKey>> chunkKeys;
+  vector<uint32_t> keyPos;
+  vector<uint8_t> keyCount;
+
+  const PackedKey * keys(const uint32_t r) const
+  {
+    return chunkKeys[r / JOIN_CHUNK].data() + keyPos[r];
+  }
+
+  bool less(
+    const uint32_t r1,
+    const uint32_t r2) const
+  {
+    return lexicographical_compare(
+      keys(r1), keys(r1) + keyCount[r1],
+      keys(r2), keys(r2) + keyCount[r2]);
+  }
+
+  bool same(
+    const uint32_t r1,
+    const uint32_t r2) const
+  {
+    return keyCount[r1] == keyCount[r2] &&
+      equal(keys(r1), keys(r1) + keyCount[r1], keys(r2));
+  }
+
+  string text(const uint32_t r) const
+  {
+    string s, key;
+    for (unsigned i = 0; i < keyCount[r]; i++)
+    {
+      unpackKeyOrdered(keys(r)[i], key);
+      s += (i == 0 ? "" : " ") + key;
+    }
+    return s;
+  }
+};
+
+
+static void encodeNames(
+  const Options& options,
+  const vector<string>& names,
+  NameKeys& nameKeys,
+  vector<KeyRecord>& items)
+{
+  NameTokenizer tokenizer;
+  if (options.names == NAMES_EVENT)
+    tokenizer.setEventNames();
+  const NameTokenizer * tok =
+    (options.names == NAMES_NONE ? nullptr : &tokenizer);
+
+  const size_t n = names.size();
+  const size_t numChunks = (n + JOIN_CHUNK - 1) / JOIN_CHUNK;
+  nameKeys.chunkKeys.resize(numChunks);
+  nameKeys.keyPos.resize(n);
+  nameKeys.keyCount.resize(n);
+  items.resize(n);
+
+  Scheduler scheduler;
+  scheduler.setThreads(options.numThreads);
+  vector<Metaphone3> encoders(scheduler.getThreads());
+
+  scheduler.run(vector<size_t>(numChunks, 1), [&](size_t chunk,
+    unsigned thrNo)
+  {
+    Metaphone3& mph = encoders[thrNo];
+    setIndexConfig(mph, options.config);
+
+    PackedKey mains[NAME_MAX_TOKENS], alts[NAME_MAX_TOKENS];
+    vector<PackedKey>& keys = nameKeys.chunkKeys[chunk];
+    const size_t first = chunk * JOIN_CHUNK;
+    const size_t last = min(first + JOIN_CHUNK, n);
+
+    for (size_t r = first; r < last; r++)
+    {
+      // At most 255 keys fit the count.
+      const size_t numKeys = encodeTokenKeys(mph, names[r], tok,
+        mains, alts, min(NAME_MAX_TOKENS, 255));
+
+      // The sort key is a hash of the key sequence.
+      const uint64_t hash = packedKeysHash(mains, numKeys);
+
+      nameKeys.keyPos[r] = static_cast<uint32_t>(keys.size());
+      nameKeys.keyCount[r] = static_cast<uint8_t>(numKeys);
+      keys.insert(keys.end(), mains, mains + numKeys);
+      items[r] = {hash, static_cast<uint32_t>(r), 0};
+    }
+  });
+
+  // Names without any key cannot be duplicates.
+  items.erase(remove_if(items.begin(), items.end(),
+    [&](const KeyRecord& item)
+  {
+    return nameKeys.keyCount[item.record] == 0;
+  }), items.end());
+}
+
+
+unsigned runSelfJoin(const Options& options)
+{
+  vector<string> names;
+  if (! readFile(options.inputs[0], names))
+  {
+    cout << "File " << options.inputs[0] << " not found\n";
+    return 1;
+  }
+
+  const auto start = steady_clock::now();
+
+  NameKeys nameKeys;
+  vector<KeyRecord> items;
+  encodeNames(options, names, nameKeys, items);
+
+  radixSort(items, options.numThreads);
+
+  // Runs of equal hashes.  A run with different key sequences (a
+  // hash collision) is sorted by the keys themselves and split.
+  struct Cluster
+  {
+    size_t first;
+    size_t last;
+  };
+  vector<Cluster> clusters;
+
+  size_t i = 0;
+  while (i < items.size())
+  {
+    size_t j = i + 1;
+    while (j < items.size() && items[j].key == items[i].key)
+      j++;
+
+    if (j - i >= 2)
+    {
+      bool mixed = false;
+      for (size_t k = i + 1; k < j && ! mixed; k++)
+        mixed = ! nameKeys.same(items[i].record, items[k].record);
+
+      if (mixed)
+        stable_sort(items.begin() + static_cast<long>(i),
+          items.begin() + static_cast<long>(j),
+          [&](const KeyRecord& a, const KeyRecord& b)
+        {
+          return nameKeys.less(a.record, b.record);
+        });
+
+      size_t k = i;
+      while (k < j)
+      {
+        size_t l = k + 1;
+        while (l < j && nameKeys.same(items[k].record, items[l].record))
+          l++;
+        if (l - k >= 2)
+          clusters.push_back({k, l});
+        k = l;
+      }
+    }
+    i = j;
+  }
+
+  // Largest clusters first, then in order of their first line.
+  sort(clusters.begin(), clusters.end(),
+    [&](const Cluster& a, const Cluster& b)
+  {
+    if (a.last - a.first != b.last - b.first)
+      return a.last - a.first > b.last - b.first;
+    return items[a.first].record < items[b.first].record;
+  });
+
+  const auto ms = duration_cast<milliseconds>(
+    steady_clock::now() - start).count();
+
+  stringstream ss;
+  size_t numDups = 0;
+  for (auto& c: clusters)
+  {
+    const size_t size = c.last - c.first;
+    numDups += size;
+    ss << size << ";" << nameKeys.text(items[c.first].record) << "\n";
+    for (size_t k = c.first; k < c.last; k++)
+    {
+      const uint32_t r = items[k].record;
+      string_view name(names[r]);
+      if (! name.empty() && name.back() == '\r')
+        name.remove_suffix(1);
+      ss << "  " << r + 1 << ";" << name << "\n";
+    }
+  }
+
+  ss << names.size() << " names, " << clusters.size() <<
+    " clusters with " << numDups << " names, " << ms << " ms\n";
+  cout << ss.str();
+  return 0;
+}
@@ -0,0 +1,21 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifndef SELFJOIN_H
+#define SELFJOIN_H
+
+#include "args.h"
+
+using namespace std;
+
+
+// Finds candidate duplicates within the single input file:  names
+// whose main keys agree token for token in configuration
+// options.config.  The names are encoded in parallel and grouped with
+// a parallel radix sort.  Prints the clusters of two or more names,
+// largest first, with their line numbers.  Returns 0 on success.
+unsigned runSelfJoin(const Options& options);
+
+#endif
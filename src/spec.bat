@@ -0,0 +1,6 @@
+./test -S Metaphone3Spec.txt
+if ($status != 0) exit 1
+mkdir -p golden
+java -jar ../java/Metaphone3.jar Metaphone3SpecProbes.txt golden/Metaphone3SpecProbes.txt
+./test -S Metaphone3Spec.txt -v golden > tmp/dSpec
+grep " differences$" tmp/dSpec
@@ -0,0 +1,91 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iostream>
+#include <sstream>
+
+#include "spec.h"
+#include "files.h"
+#include "Metaphone3.h"
+#include "RuleSpec.h"
+#include "validate.h"
+
+
+static string specStem(const string& specFile)
+{
+  // E.g. Metaphone3Spec.txt -> Metaphone3Spec.
+  const size_t slash = specFile.find_last_of("/\\");
+  const size_t dot = specFile.find_last_of('.');
+  if (dot == string::npos || (slash != string::npos && dot < slash))
+    return specFile;
+  else
+    return specFile.substr(0, dot);
+}
+
+
+static string baseName(const string& fname)
+{
+  const size_t slash = fname.find_last_of("/\\");
+  return (slash == string::npos ? fname : fname.substr(slash+1));
+}
+
+
+unsigned runSpec(const Options& options)
+{
+  RuleSpec spec;
+  if (! spec.read(options.specFile))
+    return 1;
+
+  const string stem = specStem(options.specFile);
+  const string headerFile = stem + ".h";
+  const string probesFile = stem + "Probes.txt";
+  if (headerFile == options.specFile ||
+      ! writeFile(headerFile, spec.header()))
+  {
+    cout << "Cannot write " << headerFile << "\n";
+    return 1;
+  }
+
+  vector<string> probes;
+  spec.probes(probes);
+  string text;
+  for (auto& word: probes)
+    text += word + "\n";
+  if (! writeFile(probesFile, text))
+  {
+    cout << "Cannot write " << probesFile << "\n";
+    return 1;
+  }
+
+  cout << "Compiled " << spec.numRules() << " rules of " <<
+    options.specFile << " into " << headerFile << ",\nand wrote " <<
+    probes.size() << " words that make them fire to " << probesFile <<
+    "\n";
+
+  // The rules of this build are only worth checking if they are the
+  // ones of the spec.
+  if (spec.checksum() != Metaphone3::getSpecChecksum())
+  {
+    cout << "This build has the " << Metaphone3::numSpecRules() <<
+      " rules of another spec.  Build again with\n" << headerFile <<
+      " as src/Metaphone3Spec.h and run this again to check them.\n";
+    return 1;
+  }
+
+  if (options.golden == "")
+  {
+    cout << "Nothing to check the rules against.  Make golden output " <<
+      "for " << baseName(probesFile) << "\n(and any inputs) with " <<
+      "java/Metaphone3.jar, and run this again with -v.\n";
+    return 0;
+  }
+
+  // The golden output, such as that of java/Metaphone3.jar, is the
+  // reference for the probe words and the inputs.
+  Options voptions = options;
+  voptions.inputs.insert(voptions.inputs.begin(), probesFile);
+  cout << "\n";
+  return runValidate(voptions);
+}
@@ -0,0 +1,24 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifndef SPEC_H
+#define SPEC_H
+
+#include "args.h"
+
+using namespace std;
+
+
+// Compiles the rule spec options.specFile (Metaphone3Spec.txt) into
+// the header of the same name ending on .h (see RuleSpec.h), and
+// writes the probe words of the spec, which make its rules fire or
+// nearly fire, to the file of the same name ending on Probes.txt.  If
+// this build has the rules of that spec and options.golden is set,
+// validates the probe words and the input files (and directories), if
+// any, against the golden output (see validate.h).  Returns 0 if the
+// build has the rules of the spec and no line differs.
+unsigned runSpec(const Options& options);
+
+#endif
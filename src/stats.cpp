@@ -0,0 +1,318 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+
+#include "stats.h"
+#include "files.h"
+#include "encode.h"
+#include "PhoneticIndex.h"
+#include "Sketches.h"
+#include "Scheduler.h"
+#include "LineReader.h"
+
+using namespace std::chrono;
+
+// Lines per encoding job, and jobs per batch read from a file.
+#define STATS_CHUNK 4096
+#define STATS_BATCH_CHUNKS 16
+
+// Sketch sizes.  A HyperLogLog of precision 14 is off by about 0.8%.
+#define STATS_HLL_PRECISION 14
+#define STATS_CMS_DEPTH 4
+#define STATS_CMS_WIDTH (1 << 15)
+
+// Candidate heavy keys per thread:  this many per key printed, and at
+// least STATS_MIN_CANDIDATES.
+#define STATS_CANDIDATES_PER_KEY 8
+#define STATS_MIN_CANDIDATES 64
+
+
+// The sketches of one thread, or all of them merged.
+struct KeyStats
+{
+  size_t numNames;
+  size_t numTokens;
+  size_t numKeys; // Occurrences in the chosen configuration
+
+  HyperLogLog spellings;
+
+  // Per configuration, the main and alternate keys, and the main keys
+  // cut to 1 .. PACKED_KEY_MAX_LENGTH symbols.
+  HyperLogLog keys[INDEX_CONFIGS];
+  HyperLogLog prefixes[INDEX_CONFIGS][PACKED_KEY_MAX_LENGTH];
+
+  // The keys in the chosen configuration.
+  CountMinSketch counts;
+  HeavyHitters hitters;
+
+  void init(const unsigned top)
+  {
+    numNames = 0;
+    numTokens = 0;
+    numKeys = 0;
+    spellings.setPrecision(STATS_HLL_PRECISION);
+    for (unsigned c = 0; c < INDEX_CONFIGS; c++)
+    {
+      keys[c].setPrecision(STATS_HLL_PRECISION);
+      for (auto& p: prefixes[c])
+        p.setPrecision(STATS_HLL_PRECISION);
+    }
+    counts.setSize(STATS_CMS_DEPTH, STATS_CMS_WIDTH);
+    hitters.setCapacity(max(STATS_CANDIDATES_PER_KEY * top,
+      static_cast<unsigned>(STATS_MIN_CANDIDATES)));
+  }
+
+  void merge(const KeyStats& other)
+  {
+    numNames += other.numNames;
+    numTokens += other.numTokens;
+    numKeys += other.numKeys;
+    spellings.merge(other.spellings);
+    for (unsigned c = 0; c < INDEX_CONFIGS; c++)
+    {
+      keys[c].merge(other.keys[c]);
+      for (unsigned l = 0; l < PACKED_KEY_MAX_LENGTH; l++)
+        prefixes[c][l].merge(other.prefixes[c][l]);
+    }
+    counts.merge(other.counts);
+  }
+
+  size_t bytes() const
+  {
+    size_t b = spellings.bytes() + counts.bytes() + hitters.bytes();
+    for (unsigned c = 0; c < INDEX_CONFIGS; c++)
+    {
+      b += keys[c].bytes();
+      for (auto& p: prefixes[c])
+        b += p.bytes();
+    }
+    return b;
+  }
+};
+
+
+// The first length symbols of an ordered key (see PackedKey.h).
+static PackedKey keyPrefix(
+  const PackedKey key,
+  const unsigned length)
+{
+  const unsigned dropped = PACKED_KEY_BITS * (PACKED_KEY_MAX_LENGTH - length);
+  return (key >> dropped) << dropped;
+}
+
+
+static void addKey(
+  KeyStats& stats,
+  const PackedKey key)
+{
+  const uint64_t hash = packedKeyHash(key);
+  stats.hitters.offer(key, stats.counts.add(hash));
+  stats.numKeys++;
+}
+
+
+static void addName(
+  Metaphone3& mph,
+  const string& text,
+  const NameTokenizer * tok,
+  const unsigned config,
+  string& normal,
+  KeyStats& stats)
+{
+  stats.numNames++;
+  forEachToken(text, tok, NAME_MAX_TOKENS, [&](const string_view word)
+  {
+    mph.normalize(word, normal);
+    bool any = false;
+    for (unsigned c = 0; c < INDEX_CONFIGS; c++)
+    {
+      setIndexConfig(mph, c);
+      mph.setNormalizedWord(normal);
+      mph.encode();
+      const PackedKey main = mph.getOrderedMetaph();
+      if (main == 0)
+        continue;
+      const PackedKey alt = mph.getOrderedAlternateMetaph();
+
+      any = true;
+      stats.keys[c].add(packedKeyHash(main));
+      if (alt != 0)
+        stats.keys[c].add(packedKeyHash(alt));
+      for (unsigned l = 1; l <= PACKED_KEY_MAX_LENGTH; l++)
+        stats.prefixes[c][l-1].add(packedKeyHash(keyPrefix(main, l)));
+
+      if (c == config)
+      {
+        addKey(stats, main);
+        if (alt != 0 && alt != main)
+          addKey(stats, alt);
+      }
+    }
+
+    if (! any)
+      return false;
+    stats.numTokens++;
+    stats.spellings.add(packedKeyHash(hash<string>()(normal)));
+    return true;
+  });
+}
+
+
+// The top keys of the merged stats, heaviest first, with their
+// estimated counts.
+static void topKeys(
+  const vector<KeyStats>& perThread,
+  const KeyStats& all,
+  const unsigned top,
+  vector<pair<PackedKey, uint32_t>>& result)
+{
+  vector<PackedKey> candidates;
+  for (auto& stats: perThread)
+    stats.hitters.keys(candidates);
+  sort(candidates.begin(), candidates.end());
+  candidates.erase(unique(candidates.begin(), candidates.end()),
+    candidates.end());
+
+  for (const PackedKey key: candidates)
+    result.emplace_back(key, all.counts.estimate(packedKeyHash(key)));
+
+  const size_t n = min(static_cast<size_t>(top), result.size());
+  partial_sort(result.begin(), result.begin() + n, result.end(),
+    [](const pair<PackedKey, uint32_t>& a,
+      const pair<PackedKey, uint32_t>& b)
+  {
+    return (a.second != b.second ? a.second > b.second :
+      a.first < b.first);
+  });
+  result.resize(n);
+}
+
+
+unsigned runStats(const Options& options)
+{
+  vector<InputFile> files;
+  if (! expandInputs(options.inputs, files))
+    return 1;
+
+  NameTokenizer tokenizer;
+  if (options.names == NAMES_EVENT)
+    tokenizer.setEventNames();
+  const NameTokenizer * tok =
+    (options.names == NAMES_NONE ? nullptr : &tokenizer);
+
+  Scheduler scheduler;
+  scheduler.setThreads(options.numThreads);
+  const unsigned numThreads = scheduler.getThreads();
+  vector<Metaphone3> encoders(numThreads);
+  vector<string> normals(numThreads);
+  vector<KeyStats> perThread(numThreads);
+  for (unsigned t = 0; t < numThreads; t++)
+  {
+    encoders[t].setKeyLength(PACKED_KEY_MAX_LENGTH);
+    perThread[t].init(options.statsTop);
+  }
+
+  const auto start = steady_clock::now();
+  vector<string> batch, block;
+  for (auto& file: files)
+  {
+    LineReader reader;
+    if (! reader.open(file.name))
+    {
+      cout << "File " << file.name << " not found\n";
+      return 1;
+    }
+
+    bool more = true;
+    while (more)
+    {
+      batch.clear();
+      while (batch.size() < STATS_BATCH_CHUNKS * STATS_CHUNK &&
+          (more = reader.getBlock(block)))
+        batch.insert(batch.end(), make_move_iterator(block.begin()),
+          make_move_iterator(block.end()));
+
+      const size_t numChunks = (batch.size() + STATS_CHUNK - 1) /
+        STATS_CHUNK;
+      scheduler.run(vector<size_t>(numChunks, 1), [&](size_t chunk,
+        unsigned thrNo)
+      {
+        const size_t first = chunk * STATS_CHUNK;
+        const size_t last = min(first + STATS_CHUNK, batch.size());
+        for (size_t r = first; r < last; r++)
+          addName(encoders[thrNo], batch[r], tok, options.config,
+            normals[thrNo], perThread[thrNo]);
+      });
+    }
+
+    if (! reader.close())
+    {
+      cout << "File " << file.name << " could not be read\n";
+      return 1;
+    }
+  }
+
+  KeyStats all;
+  all.init(options.statsTop);
+  for (auto& stats: perThread)
+    all.merge(stats);
+
+  vector<pair<PackedKey, uint32_t>> top;
+  topKeys(perThread, all, options.statsTop, top);
+
+  const auto ms = duration_cast<milliseconds>(
+    steady_clock::now() - start).count();
+
+  const double spellings = all.spellings.estimate();
+  stringstream ss;
+  ss << all.numNames << " names, " << all.numTokens <<
+    " tokens, about " << fixed << setprecision(0) << spellings <<
+    " distinct spellings, in " << ms << " ms\n";
+  ss << "Sketches:  " << perThread[0].bytes() << " bytes per thread\n\n";
+
+  ss << "Distinct main and alternate keys (estimated)\n";
+  for (unsigned c = 0; c < INDEX_CONFIGS; c++)
+    ss << "  configuration " << c << ":  " << all.keys[c].estimate() <<
+      "\n";
+
+  ss << "\nCollision rate (1 - distinct main keys / distinct spellings)" <<
+    "\nwith the keys cut to n symbols\n";
+  ss << setw(4) << "n";
+  for (unsigned c = 0; c < INDEX_CONFIGS; c++)
+    ss << setw(10) << ("config " + to_string(c));
+  ss << "\n" << setprecision(1);
+  for (unsigned l = 1; l <= PACKED_KEY_MAX_LENGTH; l++)
+  {
+    ss << setw(4) << l;
+    for (unsigned c = 0; c < INDEX_CONFIGS; c++)
+    {
+      const double keys = all.prefixes[c][l-1].estimate();
+      const double rate = (spellings > 0. ?
+        max(0., 1. - keys / spellings) : 0.);
+      ss << setw(9) << 100. * rate << "%";
+    }
+    ss << "\n";
+  }
+
+  ss << "\nMost frequent keys in configuration " << options.config <<
+    " (of " << all.numKeys << " main and alternate keys)\n";
+  string key;
+  for (auto& p: top)
+  {
+    unpackKeyOrdered(p.first, key);
+    ss << "  " << left << setw(PACKED_KEY_MAX_LENGTH) << key << right <<
+      setw(10) << p.second << setw(8) << setprecision(2) <<
+      100. * p.second / max(all.numKeys, size_t(1)) << "%\n";
+  }
+
+  cout << ss.str();
+  return 0;
+}
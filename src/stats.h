@@ -0,0 +1,24 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifndef STATS_H
+#define STATS_H
+
+#include "args.h"
+
+using namespace std;
+
+
+// Streams the input files (and directories) through fixed-size
+// sketches (see Sketches.h), so memory does not grow with the input.
+// Each token is encoded in all four configurations with keys of up to
+// PACKED_KEY_MAX_LENGTH symbols.  Prints the estimated number of
+// distinct spellings and of distinct keys per configuration, the
+// collision rate when the main keys are cut to each length, and the
+// options.statsTop most frequent keys in configuration options.config.
+// Returns 0 on success.
+unsigned runStats(const Options& options);
+
+#endif
@@ -1,10 +1,30 @@
 // Test driver for Metaphone3 port.
 
 #include <iostream>
-#include <fstream>
 #include <vector>
 
 #include "Metaphone3.h"
+#include "args.h"
+#include "files.h"
+#include "encode.h"
+#include "batch.h"
+#include "validate.h"
+#include "lookup.h"
+#include "selfjoin.h"
+#include "join.h"
+#include "cluster.h"
+#include "scan.h"
+#include "dict.h"
+#include "bloom.h"
+#include "stats.h"
+#include "evaluate.h"
+#include "reorder.h"
+#include "packs.h"
+#include "spec.h"
+#include "append.h"
+#include "Vocabulary.h"
+#include "PhoneticKeys.h"
+#include "PhoneticIndex.h"
 
 #define UNUSED(x) ((void)(true ? 0 : ((x), void(), 0)))
 
@@ -38,125 +58,243 @@ vector<string> TEST
 };
 
 
-void tokenize(
-  const string& text,
-  vector<string>& tokens,
-  const string& delimiters);
+int main(int argc, char * argv[])
+{
+  Options options;
+  readArgs(argc, argv, options);
 
-void read_file(
-  const string& fname,
-  vector<string>& file_list);
+  if (options.rulesFile != "")
+  {
+    if (options.inputs.empty())
+    {
+      usage(argv[0]);
+      exit(0);
+    }
+    return (runReorder(options) == 0 ? 0 : 1);
+  }
 
+  if (options.specFile != "")
+    return (runSpec(options) == 0 ? 0 : 1);
 
+  if (options.golden != "")
+  {
+    if (options.inputs.empty())
+    {
+      usage(argv[0]);
+      exit(0);
+    }
+    return (runValidate(options) == 0 ? 0 : 1);
+  }
 
-int main(int argc, char * argv[])
-{
-  vector<string> file_list;
-  vector<string>* test_list;
-  string base;
+  if (options.outDir != "")
+  {
+    if (options.inputs.empty())
+    {
+      usage(argv[0]);
+      exit(0);
+    }
+    return (runBatch(options) == 0 ? 0 : 1);
+  }
 
-  if (argc == 1)
-    test_list = &TEST;
-  else if (argc == 2)
+  if (options.join)
   {
-    string fname = string(argv[1]);
-    read_file(fname, file_list);
+    if (options.inputs.empty())
+    {
+      usage(argv[0]);
+      exit(0);
+    }
+    return (runJoin(options) == 0 ? 0 : 1);
+  }
 
-    test_list = &file_list;
+  if (options.duplicates)
+  {
+    if (options.inputs.size() != 1)
+    {
+      usage(argv[0]);
+      exit(0);
+    }
+    return (runSelfJoin(options) == 0 ? 0 : 1);
   }
-  else
+
+  if (options.appendBatch > 0)
   {
-    cout << "Usage: test [input_file]\n";
-    cout << "Writes to stdout";
-    exit(0);
+    if (options.inputs.empty())
+    {
+      usage(argv[0]);
+      exit(0);
+    }
+    return (runAppend(options) == 0 ? 0 : 1);
   }
 
+  if (options.cluster)
+  {
+    if (options.inputs.size() != 1)
+    {
+      usage(argv[0]);
+      exit(0);
+    }
+    return (runCluster(options) == 0 ? 0 : 1);
+  }
 
-  Metaphone3 mph;
-  for (auto &wd: * test_list)
-  {
-    cout << wd << ";";
-    vector<string> tokens;
-    tokens.clear();
-    tokenize(wd, tokens, " ");
-
-    for (bool encodeVowels: {false, true})
-    {
-      mph.setEncodeVowels(encodeVowels);
-      for (bool encodeExact: {false, true})
-      {
-        mph.setEncodeExact(encodeExact);
-
-        string main, alt;
-        for (auto &t: tokens)
-        {
-          mph.setWord(t);
-          mph.encode();
-
-          string x = mph.getMetaph();
-          if (x != "")
-            main += x + " ";
-          x = mph.getAlternateMetaph();
-          if (x != "")
-            alt += x + " ";
-        }
-        if (main != "")
-          main.pop_back(); // Drop trailing space
-        if (alt != "")
-        alt.pop_back();
-        cout << main << ";" << alt << ";";
-      }
-    }
-    cout << endl;
+  if (options.scanName != "")
+  {
+    if (options.inputs.size() != 1)
+    {
+      usage(argv[0]);
+      exit(0);
+    }
+    return (runScan(options) == 0 ? 0 : 1);
+  }
+
+  if (options.statsTop > 0)
+  {
+    if (options.inputs.empty())
+    {
+      usage(argv[0]);
+      exit(0);
+    }
+    return (runStats(options) == 0 ? 0 : 1);
+  }
+
+  if (options.bloomFile != "")
+  {
+    if (options.inputs.empty())
+    {
+      usage(argv[0]);
+      exit(0);
+    }
+    return (runBloom(options) == 0 ? 0 : 1);
   }
-}
 
+  if (options.pronFile != "")
+  {
+    if (! options.inputs.empty())
+    {
+      usage(argv[0]);
+      exit(0);
+    }
+    return (runEvaluate(options) == 0 ? 0 : 1);
+  }
 
-// tokenize splits a string into tokens separated by delimiter.
-// http://stackoverflow.com/questions/236129/split-a-string-in-c
+  if (options.rulePacks != 0)
+  {
+    if (options.inputs.empty())
+    {
+      usage(argv[0]);
+      exit(0);
+    }
+    return (runPacks(options) == 0 ? 0 : 1);
+  }
 
-void tokenize(
-  const string& text,
-  vector<string>& tokens,
-  const string& delimiters)
-{
-  string::size_type pos, lastPos = 0;
+  if (options.dictFile != "")
+    return (runDict(options) == 0 ? 0 : 1);
 
-  while (true)
+  if (options.lookupName != "" || options.lookupKey != "" ||
+      options.queryFile != "" ||
+      options.saveIndex != "" || options.indexFile != "")
   {
-    pos = text.find_first_of(delimiters, lastPos);
-    if (pos == std::string::npos)
+    if (options.inputs.size() != (options.indexFile == "" ? 1u : 0u) ||
+        (options.queryFile != "" && options.rank == 0))
     {
-      pos = text.length();
-      tokens.push_back(string(text.data()+lastPos,
-        static_cast<string::size_type>(pos - lastPos)));
-      break;
+      usage(argv[0]);
+      exit(0);
     }
-    else
+    return (runLookup(options) == 0 ? 0 : 1);
+  }
+
+  Metaphone3 mph;
+
+  NameTokenizer tokenizer;
+  if (options.names == NAMES_EVENT)
+    tokenizer.setEventNames();
+  const NameTokenizer * tokenizerPtr =
+    (options.names == NAMES_NONE ? nullptr : &tokenizer);
+
+  if (options.inputs.size() > 1)
+  {
+    usage(argv[0]);
+    exit(0);
+  }
+
+  if (options.vocabBase != "")
+  {
+    vector<string> file_list;
+    if (options.inputs.empty() ||
+        ! readFile(options.inputs[0], file_list))
     {
-      tokens.push_back(string(text.data()+lastPos,
-        static_cast<string::size_type>(pos - lastPos)));
+      cout << "No input file for " << options.vocabBase << "\n";
+      exit(0);
     }
-    lastPos = pos + 1;
+
+    Vocabulary vocab;
+    for (auto &wd: file_list)
+      vocab.addLine(mph, wd, tokenizerPtr);
+    vocab.encode(mph);
+
+    if (! vocab.writeVocabulary(options.vocabBase + ".vocab") ||
+        ! vocab.writeIndex(options.vocabBase + ".index"))
+    {
+      cout << "Cannot write " << options.vocabBase << " files\n";
+      exit(0);
+    }
+    cout << vocab.numLines() << " lines, " << vocab.numTokens() <<
+      " tokens, " << vocab.numDistinct() << " distinct\n";
+    return 0;
   }
-}
 
+  LineWriter writer;
+  if (! writer.open("", options.compress))
+  {
+    cout << "Cannot write to stdout\n";
+    exit(0);
+  }
 
-void read_file(
-  const string& fname,
-  vector<string>& file_list)
-{
-  const char * fn = fname.c_str();
-  ifstream f(fn);
-  if (! f.good())
+  PhoneticKeys keys;
+  keys.setAlgorithms(options.algorithms);
+  setIndexConfig(keys.metaphone3(), options.config);
+
+  if (options.inputs.empty())
   {
-    cout << "File " << fname << " not found\n";
+    string out;
+    for (auto &wd: TEST)
+    {
+      if (options.algorithms)
+        keys.encodeLine(wd, tokenizerPtr, out);
+      else
+        encodeLine(mph, wd, out, tokenizerPtr);
+    }
+    writer.write(move(out));
+    return (writer.close() ? 0 : 1);
+  }
+
+  // Decompression and compression overlap with the encoding.
+  LineReader reader;
+  if (! reader.open(options.inputs[0]))
+  {
+    writer.close();
+    cout << "File " << options.inputs[0] << " not found\n";
     exit(0);
   }
 
-  string tmp;
-  while (getline(f, tmp))
-    file_list.push_back(tmp);
-  f.close();
+  if (options.algorithms)
+  {
+    vector<string> lines;
+    while (reader.getBlock(lines))
+    {
+      string out;
+      for (auto& line: lines)
+        keys.encodeLine(line, tokenizerPtr, out);
+      if (! writer.write(move(out)))
+        break;
+    }
+  }
+  else
+    encodeStream(mph, reader, writer, options.dedup, tokenizerPtr);
+
+  const bool okRead = reader.close();
+  const bool okWrite = writer.close();
+  if (! okRead)
+    cout << "File " << options.inputs[0] << " could not be read\n";
+  return (okRead && okWrite ? 0 : 1);
 }
 
@@ -0,0 +1,139 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+// Checks the name tokenizer on names that have caused trouble.
+// Prints the failing cases and returns the number of failures.
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "NameTokenizer.h"
+#include "Metaphone3.h"
+
+using namespace std;
+
+
+struct SplitCase
+{
+  string text;
+  string tokens; // Compacted tokens separated by '|'
+};
+
+static const vector<SplitCase> PLAYER_CASES =
+{
+  {"Al Roth", "Al|Roth"},
+  {"Van Cliburn", "Van|Cliburn"},
+  {"van der Berg", "vanderBerg"},
+  {"Jan van der Berg", "Jan|vanderBerg"},
+  {"Piet de Wit", "Piet|deWit"},
+  {"De la Cruz", "DelaCruz"},
+  {"Jean-Pierre O'Brien", "Jean|Pierre|OBrien"},
+  {"J.R. Smith", "J|R|Smith"},
+  {"Ahmed El Sayed", "Ahmed|El|Sayed"},
+  {"Carlos Da Silva", "Carlos|Da|Silva"},
+  {"Van", "Van"}
+};
+
+static const vector<SplitCase> EVENT_CASES =
+{
+  {"Van Cliburn Cup 2017", "Van|Cliburn|Cup|2017"},
+  {"Coupe de la Ville", "Coupe|de|la|Ville"}
+};
+
+
+static string splitToString(
+  const NameTokenizer& tokenizer,
+  const string& text)
+{
+  NameToken tokens[NAME_MAX_TOKENS];
+  char buf[NAME_MAX_TOKEN];
+  const size_t n = tokenizer.split(text, tokens, NAME_MAX_TOKENS);
+
+  string s;
+  for (size_t i = 0; i < n; i++)
+  {
+    if (i > 0)
+      s += "|";
+    s += string(tokenizer.compact(tokens[i], buf));
+  }
+  return s;
+}
+
+
+static unsigned checkSplits(
+  const NameTokenizer& tokenizer,
+  const vector<SplitCase>& cases)
+{
+  unsigned numErrors = 0;
+  for (auto& c: cases)
+  {
+    const string s = splitToString(tokenizer, c.text);
+    if (s == c.tokens)
+      continue;
+
+    cout << "'" << c.text << "': got " << s << ", expected " <<
+      c.tokens << "\n";
+    numErrors++;
+  }
+  return numErrors;
+}
+
+
+static string encodeToken(
+  const NameTokenizer& tokenizer,
+  const string& text)
+{
+  NameToken tokens[NAME_MAX_TOKENS];
+  char buf[NAME_MAX_TOKEN];
+  if (tokenizer.split(text, tokens, NAME_MAX_TOKENS) != 1)
+    return "";
+
+  Metaphone3 mph;
+  mph.setEncodeVowels(true);
+  mph.setEncodeExact(true);
+  mph.setWord(tokenizer.compact(tokens[0], buf));
+  mph.encode();
+  return mph.getMetaph();
+}
+
+
+static unsigned checkJoinedKey(const NameTokenizer& tokenizer)
+{
+  // The joined surname encodes like the word written together, and
+  // the key is cut off at eight symbols, in the middle of "Berg".
+  unsigned numErrors = 0;
+  for (auto& text: {"van der Berg", "Vanderberg", "Vanderbergh"})
+  {
+    const string key = encodeToken(tokenizer, text);
+    if (key == "VANDARBA")
+      continue;
+
+    cout << "'" << text << "': got key " << key <<
+      ", expected VANDARBA\n";
+    numErrors++;
+  }
+  return numErrors;
+}
+
+
+int main()
+{
+  NameTokenizer tokenizer;
+  unsigned numErrors = 0;
+
+  tokenizer.setPlayerNames();
+  numErrors += checkSplits(tokenizer, PLAYER_CASES);
+  numErrors += checkJoinedKey(tokenizer);
+
+  tokenizer.setEventNames();
+  numErrors += checkSplits(tokenizer, EVENT_CASES);
+
+  if (numErrors == 0)
+    cout << "All tokenizer checks pass\n";
+  else
+    cout << numErrors << " tokenizer checks fail\n";
+  return static_cast<int>(numErrors);
+}
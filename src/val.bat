@@ -1,8 +1,11 @@
-foreach i (../../../bridgedata/words/Moby/Words/files/*)
+set dir = "../../../bridgedata/words/Moby/Words/files"
+mkdir -p golden
+foreach i (${dir}/*)
   set b = `basename $i`
-  echo $b
-  ./test $i > tmp/a$b
-  # java -jar ../java/Metaphone3.jar $i tmp/b$b
-  diff --ignore-all-space tmp/a$b tmp/b$b > tmp/d$b
+  if (! -e golden/${b}.gz) then
+    java -jar ../java/Metaphone3.jar $i golden/$b
+    gzip golden/$b
+  endif
 end
-wc tmp/d*.TXT
+./test -v golden ${dir} > tmp/dMoby
+grep " differences$" tmp/dMoby
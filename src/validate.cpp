@@ -0,0 +1,256 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#include <iostream>
+#include <sstream>
+#include <filesystem>
+
+#include "validate.h"
+#include "files.h"
+#include "encode.h"
+#include "Scheduler.h"
+
+namespace fs = std::filesystem;
+
+// Lines per parallel comparison job.
+#define VALIDATE_CHUNK 4096
+
+
+struct ValidateFile
+{
+  InputFile in;
+  string goldenName;
+  vector<string> lines;
+  vector<string> golden;
+  bool ok;
+};
+
+struct ValidateChunk
+{
+  size_t fileNo;
+  size_t first;
+  size_t last;
+  unsigned numDiffs;
+  string report;
+};
+
+
+static string stripSpace(const string& text)
+{
+  string s;
+  s.reserve(text.size());
+  for (auto c: text)
+  {
+    if (c != ' ' && c != '\t' && c != '\r')
+      s.push_back(c);
+  }
+  return s;
+}
+
+
+static void splitFields(
+  const string& text,
+  vector<string>& fields)
+{
+  fields.clear();
+  tokenize(text, fields, ";");
+}
+
+
+static void traceLine(
+  Metaphone3& mph,
+  const string& text,
+  const string& ours,
+  const string& golden,
+  stringstream& ss)
+{
+  // Fields are text, then main and alt for each of the four
+  // configurations in the order used by encodeLine().
+  vector<string> fo, fg;
+  splitFields(ours, fo);
+  splitFields(golden, fg);
+  fo.resize(9);
+  fg.resize(9);
+
+  vector<string> tokens;
+  tokenize(text, tokens, " ");
+
+  unsigned config = 0;
+  for (bool encodeVowels: {false, true})
+  {
+    for (bool encodeExact: {false, true})
+    {
+      const unsigned f = 2 * config + 1;
+      config++;
+      if (stripSpace(fo[f]) == stripSpace(fg[f]) &&
+          stripSpace(fo[f+1]) == stripSpace(fg[f+1]))
+        continue;
+
+      ss << "  vowels " << encodeVowels << " exact " << encodeExact <<
+        ": got " << fo[f] << "/" << fo[f+1] <<
+        ", expected " << fg[f] << "/" << fg[f+1] << "\n";
+
+      mph.setEncodeVowels(encodeVowels);
+      mph.setEncodeExact(encodeExact);
+      mph.setTrace(true);
+      for (auto& t: tokens)
+      {
+        mph.setWord(t);
+        mph.encode();
+        ss << "    " << t << ": " << mph.getTraceString() << "\n";
+      }
+      mph.setTrace(false);
+    }
+  }
+}
+
+
+static void compareChunk(
+  Metaphone3& mph,
+  const ValidateFile& vf,
+  ValidateChunk& chunk)
+{
+  stringstream ss;
+  string ours;
+  chunk.numDiffs = 0;
+
+  for (size_t i = chunk.first; i < chunk.last; i++)
+  {
+    const string& text = vf.lines[i];
+    ours.clear();
+    encodeLine(mph, text, ours, nullptr);
+    ours.pop_back(); // Drop newline
+
+    if (stripSpace(ours) == stripSpace(vf.golden[i]))
+      continue;
+
+    chunk.numDiffs++;
+    ss << vf.in.base << ":" << i+1 << ": " << text << "\n";
+    traceLine(mph, text, ours, vf.golden[i], ss);
+  }
+  chunk.report = ss.str();
+}
+
+
+static bool findGolden(
+  const Options& options,
+  vector<ValidateFile>& vfiles)
+{
+  error_code ec;
+  if (! fs::is_directory(options.golden, ec))
+  {
+    if (vfiles.size() != 1)
+    {
+      cout << "Several inputs need a golden directory\n";
+      return false;
+    }
+    vfiles[0].goldenName = options.golden;
+    return true;
+  }
+
+  for (auto& vf: vfiles)
+  {
+    const string base = (fs::path(options.golden) /
+      stripCompressSuffix(vf.in.base)).string();
+    vf.goldenName = base;
+    for (auto format: {COMPRESS_GZIP, COMPRESS_ZSTD})
+    {
+      const string name = base + compressSuffix(format);
+      if (fs::exists(name, ec))
+        vf.goldenName = name;
+    }
+  }
+  return true;
+}
+
+
+unsigned runValidate(const Options& options)
+{
+  vector<InputFile> files;
+  if (! expandInputs(options.inputs, files))
+    return 1;
+
+  vector<ValidateFile> vfiles(files.size());
+  for (size_t i = 0; i < files.size(); i++)
+    vfiles[i].in = files[i];
+
+  if (! findGolden(options, vfiles))
+    return 1;
+
+  Scheduler scheduler;
+  scheduler.setThreads(options.numThreads);
+
+  // Read and decompress the files in parallel.
+  vector<size_t> weights;
+  for (auto& vf: vfiles)
+    weights.push_back(vf.in.size);
+
+  scheduler.run(weights, [&vfiles](size_t job, unsigned)
+  {
+    ValidateFile& vf = vfiles[job];
+    vf.ok = readFile(vf.in.name, vf.lines) &&
+      readFile(vf.goldenName, vf.golden);
+  });
+
+  unsigned numErrors = 0;
+  vector<ValidateChunk> chunks;
+  for (size_t f = 0; f < vfiles.size(); f++)
+  {
+    ValidateFile& vf = vfiles[f];
+    if (! vf.ok)
+    {
+      cout << "File " << vf.in.name << " or " << vf.goldenName <<
+        " failed\n";
+      numErrors++;
+      continue;
+    }
+
+    if (vf.lines.size() != vf.golden.size())
+    {
+      cout << vf.in.base << ": " << vf.lines.size() <<
+        " lines, but golden file has " << vf.golden.size() << "\n";
+      numErrors++;
+    }
+
+    const size_t n = min(vf.lines.size(), vf.golden.size());
+    for (size_t first = 0; first < n; first += VALIDATE_CHUNK)
+    {
+      chunks.push_back(ValidateChunk());
+      ValidateChunk& chunk = chunks.back();
+      chunk.fileNo = f;
+      chunk.first = first;
+      chunk.last = min(first + VALIDATE_CHUNK, n);
+    }
+  }
+
+  // Encode and compare in parallel, then report in input order.
+  vector<Metaphone3> encoders(scheduler.getThreads());
+  weights.assign(chunks.size(), VALIDATE_CHUNK);
+
+  scheduler.run(weights, [&](size_t job, unsigned thrNo)
+  {
+    ValidateChunk& chunk = chunks[job];
+    compareChunk(encoders[thrNo], vfiles[chunk.fileNo], chunk);
+  });
+
+  vector<unsigned> fileDiffs(vfiles.size(), 0);
+  for (auto& chunk: chunks)
+  {
+    cout << chunk.report;
+    fileDiffs[chunk.fileNo] += chunk.numDiffs;
+  }
+
+  for (size_t f = 0; f < vfiles.size(); f++)
+  {
+    if (! vfiles[f].ok)
+      continue;
+    cout << vfiles[f].in.base << ": " << vfiles[f].lines.size() <<
+      " lines, " << fileDiffs[f] << " differences\n";
+    numErrors += fileDiffs[f];
+  }
+
+  return numErrors;
+}
+
@@ -0,0 +1,23 @@
+// Extension of Metaphone3.
+// Copyright (C) 2017 by Soren Hein.
+// No restrictions on copying and modifying, as long as credit is given.
+// No warranties.
+
+#ifndef VALIDATE_H
+#define VALIDATE_H
+
+#include "args.h"
+
+using namespace std;
+
+
+// Compares the driver output for each input file against a golden
+// file produced once by java/Metaphone3.jar.  The golden file may be
+// gzip or zstd-compressed.  If options.golden is a directory, the golden
+// file for input "x.txt" is "x.txt.gz", "x.txt.zst" or "x.txt" there.
+// Lines are compared ignoring white space, like diff --ignore-all-space.
+// Differing lines are printed with the rule trace of the C++ encoder.
+// Returns the number of differing lines (or failed files).
+unsigned runValidate(const Options& options);
+
+#endif